@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""Compare index DB size and hot-query latency: legacy vs current layout.
+
+Copies an existing ``.roam/index.db`` (or builds a synthetic one) twice:
+
+* ``legacy``  -- the pre-v12 index set (five edge indexes, separate
+  ``symbols(file_id)``/``files(path)`` indexes), no planner statistics
+* ``current`` -- ``ensure_schema`` + ``refresh_planner_stats(full=True)``
+
+Both copies are VACUUMed before measuring, so sizes reflect the layout
+rather than free-list pages.
+
+Usage:
+    python dev/db-layout-bench.py                     # ./.roam/index.db
+    python dev/db-layout-bench.py path/to/index.db
+    python dev/db-layout-bench.py --synthetic 200000  # random graph, N edges
+    python dev/db-layout-bench.py --json
+"""
+
+import argparse
+import json
+import random
+import shutil
+import sqlite3
+import statistics
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "src"))
+
+from roam.db.connection import ensure_schema, refresh_planner_stats  # noqa: E402
+
+LEGACY_INDEXES = [
+    "CREATE INDEX IF NOT EXISTS idx_symbols_file ON symbols(file_id)",
+    "CREATE INDEX IF NOT EXISTS idx_files_path ON files(path)",
+    "CREATE INDEX IF NOT EXISTS idx_edges_source ON edges(source_id)",
+    "CREATE INDEX IF NOT EXISTS idx_edges_target ON edges(target_id)",
+    "CREATE INDEX IF NOT EXISTS idx_edges_kind_target ON edges(kind, target_id)",
+    "CREATE INDEX IF NOT EXISTS idx_edges_source_target ON edges(source_id, target_id)",
+    "CREATE INDEX IF NOT EXISTS idx_file_edges_source ON file_edges(source_file_id)",
+]
+CURRENT_ONLY_INDEXES = ("idx_edges_out", "idx_edges_in")
+
+# Hot queries: (label, sql, parameter source)
+HOT_QUERIES = [
+    (
+        "callers_of",
+        "SELECT s.id, s.name, e.kind FROM edges e JOIN symbols s ON e.source_id = s.id WHERE e.target_id = ?",
+        "symbol",
+    ),
+    (
+        "callees_of",
+        "SELECT s.id, s.name, e.kind FROM edges e JOIN symbols s ON e.target_id = s.id WHERE e.source_id = ?",
+        "symbol",
+    ),
+    ("in_degree", "SELECT COUNT(*) FROM edges WHERE target_id = ? AND kind = 'calls'", "symbol"),
+    ("symbols_in_file", "SELECT id, name, kind FROM symbols WHERE file_id = ? ORDER BY line_start", "file"),
+    ("symbol_by_name", "SELECT id, file_id FROM symbols WHERE name = ?", "name"),
+    ("graph_load", "SELECT source_id, target_id, kind FROM edges", None),
+]
+
+
+def build_synthetic(path: Path, n_edges: int, seed: int = 7) -> None:
+    rnd = random.Random(seed)
+    n_files = max(10, n_edges // 200)
+    n_symbols = max(50, n_edges // 4)
+    conn = sqlite3.connect(str(path))
+    ensure_schema(conn)
+    conn.executemany(
+        "INSERT INTO files (id, path, language) VALUES (?, ?, 'python')",
+        [(i, f"pkg/mod_{i}.py") for i in range(1, n_files + 1)],
+    )
+    kinds = ["function", "method", "class", "variable"]
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, qualified_name, kind, line_start, line_end) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?)",
+        [
+            (i, rnd.randint(1, n_files), f"sym_{i % 5000}", f"pkg.sym_{i}", rnd.choice(kinds), i % 500, i % 500 + 9)
+            for i in range(1, n_symbols + 1)
+        ],
+    )
+    edge_kinds = ["calls"] * 6 + ["imports", "uses", "inherits"]
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind, line, source_file_id) VALUES (?, ?, ?, ?, ?)",
+        [
+            (
+                rnd.randint(1, n_symbols),
+                # Skewed targets, like real call graphs
+                min(n_symbols, int(rnd.paretovariate(1.2))),
+                rnd.choice(edge_kinds),
+                rnd.randint(1, 500),
+                rnd.randint(1, n_files),
+            )
+            for _ in range(n_edges)
+        ],
+    )
+    conn.commit()
+    conn.close()
+
+
+def make_legacy(path: Path) -> None:
+    conn = sqlite3.connect(str(path))
+    for name in CURRENT_ONLY_INDEXES:
+        conn.execute(f"DROP INDEX IF EXISTS {name}")
+    for sql in LEGACY_INDEXES:
+        conn.execute(sql)
+    conn.execute("DROP TABLE IF EXISTS sqlite_stat1")
+    conn.commit()
+    conn.execute("VACUUM")
+    conn.close()
+
+
+def make_current(path: Path) -> None:
+    conn = sqlite3.connect(str(path))
+    ensure_schema(conn)
+    refresh_planner_stats(conn, full=True)
+    conn.commit()
+    conn.execute("VACUUM")
+    conn.close()
+
+
+def index_bytes(conn) -> dict[str, int]:
+    """Bytes per table/index via dbstat, when compiled in."""
+    try:
+        rows = conn.execute("SELECT name, SUM(pgsize) FROM dbstat GROUP BY name").fetchall()
+    except sqlite3.OperationalError:
+        return {}
+    return {name: size for name, size in rows if name.startswith(("edges", "symbols", "files", "idx_"))}
+
+
+def time_queries(path: Path, samples: int, seed: int = 11) -> dict[str, float]:
+    conn = sqlite3.connect(str(path))
+    rnd = random.Random(seed)
+    sym_ids = [r[0] for r in conn.execute("SELECT id FROM symbols").fetchall()]
+    file_ids = [r[0] for r in conn.execute("SELECT id FROM files").fetchall()]
+    names = [r[0] for r in conn.execute("SELECT DISTINCT name FROM symbols LIMIT 5000").fetchall()]
+    pools = {"symbol": sym_ids, "file": file_ids, "name": names}
+
+    out = {}
+    for label, sql, pool in HOT_QUERIES:
+        timings = []
+        runs = 3 if pool is None else samples
+        for _ in range(runs):
+            params = () if pool is None else (rnd.choice(pools[pool]),)
+            t0 = time.perf_counter()
+            conn.execute(sql, params).fetchall()
+            timings.append(time.perf_counter() - t0)
+        out[label] = statistics.median(timings) * 1e6
+    conn.close()
+    return out
+
+
+def measure(path: Path, samples: int) -> dict:
+    conn = sqlite3.connect(str(path))
+    result = {"bytes": path.stat().st_size, "objects": index_bytes(conn)}
+    conn.close()
+    result["median_us"] = time_queries(path, samples)
+    return result
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("db", nargs="?", default=".roam/index.db", help="index DB to copy (default: .roam/index.db)")
+    ap.add_argument("--synthetic", type=int, metavar="EDGES", help="build a random index with EDGES edges instead")
+    ap.add_argument("--samples", type=int, default=500, help="lookups per point query (default: 500)")
+    ap.add_argument("--json", action="store_true", help="emit JSON")
+    args = ap.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        tmp = Path(tmp)
+        base = tmp / "base.db"
+        if args.synthetic:
+            build_synthetic(base, args.synthetic)
+        else:
+            src = Path(args.db)
+            if not src.exists():
+                print(f"No index at {src}; run `roam index` or pass --synthetic N", file=sys.stderr)
+                return 1
+            shutil.copyfile(src, base)
+
+        legacy, current = tmp / "legacy.db", tmp / "current.db"
+        shutil.copyfile(base, legacy)
+        shutil.copyfile(base, current)
+        make_legacy(legacy)
+        make_current(current)
+        report = {"legacy": measure(legacy, args.samples), "current": measure(current, args.samples)}
+
+    if args.json:
+        print(json.dumps(report, indent=2))
+        return 0
+
+    lb, cb = report["legacy"]["bytes"], report["current"]["bytes"]
+    print(f"DB size: legacy {lb / 1e6:.1f} MB -> current {cb / 1e6:.1f} MB ({(cb - lb) / lb * 100:+.1f}%)")
+    for layout in ("legacy", "current"):
+        objects = report[layout]["objects"]
+        if objects:
+            top = sorted(objects.items(), key=lambda kv: -kv[1])[:8]
+            print(f"  {layout}: " + ", ".join(f"{n} {b / 1e6:.1f}MB" for n, b in top))
+    print(f"\n{'query':<18}{'legacy us':>12}{'current us':>12}{'change':>10}")
+    for label, _, _ in HOT_QUERIES:
+        lt, ct = report["legacy"]["median_us"][label], report["current"]["median_us"][label]
+        print(f"{label:<18}{lt:>12.1f}{ct:>12.1f}{(ct - lt) / lt * 100:>+9.1f}%")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""Regenerate ``src/roam/command_meta.py`` (command summaries for ``roam --help``).
+
+``roam --help`` prints one-line summaries for the featured commands.  Reading
+them from the Click commands would import every command module (and with
+them networkx and the analysis stack).  The help screen reads this generated
+table instead.  ``tests/test_cold_start.py`` fails when the table is stale.
+
+Usage:
+    python dev/gen-command-meta.py           # rewrite the table
+    python dev/gen-command-meta.py --check   # exit 1 if it is out of date
+"""
+
+import argparse
+import importlib
+import json
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+sys.path.insert(0, str(ROOT / "src"))
+
+from roam.cli import _COMMANDS  # noqa: E402
+
+TARGET = ROOT / "src" / "roam" / "command_meta.py"
+SUMMARY_LIMIT = 60
+
+HEADER = '''"""Command summaries for ``roam --help``, without importing command modules.
+
+Generated by ``dev/gen-command-meta.py`` -- do not edit by hand.
+"""
+
+COMMAND_SUMMARIES = {
+'''
+
+
+def collect() -> dict[str, str]:
+    out = {}
+    for name, (module_path, attr) in sorted(_COMMANDS.items()):
+        cmd = getattr(importlib.import_module(module_path), attr)
+        out[name] = cmd.get_short_help_str(limit=SUMMARY_LIMIT)
+    return out
+
+
+def render(summaries: dict[str, str]) -> str:
+    lines = [HEADER]
+    for name, text in summaries.items():
+        lines.append(f"    {json.dumps(name)}: {json.dumps(text, ensure_ascii=False)},\n")
+    lines.append("}\n")
+    return "".join(lines)
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--check", action="store_true", help="only report whether the table is current")
+    args = ap.parse_args()
+
+    text = render(collect())
+    current = TARGET.read_text(encoding="utf-8") if TARGET.exists() else ""
+    if args.check:
+        if current != text:
+            print(f"{TARGET.relative_to(ROOT)} is out of date; run dev/gen-command-meta.py")
+            return 1
+        return 0
+    if current != text:
+        TARGET.write_text(text, encoding="utf-8")
+        print(f"wrote {TARGET.relative_to(ROOT)} ({len(text.splitlines())} lines)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
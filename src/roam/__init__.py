@@ -1,8 +1,15 @@
 """Roam: Codebase comprehension tool for AI coding assistants."""
 
-from importlib.metadata import PackageNotFoundError, version
 
-try:
-    __version__ = version("roam-code")
-except PackageNotFoundError:
-    __version__ = "dev"
+def __getattr__(name):
+    # Resolved on first use: importlib.metadata costs ~150ms of CLI start-up
+    if name == "__version__":
+        from importlib.metadata import PackageNotFoundError, version
+
+        try:
+            value = version("roam-code")
+        except PackageNotFoundError:
+            value = "dev"
+        globals()["__version__"] = value
+        return value
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
@@ -2,6 +2,12 @@
 
 This provides a clean embedding surface for agent frameworks and tools
 that want structured roam output without shelling out to subprocesses.
+
+:func:`run_json` drives the CLI and parses its JSON output, so it covers
+every command but serialises callers on the working directory.  For hot
+paths prefer :attr:`RoamClient.query` (a :class:`roam.query.RoamQuery`),
+which returns dataclasses straight from the analysis functions and is safe
+to share between threads.
 """
 
 from __future__ import annotations
@@ -16,6 +22,7 @@ from click.testing import CliRunner
 
 from roam.db.connection import find_project_root, open_db
 from roam.exit_codes import EXIT_GATE_FAILURE
+from roam.query import RoamQuery
 
 
 class RoamAPIError(RuntimeError):
@@ -188,6 +195,14 @@ class RoamClient:
 
     def __init__(self, project_root: str | Path | None = None) -> None:
         self.project_root = Path(project_root).resolve() if project_root is not None else find_project_root()
+        self._query: RoamQuery | None = None
+
+    @property
+    def query(self) -> RoamQuery:
+        """Typed, thread-safe query layer bound to this project."""
+        if self._query is None:
+            self._query = RoamQuery(self.project_root)
+        return self._query
 
     def run(self, command: str, *args: str, **kwargs) -> dict:
         kwargs.setdefault("project_root", self.project_root)
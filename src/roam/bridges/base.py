@@ -47,3 +47,22 @@ class LanguageBridge(ABC):
             List of edge dicts: [{"source": qualified_name, "target": qualified_name,
                                    "kind": "x-lang", "bridge": self.name}]
         """
+
+    def resolve_all(self, source_files: dict[str, list[dict]], target_files: dict[str, list[dict]]) -> list[dict]:
+        """Resolve links for every source file against one shared target set.
+
+        Bridges whose matches can be keyed (URL templates, proto names, Apex
+        class names) override this with a single hash or trie join built
+        once over *target_files*.  The default calls :meth:`resolve` per
+        source file.
+
+        Every returned edge carries ``source_path``, and ``target_path``
+        when the bridge knows it, so links can be mapped back to indexed
+        symbols.
+        """
+        edges: list[dict] = []
+        for path, symbols in source_files.items():
+            for edge in self.resolve(path, symbols, target_files):
+                edge.setdefault("source_path", path)
+                edges.append(edge)
+        return edges
@@ -50,6 +50,19 @@ _TARGET_EXTS = frozenset(
     }
 )
 
+# Suffixes of generated service stubs ("" = exact service name)
+_SERVICE_SUFFIXES = (
+    "",
+    "client",
+    "server",
+    "stub",
+    "servicer",
+    "grpc",
+    "blockingstub",
+    "futurestub",
+    "implbase",
+)
+
 # Pattern to extract package from proto file symbols
 _PROTO_PACKAGE_RE = re.compile(r"package\s+([\w.]+)")
 
@@ -96,15 +109,44 @@ class ProtobufBridge(LanguageBridge):
            struct MyMessage (Go), MyMessage (Java inner class)
         3. Service naming: service MyService -> MyServiceClient, MyServiceServer
         """
-        edges: list[dict] = []
-        source_ext = os.path.splitext(source_path)[1].lower()
-
-        if source_ext != ".proto":
-            return edges
+        return self.resolve_all({source_path: source_symbols}, target_files)
+
+    def source_keys(self, path: str, symbols: list[dict]) -> list[str]:
+        """Lower-cased proto stem of a ``.proto`` file (``foo`` for ``foo.proto``)."""
+        if os.path.splitext(path)[1].lower() != ".proto":
+            return []
+        return [os.path.basename(path).rsplit(".", 1)[0].lower()]
+
+    def target_keys(self, path: str, symbols: list[dict]) -> list[tuple[str, str]]:
+        """``(proto_stem, language)`` of a generated stub file, if it is one."""
+        basename = os.path.basename(path).lower()
+        for lang, pattern in _GENERATED_PATTERNS.items():
+            if pattern.search(basename):
+                stem = self._extract_stem(basename, lang)
+                return [(stem, lang)] if stem else []
+        return []
+
+    def resolve_all(self, source_files: dict[str, list[dict]], target_files: dict[str, list[dict]]) -> list[dict]:
+        """Join .proto files to generated stubs by stem, then symbols by name."""
+        generated: dict[str, list[tuple[str, str, _NameIndex]]] = {}
+        for tpath, tsymbols in target_files.items():
+            for stem, lang in self.target_keys(tpath, tsymbols):
+                generated.setdefault(stem, []).append((tpath, lang, _NameIndex(tsymbols)))
 
-        # Get the proto file stem (e.g., "foo" from "foo.proto")
-        proto_stem = os.path.basename(source_path).rsplit(".", 1)[0]
+        edges: list[dict] = []
+        for source_path, source_symbols in source_files.items():
+            for stem in self.source_keys(source_path, source_symbols):
+                targets = generated.get(stem)
+                if targets:
+                    edges.extend(self._resolve_proto(source_path, source_symbols, targets))
+        return edges
 
+    def _resolve_proto(
+        self,
+        source_path: str,
+        source_symbols: list[dict],
+        targets: list[tuple[str, str, _NameIndex]],
+    ) -> list[dict]:
         # Classify source symbols into messages, services, enums
         messages = []
         services = []
@@ -118,91 +160,31 @@ class ProtobufBridge(LanguageBridge):
             elif kind == "enum":
                 enums.append(sym)
 
-        # Find generated target files that correspond to this proto
-        generated_targets = self._find_generated_files(proto_stem, target_files)
-
-        # For each generated file, try to match symbols
-        for tpath, tsymbols, lang in generated_targets:
-            target_symbol_names = {sym.get("name", ""): sym.get("qualified_name", "") for sym in tsymbols}
-
-            # Match message symbols
-            for msg in messages:
-                msg_name = msg.get("name", "")
-                msg_qname = msg.get("qualified_name", msg_name)
-                matched = self._match_message(msg_name, target_symbol_names, lang)
-                for target_qname in matched:
-                    edges.append(
-                        {
-                            "source": msg_qname,
-                            "target": target_qname,
-                            "kind": "x-lang",
-                            "bridge": self.name,
-                            "mechanism": "proto-message",
-                            "target_lang": lang,
-                        }
-                    )
-
-            # Match service symbols
-            for svc in services:
-                svc_name = svc.get("name", "")
-                svc_qname = svc.get("qualified_name", svc_name)
-                matched = self._match_service(svc_name, target_symbol_names, lang)
-                for target_qname in matched:
-                    edges.append(
-                        {
-                            "source": svc_qname,
-                            "target": target_qname,
-                            "kind": "x-lang",
-                            "bridge": self.name,
-                            "mechanism": "proto-service",
-                            "target_lang": lang,
-                        }
-                    )
-
-            # Match enum symbols
-            for enum in enums:
-                enum_name = enum.get("name", "")
-                enum_qname = enum.get("qualified_name", enum_name)
-                matched = self._match_enum(enum_name, target_symbol_names, lang)
-                for target_qname in matched:
-                    edges.append(
-                        {
-                            "source": enum_qname,
-                            "target": target_qname,
-                            "kind": "x-lang",
-                            "bridge": self.name,
-                            "mechanism": "proto-enum",
-                            "target_lang": lang,
-                        }
-                    )
-
+        edges: list[dict] = []
+        for tpath, lang, names in targets:
+            for group, mechanism, match in (
+                (messages, "proto-message", self._match_message),
+                (services, "proto-service", self._match_service),
+                (enums, "proto-enum", self._match_enum),
+            ):
+                for sym in group:
+                    name = sym.get("name", "")
+                    qname = sym.get("qualified_name", name)
+                    for target_qname in match(name, names, lang):
+                        edges.append(
+                            {
+                                "source": qname,
+                                "target": target_qname,
+                                "kind": "x-lang",
+                                "bridge": self.name,
+                                "mechanism": mechanism,
+                                "target_lang": lang,
+                                "source_path": source_path,
+                                "target_path": tpath,
+                            }
+                        )
         return edges
 
-    def _find_generated_files(
-        self, proto_stem: str, target_files: dict[str, list[dict]]
-    ) -> list[tuple[str, list[dict], str]]:
-        """Find target files that were likely generated from this proto.
-
-        Returns list of (path, symbols, language) tuples.
-        """
-        results = []
-        proto_lower = proto_stem.lower()
-
-        for tpath, tsymbols in target_files.items():
-            basename = os.path.basename(tpath).lower()
-
-            # Check each language pattern
-            for lang, pattern in _GENERATED_PATTERNS.items():
-                if pattern.search(basename):
-                    # Verify the stem matches the proto file
-                    # e.g., "foo_pb2.py" stem is "foo", "foo.pb.go" stem is "foo"
-                    generated_stem = self._extract_stem(basename, lang)
-                    if generated_stem and generated_stem == proto_lower:
-                        results.append((tpath, tsymbols, lang))
-                    break  # Only match one language per file
-
-        return results
-
     def _extract_stem(self, basename: str, lang: str) -> str | None:
         """Extract the original proto stem from a generated filename.
 
@@ -243,7 +225,7 @@ class ProtobufBridge(LanguageBridge):
             return m.group(1) if m else None
         return None
 
-    def _match_message(self, msg_name: str, target_names: dict[str, str], lang: str) -> list[str]:
+    def _match_message(self, msg_name: str, names: _NameIndex, lang: str) -> list[str]:
         """Match a proto message name to generated symbols.
 
         Naming conventions vary by language:
@@ -252,31 +234,15 @@ class ProtobufBridge(LanguageBridge):
         - Java: inner class MyMessage inside OuterClass
         - C++: class MyMessage in namespace
         """
-        matched = []
         msg_lower = msg_name.lower()
-
-        for sym_name, sym_qname in target_names.items():
-            sym_lower = sym_name.lower()
-
-            # Exact match (most common for Python, Go, C++)
-            if sym_lower == msg_lower:
-                matched.append(sym_qname)
-                continue
-
-            # Go: proto snake_case -> CamelCase
-            # e.g., my_message -> MyMessage
-            if lang == "go" and self._snake_to_camel(msg_name).lower() == sym_lower:
-                matched.append(sym_qname)
-                continue
-
-            # Java: OuterClass.MessageName pattern
-            if lang == "java" and sym_lower.endswith("." + msg_lower):
-                matched.append(sym_qname)
-                continue
-
-        return matched
-
-    def _match_service(self, svc_name: str, target_names: dict[str, str], lang: str) -> list[str]:
+        keys = [msg_lower]
+        # Go: proto snake_case -> CamelCase (e.g., my_message -> MyMessage)
+        if lang == "go":
+            keys.append(self._snake_to_camel(msg_name).lower())
+        # Java: OuterClass.MessageName pattern
+        return names.lookup(keys, dotted_suffix=msg_lower if lang == "java" else None)
+
+    def _match_service(self, svc_name: str, names: _NameIndex, lang: str) -> list[str]:
         """Match a proto service name to generated symbols.
 
         Generated service stubs commonly use suffixes:
@@ -284,57 +250,21 @@ class ProtobufBridge(LanguageBridge):
         - Go: MyServiceClient, MyServiceServer
         - Java: MyServiceGrpc, MyServiceBlockingStub
         """
-        matched = []
         svc_lower = svc_name.lower()
+        keys = [svc_lower + suffix for suffix in _SERVICE_SUFFIXES]
+        # Also check with underscore separator (Python style)
+        keys.extend(svc_lower + "_" + suffix for suffix in _SERVICE_SUFFIXES if suffix)
+        return names.lookup(keys)
 
-        # Common generated suffixes for service stubs
-        suffixes = [
-            "",  # exact match
-            "client",
-            "server",
-            "stub",
-            "servicer",
-            "grpc",
-            "blockingstub",
-            "futurestub",
-            "implbase",
-        ]
-
-        for sym_name, sym_qname in target_names.items():
-            sym_lower = sym_name.lower()
-            for suffix in suffixes:
-                if sym_lower == svc_lower + suffix:
-                    matched.append(sym_qname)
-                    break
-                # Also check with underscore separator (Python style)
-                if suffix and sym_lower == svc_lower + "_" + suffix:
-                    matched.append(sym_qname)
-                    break
-
-        return matched
-
-    def _match_enum(self, enum_name: str, target_names: dict[str, str], lang: str) -> list[str]:
+    def _match_enum(self, enum_name: str, names: _NameIndex, lang: str) -> list[str]:
         """Match a proto enum name to generated symbols.
 
         Enums generally keep their name across languages.
         """
-        matched = []
-        enum_lower = enum_name.lower()
-
-        for sym_name, sym_qname in target_names.items():
-            sym_lower = sym_name.lower()
-
-            # Exact match
-            if sym_lower == enum_lower:
-                matched.append(sym_qname)
-                continue
-
-            # Go CamelCase conversion
-            if lang == "go" and self._snake_to_camel(enum_name).lower() == sym_lower:
-                matched.append(sym_qname)
-                continue
-
-        return matched
+        keys = [enum_name.lower()]
+        if lang == "go":
+            keys.append(self._snake_to_camel(enum_name).lower())
+        return names.lookup(keys)
 
     def _snake_to_camel(self, name: str) -> str:
         """Convert snake_case to CamelCase.
@@ -348,5 +278,34 @@ class ProtobufBridge(LanguageBridge):
         return "".join(p.capitalize() for p in parts if p)
 
 
+class _NameIndex:
+    """Case-insensitive name lookup over one generated file's symbols.
+
+    Mirrors a ``{name: qualified_name}`` dict (last definition wins) and
+    returns matches in that dict's order.
+    """
+
+    __slots__ = ("_by_lower", "_by_last_segment")
+
+    def __init__(self, symbols: list[dict]):
+        names = {sym.get("name", ""): sym.get("qualified_name", "") for sym in symbols}
+        self._by_lower: dict[str, list[tuple[int, str]]] = {}
+        self._by_last_segment: dict[str, list[tuple[int, str]]] = {}
+        for order, (name, qname) in enumerate(names.items()):
+            lower = name.lower()
+            self._by_lower.setdefault(lower, []).append((order, qname))
+            if "." in lower:
+                self._by_last_segment.setdefault(lower.rsplit(".", 1)[1], []).append((order, qname))
+
+    def lookup(self, keys: list[str], dotted_suffix: str | None = None) -> list[str]:
+        """Qualified names whose lower-cased name is in *keys* or ends with ``.dotted_suffix``."""
+        hits: set[tuple[int, str]] = set()
+        for key in keys:
+            hits.update(self._by_lower.get(key, ()))
+        if dotted_suffix:
+            hits.update(self._by_last_segment.get(dotted_suffix, ()))
+        return [qname for _, qname in sorted(hits)]
+
+
 # Auto-register on import
 register_bridge(ProtobufBridge())
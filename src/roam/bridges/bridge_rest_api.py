@@ -53,6 +53,9 @@ _PY_HTTP_RE = re.compile(
     re.IGNORECASE,
 )
 
+# Route parameter placeholders: :id, <id>, {id}
+_PARAM_RE = re.compile(r"[:<{]\w+[>}]?")
+
 # --- Backend route definition patterns ---
 
 # Python/Flask/FastAPI: @app.route('/api/users'), @router.get('/api/users')
@@ -122,36 +125,44 @@ class RestApiBridge(LanguageBridge):
         not raw file content), we extract URL-like strings from symbol names,
         signatures, and qualified names.
         """
-        edges: list[dict] = []
+        return self.resolve_all({source_path: source_symbols}, target_files)
 
-        # Extract URLs from source symbols (frontend calls)
-        source_urls = self._extract_urls_from_symbols(source_symbols, mode="client")
+    def source_keys(self, path: str, symbols: list[dict]) -> list[tuple[str, str]]:
+        """Client URLs called from a file, as ``(url, symbol_qualified_name)``."""
+        return self._extract_urls_from_symbols(symbols, mode="client")
 
-        if not source_urls:
-            return edges
+    def target_keys(self, path: str, symbols: list[dict]) -> list[tuple[str, str]]:
+        """Route templates a file defines, as ``(url, symbol_qualified_name)``."""
+        return self._extract_urls_from_symbols(symbols, mode="server")
 
-        # Extract route definitions from target files
+    def resolve_all(self, source_files: dict[str, list[dict]], target_files: dict[str, list[dict]]) -> list[dict]:
+        """Match every client URL against a route trie built once from all targets."""
+        trie = _RouteTrie()
+        seq = 0
         for tpath, tsymbols in target_files.items():
-            target_urls = self._extract_urls_from_symbols(tsymbols, mode="server")
-            if not target_urls:
-                continue
-
-            # Match URLs
-            for src_url, src_sym_name in source_urls:
-                for tgt_url, tgt_sym_name in target_urls:
-                    if self._urls_match(src_url, tgt_url):
-                        edges.append(
-                            {
-                                "source": src_sym_name,
-                                "target": tgt_sym_name,
-                                "kind": "x-lang",
-                                "bridge": self.name,
-                                "mechanism": "url-match",
-                                "url": src_url,
-                                "confidence": 0.8,
-                            }
-                        )
+            for tgt_url, tgt_sym_name in self.target_keys(tpath, tsymbols):
+                trie.insert(tgt_url, (seq, tgt_sym_name, tpath))
+                seq += 1
+        if not seq:
+            return []
 
+        edges: list[dict] = []
+        for spath, ssymbols in source_files.items():
+            for src_url, src_sym_name in self.source_keys(spath, ssymbols):
+                for _, tgt_sym_name, tpath in sorted(trie.match(src_url)):
+                    edges.append(
+                        {
+                            "source": src_sym_name,
+                            "target": tgt_sym_name,
+                            "kind": "x-lang",
+                            "bridge": self.name,
+                            "mechanism": "url-match",
+                            "url": src_url,
+                            "confidence": 0.8,
+                            "source_path": spath,
+                            "target_path": tpath,
+                        }
+                    )
         return edges
 
     def _extract_urls_from_symbols(self, symbols: list[dict], mode: str) -> list[tuple[str, str]]:
@@ -231,12 +242,61 @@ class RestApiBridge(LanguageBridge):
         # Check prefix match for parameterized routes
         # Convert server route params to regex
         # :param, <param>, {param} -> wildcard
-        param_re = re.sub(r"[:<{]\w+[>}]?", r"[^/]+", s)
+        param_re = _PARAM_RE.sub(r"[^/]+", s)
         if re.fullmatch(param_re, c):
             return True
 
         return False
 
 
+class _RouteTrie:
+    """Server route templates keyed by path segment.
+
+    Segments holding a route parameter (``:id``, ``<id>``, ``{id}``) are
+    stored as patterns that match one client segment; literal segments are
+    dict lookups, so matching a URL costs O(segments) plus the parameter
+    branches actually present at each level.  Trailing slashes are ignored.
+    """
+
+    __slots__ = ("literal", "params", "routes")
+
+    def __init__(self):
+        self.literal: dict[str, _RouteTrie] = {}
+        self.params: dict[str, tuple[re.Pattern, _RouteTrie]] = {}
+        self.routes: list = []
+
+    def insert(self, url: str, payload) -> None:
+        node = self
+        for seg in url.rstrip("/").split("/"):
+            if _PARAM_RE.search(seg):
+                entry = node.params.get(seg)
+                if entry is None:
+                    pattern = re.compile("[^/]+".join(re.escape(part) for part in _PARAM_RE.split(seg)))
+                    entry = node.params[seg] = (pattern, _RouteTrie())
+                node = entry[1]
+            else:
+                node = node.literal.setdefault(seg, _RouteTrie())
+        node.routes.append(payload)
+
+    def match(self, url: str) -> list:
+        """Payloads of every route matching *url* (unordered)."""
+        segs = url.rstrip("/").split("/")
+        out: list = []
+        stack = [(self, 0)]
+        while stack:
+            node, i = stack.pop()
+            if i == len(segs):
+                out.extend(node.routes)
+                continue
+            seg = segs[i]
+            child = node.literal.get(seg)
+            if child is not None:
+                stack.append((child, i + 1))
+            for pattern, child in node.params.values():
+                if pattern.fullmatch(seg):
+                    stack.append((child, i + 1))
+        return out
+
+
 # Auto-register on import
 register_bridge(RestApiBridge())
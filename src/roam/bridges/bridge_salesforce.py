@@ -62,87 +62,80 @@ class SalesforceBridge(LanguageBridge):
         2. Controller attribute: <aura:component controller="MyController">
         3. @AuraEnabled methods: match to components referencing that controller
         """
-        edges: list[dict] = []
-        source_ext = os.path.splitext(source_path)[1].lower()
+        return self.resolve_all({source_path: source_symbols}, target_files)
 
-        if source_ext not in _APEX_EXTS:
-            return edges
+    def source_keys(self, path: str, symbols: list[dict]) -> list[str]:
+        """Lower-cased Apex class name of a ``.cls``/``.trigger`` file."""
+        if os.path.splitext(path)[1].lower() not in _APEX_EXTS:
+            return []
+        return [os.path.basename(path).rsplit(".", 1)[0].lower()]
 
-        # Get the Apex class name from the file path
-        apex_class_name = os.path.basename(source_path).rsplit(".", 1)[0]
+    def target_keys(self, path: str, symbols: list[dict]) -> list[str]:
+        """Apex class names (lower-cased) a markup file pairs with by naming convention.
 
-        # Build a lookup of target symbols by qualified name for fast matching
-        target_symbol_index: dict[str, str] = {}  # symbol_name -> qualified_name
-        # Track which target files reference this Apex class as a controller
-        controller_targets: list[tuple[str, list[dict]]] = []
+        These are exactly the names :meth:`_names_match` accepts: the
+        component name itself, with a ``Controller`` suffix added, or with
+        one removed.
+        """
+        if os.path.splitext(path)[1].lower() not in _SF_MARKUP_EXTS:
+            return []
+        lower = os.path.basename(path).rsplit(".", 1)[0].lower()
+        keys = [lower, lower + "controller"]
+        if lower.endswith("controller") and len(lower) > len("controller"):
+            keys.append(lower[: -len("controller")])
+        return keys
+
+    def resolve_all(self, source_files: dict[str, list[dict]], target_files: dict[str, list[dict]]) -> list[dict]:
+        """Join Apex classes to markup files through a class-name hash index."""
+        by_class: dict[str, list[tuple[int, str]]] = {}
+        for order, (tpath, tsymbols) in enumerate(target_files.items()):
+            for key in self.target_keys(tpath, tsymbols):
+                by_class.setdefault(key, []).append((order, tpath))
 
-        for tpath, tsymbols in target_files.items():
-            text_ext = os.path.splitext(tpath)[1].lower()
-            if text_ext not in _SF_MARKUP_EXTS:
+        edges: list[dict] = []
+        for source_path, source_symbols in source_files.items():
+            keys = self.source_keys(source_path, source_symbols)
+            if not keys:
                 continue
-
-            for sym in tsymbols:
-                target_symbol_index[sym.get("name", "")] = sym.get("qualified_name", "")
-
-            # Check if any target symbol references this Apex class
-            # Aura components reference controllers via naming convention or
-            # controller attribute (already extracted as references by AuraExtractor)
-            target_basename = os.path.basename(tpath).rsplit(".", 1)[0]
+            apex_class_name = os.path.basename(source_path).rsplit(".", 1)[0]
+            controller_targets = sorted(set(by_class.get(keys[0], ())))
 
             # Strategy 1: Naming convention match
             # MyController.cls -> MyController.cmp (same name)
             # MyController.cls -> MyControllerCmp.cmp (with suffix)
-            if self._names_match(apex_class_name, target_basename):
-                controller_targets.append((tpath, tsymbols))
-                # Create edge from Apex class to the component
+            for _, tpath in controller_targets:
                 edges.append(
                     {
                         "source": apex_class_name,
-                        "target": target_basename,
+                        "target": os.path.basename(tpath).rsplit(".", 1)[0],
                         "kind": "x-lang",
                         "bridge": self.name,
                         "mechanism": "naming-convention",
+                        "source_path": source_path,
+                        "target_path": tpath,
                     }
                 )
 
-        # Strategy 2: Match @AuraEnabled methods to components that reference
-        # this controller. Any component whose controller is this Apex class
-        # can call its @AuraEnabled methods.
-        aura_enabled_methods = self._find_aura_enabled_methods(source_symbols)
-
-        for method_name, method_qname in aura_enabled_methods:
-            for tpath, tsymbols in controller_targets:
-                target_basename = os.path.basename(tpath).rsplit(".", 1)[0]
-                edges.append(
-                    {
-                        "source": method_qname,
-                        "target": target_basename,
-                        "kind": "x-lang",
-                        "bridge": self.name,
-                        "mechanism": "aura-enabled",
-                    }
-                )
-
-        # Strategy 3: Check for Visualforce controller references
-        # Visualforce pages specify controller="ClassName" in <apex:page>
-        # The VF extractor already extracts these as "controller" references,
-        # but we create x-lang edges for them here
-        for tpath, tsymbols in target_files.items():
-            text_ext = os.path.splitext(tpath)[1].lower()
-            if text_ext not in (".page", ".component"):
-                continue
-            target_basename = os.path.basename(tpath).rsplit(".", 1)[0]
-            # Check if any symbol in the target references this Apex class
-            # We look for the component-level symbol whose name matches
-            for sym in tsymbols:
-                # Visualforce pages are top-level symbols of kind "page"/"component"
-                if sym.get("kind") in ("page", "component"):
-                    # The VF extractor creates controller references; check if
-                    # this Apex class is referenced by name in the target path
-                    # (We rely on naming convention or explicit controller attr)
-                    if self._names_match(apex_class_name, target_basename):
-                        # Already handled by strategy 1 above; skip duplicate
-                        pass
+            # Strategy 2: Match @AuraEnabled methods to components that reference
+            # this controller. Any component whose controller is this Apex class
+            # can call its @AuraEnabled methods.
+            for _, method_qname in self._find_aura_enabled_methods(source_symbols):
+                for _, tpath in controller_targets:
+                    edges.append(
+                        {
+                            "source": method_qname,
+                            "target": os.path.basename(tpath).rsplit(".", 1)[0],
+                            "kind": "x-lang",
+                            "bridge": self.name,
+                            "mechanism": "aura-enabled",
+                            "source_path": source_path,
+                            "target_path": tpath,
+                        }
+                    )
+
+            # Visualforce pages name their controller via controller="ClassName";
+            # the VF extractor records those as ordinary references, and the
+            # naming convention above covers the remaining pairings.
 
         return edges
 
@@ -0,0 +1,199 @@
+"""Resolve cross-language bridges over the whole index in one pass.
+
+Symbols of every file are loaded with a single query and each active
+bridge joins all of its source files against all of its target files via
+:meth:`~roam.bridges.base.LanguageBridge.resolve_all`.  The indexer
+persists the resulting links into ``edges`` (kind ``x-lang``, ``bridge``
+set to the bridge name) so ``impact``, ``uses`` and ``trace`` follow them
+like any other edge; ``roam x-lang`` reports the same resolution.
+Incremental runs re-resolve only the links from or into changed files.
+"""
+
+from __future__ import annotations
+
+from roam.bridges.registry import detect_bridges
+from roam.db.connection import batched_in
+
+BRIDGE_EDGE_KIND = "x-lang"
+
+
+def load_file_symbols(conn) -> dict[str, list[dict]]:
+    """Symbols of every indexed file, keyed by path, in one query."""
+    rows = conn.execute(
+        "SELECT s.id, s.file_id, s.name, s.qualified_name, s.kind, s.signature, s.docstring, "
+        "COALESCE(p.qualified_name, p.name) AS parent, f.path "
+        "FROM symbols s JOIN files f ON f.id = s.file_id "
+        "LEFT JOIN symbols p ON p.id = s.parent_id "
+        "ORDER BY s.file_id, s.id"
+    ).fetchall()
+    by_path: dict[str, list[dict]] = {}
+    for r in rows:
+        by_path.setdefault(r[8], []).append(
+            {
+                "id": r[0],
+                "file_id": r[1],
+                "name": r[2],
+                "qualified_name": r[3] or r[2],
+                "kind": r[4],
+                "signature": r[5],
+                "docstring": r[6],
+                "parent": r[7],
+            }
+        )
+    return by_path
+
+
+def _with_extension(paths: list[str], extensions: frozenset[str]) -> list[str]:
+    suffixes = tuple(extensions)
+    return [p for p in paths if p.endswith(suffixes)]
+
+
+def _touches(bridge, changed: set[str]) -> bool:
+    extensions = tuple(bridge.source_extensions | bridge.target_extensions)
+    return any(p.endswith(extensions) for p in changed)
+
+
+def _active_bridges(conn, changed: set[str] | None):
+    paths = [r[0] for r in conn.execute("SELECT path FROM files").fetchall()]
+    if not paths:
+        return paths, []
+    active = detect_bridges(paths)
+    if changed is not None:
+        active = [b for b in active if _touches(b, changed)]
+    return paths, active
+
+
+def resolve_bridges(
+    conn,
+    file_symbols: dict[str, list[dict]] | None = None,
+    changed: set[str] | None = None,
+) -> tuple[list[dict], list[dict]]:
+    """Run every active bridge once over the index.
+
+    Returns ``(bridge_summaries, links)``.  *file_symbols* may be passed
+    when the caller already holds :func:`load_file_symbols` output.  With
+    *changed* paths only links from or into those files are resolved, and
+    bridges with none of their extensions among them are skipped.
+    """
+    paths, active = _active_bridges(conn, changed)
+    if not active:
+        return [], []
+    if file_symbols is None:
+        file_symbols = load_file_symbols(conn)
+
+    summaries: list[dict] = []
+    links: list[dict] = []
+    for bridge in active:
+        source_paths = _with_extension(paths, bridge.source_extensions)
+        target_paths = _with_extension(paths, bridge.target_extensions)
+        if not source_paths or not target_paths:
+            continue
+
+        sources = {p: file_symbols[p] for p in source_paths if file_symbols.get(p)}
+        targets = {p: file_symbols[p] for p in target_paths if file_symbols.get(p)}
+        if changed is None:
+            bridge_links = bridge.resolve_all(sources, targets) if sources and targets else []
+        else:
+            # Links from changed sources, plus links from the others into changed targets
+            new_sources = {p: syms for p, syms in sources.items() if p in changed}
+            old_sources = {p: syms for p, syms in sources.items() if p not in changed}
+            new_targets = {p: syms for p, syms in targets.items() if p in changed}
+            bridge_links = bridge.resolve_all(new_sources, targets) if new_sources and targets else []
+            if old_sources and new_targets:
+                bridge_links += bridge.resolve_all(old_sources, new_targets)
+
+        links.extend(bridge_links)
+        summaries.append(
+            {
+                "name": bridge.name,
+                "source_files": len(source_paths),
+                "target_files": len(target_paths),
+                "links": len(bridge_links),
+                "source_extensions": sorted(bridge.source_extensions),
+                "target_extensions": sorted(bridge.target_extensions),
+            }
+        )
+    return summaries, links
+
+
+class _SymbolLookup:
+    """Map bridge link endpoints (names plus optional paths) to symbol rows."""
+
+    def __init__(self, file_symbols: dict[str, list[dict]]):
+        self._in_file: dict[str, dict[str, dict]] = {}
+        self._global: dict[str, dict | None] = {}
+        for path, symbols in file_symbols.items():
+            local: dict[str, dict] = {}
+            for sym in symbols:
+                for key in (sym["qualified_name"], sym["name"]):
+                    local.setdefault(key, sym)
+                    # Names defined in more than one place are ambiguous globally
+                    if key not in self._global:
+                        self._global[key] = sym
+                    elif self._global[key] is not sym:
+                        self._global[key] = None
+            self._in_file[path] = local
+
+    def find(self, name: str | None, path: str | None) -> dict | None:
+        """The symbol *name* in *path*; without a path, the unique global one."""
+        if not name:
+            return None
+        if path is not None:
+            # A name missing from the named file must not bind elsewhere
+            return self._in_file.get(path, {}).get(name)
+        return self._global.get(name)
+
+
+def store_bridge_edges(conn, changed_paths=None) -> int:
+    """Replace persisted bridge edges with a fresh resolution.
+
+    Links whose endpoints cannot be mapped to a single indexed symbol
+    (e.g. template variables) are reported by ``roam x-lang`` but not
+    stored.  With *changed_paths* (an incremental run) only edges from or
+    into those files are re-resolved, and nothing is loaded when no active
+    bridge handles their extensions; edges of removed symbols are already
+    gone by cascade.  Path-less endpoints resolved by a globally unique
+    name are only re-checked by a full run.  Returns the number of edges
+    written.
+    """
+    changed = None if changed_paths is None else set(changed_paths)
+    if changed is None:
+        conn.execute("DELETE FROM edges WHERE bridge IS NOT NULL")
+    else:
+        if not changed or not _active_bridges(conn, changed)[1]:
+            return 0
+        ids = [
+            r[0]
+            for r in batched_in(
+                conn,
+                "SELECT s.id FROM symbols s JOIN files f ON f.id = s.file_id WHERE f.path IN ({ph})",
+                sorted(changed),
+            )
+        ]
+        batched_in(
+            conn, "DELETE FROM edges WHERE bridge IS NOT NULL AND (source_id IN ({ph}) OR target_id IN ({ph}))", ids
+        )
+    file_symbols = load_file_symbols(conn)
+    _, links = resolve_bridges(conn, file_symbols, changed)
+    if not links:
+        return 0
+
+    lookup = _SymbolLookup(file_symbols)
+    rows = []
+    seen: set[tuple[int, int, str]] = set()
+    for link in links:
+        src = lookup.find(link.get("source"), link.get("source_path"))
+        tgt = lookup.find(link.get("target"), link.get("target_path"))
+        if src is None or tgt is None or src["id"] == tgt["id"]:
+            continue
+        key = (src["id"], tgt["id"], link["bridge"])
+        if key in seen:
+            continue
+        seen.add(key)
+        rows.append((src["id"], tgt["id"], BRIDGE_EDGE_KIND, link["bridge"], link.get("confidence"), src["file_id"]))
+
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind, bridge, confidence, source_file_id) VALUES (?, ?, ?, ?, ?, ?)",
+        rows,
+    )
+    return len(rows)
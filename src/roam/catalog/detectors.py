@@ -18,6 +18,7 @@ from __future__ import annotations
 import json
 import os
 import re
+import time
 
 from roam.catalog.tasks import best_way
 
@@ -109,20 +110,6 @@ def _dedupe(seq: list[str]) -> list[str]:
     return out
 
 
-def _read_symbol_source(path: str, line_start: int | None, line_end: int | None) -> str:
-    """Best-effort source slice for a symbol location."""
-    try:
-        with open(path, "r", encoding="utf-8", errors="replace") as f:
-            lines = f.read().splitlines()
-    except OSError:
-        return ""
-    if line_start is None or line_end is None:
-        return "\n".join(lines)
-    ls = max(1, int(line_start))
-    le = max(ls, int(line_end))
-    return "\n".join(lines[ls - 1 : le])
-
-
 def _iter_loop_calls(row) -> list[str]:
     """Return combined loop call names (leaf + qualified)."""
     calls = _json_list(_row_value(row, "calls_in_loops", ""))
@@ -276,46 +263,362 @@ def _guard_hints_from_source(language: str | None, snippet: str) -> list[str]:
     return _dedupe(hits)
 
 
+# ---------------------------------------------------------------------------
+# Fused scan engine
+# ---------------------------------------------------------------------------
+#
+# Every built-in detector only looks at function/method symbols joined with
+# their ``math_signals`` (and, for one detector, ``symbol_metrics``) row.
+# Instead of each detector issuing its own full-table query, the engine
+# loads those columns once into columnar arrays, walks the rows a single
+# time and hands each row to every active per-row check.  Follow-up lookups
+# (memoization edges, same-file helpers) are answered from sets built with
+# chunked IN-queries, and symbol sources are sliced from a small per-file
+# line cache instead of re-reading the file for every symbol.
+
+_MS_COLUMNS = (
+    "loop_depth",
+    "has_nested_loops",
+    "calls_in_loops",
+    "calls_in_loops_qualified",
+    "subscript_in_loops",
+    "has_self_call",
+    "loop_with_compare",
+    "loop_with_accumulator",
+    "loop_with_multiplication",
+    "loop_with_modulo",
+    "self_call_count",
+    "str_concat_in_loop",
+    "loop_invariant_calls",
+    "loop_lookup_calls",
+    "front_ops_in_loop",
+)
+
+_MEMO_NAMES = ("lru_cache", "cache", "memoize", "memo", "functools.lru_cache", "functools.cache")
+_AMBIGUOUS_BARE = {"query", "find", "get"}
+_SOURCE_CACHE_FILES = 16
+
+
+def _table_columns(conn, table: str) -> set[str]:
+    """Return the column names of *table* (empty when the table is missing)."""
+    try:
+        return {r[1] for r in conn.execute(f"PRAGMA table_info({table})").fetchall()}
+    except Exception:
+        return set()
+
+
+def _like_regex(patterns) -> re.Pattern:
+    """Compile SQL ``LIKE`` patterns into one case-insensitive regex.
+
+    Mirrors SQLite semantics: ``%`` matches any run, ``_`` exactly one
+    character, and ASCII matching is case-insensitive.
+    """
+    parts = []
+    for pat in patterns:
+        out = []
+        for ch in pat:
+            if ch == "%":
+                out.append(".*")
+            elif ch == "_":
+                out.append(".")
+            else:
+                out.append(re.escape(ch))
+        parts.append("".join(out))
+    return re.compile("(?:" + "|".join(parts) + r")\Z", re.IGNORECASE | re.DOTALL)
+
+
+def _flag(row, key) -> int:
+    """Numeric signal value with SQL NULL treated as 0."""
+    return row.get(key) or 0
+
+
+class DetectorScan:
+    """Columnar snapshot of the detector inputs for one run.
+
+    ``columns`` maps column name to a list with one entry per function or
+    method symbol.  ``has_ms`` / ``has_sm`` flag rows that have a
+    ``math_signals`` / ``symbol_metrics`` row (inner-join semantics).
+    """
+
+    def __init__(self, conn):
+        self.conn = conn
+        self.ms_columns = _table_columns(conn, "math_signals")
+        self.has_symbol_metrics = bool(_table_columns(conn, "symbol_metrics"))
+        self.columns: dict[str, list] = {}
+        self.size = 0
+        self._memoized: set[int] | None = None
+        self._local_helpers: set[tuple[int, str]] | None = None
+        self._loop_calls: dict[tuple[int, bool], list[str]] = {}
+        self._lines: dict[str, list[str] | None] = {}
+        self._test_paths: dict[str, bool] = {}
+        self._load()
+
+    def has_column(self, name: str) -> bool:
+        return name in self.ms_columns
+
+    def _load(self):
+        select = [
+            "s.id",
+            "s.file_id",
+            "s.name",
+            "s.qualified_name",
+            "s.kind",
+            "f.path AS file_path",
+            "f.language AS language",
+            "s.line_start",
+            "s.line_end",
+        ]
+        joins = ["JOIN files f ON s.file_id = f.id"]
+        if self.ms_columns:
+            select.append("ms.symbol_id IS NOT NULL AS has_ms")
+            for col in _MS_COLUMNS:
+                select.append(f"ms.{col}" if col in self.ms_columns else f"NULL AS {col}")
+            joins.append("LEFT JOIN math_signals ms ON ms.symbol_id = s.id")
+        else:
+            select.append("0 AS has_ms")
+            select.extend(f"NULL AS {col}" for col in _MS_COLUMNS)
+        if self.has_symbol_metrics:
+            select.append("sm.symbol_id IS NOT NULL AS has_sm")
+            select.append("sm.cognitive_complexity")
+            joins.append("LEFT JOIN symbol_metrics sm ON sm.symbol_id = s.id")
+        else:
+            select.append("0 AS has_sm")
+            select.append("NULL AS cognitive_complexity")
+
+        cur = self.conn.cursor()
+        cur.row_factory = None
+        cur.execute(
+            f"SELECT {', '.join(select)} FROM symbols s {' '.join(joins)} WHERE s.kind IN ('function', 'method')"
+        )
+        names = [d[0] for d in cur.description]
+        rows = cur.fetchall()
+        self.size = len(rows)
+        values = list(zip(*rows)) if rows else [()] * len(names)
+        self.columns = {name: list(col) for name, col in zip(names, values)}
+
+    def rows(self):
+        """Yield ``(index, row_dict)`` for every loaded symbol."""
+        names = list(self.columns)
+        for i, values in enumerate(zip(*self.columns.values())):
+            yield i, dict(zip(names, values))
+
+    def is_test_path(self, path: str) -> bool:
+        hit = self._test_paths.get(path)
+        if hit is None:
+            hit = self._test_paths[path] = _is_test_path(path)
+        return hit
+
+    def loop_calls(self, row, qualified: bool = False) -> list[str]:
+        """Loop call names for *row*, parsed once per symbol.
+
+        Leaf names only by default; ``qualified=True`` also merges
+        ``calls_in_loops_qualified`` for detectors that match receivers.
+        """
+        key = (row["id"], qualified)
+        calls = self._loop_calls.get(key)
+        if calls is None:
+            if qualified:
+                calls = _iter_loop_calls(row)
+            else:
+                calls = _dedupe(_json_list(row.get("calls_in_loops")))
+            self._loop_calls[key] = calls
+        return calls
+
+    def source(self, row) -> str:
+        """Source slice for *row*, served from a bounded per-file line cache."""
+        path = row["file_path"]
+        lines = self._lines.get(path, False)
+        if lines is False:
+            try:
+                with open(path, "r", encoding="utf-8", errors="replace") as f:
+                    lines = f.read().splitlines()
+            except OSError:
+                lines = None
+            if len(self._lines) >= _SOURCE_CACHE_FILES:
+                self._lines.pop(next(iter(self._lines)))
+            self._lines[path] = lines
+        if lines is None:
+            return ""
+        line_start, line_end = row.get("line_start"), row.get("line_end")
+        if line_start is None or line_end is None:
+            return "\n".join(lines)
+        ls = max(1, int(line_start))
+        le = max(ls, int(line_end))
+        return "\n".join(lines[ls - 1 : le])
+
+    def is_memoized(self, symbol_id: int) -> bool:
+        """True when the symbol has an edge to a memoization helper."""
+        if self._memoized is None:
+            cols = self.columns
+            candidates = [
+                sid
+                for sid, has_ms, self_call, self_count in zip(
+                    cols.get("id", []),
+                    cols.get("has_ms", []),
+                    cols.get("has_self_call", []),
+                    cols.get("self_call_count", []),
+                )
+                if has_ms and ((self_call or 0) >= 1 or (self_count or 0) >= 2)
+            ]
+            from roam.db.connection import batched_in
+
+            ph_names = ",".join("?" for _ in _MEMO_NAMES)
+            rows = batched_in(
+                self.conn,
+                "SELECT DISTINCT e.source_id FROM edges e "
+                "JOIN symbols t ON e.target_id = t.id "
+                "WHERE e.source_id IN ({ph}) " + f"AND t.name IN ({ph_names})",
+                candidates,
+                post=_MEMO_NAMES,
+            )
+            self._memoized = {r[0] for r in rows}
+        return symbol_id in self._memoized
+
+    def has_local_helper(self, symbol_id: int, leaf: str) -> bool:
+        """True when *symbol_id* calls a same-file symbol named *leaf*."""
+        if self._local_helpers is None:
+            cols = self.columns
+            candidates = [
+                sid
+                for sid, has_ms, depth in zip(cols.get("id", []), cols.get("has_ms", []), cols.get("loop_depth", []))
+                if has_ms and (depth or 0) >= 1
+            ]
+            from roam.db.connection import batched_in
+
+            ph_names = ",".join("?" for _ in _AMBIGUOUS_BARE)
+            rows = batched_in(
+                self.conn,
+                "SELECT DISTINCT e.source_id, lower(t.name) FROM edges e "
+                "JOIN symbols t ON e.target_id = t.id "
+                "JOIN symbols s ON e.source_id = s.id "
+                "WHERE e.source_id IN ({ph}) AND t.file_id = s.file_id " + f"AND lower(t.name) IN ({ph_names})",
+                candidates,
+                post=sorted(_AMBIGUOUS_BARE),
+            )
+            self._local_helpers = {(r[0], r[1]) for r in rows}
+        return (symbol_id, leaf) in self._local_helpers
+
+
+def run_fused(conn, checks, scan: DetectorScan | None = None):
+    """Evaluate several per-row checks in one pass over a shared scan.
+
+    *checks* is a list of ``(task_id, check_fn)`` pairs.  Returns
+    ``(hits_by_task, failures, timings_ms)``; a check that raises is
+    dropped for the rest of the pass and reported in *failures*.
+    """
+    if scan is None:
+        scan = DetectorScan(conn)
+    active = list(checks)
+    hits: dict[str, list[dict]] = {task_id: [] for task_id, _ in active}
+    elapsed: dict[str, float] = {task_id: 0.0 for task_id, _ in active}
+    failures: list[dict] = []
+    clock = time.perf_counter
+
+    for _i, row in scan.rows():
+        if scan.is_test_path(row["file_path"]):
+            continue
+        for entry in list(active):
+            task_id, check = entry
+            t0 = clock()
+            try:
+                found = check(scan, row)
+            except Exception as exc:
+                failures.append({"task_id": task_id, "detector": check.__name__, "error": str(exc)})
+                hits[task_id] = []
+                active.remove(entry)
+                continue
+            finally:
+                elapsed[task_id] += clock() - t0
+            if found is not None:
+                hits[task_id].append(found)
+
+    timings = {task_id: round(sec * 1000, 2) for task_id, sec in elapsed.items()}
+    return hits, failures, timings
+
+
+def _run_single(conn, task_id, check):
+    hits, failures, _timings = run_fused(conn, [(task_id, check)])
+    if failures:
+        raise RuntimeError(failures[0]["error"])
+    return hits[task_id]
+
+
 # ---------------------------------------------------------------------------
 # Individual detectors
 # ---------------------------------------------------------------------------
+#
+# Each ``_check_*`` function evaluates one symbol row and returns a finding
+# or None.  The public ``detect_*`` wrappers keep the ``(conn) -> list``
+# signature for callers that only need one detector.
+
+_SORT_NAMES = _like_regex(["%sort%", "%Sort%"])
+
+
+def _check_manual_sort(scan, r):
+    if not r["has_ms"] or not _SORT_NAMES.match(r["name"] or ""):
+        return None
+    if _flag(r, "has_nested_loops") != 1 or _flag(r, "loop_with_compare") != 1:
+        return None
+    calls = scan.loop_calls(r)
+    if _call_in(calls, {"sort", "sorted", "Arrays.sort", "Collections.sort", "qsort", "std::sort"}):
+        return None
+    # Subscript access in loops strengthens the signal (swap pattern)
+    conf = "high" if r["subscript_in_loops"] else "medium"
+    return _finding(
+        "sorting",
+        "manual-sort",
+        r,
+        "Nested loops with comparisons in sort-named function",
+        conf,
+    )
 
 
 def detect_manual_sort(conn):
     """Symbols named *sort* with nested loops, comparisons, and subscript
     access (swap pattern).  No call to built-in sort."""
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.has_nested_loops, ms.calls_in_loops, "
-        "ms.loop_with_compare, ms.subscript_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE (s.name LIKE '%sort%' OR s.name LIKE '%Sort%') "
-        "AND s.kind IN ('function', 'method') "
-        "AND ms.has_nested_loops = 1 "
-        "AND ms.loop_with_compare = 1"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"sort", "sorted", "Arrays.sort", "Collections.sort", "qsort", "std::sort"}):
-            continue
-        # Subscript access in loops strengthens the signal (swap pattern)
-        conf = "high" if r["subscript_in_loops"] else "medium"
-        results.append(
-            _finding(
-                "sorting",
-                "manual-sort",
-                r,
-                "Nested loops with comparisons in sort-named function",
-                conf,
-            )
-        )
-    return results
+    return _run_single(conn, "sorting", _check_manual_sort)
+
+
+_SEARCH_SORTED_NAMES = _like_regex(
+    [
+        "%search_sorted%",
+        "%searchSorted%",
+        "%find_sorted%",
+        "%findSorted%",
+        "%find_in_sorted%",
+        "%in_sorted%",
+        "%linear_search%",
+        "%linearSearch%",
+    ]
+)
+
+
+def _check_linear_search(scan, r):
+    if not r["has_ms"] or not _SEARCH_SORTED_NAMES.match(r["name"] or ""):
+        return None
+    if _flag(r, "loop_depth") < 1 or _flag(r, "loop_with_compare") != 1:
+        return None
+    calls = scan.loop_calls(r)
+    if _call_in(
+        calls,
+        {
+            "bisect",
+            "bisect_left",
+            "bisect_right",
+            "binarySearch",
+            "binary_search",
+            "lower_bound",
+            "upper_bound",
+        },
+    ):
+        return None
+    return _finding(
+        "search-sorted",
+        "linear-scan",
+        r,
+        "Linear scan in function that implies sorted data",
+        "low",
+    )
 
 
 def detect_linear_search(conn):
@@ -325,85 +628,81 @@ def detect_linear_search(conn):
     Downgraded to low confidence because we cannot verify from AST alone
     that the data being searched is actually sorted.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.loop_depth, ms.loop_with_compare, ms.calls_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE (s.name LIKE '%search_sorted%' OR s.name LIKE '%searchSorted%' "
-        "  OR s.name LIKE '%find_sorted%' OR s.name LIKE '%findSorted%' "
-        "  OR s.name LIKE '%find_in_sorted%' OR s.name LIKE '%in_sorted%' "
-        "  OR s.name LIKE '%linear_search%' OR s.name LIKE '%linearSearch%') "
-        "AND s.kind IN ('function', 'method') "
-        "AND ms.loop_depth >= 1 "
-        "AND ms.loop_with_compare = 1"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(
-            calls,
-            {
-                "bisect",
-                "bisect_left",
-                "bisect_right",
-                "binarySearch",
-                "binary_search",
-                "lower_bound",
-                "upper_bound",
-            },
-        ):
-            continue
-        results.append(
-            _finding(
-                "search-sorted",
-                "linear-scan",
-                r,
-                "Linear scan in function that implies sorted data",
-                "low",
-            )
-        )
-    return results
+    return _run_single(conn, "search-sorted", _check_linear_search)
+
+
+_MEMBERSHIP_NAMES = _like_regex(
+    [
+        "%contain%",
+        "%member%",
+        "%exist%",
+        "%has_%",
+        "%in_%",
+        "%check%",
+        "%includes%",
+        "%Includes%",
+    ]
+)
+
+
+def _check_list_membership(scan, r):
+    if not r["has_ms"]:
+        return None
+    if _flag(r, "has_nested_loops") != 1 or _flag(r, "loop_with_compare") != 1:
+        return None
+    if _flag(r, "subscript_in_loops") != 1 or not _MEMBERSHIP_NAMES.match(r["name"] or ""):
+        return None
+    return _finding(
+        "membership",
+        "list-scan",
+        r,
+        "Nested loops with comparisons for membership check",
+        "medium",
+    )
 
 
 def detect_list_membership(conn):
     """Nested loops with equality comparisons — structural pattern for
     O(n^2) membership testing regardless of function name."""
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.loop_with_compare, ms.subscript_in_loops, "
-        "ms.has_nested_loops, ms.calls_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND ms.has_nested_loops = 1 "
-        "AND ms.loop_with_compare = 1 "
-        "AND ms.subscript_in_loops = 1 "
-        "AND (s.name LIKE '%contain%' OR s.name LIKE '%member%' "
-        "  OR s.name LIKE '%exist%' OR s.name LIKE '%has_%' "
-        "  OR s.name LIKE '%in_%' OR s.name LIKE '%check%' "
-        "  OR s.name LIKE '%includes%' OR s.name LIKE '%Includes%')"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        results.append(
-            _finding(
-                "membership",
-                "list-scan",
-                r,
-                "Nested loops with comparisons for membership check",
-                "medium",
-            )
-        )
-    return results
+    return _run_single(conn, "membership", _check_list_membership)
+
+
+_STRING_BUILD_HINTS = (
+    "concat",
+    "build_str",
+    "build_string",
+    "format",
+    "render",
+    "serialize",
+    "to_string",
+    "tostring",
+    "stringify",
+    "to_csv",
+    "to_html",
+    "to_xml",
+    "generate_report",
+    "join",
+)
+
+
+def _check_string_concat_loop(scan, r):
+    if not r["has_ms"] or _flag(r, "loop_depth") < 1 or _flag(r, "loop_with_accumulator") != 1:
+        return None
+    calls = scan.loop_calls(r)
+    # Structural signal: calls to string concat/append methods
+    has_concat_call = bool(_call_in(calls, {"concat", "strcat", "append", "push"}))
+    # Name signal: function name suggests string building
+    name_lower = (r["name"] or "").lower()
+    has_name_hint = any(kw in name_lower for kw in _STRING_BUILD_HINTS)
+    if not (has_concat_call or has_name_hint):
+        return None
+    return _finding(
+        "string-concat",
+        "loop-concat",
+        r,
+        "Loop accumulation in string-building function",
+        "medium",
+    )
 
 
 def detect_string_concat_loop(conn):
@@ -412,93 +711,79 @@ def detect_string_concat_loop(conn):
     Relies primarily on the structural pattern (loop + accumulator) combined
     with calls to string methods (append/concat) or string-building name hints.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.loop_depth, ms.calls_in_loops, ms.loop_with_accumulator "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND ms.loop_depth >= 1 "
-        "AND ms.loop_with_accumulator = 1"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        # Structural signal: calls to string concat/append methods
-        has_concat_call = bool(_call_in(calls, {"concat", "strcat", "append", "push"}))
-        # Name signal: function name suggests string building
-        name_lower = (r["name"] or "").lower()
-        has_name_hint = any(
-            kw in name_lower
-            for kw in (
-                "concat",
-                "build_str",
-                "build_string",
-                "format",
-                "render",
-                "serialize",
-                "to_string",
-                "tostring",
-                "stringify",
-                "to_csv",
-                "to_html",
-                "to_xml",
-                "generate_report",
-                "join",
-            )
-        )
-        if has_concat_call or has_name_hint:
-            results.append(
-                _finding(
-                    "string-concat",
-                    "loop-concat",
-                    r,
-                    "Loop accumulation in string-building function",
-                    "medium",
-                )
-            )
-    return results
+    return _run_single(conn, "string-concat", _check_string_concat_loop)
+
+
+_DEDUP_NAMES = _like_regex(
+    [
+        "%dedup%",
+        "%unique%",
+        "%Dedup%",
+        "%Unique%",
+        "%distinct%",
+        "%Distinct%",
+        "%remove_dup%",
+        "%removeDup%",
+    ]
+)
+
+
+def _check_manual_dedup(scan, r):
+    if not r["has_ms"] or not _DEDUP_NAMES.match(r["name"] or ""):
+        return None
+    if _flag(r, "has_nested_loops") != 1 or _flag(r, "loop_with_compare") != 1:
+        return None
+    # Negative check: skip if they already use set/hash
+    calls = scan.loop_calls(r)
+    if _call_in(calls, {"set", "Set", "HashSet"}):
+        return None
+    return _finding(
+        "unique",
+        "nested-dedup",
+        r,
+        "Nested loops with comparisons in dedup function",
+        "high",
+    )
 
 
 def detect_manual_dedup(conn):
     """Nested loops in dedup/unique-named functions without set usage."""
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.has_nested_loops, ms.loop_with_compare, ms.calls_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE (s.name LIKE '%dedup%' OR s.name LIKE '%unique%' "
-        "  OR s.name LIKE '%Dedup%' OR s.name LIKE '%Unique%' "
-        "  OR s.name LIKE '%distinct%' OR s.name LIKE '%Distinct%' "
-        "  OR s.name LIKE '%remove_dup%' OR s.name LIKE '%removeDup%') "
-        "AND s.kind IN ('function', 'method') "
-        "AND ms.has_nested_loops = 1 "
-        "AND ms.loop_with_compare = 1"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        # Negative check: skip if they already use set/hash
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"set", "Set", "HashSet"}):
-            continue
-        results.append(
-            _finding(
-                "unique",
-                "nested-dedup",
-                r,
-                "Nested loops with comparisons in dedup function",
-                "high",
-            )
-        )
-    return results
+    return _run_single(conn, "unique", _check_manual_dedup)
+
+
+_MAXMIN_NAMES = _like_regex(
+    [
+        "%find_max%",
+        "%find_min%",
+        "%findMax%",
+        "%findMin%",
+        "%get_max%",
+        "%get_min%",
+        "%getMax%",
+        "%getMin%",
+        "%find_largest%",
+        "%find_smallest%",
+        "%findLargest%",
+        "%findSmallest%",
+    ]
+)
+
+
+def _check_manual_maxmin(scan, r):
+    if not r["has_ms"] or not _MAXMIN_NAMES.match(r["name"] or ""):
+        return None
+    if _flag(r, "loop_depth") < 1 or _flag(r, "loop_with_compare") != 1:
+        return None
+    calls = scan.loop_calls(r)
+    if _call_in(calls, {"max", "min", "Math.max", "Math.min", "Collections.max", "Collections.min"}):
+        return None
+    return _finding(
+        "max-min",
+        "manual-loop",
+        r,
+        "Manual loop with comparisons in max/min function (idiomatic improvement)",
+        "low",
+    )
 
 
 def detect_manual_maxmin(conn):
@@ -507,41 +792,27 @@ def detect_manual_maxmin(conn):
     Same Big-O (both O(n)) — this is an idiom improvement, flagged at low
     confidence.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.loop_depth, ms.loop_with_compare, "
-        "ms.loop_with_accumulator, ms.calls_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE (s.name LIKE '%find_max%' OR s.name LIKE '%find_min%' "
-        "  OR s.name LIKE '%findMax%' OR s.name LIKE '%findMin%' "
-        "  OR s.name LIKE '%get_max%' OR s.name LIKE '%get_min%' "
-        "  OR s.name LIKE '%getMax%' OR s.name LIKE '%getMin%' "
-        "  OR s.name LIKE '%find_largest%' OR s.name LIKE '%find_smallest%' "
-        "  OR s.name LIKE '%findLargest%' OR s.name LIKE '%findSmallest%') "
-        "AND s.kind IN ('function', 'method') "
-        "AND ms.loop_depth >= 1 "
-        "AND ms.loop_with_compare = 1"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"max", "min", "Math.max", "Math.min", "Collections.max", "Collections.min"}):
-            continue
-        results.append(
-            _finding(
-                "max-min",
-                "manual-loop",
-                r,
-                "Manual loop with comparisons in max/min function (idiomatic improvement)",
-                "low",
-            )
-        )
-    return results
+    return _run_single(conn, "max-min", _check_manual_maxmin)
+
+
+_ACCUMULATE_NAMES = _like_regex(["%_sum%", "%_total%", "%Sum%", "%Total%", "%accumulate%", "%Accumulate%"])
+
+
+def _check_manual_accumulation(scan, r):
+    if not r["has_ms"] or not _ACCUMULATE_NAMES.match(r["name"] or ""):
+        return None
+    if _flag(r, "loop_depth") < 1 or _flag(r, "loop_with_accumulator") != 1:
+        return None
+    calls = scan.loop_calls(r)
+    if _call_in(calls, {"sum", "reduce", "aggregate", "prod"}):
+        return None
+    return _finding(
+        "accumulation",
+        "manual-sum",
+        r,
+        "Loop with accumulator in sum/total function (idiomatic improvement)",
+        "low",
+    )
 
 
 def detect_manual_accumulation(conn):
@@ -549,244 +820,128 @@ def detect_manual_accumulation(conn):
 
     Same Big-O (both O(n)) — idiom improvement, flagged at low confidence.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.loop_depth, ms.loop_with_accumulator, ms.calls_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE (s.name LIKE '%_sum%' OR s.name LIKE '%_total%' "
-        "  OR s.name LIKE '%Sum%' OR s.name LIKE '%Total%' "
-        "  OR s.name LIKE '%accumulate%' OR s.name LIKE '%Accumulate%') "
-        "AND s.kind IN ('function', 'method') "
-        "AND ms.loop_depth >= 1 "
-        "AND ms.loop_with_accumulator = 1"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"sum", "reduce", "aggregate", "prod"}):
-            continue
-        results.append(
-            _finding(
-                "accumulation",
-                "manual-sum",
-                r,
-                "Loop with accumulator in sum/total function (idiomatic improvement)",
-                "low",
-            )
-        )
-    return results
+    return _run_single(conn, "accumulation", _check_manual_accumulation)
+
+
+_POWER_NAMES = _like_regex(["%pow%", "%Pow%", "%power%", "%Power%", "%exp%", "%Exponent%"])
+
+
+def _check_manual_power(scan, r):
+    if not r["has_ms"] or not _POWER_NAMES.match(r["name"] or ""):
+        return None
+    if _flag(r, "loop_depth") < 1:
+        return None
+    # Older indexes lack loop_with_multiplication; fall back to accumulation.
+    gate = "loop_with_multiplication" if scan.has_column("loop_with_multiplication") else "loop_with_accumulator"
+    if _flag(r, gate) != 1:
+        return None
+    calls = scan.loop_calls(r, qualified=True)
+    if _call_in(calls, {"pow", "Math.pow", "std::pow", "math.pow", "BigInteger.modPow"}):
+        return None
+    conf = "high" if _flag(r, "loop_with_multiplication") else "medium"
+    return _finding(
+        "manual-power",
+        "loop-multiply",
+        r,
+        "Loop multiplication used for exponentiation",
+        conf,
+    )
 
 
 def detect_manual_power(conn):
     """Loop-based exponentiation in power/exponent-named functions."""
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_depth, ms.loop_with_multiplication, "
-            "ms.calls_in_loops, ms.calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE (s.name LIKE '%pow%' OR s.name LIKE '%Pow%' "
-            "  OR s.name LIKE '%power%' OR s.name LIKE '%Power%' "
-            "  OR s.name LIKE '%exp%' OR s.name LIKE '%Exponent%') "
-            "AND s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1 "
-            "AND ms.loop_with_multiplication = 1"
-        ).fetchall()
-    except Exception:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_depth, 0 as loop_with_multiplication, "
-            "ms.calls_in_loops, '' as calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE (s.name LIKE '%pow%' OR s.name LIKE '%Pow%' "
-            "  OR s.name LIKE '%power%' OR s.name LIKE '%Power%' "
-            "  OR s.name LIKE '%exp%' OR s.name LIKE '%Exponent%') "
-            "AND s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1 "
-            "AND ms.loop_with_accumulator = 1"
-        ).fetchall()
+    return _run_single(conn, "manual-power", _check_manual_power)
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"pow", "Math.pow", "std::pow", "math.pow", "BigInteger.modPow"}):
-            continue
-        conf = "high" if _row_value(r, "loop_with_multiplication", 0) else "medium"
-        results.append(
-            _finding(
-                "manual-power",
-                "loop-multiply",
-                r,
-                "Loop multiplication used for exponentiation",
-                conf,
-            )
-        )
-    return results
+
+_GCD_NAMES = _like_regex(["%gcd%", "%GCD%", "%hcf%", "%gcf%"])
+
+
+def _check_manual_gcd(scan, r):
+    if not r["has_ms"] or not _GCD_NAMES.match(r["name"] or "") or _flag(r, "loop_depth") < 1:
+        return None
+    calls = scan.loop_calls(r, qualified=True)
+    if _call_in(calls, {"gcd", "math.gcd", "std::gcd", "BigInteger.gcd"}):
+        return None
+    conf = "high" if _flag(r, "loop_with_modulo") else "medium"
+    return _finding(
+        "manual-gcd",
+        "manual-gcd",
+        r,
+        "Manual GCD loop can be replaced with standard gcd helper",
+        conf,
+    )
 
 
 def detect_manual_gcd(conn):
     """Manual GCD loops where built-in/standard helpers are available."""
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_depth, ms.loop_with_modulo, "
-            "ms.calls_in_loops, ms.calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE (s.name LIKE '%gcd%' OR s.name LIKE '%GCD%' "
-            "  OR s.name LIKE '%hcf%' OR s.name LIKE '%gcf%') "
-            "AND s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
-    except Exception:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_depth, 0 as loop_with_modulo, "
-            "ms.calls_in_loops, '' as calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE (s.name LIKE '%gcd%' OR s.name LIKE '%GCD%' "
-            "  OR s.name LIKE '%hcf%' OR s.name LIKE '%gcf%') "
-            "AND s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
+    return _run_single(conn, "manual-gcd", _check_manual_gcd)
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"gcd", "math.gcd", "std::gcd", "BigInteger.gcd"}):
-            continue
-        conf = "medium"
-        if _row_value(r, "loop_with_modulo", 0):
-            conf = "high"
-        results.append(
-            _finding(
-                "manual-gcd",
-                "manual-gcd",
-                r,
-                "Manual GCD loop can be replaced with standard gcd helper",
-                conf,
-            )
-        )
-    return results
+
+_REVERSE_NAMES = _like_regex(["%reverse%", "%Reverse%"])
+
+
+def _check_string_reverse(scan, r):
+    if not r["has_ms"] or not _REVERSE_NAMES.match(r["name"] or "") or _flag(r, "loop_depth") < 1:
+        return None
+    calls = scan.loop_calls(r, qualified=True)
+    if _call_in(calls, {"reverse", "reversed", "std::reverse", "StringBuilder.reverse", "strrev"}):
+        return None
+    return _finding(
+        "string-reverse",
+        "manual-reverse",
+        r,
+        "Manual character-loop reversal in reverse-named function",
+        "low",
+    )
 
 
 def detect_string_reverse(conn):
     """Manual reversal loops in reverse-named functions."""
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_depth, ms.loop_with_accumulator, "
-            "ms.calls_in_loops, ms.calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE (s.name LIKE '%reverse%' OR s.name LIKE '%Reverse%') "
-            "AND s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
-    except Exception:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_depth, ms.loop_with_accumulator, "
-            "ms.calls_in_loops, '' as calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE (s.name LIKE '%reverse%' OR s.name LIKE '%Reverse%') "
-            "AND s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
+    return _run_single(conn, "string-reverse", _check_string_reverse)
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"reverse", "reversed", "std::reverse", "StringBuilder.reverse", "strrev"}):
-            continue
-        results.append(
-            _finding(
-                "string-reverse",
-                "manual-reverse",
-                r,
-                "Manual character-loop reversal in reverse-named function",
-                "low",
-            )
-        )
-    return results
+
+_MATRIX_NAMES = _like_regex(["%matrix%", "%matmul%", "%multiply_matrix%", "%dot%"])
+
+
+def _check_matrix_mult(scan, r):
+    if not r["has_ms"] or not _MATRIX_NAMES.match(r["name"] or ""):
+        return None
+    if _flag(r, "loop_depth") < 3 or _flag(r, "subscript_in_loops") != 1:
+        return None
+    calls = scan.loop_calls(r, qualified=True)
+    if _call_in(calls, {"dot", "matmul", "gemm", "dgemm", "numpy.dot", "np.matmul"}):
+        return None
+    conf = "high" if (_flag(r, "loop_with_multiplication") and _flag(r, "loop_with_accumulator")) else "medium"
+    return _finding(
+        "matrix-mult",
+        "naive-triple",
+        r,
+        "Naive matrix multiplication via nested loops",
+        conf,
+    )
 
 
 def detect_matrix_mult(conn):
     """Naive triple-loop matrix multiplication patterns."""
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_depth, ms.subscript_in_loops, "
-            "ms.loop_with_multiplication, ms.loop_with_accumulator, "
-            "ms.calls_in_loops, ms.calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE (s.name LIKE '%matrix%' OR s.name LIKE '%matmul%' "
-            "  OR s.name LIKE '%multiply_matrix%' OR s.name LIKE '%dot%') "
-            "AND s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 3 "
-            "AND ms.subscript_in_loops = 1"
-        ).fetchall()
-    except Exception:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_depth, ms.subscript_in_loops, "
-            "0 as loop_with_multiplication, ms.loop_with_accumulator, "
-            "ms.calls_in_loops, '' as calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE (s.name LIKE '%matrix%' OR s.name LIKE '%matmul%' "
-            "  OR s.name LIKE '%multiply_matrix%' OR s.name LIKE '%dot%') "
-            "AND s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 3 "
-            "AND ms.subscript_in_loops = 1"
-        ).fetchall()
+    return _run_single(conn, "matrix-mult", _check_matrix_mult)
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"dot", "matmul", "gemm", "dgemm", "numpy.dot", "np.matmul"}):
-            continue
-        conf = (
-            "high"
-            if (_row_value(r, "loop_with_multiplication", 0) and _row_value(r, "loop_with_accumulator", 0))
-            else "medium"
-        )
-        results.append(
-            _finding(
-                "matrix-mult",
-                "naive-triple",
-                r,
-                "Naive matrix multiplication via nested loops",
-                conf,
-            )
-        )
-    return results
+
+_FIB_NAMES = _like_regex(["%fib%", "%Fib%"])
+
+
+def _check_naive_fibonacci(scan, r):
+    if not r["has_ms"] or not _FIB_NAMES.match(r["name"] or "") or _flag(r, "has_self_call") < 1:
+        return None
+    # Check if there's a memoization decorator (edge to lru_cache/cache)
+    if scan.is_memoized(r["id"]):
+        return None
+    return _finding(
+        "fibonacci",
+        "naive-recursive",
+        r,
+        "Recursive fibonacci without memoization (exponential blowup)",
+        "high",
+    )
 
 
 def detect_naive_fibonacci(conn):
@@ -794,43 +949,44 @@ def detect_naive_fibonacci(conn):
 
     O(2^n) -> O(n) — one of the strongest algorithmic improvements.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.has_self_call "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE (s.name LIKE '%fib%' OR s.name LIKE '%Fib%') "
-        "AND s.kind IN ('function', 'method') "
-        "AND ms.has_self_call >= 1"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        # Check if there's a memoization decorator (edge to lru_cache/cache)
-        memo_edge = conn.execute(
-            "SELECT 1 FROM edges e "
-            "JOIN symbols t ON e.target_id = t.id "
-            "WHERE e.source_id = ? "
-            "AND t.name IN ('lru_cache', 'cache', 'memoize', 'memo', "
-            "               'functools.lru_cache', 'functools.cache') "
-            "LIMIT 1",
-            (r["id"],),
-        ).fetchone()
-        if memo_edge:
-            continue
-        results.append(
-            _finding(
-                "fibonacci",
-                "naive-recursive",
-                r,
-                "Recursive fibonacci without memoization (exponential blowup)",
-                "high",
-            )
-        )
-    return results
+    return _run_single(conn, "fibonacci", _check_naive_fibonacci)
+
+
+# Names that suggest grid/matrix traversal (suppress these)
+_GRID_NAMES = (
+    "matrix",
+    "grid",
+    "board",
+    "pixel",
+    "cell",
+    "permut",
+    "combin",
+    "cartesian",
+    "product",
+    "transpose",
+    "rotate",
+    "convolv",
+)
+
+
+def _check_nested_lookup(scan, r):
+    if not r["has_ms"] or not r["has_sm"]:
+        return None
+    if _flag(r, "has_nested_loops") != 1 or _flag(r, "subscript_in_loops") != 1:
+        return None
+    if _flag(r, "loop_with_compare") != 1 or _flag(r, "cognitive_complexity") < 8:
+        return None
+    # Suppress grid/matrix traversal patterns
+    name_lower = (r["name"] or "").lower()
+    if any(kw in name_lower for kw in _GRID_NAMES):
+        return None
+    return _finding(
+        "nested-lookup",
+        "nested-iteration",
+        r,
+        "Nested loops with subscript access and comparisons (potential O(n*m))",
+        "medium",
+    )
 
 
 def detect_nested_lookup(conn):
@@ -840,55 +996,41 @@ def detect_nested_lookup(conn):
     and requires both nested loops AND comparisons (not just nested loops
     with subscript access, which could be matrix operations).
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.has_nested_loops, ms.subscript_in_loops, "
-        "ms.loop_with_compare "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "JOIN symbol_metrics sm ON sm.symbol_id = s.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND ms.has_nested_loops = 1 "
-        "AND ms.subscript_in_loops = 1 "
-        "AND ms.loop_with_compare = 1 "
-        "AND sm.cognitive_complexity >= 8"
-    ).fetchall()
-
-    # Names that suggest grid/matrix traversal (suppress these)
-    _GRID_NAMES = {
-        "matrix",
-        "grid",
-        "board",
-        "pixel",
-        "cell",
-        "permut",
-        "combin",
-        "cartesian",
-        "product",
-        "transpose",
-        "rotate",
-        "convolv",
-    }
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        # Suppress grid/matrix traversal patterns
-        name_lower = (r["name"] or "").lower()
-        if any(kw in name_lower for kw in _GRID_NAMES):
-            continue
-        results.append(
-            _finding(
-                "nested-lookup",
-                "nested-iteration",
-                r,
-                "Nested loops with subscript access and comparisons (potential O(n*m))",
-                "medium",
-            )
-        )
-    return results
+    return _run_single(conn, "nested-lookup", _check_nested_lookup)
+
+
+_GROUPBY_NAMES = _like_regex(
+    [
+        "%group%",
+        "%Group%",
+        "%bucket%",
+        "%Bucket%",
+        "%partition%",
+        "%Partition%",
+        "%categorize%",
+        "%Categorize%",
+        "%classify%",
+        "%Classify%",
+        "%bin_by%",
+        "%key_by%",
+        "%index_by%",
+    ]
+)
+
+
+def _check_manual_groupby(scan, r):
+    if not r["has_ms"] or not _GROUPBY_NAMES.match(r["name"] or "") or _flag(r, "loop_depth") < 1:
+        return None
+    calls = scan.loop_calls(r)
+    if _call_in(calls, {"groupby", "group_by", "defaultdict", "setdefault", "groupingBy", "Collectors"}):
+        return None
+    return _finding(
+        "groupby",
+        "manual-check",
+        r,
+        "Manual loop in group-by function (idiomatic improvement)",
+        "low",
+    )
 
 
 def detect_manual_groupby(conn):
@@ -896,40 +1038,43 @@ def detect_manual_groupby(conn):
 
     Same Big-O (both O(n)) — idiom improvement.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.loop_depth, ms.loop_with_accumulator, ms.calls_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE (s.name LIKE '%group%' OR s.name LIKE '%Group%' "
-        "  OR s.name LIKE '%bucket%' OR s.name LIKE '%Bucket%' "
-        "  OR s.name LIKE '%partition%' OR s.name LIKE '%Partition%' "
-        "  OR s.name LIKE '%categorize%' OR s.name LIKE '%Categorize%' "
-        "  OR s.name LIKE '%classify%' OR s.name LIKE '%Classify%' "
-        "  OR s.name LIKE '%bin_by%' OR s.name LIKE '%key_by%' "
-        "  OR s.name LIKE '%index_by%') "
-        "AND s.kind IN ('function', 'method') "
-        "AND ms.loop_depth >= 1"
-    ).fetchall()
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"groupby", "group_by", "defaultdict", "setdefault", "groupingBy", "Collectors"}):
-            continue
-        results.append(
-            _finding(
-                "groupby",
-                "manual-check",
-                r,
-                "Manual loop in group-by function (idiomatic improvement)",
-                "low",
-            )
-        )
-    return results
+    return _run_single(conn, "groupby", _check_manual_groupby)
+
+
+# Intentional polling patterns — suppress these
+_POLL_NAMES = (
+    "poll",
+    "retry",
+    "health_check",
+    "healthcheck",
+    "monitor",
+    "wait_for",
+    "wait_until",
+    "watchdog",
+    "ping",
+    "heartbeat",
+    "keepalive",
+    "backoff",
+)
+
+
+def _check_busy_wait(scan, r):
+    if not r["has_ms"] or _flag(r, "loop_depth") < 1:
+        return None
+    calls = scan.loop_calls(r)
+    if not _call_in(calls, {"sleep", "time.sleep", "Thread.sleep", "usleep", "nanosleep", "Sleep"}):
+        return None
+    # Suppress intentional polling
+    name_lower = (r["name"] or "").lower()
+    if any(kw in name_lower for kw in _POLL_NAMES):
+        return None
+    return _finding(
+        "busy-wait",
+        "sleep-loop",
+        r,
+        "sleep() called inside a loop (busy-wait pattern)",
+        "high",
+    )
 
 
 def detect_busy_wait(conn):
@@ -938,59 +1083,61 @@ def detect_busy_wait(conn):
     Suppresses intentional polling: functions named *poll*, *retry*,
     *health_check*, *monitor*, *wait_for* — these are legitimate patterns.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.loop_depth, ms.calls_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND ms.loop_depth >= 1"
-    ).fetchall()
-
-    # Intentional polling patterns — suppress these
-    _POLL_NAMES = {
-        "poll",
-        "retry",
-        "health_check",
-        "healthcheck",
-        "monitor",
-        "wait_for",
-        "wait_until",
-        "watchdog",
-        "ping",
-        "heartbeat",
-        "keepalive",
-        "backoff",
-    }
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        calls = _iter_loop_calls(r)
-        if not _call_in(calls, {"sleep", "time.sleep", "Thread.sleep", "usleep", "nanosleep", "Sleep"}):
-            continue
-        # Suppress intentional polling
-        name_lower = (r["name"] or "").lower()
-        if any(kw in name_lower for kw in _POLL_NAMES):
-            continue
-        results.append(
-            _finding(
-                "busy-wait",
-                "sleep-loop",
-                r,
-                "sleep() called inside a loop (busy-wait pattern)",
-                "high",
-            )
-        )
-    return results
+    return _run_single(conn, "busy-wait", _check_busy_wait)
 
 
 # ---------------------------------------------------------------------------
 # New detectors: patterns identified by research
 # ---------------------------------------------------------------------------
 
+# Note: call target names are extracted as the last identifier in
+# member expressions (e.g. re.compile -> "compile", re.match -> "match")
+_REGEX_COMPILE_CALLS = {"compile", "Compile", "MustCompile"}
+_REGEX_CONVENIENCE_CALLS = {
+    "match",
+    "search",
+    "findall",
+    "sub",
+    "split",
+    "fullmatch",
+    "finditer",
+    "matches",
+    "Replace",
+    "ReplaceAll",
+    "Find",
+    "FindAll",
+    "MatchString",
+}
+
+
+def _check_regex_in_loop(scan, r):
+    if not r["has_ms"] or _flag(r, "loop_depth") < 1:
+        return None
+    calls = scan.loop_calls(r)
+    # Direct compile in loop is always bad
+    compile_calls = _call_in(calls, _REGEX_COMPILE_CALLS)
+    if compile_calls:
+        return _finding(
+            "regex-in-loop",
+            "compile-per-iter",
+            r,
+            f"Regex compile ({', '.join(compile_calls[:2])}) inside loop",
+            "high",
+        )
+    # Convenience regex calls in loop (re.match, re.search, etc.) also
+    # compile each time in most runtimes — flag at medium confidence
+    # since these could be on a pre-compiled pattern object
+    convenience_calls = _call_in(calls, _REGEX_CONVENIENCE_CALLS)
+    if convenience_calls:
+        return _finding(
+            "regex-in-loop",
+            "compile-per-iter",
+            r,
+            f"Regex call ({', '.join(convenience_calls[:2])}) inside loop (may recompile per iteration)",
+            "medium",
+        )
+    return None
+
 
 def detect_regex_in_loop(conn):
     """Regex compilation inside a loop — recompiles on every iteration.
@@ -998,67 +1145,175 @@ def detect_regex_in_loop(conn):
     O(n*p) wasted compilation when O(p + n*m) is achievable by compiling
     once outside the loop.  Applies to all languages with regex engines.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, ms.loop_depth, ms.calls_in_loops "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN math_signals ms ON ms.symbol_id = s.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND ms.loop_depth >= 1"
-    ).fetchall()
-
-    # Note: call target names are extracted as the last identifier in
-    # member expressions (e.g. re.compile -> "compile", re.match -> "match")
-    _REGEX_COMPILE_CALLS = {"compile", "Compile", "MustCompile"}
-    _REGEX_CONVENIENCE_CALLS = {
-        "match",
-        "search",
-        "findall",
-        "sub",
-        "split",
-        "fullmatch",
-        "finditer",
-        "matches",
-        "Replace",
-        "ReplaceAll",
-        "Find",
-        "FindAll",
-        "MatchString",
-    }
+    return _run_single(conn, "regex-in-loop", _check_regex_in_loop)
+
+
+# High-confidence calls: strongly indicative DB/API round trips.
+_IO_HIGH_EXACT = {
+    "requests.get",
+    "requests.post",
+    "requests.put",
+    "requests.delete",
+    "requests.patch",
+    "urllib.request.urlopen",
+    "session.execute",
+    "session.query",
+    "cursor.execute",
+    "http.Get",
+    "http.Post",
+}
+_IO_HIGH_EXACT_LOWER = {c.lower() for c in _IO_HIGH_EXACT}
+_IO_HIGH_LEAF = {"execute", "executemany", "query", "urlopen"}
+_IO_MEDIUM_LEAF = {"fetchone", "fetchall", "fetchmany", "fetch", "find", "get", "open"}
+_IO_RECEIVER_HINTS = {
+    "session",
+    "cursor",
+    "db",
+    "conn",
+    "connection",
+    "repo",
+    "repository",
+    "queryset",
+    "client",
+    "api",
+    "http",
+    "requests",
+    "urllib",
+}
+
+# Suppress functions that are intentionally batch/migration wrappers.
+_IO_WRAPPER_NAMES = (
+    "batch",
+    "bulk",
+    "migrate",
+    "seed",
+    "import",
+    "export",
+    "sync_all",
+    "backfill",
+)
+
+
+def _receiver_hint(call: str) -> str:
+    if "." not in call:
+        return ""
+    return call.rsplit(".", 1)[0].lower()
+
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
+def _receiver_is_ioish(call: str) -> bool:
+    recv = _receiver_hint(call)
+    if not recv:
+        return False
+    return any(h in recv for h in _IO_RECEIVER_HINTS)
+
+
+def _match_framework_pack(call: str, language: str | None) -> dict | None:
+    leaf = _call_leaf(call).lower()
+    recv = _receiver_hint(call)
+    lower_c = call.lower()
+    for pack in _framework_packs(language):
+        leaves = pack.get("leaves", set())
+        recv_hints = pack.get("receiver_hints", set())
+        if lower_c in {c.lower() for c in pack.get("exact", set())}:
+            return pack
+        if leaf not in leaves:
             continue
-        calls = _iter_loop_calls(r)
-        # Direct compile in loop is always bad
-        compile_calls = _call_in(calls, _REGEX_COMPILE_CALLS)
-        # Convenience regex calls in loop (re.match, re.search, etc.) also
-        # compile each time in most runtimes — flag at medium confidence
-        # since these could be on a pre-compiled pattern object
-        convenience_calls = _call_in(calls, _REGEX_CONVENIENCE_CALLS)
-        if compile_calls:
-            results.append(
-                _finding(
-                    "regex-in-loop",
-                    "compile-per-iter",
-                    r,
-                    f"Regex compile ({', '.join(compile_calls[:2])}) inside loop",
-                    "high",
-                )
-            )
-        elif convenience_calls:
-            results.append(
-                _finding(
-                    "regex-in-loop",
-                    "compile-per-iter",
-                    r,
-                    f"Regex call ({', '.join(convenience_calls[:2])}) inside loop (may recompile per iteration)",
-                    "medium",
-                )
-            )
-    return results
+        if not recv_hints:
+            return pack
+        if any(h in recv for h in recv_hints):
+            return pack
+    return None
+
+
+def _check_io_in_loop(scan, r):
+    if not r["has_ms"] or _flag(r, "loop_depth") < 1:
+        return None
+    language = r.get("language") or ""
+    calls = scan.loop_calls(r, qualified=True)
+    if not calls:
+        return None
+
+    high_calls: list[str] = []
+    medium_calls: list[str] = []
+    frameworks: set[str] = set()
+    fixes: set[str] = set()
+    for c in calls:
+        pack = _match_framework_pack(c, language)
+        if pack:
+            frameworks.add(pack["framework"])
+            if pack.get("fix"):
+                fixes.add(pack["fix"])
+            if pack.get("confidence") == "high":
+                high_calls.append(c)
+            else:
+                medium_calls.append(c)
+            continue
+
+        lower_c = c.lower()
+        leaf = _call_leaf(c).lower()
+        if lower_c in _IO_HIGH_EXACT_LOWER:
+            high_calls.append(c)
+            continue
+        if leaf in _IO_HIGH_LEAF and _receiver_is_ioish(c):
+            high_calls.append(c)
+            continue
+        # requests.<verb> style HTTP calls
+        if leaf in {"get", "post", "put", "delete", "patch", "request"}:
+            recv = _receiver_hint(c)
+            if "requests" in recv or recv.endswith("http"):
+                high_calls.append(c)
+                continue
+        if leaf in _IO_MEDIUM_LEAF and _receiver_is_ioish(c):
+            medium_calls.append(c)
+            continue
+        # Bare helper names without a receiver are ambiguous: if they
+        # resolve to a local helper in the same file, treat as non-I/O.
+        if "." not in c and leaf in _AMBIGUOUS_BARE:
+            if scan.has_local_helper(r["id"], leaf):
+                continue
+            medium_calls.append(c)
+            continue
+        if leaf == "open":
+            medium_calls.append(c)
+            continue
+
+    if not high_calls and not medium_calls:
+        return None
+
+    name_lower = (r["name"] or "").lower()
+    if any(kw in name_lower for kw in _IO_WRAPPER_NAMES):
+        return None
+
+    # Source is only needed once we know a finding will be emitted.
+    guard_hints = _guard_hints_from_source(language, scan.source(r))
+    guard_applies = bool(frameworks and guard_hints)
+    reason_suffix = ""
+    if frameworks:
+        reason_suffix = f"; frameworks: {', '.join(sorted(frameworks))}"
+    if high_calls:
+        reason_calls = _dedupe(high_calls)[:2]
+        confidence = "high"
+        template = "I/O call ({}) inside loop (N+1 pattern){}"
+    else:
+        reason_calls = _dedupe(medium_calls)[:2]
+        confidence = "medium"
+        template = "I/O-like call ({}) inside loop (may be N+1){}"
+    if guard_applies:
+        confidence = _lower_confidence(confidence)
+        reason_suffix += f"; eager/batch guards: {', '.join(guard_hints[:2])}"
+    return _finding(
+        "io-in-loop",
+        "loop-query",
+        r,
+        template.format(", ".join(reason_calls), reason_suffix),
+        confidence,
+        evidence={
+            "io_calls": _dedupe(high_calls + medium_calls)[:6],
+            "frameworks": sorted(frameworks),
+            "guard_hints": guard_hints,
+        },
+        fix="; ".join(sorted(fixes)) if fixes else None,
+    )
 
 
 def detect_io_in_loop(conn):
@@ -1067,284 +1322,81 @@ def detect_io_in_loop(conn):
     One of the most impactful performance anti-patterns in web applications.
     Each iteration incurs a full I/O round trip.
     """
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.file_id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "f.language as language, s.line_start, s.line_end, ms.loop_depth, ms.calls_in_loops, "
-            "ms.calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
-    except Exception:
-        rows = conn.execute(
-            "SELECT s.id, s.file_id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "f.language as language, s.line_start, s.line_end, ms.loop_depth, ms.calls_in_loops, "
-            "'' as calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
-
-    # High-confidence calls: strongly indicative DB/API round trips.
-    _HIGH_EXACT = {
-        "requests.get",
-        "requests.post",
-        "requests.put",
-        "requests.delete",
-        "requests.patch",
-        "urllib.request.urlopen",
-        "session.execute",
-        "session.query",
-        "cursor.execute",
-        "http.Get",
-        "http.Post",
-    }
-    _HIGH_EXACT_LOWER = {c.lower() for c in _HIGH_EXACT}
-    _HIGH_LEAF = {"execute", "executemany", "query", "urlopen"}
-    _AMBIGUOUS_BARE = {"query", "find", "get"}
-    _MEDIUM_LEAF = {"fetchone", "fetchall", "fetchmany", "fetch", "find", "get", "open"}
-    _IO_RECEIVER_HINTS = {
-        "session",
-        "cursor",
-        "db",
-        "conn",
-        "connection",
-        "repo",
-        "repository",
-        "queryset",
-        "client",
-        "api",
-        "http",
-        "requests",
-        "urllib",
-    }
+    return _run_single(conn, "io-in-loop", _check_io_in_loop)
 
-    # Suppress functions that are intentionally batch/migration wrappers.
-    _IO_WRAPPER_NAMES = {
-        "batch",
-        "bulk",
-        "migrate",
-        "seed",
-        "import",
-        "export",
-        "sync_all",
-        "backfill",
-    }
 
-    def _receiver_hint(call: str) -> str:
-        if "." not in call:
-            return ""
-        return call.rsplit(".", 1)[0].lower()
-
-    def _receiver_is_ioish(call: str) -> bool:
-        recv = _receiver_hint(call)
-        if not recv:
-            return False
-        return any(h in recv for h in _IO_RECEIVER_HINTS)
-
-    def _match_framework_pack(call: str, language: str | None) -> dict | None:
-        leaf = _call_leaf(call).lower()
-        recv = _receiver_hint(call)
-        lower_c = call.lower()
-        for pack in _framework_packs(language):
-            leaves = pack.get("leaves", set())
-            recv_hints = pack.get("receiver_hints", set())
-            if lower_c in {c.lower() for c in pack.get("exact", set())}:
-                return pack
-            if leaf not in leaves:
-                continue
-            if not recv_hints:
-                return pack
-            if any(h in recv for h in recv_hints):
-                return pack
+def _check_list_prepend(scan, r):
+    if not r["has_ms"]:
         return None
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        language = _row_value(r, "language", "")
-        snippet = _read_symbol_source(
-            r["file_path"],
-            _row_value(r, "line_start", None),
-            _row_value(r, "line_end", None),
+    # New indexes precompute the exact front-op signal.
+    if scan.has_column("front_ops_in_loop"):
+        if _flag(r, "front_ops_in_loop") != 1:
+            return None
+        return _finding(
+            "list-prepend",
+            "insert-front",
+            r,
+            "Front insert/remove inside loop (O(n) shift per operation)",
+            "high",
         )
-        guard_hints = _guard_hints_from_source(language, snippet)
-        calls = _iter_loop_calls(r)
-        if not calls:
-            continue
+    # Fallback heuristic for older indexes (conservative): only explicit front APIs.
+    if _flag(r, "loop_depth") < 1:
+        return None
+    calls = scan.loop_calls(r)
+    if not _call_in(calls, {"insert", "unshift", "shift", "appendleft", "popleft"}):
+        return None
+    return _finding(
+        "list-prepend",
+        "insert-front",
+        r,
+        "Potential front insert/remove inside loop",
+        "medium",
+    )
 
-        high_calls: list[str] = []
-        medium_calls: list[str] = []
-        frameworks: set[str] = set()
-        fixes: set[str] = set()
-        for c in calls:
-            pack = _match_framework_pack(c, language)
-            if pack:
-                frameworks.add(pack["framework"])
-                if pack.get("fix"):
-                    fixes.add(pack["fix"])
-                if pack.get("confidence") == "high":
-                    high_calls.append(c)
-                else:
-                    medium_calls.append(c)
-                continue
 
-            lower_c = c.lower()
-            leaf = _call_leaf(c).lower()
-            if lower_c in _HIGH_EXACT_LOWER:
-                high_calls.append(c)
-                continue
-            if leaf in _HIGH_LEAF and _receiver_is_ioish(c):
-                high_calls.append(c)
-                continue
-            # requests.<verb> style HTTP calls
-            if leaf in {"get", "post", "put", "delete", "patch", "request"}:
-                recv = _receiver_hint(c)
-                if "requests" in recv or recv.endswith("http"):
-                    high_calls.append(c)
-                    continue
-            if leaf in _MEDIUM_LEAF and _receiver_is_ioish(c):
-                medium_calls.append(c)
-                continue
-            # Bare helper names without a receiver are ambiguous: if they
-            # resolve to a local helper in the same file, treat as non-I/O.
-            if "." not in c and leaf in _AMBIGUOUS_BARE:
-                local_helper = conn.execute(
-                    "SELECT 1 FROM edges e "
-                    "JOIN symbols t ON e.target_id = t.id "
-                    "WHERE e.source_id = ? "
-                    "AND lower(t.name) = ? "
-                    "AND t.file_id = ? "
-                    "LIMIT 1",
-                    (r["id"], leaf, r["file_id"]),
-                ).fetchone()
-                if local_helper:
-                    continue
-                medium_calls.append(c)
-                continue
-            if leaf == "open":
-                medium_calls.append(c)
-                continue
+def detect_list_prepend(conn):
+    """insert(0, x), unshift(), or pop(0) inside a loop — O(n) per op
+    due to array shifting, O(n^2) total."""
+    return _run_single(conn, "list-prepend", _check_list_prepend)
 
-        if not high_calls and not medium_calls:
-            continue
 
-        name_lower = (r["name"] or "").lower()
-        if any(kw in name_lower for kw in _IO_WRAPPER_NAMES):
-            continue
+_SORTED_INDEX_RE = re.compile(r"\bsorted\s*\([^)]*\)\s*\[\s*(?:-?\d+|:\s*[^]\n]+)\s*\]")
+_INPLACE_SORT_INDEX_RE = re.compile(
+    r"\b([A-Za-z_][A-Za-z0-9_]*)\s*\.\s*sort\s*\([^)]*\).*?"
+    r"\b\1\s*\[\s*(?:-?\d+|:\s*[^]\n]+)\s*\]",
+    re.DOTALL,
+)
+_GENERIC_SORT_INDEX_RE = re.compile(
+    r"\bsort(?:ed)?\s*\([^)]*\).*?\[\s*(?:-?\d+|:\s*[^]\n]+)\s*\]",
+    re.DOTALL,
+)
 
-        guard_applies = bool(frameworks and guard_hints)
-        if high_calls:
-            reason_calls = _dedupe(high_calls)[:2]
-            reason_suffix = ""
-            if frameworks:
-                reason_suffix = f"; frameworks: {', '.join(sorted(frameworks))}"
-            confidence = "high"
-            if guard_applies:
-                confidence = _lower_confidence(confidence)
-                reason_suffix += f"; eager/batch guards: {', '.join(guard_hints[:2])}"
-            results.append(
-                _finding(
-                    "io-in-loop",
-                    "loop-query",
-                    r,
-                    f"I/O call ({', '.join(reason_calls)}) inside loop (N+1 pattern){reason_suffix}",
-                    confidence,
-                    evidence={
-                        "io_calls": _dedupe(high_calls + medium_calls)[:6],
-                        "frameworks": sorted(frameworks),
-                        "guard_hints": guard_hints,
-                    },
-                    fix="; ".join(sorted(fixes)) if fixes else None,
-                )
-            )
-        else:
-            reason_calls = _dedupe(medium_calls)[:2]
-            reason_suffix = ""
-            if frameworks:
-                reason_suffix = f"; frameworks: {', '.join(sorted(frameworks))}"
-            confidence = "medium"
-            if guard_applies:
-                confidence = _lower_confidence(confidence)
-                reason_suffix += f"; eager/batch guards: {', '.join(guard_hints[:2])}"
-            results.append(
-                _finding(
-                    "io-in-loop",
-                    "loop-query",
-                    r,
-                    f"I/O-like call ({', '.join(reason_calls)}) inside loop (may be N+1){reason_suffix}",
-                    confidence,
-                    evidence={
-                        "io_calls": _dedupe(high_calls + medium_calls)[:6],
-                        "frameworks": sorted(frameworks),
-                        "guard_hints": guard_hints,
-                    },
-                    fix="; ".join(sorted(fixes)) if fixes else None,
-                )
-            )
-    return results
 
+def _check_sort_to_select(scan, r):
+    snippet = scan.source(r)
+    if not snippet or "sort" not in snippet:
+        return None
 
-def detect_list_prepend(conn):
-    """insert(0, x), unshift(), or pop(0) inside a loop — O(n) per op
-    due to array shifting, O(n^2) total."""
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.front_ops_in_loop "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.front_ops_in_loop = 1"
-        ).fetchall()
-    except Exception:
-        # Fallback for older indexes without front_ops_in_loop.
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.calls_in_loops, '' as calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
+    # Strong patterns: sorted(...)[0], sorted(... )[:k], arr.sort(); arr[0]
+    if _SORTED_INDEX_RE.search(snippet) or _INPLACE_SORT_INDEX_RE.search(snippet):
+        return _finding(
+            "sort-to-select",
+            "full-sort",
+            r,
+            "Sort used only for first/last/top-k selection",
+            "high",
+        )
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        # New indexes precompute the exact front-op signal.
-        if _row_value(r, "front_ops_in_loop", None) == 1:
-            results.append(
-                _finding(
-                    "list-prepend",
-                    "insert-front",
-                    r,
-                    "Front insert/remove inside loop (O(n) shift per operation)",
-                    "high",
-                )
-            )
-            continue
-        # Fallback heuristic (conservative): only explicit front APIs.
-        calls = _iter_loop_calls(r)
-        if _call_in(calls, {"insert", "unshift", "shift", "appendleft", "popleft"}):
-            results.append(
-                _finding(
-                    "list-prepend",
-                    "insert-front",
-                    r,
-                    "Potential front insert/remove inside loop",
-                    "medium",
-                )
-            )
-    return results
+    # Fallback pattern for other languages (sort(...) then index/slice).
+    if _GENERIC_SORT_INDEX_RE.search(snippet):
+        return _finding(
+            "sort-to-select",
+            "full-sort",
+            r,
+            "Potential full sort followed by index/slice selection",
+            "medium",
+        )
+    return None
 
 
 def detect_sort_to_select(conn):
@@ -1354,58 +1406,44 @@ def detect_sort_to_select(conn):
     Detection: function calls sort AND has subscript access, but does NOT
     iterate the full sorted result.
     """
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-        "s.line_start, s.line_end "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "WHERE s.kind IN ('function', 'method')"
-    ).fetchall()
-
-    sorted_index_re = re.compile(r"\bsorted\s*\([^)]*\)\s*\[\s*(?:-?\d+|:\s*[^]\n]+)\s*\]")
-    inplace_sort_index_re = re.compile(
-        r"\b([A-Za-z_][A-Za-z0-9_]*)\s*\.\s*sort\s*\([^)]*\).*?"
-        r"\b\1\s*\[\s*(?:-?\d+|:\s*[^]\n]+)\s*\]",
-        re.DOTALL,
-    )
-    generic_sort_index_re = re.compile(
-        r"\bsort(?:ed)?\s*\([^)]*\).*?\[\s*(?:-?\d+|:\s*[^]\n]+)\s*\]",
-        re.DOTALL,
-    )
+    return _run_single(conn, "sort-to-select", _check_sort_to_select)
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        snippet = _read_symbol_source(r["file_path"], r["line_start"], r["line_end"])
-        if not snippet:
-            continue
 
-        # Strong patterns: sorted(...)[0], sorted(... )[:k], arr.sort(); arr[0]
-        if sorted_index_re.search(snippet) or inplace_sort_index_re.search(snippet):
-            results.append(
-                _finding(
-                    "sort-to-select",
-                    "full-sort",
-                    r,
-                    "Sort used only for first/last/top-k selection",
-                    "high",
-                )
-            )
-            continue
+_LOOKUP_CALLS = {
+    "index",
+    "indexOf",
+    "lastIndexOf",
+    "contains",
+    "includes",
+    "Contains",
+    "IndexOf",
+}
 
-        # Fallback pattern for other languages (sort(...) then index/slice).
-        if generic_sort_index_re.search(snippet):
-            results.append(
-                _finding(
-                    "sort-to-select",
-                    "full-sort",
-                    r,
-                    "Potential full sort followed by index/slice selection",
-                    "medium",
-                )
-            )
-    return results
+
+def _check_loop_lookup(scan, r):
+    if not r["has_ms"] or _flag(r, "loop_depth") < 1:
+        return None
+    lookup_calls = _json_list(r.get("loop_lookup_calls"))
+    if lookup_calls:
+        return _finding(
+            "loop-lookup",
+            "method-scan",
+            r,
+            f"Linear lookup ({', '.join(lookup_calls[:2])}) called on invariant collection",
+            "high",
+        )
+    # Fallback for older indexes: conservative matching only.
+    calls = scan.loop_calls(r, qualified=True)
+    fallback_hits = _call_in(calls, _LOOKUP_CALLS)
+    if fallback_hits:
+        return _finding(
+            "loop-lookup",
+            "method-scan",
+            r,
+            f"Linear lookup ({', '.join(fallback_hits[:2])}) called inside loop",
+            "low",
+        )
+    return None
 
 
 def detect_loop_lookup(conn):
@@ -1414,75 +1452,49 @@ def detect_loop_lookup(conn):
     Each call is O(m) linear scan on the lookup collection, total O(n*m).
     Pre-building a set gives O(1) per lookup, O(n+m) total.
     """
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_lookup_calls, ms.calls_in_loops, "
-            "ms.calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
-    except Exception:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, '' as loop_lookup_calls, ms.calls_in_loops, "
-            "'' as calls_in_loops_qualified "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.loop_depth >= 1"
-        ).fetchall()
-
-    _LOOKUP_CALLS = {
-        "index",
-        "indexOf",
-        "lastIndexOf",
-        "contains",
-        "includes",
-        "Contains",
-        "IndexOf",
-    }
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        lookup_calls = _json_list(_row_value(r, "loop_lookup_calls", ""))
-        if lookup_calls:
-            results.append(
-                _finding(
-                    "loop-lookup",
-                    "method-scan",
-                    r,
-                    f"Linear lookup ({', '.join(lookup_calls[:2])}) called on invariant collection",
-                    "high",
-                )
-            )
-            continue
-        # Fallback for older indexes: conservative matching only.
-        calls = _iter_loop_calls(r)
-        fallback_hits = _call_in(calls, _LOOKUP_CALLS)
-        if fallback_hits:
-            results.append(
-                _finding(
-                    "loop-lookup",
-                    "method-scan",
-                    r,
-                    f"Linear lookup ({', '.join(fallback_hits[:2])}) called inside loop",
-                    "low",
-                )
-            )
-    return results
+    return _run_single(conn, "loop-lookup", _check_loop_lookup)
 
 
 # ---------------------------------------------------------------------------
 # Tier 2 detectors: enhanced signals
 # ---------------------------------------------------------------------------
 
+# Tree/AST walkers recurse into children intentionally and don't have
+# overlapping subproblems.
+_WALKER_NAMES = (
+    "walk",
+    "visit",
+    "traverse",
+    "search",
+    "scan",
+    "crawl",
+    "descend",
+    "recurse",
+    "dfs",
+    "bfs",
+)
+
+
+def _check_branching_recursion(scan, r):
+    # self_call_count column may not exist in older DBs
+    if not r["has_ms"] or not scan.has_column("self_call_count") or _flag(r, "self_call_count") < 2:
+        return None
+    # Skip fibonacci — already covered by detect_naive_fibonacci
+    name_lower = (r["name"] or "").lower()
+    if "fib" in name_lower:
+        return None
+    if any(kw in name_lower for kw in _WALKER_NAMES):
+        return None
+    if scan.is_memoized(r["id"]):
+        return None
+    return _finding(
+        "branching-recursion",
+        "naive-branching",
+        r,
+        f"Branching recursion ({r['self_call_count']} self-calls) without memoization",
+        "high",
+    )
+
 
 def detect_branching_recursion(conn):
     """Functions with 2+ self-call sites and no memoization.
@@ -1490,99 +1502,140 @@ def detect_branching_recursion(conn):
     Generalizes fibonacci to any branching recursion: tree traversals,
     divide-and-conquer, DP problems.  O(2^n) -> O(n) with memoization.
     """
-    # self_call_count column may not exist in older DBs — fall back safely
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.self_call_count "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.self_call_count >= 2"
-        ).fetchall()
-    except Exception:
-        return []
+    return _run_single(conn, "branching-recursion", _check_branching_recursion)
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        # Skip fibonacci — already covered by detect_naive_fibonacci
-        name_lower = (r["name"] or "").lower()
-        if "fib" in name_lower:
-            continue
-        # Skip tree/AST walkers — recursive traversal of children is
-        # intentional and doesn't have overlapping subproblems
-        _WALKER_NAMES = {
-            "walk",
-            "visit",
-            "traverse",
-            "search",
-            "scan",
-            "crawl",
-            "descend",
-            "recurse",
-            "dfs",
-            "bfs",
-        }
-        if any(kw in name_lower for kw in _WALKER_NAMES):
-            continue
-        # Check for memoization edge
-        memo_edge = conn.execute(
-            "SELECT 1 FROM edges e "
-            "JOIN symbols t ON e.target_id = t.id "
-            "WHERE e.source_id = ? "
-            "AND t.name IN ('lru_cache', 'cache', 'memoize', 'memo', "
-            "               'functools.lru_cache', 'functools.cache') "
-            "LIMIT 1",
-            (r["id"],),
-        ).fetchone()
-        if memo_edge:
-            continue
-        results.append(
-            _finding(
-                "branching-recursion",
-                "naive-branching",
-                r,
-                f"Branching recursion ({r['self_call_count']} self-calls) without memoization",
-                "high",
-            )
-        )
-    return results
+
+def _check_quadratic_string(scan, r):
+    if not r["has_ms"] or _flag(r, "str_concat_in_loop") != 1:
+        return None
+    return _finding(
+        "quadratic-string",
+        "augment-concat",
+        r,
+        "String += in loop (O(n^2) due to immutable reallocation)",
+        "high",
+    )
 
 
 def detect_quadratic_string(conn):
     """String concatenation via += inside a loop — O(n^2) due to
     immutable string reallocation in Python/Java/Go.
     """
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.str_concat_in_loop "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.str_concat_in_loop = 1"
-        ).fetchall()
-    except Exception:
-        return []
+    return _run_single(conn, "quadratic-string", _check_quadratic_string)
+
+
+# Calls that are intentionally per-iteration (suppress)
+_INTENTIONAL_CALLS = {
+    # Logging / output
+    "print",
+    "log",
+    "debug",
+    "info",
+    "warn",
+    "warning",
+    "error",
+    # Collection mutation
+    "append",
+    "add",
+    "push",
+    "extend",
+    "write",
+    "send",
+    "get",
+    "values",
+    "items",
+    "keys",
+    "update",
+    "pop",
+    "remove",
+    "insert",
+    "setdefault",
+    "discard",
+    # String methods (inherently per-item)
+    "startswith",
+    "endswith",
+    "replace",
+    "format",
+    "strip",
+    "split",
+    "join",
+    "lower",
+    "upper",
+    "lstrip",
+    "rstrip",
+    "encode",
+    "decode",
+    "ljust",
+    "rjust",
+    "center",
+    "zfill",
+    # Event / tracking
+    "emit",
+    "track",
+    "record",
+    "increment",
+    "decrement",
+    # Iteration helpers / builtins
+    "enumerate",
+    "zip",
+    "range",
+    "sorted",
+    "reversed",
+    "list",
+    "dict",
+    "set",
+    "tuple",
+    "len",
+    "str",
+    "int",
+    "float",
+    "bool",
+    "bytes",
+    "type",
+    # Math / comparison builtins (per-item reductions)
+    "max",
+    "min",
+    "sum",
+    "abs",
+    "round",
+    "pow",
+    "isinstance",
+    "issubclass",
+    "hasattr",
+    "getattr",
+    "setattr",
+    # File / IO
+    "resolve",
+    "execute",
+    "fetchone",
+    "fetchall",
+    "read_text",
+    "read_bytes",
+    "open",
+    # Control flow
+    "sleep",
+    "yield",
+}
 
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        results.append(
-            _finding(
-                "quadratic-string",
-                "augment-concat",
-                r,
-                "String += in loop (O(n^2) due to immutable reallocation)",
-                "high",
-            )
-        )
-    return results
+
+def _check_loop_invariant_call(scan, r):
+    if not r["has_ms"] or not scan.has_column("loop_invariant_calls"):
+        return None
+    raw = r.get("loop_invariant_calls")
+    if raw is None or raw == "[]":
+        return None
+    inv_calls = json.loads(raw) if raw else []
+    # Filter out intentional per-iteration calls
+    flagged = [c for c in inv_calls if c.lower() not in _INTENTIONAL_CALLS]
+    if not flagged:
+        return None
+    return _finding(
+        "loop-invariant-call",
+        "repeated-call",
+        r,
+        f"Loop-invariant call ({', '.join(flagged[:3])}) can be hoisted before loop",
+        "medium",
+    )
 
 
 def detect_loop_invariant_call(conn):
@@ -1591,132 +1644,7 @@ def detect_loop_invariant_call(conn):
     These can be hoisted before the loop to avoid repeated computation.
     Suppresses common intentional per-iteration calls (logging, metrics, etc.).
     """
-    try:
-        rows = conn.execute(
-            "SELECT s.id, s.name, s.qualified_name, s.kind, f.path as file_path, "
-            "s.line_start, ms.loop_invariant_calls "
-            "FROM symbols s "
-            "JOIN files f ON s.file_id = f.id "
-            "JOIN math_signals ms ON ms.symbol_id = s.id "
-            "WHERE s.kind IN ('function', 'method') "
-            "AND ms.loop_invariant_calls IS NOT NULL "
-            "AND ms.loop_invariant_calls != '[]'"
-        ).fetchall()
-    except Exception:
-        return []
-
-    # Calls that are intentionally per-iteration (suppress)
-    _INTENTIONAL_CALLS = {
-        # Logging / output
-        "print",
-        "log",
-        "debug",
-        "info",
-        "warn",
-        "warning",
-        "error",
-        # Collection mutation
-        "append",
-        "add",
-        "push",
-        "extend",
-        "write",
-        "send",
-        "get",
-        "values",
-        "items",
-        "keys",
-        "update",
-        "pop",
-        "remove",
-        "insert",
-        "setdefault",
-        "discard",
-        # String methods (inherently per-item)
-        "startswith",
-        "endswith",
-        "replace",
-        "format",
-        "strip",
-        "split",
-        "join",
-        "lower",
-        "upper",
-        "lstrip",
-        "rstrip",
-        "encode",
-        "decode",
-        "ljust",
-        "rjust",
-        "center",
-        "zfill",
-        # Event / tracking
-        "emit",
-        "track",
-        "record",
-        "increment",
-        "decrement",
-        # Iteration helpers / builtins
-        "enumerate",
-        "zip",
-        "range",
-        "sorted",
-        "reversed",
-        "list",
-        "dict",
-        "set",
-        "tuple",
-        "len",
-        "str",
-        "int",
-        "float",
-        "bool",
-        "bytes",
-        "type",
-        # Math / comparison builtins (per-item reductions)
-        "max",
-        "min",
-        "sum",
-        "abs",
-        "round",
-        "pow",
-        "isinstance",
-        "issubclass",
-        "hasattr",
-        "getattr",
-        "setattr",
-        # File / IO
-        "resolve",
-        "execute",
-        "fetchone",
-        "fetchall",
-        "read_text",
-        "read_bytes",
-        "open",
-        # Control flow
-        "sleep",
-        "yield",
-    }
-
-    results = []
-    for r in rows:
-        if _is_test_path(r["file_path"]):
-            continue
-        inv_calls = json.loads(r["loop_invariant_calls"]) if r["loop_invariant_calls"] else []
-        # Filter out intentional per-iteration calls
-        flagged = [c for c in inv_calls if c.lower() not in _INTENTIONAL_CALLS]
-        if not flagged:
-            continue
-        results.append(
-            _finding(
-                "loop-invariant-call",
-                "repeated-call",
-                r,
-                f"Loop-invariant call ({', '.join(flagged[:3])}) can be hoisted before loop",
-                "medium",
-            )
-        )
-    return results
+    return _run_single(conn, "loop-invariant-call", _check_loop_invariant_call)
 
 
 # ---------------------------------------------------------------------------
@@ -2134,6 +2062,34 @@ _MATH_DETECTORS = [
 ]
 
 
+# Per-row checks evaluated by the fused engine, keyed by public detector.
+_FUSED_CHECKS = {
+    detect_manual_sort: _check_manual_sort,
+    detect_linear_search: _check_linear_search,
+    detect_list_membership: _check_list_membership,
+    detect_string_concat_loop: _check_string_concat_loop,
+    detect_manual_dedup: _check_manual_dedup,
+    detect_manual_maxmin: _check_manual_maxmin,
+    detect_manual_accumulation: _check_manual_accumulation,
+    detect_manual_power: _check_manual_power,
+    detect_manual_gcd: _check_manual_gcd,
+    detect_naive_fibonacci: _check_naive_fibonacci,
+    detect_nested_lookup: _check_nested_lookup,
+    detect_manual_groupby: _check_manual_groupby,
+    detect_string_reverse: _check_string_reverse,
+    detect_matrix_mult: _check_matrix_mult,
+    detect_busy_wait: _check_busy_wait,
+    detect_regex_in_loop: _check_regex_in_loop,
+    detect_io_in_loop: _check_io_in_loop,
+    detect_list_prepend: _check_list_prepend,
+    detect_sort_to_select: _check_sort_to_select,
+    detect_loop_lookup: _check_loop_lookup,
+    detect_branching_recursion: _check_branching_recursion,
+    detect_quadratic_string: _check_quadratic_string,
+    detect_loop_invariant_call: _check_loop_invariant_call,
+}
+
+
 def _iter_registered_detectors():
     """Yield built-in detectors plus plugin-contributed detectors."""
     for det in _MATH_DETECTORS:
@@ -2171,31 +2127,70 @@ def run_detectors(
         Precision profile: ``balanced`` (default), ``strict``, ``aggressive``.
     return_meta : bool
         When True, returns ``(findings, meta)`` where ``meta`` contains
-        detector execution diagnostics (totals + failures).
+        detector execution diagnostics (totals, failures and per-detector
+        wall time in ``detector_timings_ms``).
+
+    Built-in detectors are evaluated together in a single pass over one
+    :class:`DetectorScan`; plugin detectors are called individually.
 
     Returns list of finding dicts, or ``(findings, meta)`` when
     ``return_meta=True``.
     """
-    findings = []
     failed_detectors = []
     executed = 0
     executed_tasks: list[str] = []
+    timings: dict[str, float] = {}
+    # Built-in detectors share one fused scan; plugin detectors run as-is.
+    fused: list[tuple[str, object]] = []
+    ordered: list[tuple[str, object]] = []
     for task_id, _way_id, detect_fn in _iter_registered_detectors():
         if task_filter and task_id != task_filter:
             continue
         executed += 1
         executed_tasks.append(task_id)
+        ordered.append((task_id, detect_fn))
+        check = _FUSED_CHECKS.get(detect_fn)
+        if check is not None:
+            fused.append((task_id, check))
+
+    fused_hits: dict[str, list[dict]] = {}
+    if fused:
+        t0 = time.perf_counter()
         try:
-            hits = detect_fn(conn)
+            scan = DetectorScan(conn)
         except Exception as exc:
-            failed_detectors.append(
-                {
-                    "task_id": task_id,
-                    "detector": detect_fn.__name__,
-                    "error": str(exc),
-                }
-            )
-            continue
+            scan = None
+            for task_id, check in fused:
+                failed_detectors.append({"task_id": task_id, "detector": check.__name__, "error": str(exc)})
+        timings["_scan_load"] = round((time.perf_counter() - t0) * 1000, 2)
+        if scan is not None:
+            fused_hits, fused_failures, fused_timings = run_fused(conn, fused, scan)
+            failed_detectors.extend(fused_failures)
+            timings.update(fused_timings)
+            for failure in fused_failures:
+                fused_hits.pop(failure["task_id"], None)
+
+    findings = []
+    for task_id, detect_fn in ordered:
+        if detect_fn in _FUSED_CHECKS:
+            hits = fused_hits.get(task_id)
+            if hits is None:
+                continue
+        else:
+            t0 = time.perf_counter()
+            try:
+                hits = detect_fn(conn)
+            except Exception as exc:
+                failed_detectors.append(
+                    {
+                        "task_id": task_id,
+                        "detector": detect_fn.__name__,
+                        "error": str(exc),
+                    }
+                )
+                continue
+            finally:
+                timings[task_id] = round((time.perf_counter() - t0) * 1000, 2)
         dmeta = _detector_meta(task_id)
         for h in hits:
             h.setdefault("precision", dmeta["precision"])
@@ -2236,6 +2231,7 @@ def run_detectors(
             "profile": profile_key,
             "profile_filtered": profile_filtered,
             "detector_metadata": {task_id: _detector_meta(task_id) for task_id in executed_tasks},
+            "detector_timings_ms": timings,
         }
         return findings, meta
 
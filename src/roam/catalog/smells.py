@@ -11,11 +11,16 @@ Severity levels:
 
 15 deterministic detectors querying the SQLite index. No heuristics,
 no source reading -- pure DB queries for speed and reproducibility.
+``run_all_detectors`` shares one :class:`SmellScan` across detectors so
+the symbol table is read once instead of once per detector (and once
+per class for the membership checks).
 """
 
 from __future__ import annotations
 
+import bisect
 import re
+import time
 
 
 def _loc(path: str, line: int | None) -> str:
@@ -48,15 +53,29 @@ def _finding(
 
 def _parse_param_count(signature: str | None) -> int:
     """Count parameters from a signature string, excluding self/cls."""
-    if not signature:
-        return 0
-    # Extract content between first pair of parentheses
-    m = re.search(r"\(([^)]*)\)", signature)
+    return len(_param_names(signature))
+
+
+# ---------------------------------------------------------------------------
+# Shared scan
+# ---------------------------------------------------------------------------
+
+
+def _table_columns(conn, table: str) -> set[str]:
+    try:
+        return {r[1] for r in conn.execute(f"PRAGMA table_info({table})").fetchall()}
+    except Exception:
+        return set()
+
+
+def _param_names(signature: str | None) -> list[str]:
+    """Lower-cased parameter names from a signature, excluding self/cls."""
+    m = re.search(r"\(([^)]*)\)", signature or "")
     if not m:
-        return 0
+        return []
     params_str = m.group(1).strip()
     if not params_str:
-        return 0
+        return []
     # Split by comma, handling nested generics/brackets
     depth = 0
     parts: list[str] = []
@@ -75,9 +94,162 @@ def _parse_param_count(signature: str | None) -> int:
             current.append(ch)
     if current:
         parts.append("".join(current).strip())
-    # Filter out self/cls and empty parts
-    filtered = [p for p in parts if p and p.split(":")[0].split("=")[0].strip().lower() not in ("self", "cls", "")]
-    return len(filtered)
+    names = []
+    for p in parts:
+        name = p.split(":")[0].split("=")[0].strip().lower()
+        if name and name not in ("self", "cls"):
+            names.append(name)
+    return names
+
+
+class SmellScan:
+    """One pass over the symbol table shared by every smell detector.
+
+    Symbols are loaded once with their ``symbol_metrics`` and
+    ``graph_metrics`` columns LEFT JOINed in.  Class membership, internal
+    method edges and per-function edge locality are derived lazily from a
+    single query each instead of one query per class or function.
+    """
+
+    def __init__(self, conn):
+        self.conn = conn
+        self.has_symbol_metrics = bool(_table_columns(conn, "symbol_metrics"))
+        self.has_graph_metrics = bool(_table_columns(conn, "graph_metrics"))
+        self._symbols: list[dict] | None = None
+        self._by_file: dict[int, list[tuple[int, int, int]]] = {}
+        self._class_methods: dict[int, list[int]] | None = None
+        self._internal_edges: dict[int, int] | None = None
+        self._edge_locality: dict[int, tuple[int, int]] | None = None
+        self._params: dict[str, list[str]] = {}
+
+    @property
+    def symbols(self) -> list[dict]:
+        if self._symbols is None:
+            self._symbols = self._load()
+        return self._symbols
+
+    def _load(self) -> list[dict]:
+        sm = "sm.cognitive_complexity, sm.nesting_depth" if self.has_symbol_metrics else "NULL, NULL"
+        gm = "gm.in_degree, gm.out_degree" if self.has_graph_metrics else "NULL, NULL"
+        joins = ""
+        if self.has_symbol_metrics:
+            joins += " LEFT JOIN symbol_metrics sm ON sm.symbol_id = s.id"
+        if self.has_graph_metrics:
+            joins += " LEFT JOIN graph_metrics gm ON gm.symbol_id = s.id"
+        cur = self.conn.cursor()
+        cur.row_factory = None
+        rows = cur.execute(
+            "SELECT s.id, s.name, s.kind, s.line_start, s.line_end, f.path, "
+            f"s.file_id, s.signature, {sm}, {gm} "
+            "FROM symbols s "
+            f"JOIN files f ON s.file_id = f.id{joins} "
+            "ORDER BY s.id"
+        ).fetchall()
+        keys = (
+            "id",
+            "name",
+            "kind",
+            "line_start",
+            "line_end",
+            "file_path",
+            "file_id",
+            "signature",
+            "cognitive_complexity",
+            "nesting_depth",
+            "in_degree",
+            "out_degree",
+        )
+        return [dict(zip(keys, r)) for r in rows]
+
+    def functions(self):
+        return (r for r in self.symbols if r["kind"] in ("function", "method"))
+
+    def classes(self):
+        return (r for r in self.symbols if r["kind"] == "class")
+
+    def param_names(self, signature: str | None) -> list[str]:
+        key = signature or ""
+        names = self._params.get(key)
+        if names is None:
+            names = self._params[key] = _param_names(key)
+        return names
+
+    def class_methods(self, cls: dict) -> list[int]:
+        """Method ids whose line span lies inside *cls* in the same file."""
+        if self._class_methods is None:
+            by_file: dict[int, list[tuple[int, int, int]]] = {}
+            for r in self.symbols:
+                if r["kind"] == "method" and r["line_start"] is not None and r["line_end"] is not None:
+                    by_file.setdefault(r["file_id"], []).append((r["line_start"], r["line_end"], r["id"]))
+            for methods in by_file.values():
+                methods.sort()
+            self._by_file = by_file
+            self._class_methods = {}
+        cached = self._class_methods.get(cls["id"])
+        if cached is not None:
+            return cached
+        methods = self._by_file.get(cls["file_id"], [])
+        lo, hi = cls["line_start"] or 0, cls["line_end"] or 0
+        ids = []
+        for i in range(bisect.bisect_left(methods, (lo,)), len(methods)):
+            start, end, sid = methods[i]
+            if start > hi:
+                break
+            if end <= hi:
+                ids.append(sid)
+        self._class_methods[cls["id"]] = ids
+        return ids
+
+    def internal_edges(self, cls: dict) -> int:
+        """Number of edges between methods of *cls*."""
+        if self._internal_edges is None:
+            owners: dict[int, list[int]] = {}
+            for c in self.classes():
+                members = self.class_methods(c)
+                if len(members) >= 5:
+                    for mid in members:
+                        owners.setdefault(mid, []).append(c["id"])
+            counts: dict[int, int] = {}
+            if owners:
+                rows = self.conn.execute(
+                    "SELECT e.source_id, e.target_id FROM edges e "
+                    "JOIN symbols a ON a.id = e.source_id "
+                    "JOIN symbols b ON b.id = e.target_id "
+                    "WHERE a.kind = 'method' AND b.kind = 'method' AND a.file_id = b.file_id"
+                ).fetchall()
+                for src, tgt in rows:
+                    src_owners = owners.get(src)
+                    tgt_owners = owners.get(tgt)
+                    if not src_owners or not tgt_owners:
+                        continue
+                    for cid in src_owners:
+                        if cid in tgt_owners:
+                            counts[cid] = counts.get(cid, 0) + 1
+            self._internal_edges = counts
+        return self._internal_edges.get(cls["id"], 0)
+
+    def edge_locality(self, sid: int) -> tuple[int, int] | None:
+        """``(total, external)`` outgoing edge counts for functions with 4+ edges."""
+        if self._edge_locality is None:
+            rows = self.conn.execute(
+                "SELECT e.source_id, COUNT(*), "
+                "SUM(CASE WHEN t.file_id != s.file_id THEN 1 ELSE 0 END) "
+                "FROM edges e "
+                "JOIN symbols s ON s.id = e.source_id "
+                "JOIN symbols t ON t.id = e.target_id "
+                "WHERE s.kind IN ('function', 'method') "
+                "GROUP BY e.source_id HAVING COUNT(*) >= 4"
+            ).fetchall()
+            self._edge_locality = {r[0]: (r[1], r[2] or 0) for r in rows}
+        return self._edge_locality.get(sid)
+
+
+def _line_count(r: dict) -> int:
+    return (r["line_end"] or 0) - (r["line_start"] or 0)
+
+
+def _gt(value, threshold) -> bool:
+    return value is not None and value > threshold
 
 
 # ---------------------------------------------------------------------------
@@ -85,58 +257,48 @@ def _parse_param_count(signature: str | None) -> int:
 # ---------------------------------------------------------------------------
 
 
-def detect_brain_method(conn) -> list[dict]:
+def detect_brain_method(conn, scan: SmellScan | None = None) -> list[dict]:
     """Functions with complexity > 60 AND > 100 LOC."""
-    rows = conn.execute(
-        "SELECT s.name, s.kind, s.line_start, s.line_end, f.path as file_path, "
-        "sm.cognitive_complexity "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN symbol_metrics sm ON sm.symbol_id = s.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND sm.cognitive_complexity > 60 "
-        "AND (s.line_end - s.line_start) > 100"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
+    if not scan.has_symbol_metrics:
+        return []
     results = []
-    for r in rows:
-        loc_str = _loc(r["file_path"], r["line_start"])
-        line_count = (r["line_end"] or 0) - (r["line_start"] or 0)
+    for r in scan.functions():
+        if not _gt(r["cognitive_complexity"], 60):
+            continue
+        if r["line_start"] is None or r["line_end"] is None or _line_count(r) <= 100:
+            continue
         results.append(
             _finding(
                 "brain-method",
                 "critical",
                 r["name"],
                 r["kind"],
-                loc_str,
+                _loc(r["file_path"], r["line_start"]),
                 r["cognitive_complexity"],
                 60,
-                f"Brain method: complexity {r['cognitive_complexity']:.0f}, {line_count} LOC",
+                f"Brain method: complexity {r['cognitive_complexity']:.0f}, {_line_count(r)} LOC",
             )
         )
     return results
 
 
-def detect_deep_nesting(conn) -> list[dict]:
+def detect_deep_nesting(conn, scan: SmellScan | None = None) -> list[dict]:
     """Symbols with nesting depth > 4."""
-    rows = conn.execute(
-        "SELECT s.name, s.kind, s.line_start, f.path as file_path, "
-        "sm.nesting_depth "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN symbol_metrics sm ON sm.symbol_id = s.id "
-        "WHERE sm.nesting_depth > 4 "
-        "AND s.kind IN ('function', 'method')"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
+    if not scan.has_symbol_metrics:
+        return []
     results = []
-    for r in rows:
-        loc_str = _loc(r["file_path"], r["line_start"])
+    for r in scan.functions():
+        if not _gt(r["nesting_depth"], 4):
+            continue
         results.append(
             _finding(
                 "deep-nesting",
                 "warning",
                 r["name"],
                 r["kind"],
-                loc_str,
+                _loc(r["file_path"], r["line_start"]),
                 r["nesting_depth"],
                 4,
                 f"Deep nesting: depth {r['nesting_depth']}",
@@ -145,28 +307,22 @@ def detect_deep_nesting(conn) -> list[dict]:
     return results
 
 
-def detect_long_params(conn) -> list[dict]:
+def detect_long_params(conn, scan: SmellScan | None = None) -> list[dict]:
     """Functions with > 5 parameters (excluding self/cls)."""
-    rows = conn.execute(
-        "SELECT s.name, s.kind, s.line_start, s.signature, f.path as file_path "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND s.signature IS NOT NULL "
-        "AND s.signature != ''"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
     results = []
-    for r in rows:
-        count = _parse_param_count(r["signature"])
+    for r in scan.functions():
+        if not r["signature"]:
+            continue
+        count = len(scan.param_names(r["signature"]))
         if count > 5:
-            loc_str = _loc(r["file_path"], r["line_start"])
             results.append(
                 _finding(
                     "long-params",
                     "warning",
                     r["name"],
                     r["kind"],
-                    loc_str,
+                    _loc(r["file_path"], r["line_start"]),
                     count,
                     5,
                     f"Long parameter list: {count} params",
@@ -175,34 +331,23 @@ def detect_long_params(conn) -> list[dict]:
     return results
 
 
-def detect_large_class(conn) -> list[dict]:
+def detect_large_class(conn, scan: SmellScan | None = None) -> list[dict]:
     """Classes with > 500 LOC AND > 20 methods."""
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.kind, s.line_start, s.line_end, f.path as file_path "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "WHERE s.kind = 'class' "
-        "AND (s.line_end - s.line_start) > 500"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
     results = []
-    for r in rows:
-        method_count = conn.execute(
-            "SELECT COUNT(*) FROM symbols "
-            "WHERE file_id = (SELECT file_id FROM symbols WHERE id = ?) "
-            "AND kind = 'method' "
-            "AND line_start >= ? AND line_end <= ?",
-            (r["id"], r["line_start"] or 0, r["line_end"] or 0),
-        ).fetchone()[0]
+    for r in scan.classes():
+        if r["line_start"] is None or r["line_end"] is None or _line_count(r) <= 500:
+            continue
+        method_count = len(scan.class_methods(r))
         if method_count > 20:
-            loc_str = _loc(r["file_path"], r["line_start"])
-            line_count = (r["line_end"] or 0) - (r["line_start"] or 0)
+            line_count = _line_count(r)
             results.append(
                 _finding(
                     "large-class",
                     "critical",
                     r["name"],
                     r["kind"],
-                    loc_str,
+                    _loc(r["file_path"], r["line_start"]),
                     line_count,
                     500,
                     f"Large class: {line_count} LOC, {method_count} methods",
@@ -211,24 +356,14 @@ def detect_large_class(conn) -> list[dict]:
     return results
 
 
-def detect_god_class(conn) -> list[dict]:
+def detect_god_class(conn, scan: SmellScan | None = None) -> list[dict]:
     """Classes with > 30 methods OR > 1000 LOC."""
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.kind, s.line_start, s.line_end, "
-        "f.path as file_path, s.file_id "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "WHERE s.kind = 'class'"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
     results = []
-    for r in rows:
-        line_count = (r["line_end"] or 0) - (r["line_start"] or 0)
-        method_count = conn.execute(
-            "SELECT COUNT(*) FROM symbols WHERE file_id = ? AND kind = 'method' AND line_start >= ? AND line_end <= ?",
-            (r["file_id"], r["line_start"] or 0, r["line_end"] or 0),
-        ).fetchone()[0]
+    for r in scan.classes():
+        line_count = _line_count(r)
+        method_count = len(scan.class_methods(r))
         if method_count > 30 or line_count > 1000:
-            loc_str = _loc(r["file_path"], r["line_start"])
             metric = max(method_count, line_count)
             threshold = 30 if method_count > 30 else 1000
             parts = []
@@ -242,7 +377,7 @@ def detect_god_class(conn) -> list[dict]:
                     "critical",
                     r["name"],
                     r["kind"],
-                    loc_str,
+                    _loc(r["file_path"], r["line_start"]),
                     metric,
                     threshold,
                     f"God class: {', '.join(parts)}",
@@ -251,38 +386,24 @@ def detect_god_class(conn) -> list[dict]:
     return results
 
 
-def detect_feature_envy(conn) -> list[dict]:
+def detect_feature_envy(conn, scan: SmellScan | None = None) -> list[dict]:
     """Functions where > 50% of edge targets are in other files (min 4 refs)."""
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.kind, s.line_start, s.file_id, "
-        "f.path as file_path "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "WHERE s.kind IN ('function', 'method')"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
     results = []
-    for r in rows:
-        edges = conn.execute(
-            "SELECT e.target_id, t.file_id as target_file_id "
-            "FROM edges e "
-            "JOIN symbols t ON e.target_id = t.id "
-            "WHERE e.source_id = ?",
-            (r["id"],),
-        ).fetchall()
-        total = len(edges)
-        if total < 4:
+    for r in scan.functions():
+        locality = scan.edge_locality(r["id"])
+        if locality is None:
             continue
-        external = sum(1 for e in edges if e["target_file_id"] != r["file_id"])
+        total, external = locality
         ratio = external / total
         if ratio > 0.5:
-            loc_str = _loc(r["file_path"], r["line_start"])
             results.append(
                 _finding(
                     "feature-envy",
                     "warning",
                     r["name"],
                     r["kind"],
-                    loc_str,
+                    _loc(r["file_path"], r["line_start"]),
                     round(ratio * 100, 1),
                     50,
                     f"Feature envy: {external}/{total} refs ({ratio:.0%}) to other files",
@@ -291,26 +412,22 @@ def detect_feature_envy(conn) -> list[dict]:
     return results
 
 
-def detect_shotgun_surgery(conn) -> list[dict]:
+def detect_shotgun_surgery(conn, scan: SmellScan | None = None) -> list[dict]:
     """Symbols with in_degree > 7 in graph_metrics."""
-    rows = conn.execute(
-        "SELECT s.name, s.kind, s.line_start, f.path as file_path, "
-        "gm.in_degree "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN graph_metrics gm ON gm.symbol_id = s.id "
-        "WHERE gm.in_degree > 7"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
+    if not scan.has_graph_metrics:
+        return []
     results = []
-    for r in rows:
-        loc_str = _loc(r["file_path"], r["line_start"])
+    for r in scan.symbols:
+        if not _gt(r["in_degree"], 7):
+            continue
         results.append(
             _finding(
                 "shotgun-surgery",
                 "warning",
                 r["name"],
                 r["kind"],
-                loc_str,
+                _loc(r["file_path"], r["line_start"]),
                 r["in_degree"],
                 7,
                 f"Shotgun surgery: {r['in_degree']} incoming dependencies",
@@ -319,65 +436,23 @@ def detect_shotgun_surgery(conn) -> list[dict]:
     return results
 
 
-def detect_data_clumps(conn) -> list[dict]:
+def detect_data_clumps(conn, scan: SmellScan | None = None) -> list[dict]:
     """3+ params repeated across 3+ functions (group by sorted first-3 param names)."""
-    rows = conn.execute(
-        "SELECT s.name, s.kind, s.line_start, s.signature, f.path as file_path "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND s.signature IS NOT NULL "
-        "AND s.signature != ''"
-    ).fetchall()
-
-    # Build param-group map
-    from collections import defaultdict
-
-    param_groups: dict[str, list[dict]] = defaultdict(list)
-    for r in rows:
-        sig = r["signature"]
-        m = re.search(r"\(([^)]*)\)", sig or "")
-        if not m:
+    scan = scan or SmellScan(conn)
+    param_groups: dict[str, list[dict]] = {}
+    for r in scan.functions():
+        if not r["signature"]:
             continue
-        params_str = m.group(1).strip()
-        if not params_str:
-            continue
-        # Simple split by comma (top-level only)
-        depth = 0
-        parts: list[str] = []
-        current: list[str] = []
-        for ch in params_str:
-            if ch in ("(", "[", "<", "{"):
-                depth += 1
-                current.append(ch)
-            elif ch in (")", "]", ">", "}"):
-                depth -= 1
-                current.append(ch)
-            elif ch == "," and depth == 0:
-                parts.append("".join(current).strip())
-                current = []
-            else:
-                current.append(ch)
-        if current:
-            parts.append("".join(current).strip())
-        # Extract just param names, skip self/cls
-        names = []
-        for p in parts:
-            name = p.split(":")[0].split("=")[0].strip().lower()
-            if name and name not in ("self", "cls", ""):
-                names.append(name)
+        names = scan.param_names(r["signature"])
         if len(names) >= 3:
             key = ",".join(sorted(names[:3]))
-            param_groups[key].append(r)
+            param_groups.setdefault(key, []).append(r)
 
     results = []
-    seen_groups: set[str] = set()
     for key, funcs in param_groups.items():
-        if len(funcs) >= 3 and key not in seen_groups:
-            seen_groups.add(key)
+        if len(funcs) >= 3:
             # Report one finding per clump using the first function
             r = funcs[0]
-            loc_str = _loc(r["file_path"], r["line_start"])
             func_names = [f["name"] for f in funcs[:5]]
             results.append(
                 _finding(
@@ -385,7 +460,7 @@ def detect_data_clumps(conn) -> list[dict]:
                     "info",
                     r["name"],
                     r["kind"],
-                    loc_str,
+                    _loc(r["file_path"], r["line_start"]),
                     len(funcs),
                     3,
                     f"Data clump: params ({key}) repeated in {len(funcs)} functions: {', '.join(func_names)}",
@@ -394,82 +469,56 @@ def detect_data_clumps(conn) -> list[dict]:
     return results
 
 
-def detect_dead_params(conn) -> list[dict]:
+def detect_dead_params(conn, scan: SmellScan | None = None) -> list[dict]:
     """Functions with 4+ params but complexity <= 1 (likely unused params)."""
-    rows = conn.execute(
-        "SELECT s.name, s.kind, s.line_start, s.signature, f.path as file_path, "
-        "sm.cognitive_complexity "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN symbol_metrics sm ON sm.symbol_id = s.id "
-        "WHERE s.kind IN ('function', 'method') "
-        "AND sm.cognitive_complexity <= 1 "
-        "AND s.signature IS NOT NULL "
-        "AND s.signature != ''"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
+    if not scan.has_symbol_metrics:
+        return []
     results = []
-    for r in rows:
-        count = _parse_param_count(r["signature"])
+    for r in scan.functions():
+        cc = r["cognitive_complexity"]
+        if cc is None or cc > 1 or not r["signature"]:
+            continue
+        count = len(scan.param_names(r["signature"]))
         if count >= 4:
-            loc_str = _loc(r["file_path"], r["line_start"])
             results.append(
                 _finding(
                     "dead-params",
                     "info",
                     r["name"],
                     r["kind"],
-                    loc_str,
+                    _loc(r["file_path"], r["line_start"]),
                     count,
                     4,
-                    f"Dead params: {count} params but complexity {r['cognitive_complexity']:.0f}",
+                    f"Dead params: {count} params but complexity {cc:.0f}",
                 )
             )
     return results
 
 
-def detect_empty_catch(conn) -> list[dict]:
+def detect_empty_catch(conn, scan: SmellScan | None = None) -> list[dict]:
     """Placeholder: empty catch/except blocks. Returns []."""
     return []
 
 
-def detect_low_cohesion(conn) -> list[dict]:
+def detect_low_cohesion(conn, scan: SmellScan | None = None) -> list[dict]:
     """Classes with 5+ methods but fewer than methods/2 internal edges."""
-    rows = conn.execute(
-        "SELECT s.id, s.name, s.kind, s.line_start, s.line_end, "
-        "f.path as file_path, s.file_id "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "WHERE s.kind = 'class'"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
     results = []
-    for r in rows:
-        # Count methods within the class line range
-        methods = conn.execute(
-            "SELECT id FROM symbols WHERE file_id = ? AND kind = 'method' AND line_start >= ? AND line_end <= ?",
-            (r["file_id"], r["line_start"] or 0, r["line_end"] or 0),
-        ).fetchall()
-        method_count = len(methods)
+    for r in scan.classes():
+        method_count = len(scan.class_methods(r))
         if method_count < 5:
             continue
-        method_ids = [m["id"] for m in methods]
-        if not method_ids:
-            continue
-        # Count internal edges between methods of this class
-        ph = ",".join("?" for _ in method_ids)
-        internal_edges = conn.execute(
-            f"SELECT COUNT(*) FROM edges WHERE source_id IN ({ph}) AND target_id IN ({ph})",
-            method_ids + method_ids,
-        ).fetchone()[0]
+        internal_edges = scan.internal_edges(r)
         threshold = method_count // 2
         if internal_edges < threshold:
-            loc_str = _loc(r["file_path"], r["line_start"])
             results.append(
                 _finding(
                     "low-cohesion",
                     "warning",
                     r["name"],
                     r["kind"],
-                    loc_str,
+                    _loc(r["file_path"], r["line_start"]),
                     internal_edges,
                     threshold,
                     f"Low cohesion: {method_count} methods but only {internal_edges} internal edges "
@@ -479,27 +528,22 @@ def detect_low_cohesion(conn) -> list[dict]:
     return results
 
 
-def detect_message_chain(conn) -> list[dict]:
+def detect_message_chain(conn, scan: SmellScan | None = None) -> list[dict]:
     """Functions with out_degree > 10 in graph_metrics."""
-    rows = conn.execute(
-        "SELECT s.name, s.kind, s.line_start, f.path as file_path, "
-        "gm.out_degree "
-        "FROM symbols s "
-        "JOIN files f ON s.file_id = f.id "
-        "JOIN graph_metrics gm ON gm.symbol_id = s.id "
-        "WHERE gm.out_degree > 10 "
-        "AND s.kind IN ('function', 'method')"
-    ).fetchall()
+    scan = scan or SmellScan(conn)
+    if not scan.has_graph_metrics:
+        return []
     results = []
-    for r in rows:
-        loc_str = _loc(r["file_path"], r["line_start"])
+    for r in scan.functions():
+        if not _gt(r["out_degree"], 10):
+            continue
         results.append(
             _finding(
                 "message-chain",
                 "info",
                 r["name"],
                 r["kind"],
-                loc_str,
+                _loc(r["file_path"], r["line_start"]),
                 r["out_degree"],
                 10,
                 f"Message chain: {r['out_degree']} outgoing calls",
@@ -508,17 +552,17 @@ def detect_message_chain(conn) -> list[dict]:
     return results
 
 
-def detect_refused_bequest(conn) -> list[dict]:
+def detect_refused_bequest(conn, scan: SmellScan | None = None) -> list[dict]:
     """Placeholder: classes that override parent methods to do nothing. Returns []."""
     return []
 
 
-def detect_primitive_obsession(conn) -> list[dict]:
+def detect_primitive_obsession(conn, scan: SmellScan | None = None) -> list[dict]:
     """Placeholder: excessive use of primitive types. Returns []."""
     return []
 
 
-def detect_duplicate_conditionals(conn) -> list[dict]:
+def detect_duplicate_conditionals(conn, scan: SmellScan | None = None) -> list[dict]:
     """Placeholder: repeated conditional logic. Returns []."""
     return []
 
@@ -548,20 +592,40 @@ ALL_DETECTORS: list[tuple[str, callable]] = [
 _SEVERITY_ORDER = {"critical": 0, "warning": 1, "info": 2}
 
 
-def run_all_detectors(conn) -> list[dict]:
+def run_all_detectors(conn, return_meta: bool = False):
     """Run all 15 smell detectors and return combined findings.
 
-    Returns list of finding dicts sorted by severity (critical first).
+    Every detector shares one :class:`SmellScan`, so the symbol table is
+    read once per run.  A detector that raises is skipped.
+
+    Returns list of finding dicts sorted by severity (critical first), or
+    ``(findings, meta)`` when ``return_meta=True``; ``meta`` carries
+    ``detectors_failed``, ``failed_detectors`` and per-detector wall time
+    in ``detector_timings_ms``.
     """
+    scan = SmellScan(conn)
     findings: list[dict] = []
-    for _smell_id, detect_fn in ALL_DETECTORS:
+    failed: list[str] = []
+    timings: dict[str, float] = {}
+    for smell_id, detect_fn in ALL_DETECTORS:
+        t0 = time.perf_counter()
         try:
-            hits = detect_fn(conn)
+            hits = detect_fn(conn, scan)
         except Exception:
+            failed.append(smell_id)
             continue
+        finally:
+            timings[smell_id] = round((time.perf_counter() - t0) * 1000, 2)
         findings.extend(hits)
     # Sort: critical first, then warning, then info
     findings.sort(key=lambda f: _SEVERITY_ORDER.get(f.get("severity", "info"), 2))
+    if return_meta:
+        return findings, {
+            "detectors_executed": len(ALL_DETECTORS),
+            "detectors_failed": len(failed),
+            "failed_detectors": failed,
+            "detector_timings_ms": timings,
+        }
     return findings
 
 
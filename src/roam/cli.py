@@ -12,10 +12,13 @@ if sys.platform == "win32" and not os.environ.get("PYTHONIOENCODING"):
 
 import click
 
+from roam.command_meta import COMMAND_SUMMARIES
+
 # Lazy-loading command group: imports command modules only when invoked.
 # This avoids importing networkx (~500ms) on every CLI call.
 # Total: 137 invokable command names (136 canonical commands + 1 legacy alias).
-# If this changes, update README.md, CLAUDE.md, llms-install.md, and docs copy.
+# If this changes, update README.md, CLAUDE.md, llms-install.md, and docs copy,
+# and regenerate the help summaries with dev/gen-command-meta.py.
 _COMMANDS = {
     "index": ("roam.commands.cmd_index", "index"),
     "map": ("roam.commands.cmd_map", "map_cmd"),
@@ -341,7 +344,10 @@ class LazyGroup(click.Group):
         return sorted(_COMMANDS.keys())
 
     def get_command(self, ctx, cmd_name):
-        _ensure_plugin_commands_loaded()
+        # Built-ins take precedence over plugins, so only unknown names need
+        # the (entry-point scanning) plugin discovery
+        if cmd_name not in _COMMANDS:
+            _ensure_plugin_commands_loaded()
         if cmd_name not in _COMMANDS:
             return None
         module_path, attr_name = _COMMANDS[cmd_name]
@@ -391,10 +397,13 @@ class LazyGroup(click.Group):
                 continue
             formatter.write(f"  {cat_name}:\n")
             for cmd_name in valid_cmds:
-                cmd = self.get_command(ctx, cmd_name)
-                if cmd is None:
-                    continue
-                help_text = cmd.get_short_help_str(limit=60) if cmd else ""
+                # Precomputed summaries keep help from importing command modules
+                help_text = COMMAND_SUMMARIES.get(cmd_name)
+                if help_text is None:
+                    cmd = self.get_command(ctx, cmd_name)
+                    if cmd is None:
+                        continue
+                    help_text = cmd.get_short_help_str(limit=60)
                 formatter.write(f"    {cmd_name:20s} {help_text}\n")
                 shown.add(cmd_name)
             formatter.write("\n")
@@ -0,0 +1,144 @@
+"""Command summaries for ``roam --help``, without importing command modules.
+
+Generated by ``dev/gen-command-meta.py`` -- do not edit by hand.
+"""
+
+COMMAND_SUMMARIES = {
+    "adversarial": "Adversarial architecture review -- challenge your changes.",
+    "affected": "Identify affected files/modules from a git diff via...",
+    "affected-tests": "Trace from a changed symbol or file to test files that...",
+    "agent-context": "Generate per-worker context: write scope, read-only deps,...",
+    "agent-export": "Generate an AI agent context file from the roam index.",
+    "agent-plan": "Decompose partitions into dependency-ordered multi-agent...",
+    "ai-ratio": "Estimate the percentage of AI-generated code from git...",
+    "ai-readiness": "Estimate how effectively AI agents can work on this...",
+    "alerts": "Detect health degradation trends and generate actionable...",
+    "algo": "Detect suboptimal algorithms and suggest better approaches.",
+    "annotate": "Annotate a symbol or file with a persistent note.",
+    "annotations": "List annotations for a symbol, file, or the whole project.",
+    "api-changes": "Detect breaking and non-breaking API changes vs a git ref.",
+    "api-drift": "Detect mismatches between backend API responses and...",
+    "attest": "Generate a proof-carrying PR attestation.",
+    "auth-gaps": "Find endpoints missing authentication or authorization...",
+    "bisect": "Find which snapshots caused architectural degradation.",
+    "breaking": "Detect potential breaking changes vs a git ref.",
+    "budget": "Check pending changes against architectural budgets.",
+    "bus-factor": "Detect knowledge loss risk per module (bus factor analysis).",
+    "capsule": "Export the structural graph as a portable JSON capsule.",
+    "check-rules": "Run structural governance rules against the indexed...",
+    "clean": "Remove orphaned entries from the index (files no longer...",
+    "closure": "Compute the minimal set of changes needed when modifying...",
+    "clusters": "Show code clusters and directory mismatches.",
+    "codeowners": "Analyze CODEOWNERS coverage and ownership distribution.",
+    "complexity": "Show cognitive complexity metrics for functions and methods.",
+    "config": "Manage per-project roam configuration (.roam/config.json).",
+    "context": "Get the minimal context needed to safely modify a symbol.",
+    "conventions": "Auto-detect codebase naming, file, import, and export...",
+    "coupling": "Show temporal coupling: file pairs that change together.",
+    "coverage-gaps": "Find entry points with no path to a required gate symbol.",
+    "cut": "Minimum cut analysis — find fragile domain boundaries.",
+    "dark-matter": "Detect dark matter: file pairs that co-change but have no...",
+    "dashboard": "Unified codebase status: health, hotspots, debt, bus...",
+    "dead": "Show unreferenced exported symbols (dead code).",
+    "debt": "Hotspot-weighted technical debt prioritization.",
+    "deps": "Show file import/imported-by relationships.",
+    "describe": "Auto-generate a project description for AI coding agents.",
+    "dev-profile": "Analyze developer commit patterns and behavioral metrics.",
+    "diagnose": "Root cause analysis for a failing symbol.",
+    "diff": "Show blast radius: what code is affected by your changes.",
+    "digest": "Compare current metrics against the most recent snapshot.",
+    "doc-staleness": "Detect stale docstrings where the code body changed long...",
+    "docs-coverage": "Analyze exported-symbol doc coverage and stale docs in...",
+    "doctor": "Diagnose environment setup: Python, dependencies, index...",
+    "drift": "Detect ownership drift: where declared owners differ from...",
+    "duplicates": "Detect semantically duplicate functions via structural...",
+    "effects": "Show what functions DO — side-effect classification.",
+    "endpoints": "List all detected REST/GraphQL/gRPC endpoints with handlers.",
+    "entry-points": "Entry point catalog with protocol classification.",
+    "fan": "Show fan-in/fan-out: most connected symbols or files.",
+    "file": "Show file skeleton: all definitions with signatures.",
+    "fingerprint": "Topology fingerprint for cross-repo comparison.",
+    "fitness": "Run architectural fitness functions from .roam/fitness.yaml.",
+    "fn-coupling": "Show function-level temporal coupling (hidden dependencies).",
+    "forecast": "Predict when metrics will exceed thresholds using trend...",
+    "grep": "Context-enriched grep: search with enclosing symbol...",
+    "guard": "Sub-agent preflight bundle for a symbol (~2K-token target).",
+    "health": "Show code health: cycles, god components, bottlenecks.",
+    "hooks": "Manage git hook integration for automatic re-indexing.",
+    "hotspots": "Show runtime hotspots comparing static analysis vs...",
+    "impact": "Show blast radius: what breaks if a symbol changes.",
+    "index": "Build or rebuild the codebase index.",
+    "ingest-trace": "Ingest runtime trace data and match spans to symbols.",
+    "init": "Initialize Roam for this project: index, config, CI...",
+    "intent": "Link documentation to code -- find what docs describe...",
+    "invariants": "Discover implicit contracts for symbols.",
+    "layers": "Show dependency layers and violations.",
+    "map": "Show project skeleton with entry points and key symbols.",
+    "math": "Detect suboptimal algorithms and suggest better approaches.",
+    "mcp": "Start the roam MCP server.",
+    "mcp-setup": "Generate MCP server config for AI coding platforms.",
+    "metrics": "Show unified metrics for a file or symbol.",
+    "migration-safety": "Check migration files for non-idempotent (unsafe if run...",
+    "minimap": "Generate a compact codebase minimap for CLAUDE.md injection.",
+    "missing-index": "Detect queries that filter or sort on columns without...",
+    "module": "Show directory contents: exports, signatures, deps.",
+    "mutate": "Syntax-less agentic editing.",
+    "n1": "Detect implicit N+1 I/O patterns in ORM models.",
+    "onboard": "Generate a new-developer onboarding guide for the codebase.",
+    "orchestrate": "Partition the codebase for parallel multi-agent work.",
+    "orphan-routes": "Find backend API routes that have no frontend consumers...",
+    "over-fetch": "Detect models that serialize more fields than necessary...",
+    "owner": "Show code ownership: who owns a file or directory.",
+    "partition": "Generate a multi-agent partition manifest with conflict...",
+    "path-coverage": "Find critical untested paths from entry points to...",
+    "patterns": "Detect common architectural patterns in the codebase.",
+    "plan": "Generate a structured execution plan for modifying code.",
+    "plan-refactor": "Build an ordered refactoring plan with risk, test, and...",
+    "pr-diff": "Show structural impact of pending changes.",
+    "pr-risk": "Compute risk score for pending changes.",
+    "preflight": "Run a pre-change safety checklist for a symbol, file, or...",
+    "relate": "Show how a set of symbols relate to each other.",
+    "report": "Run a compound report preset — multiple commands in one...",
+    "reset": "Delete the index DB and rebuild from scratch.",
+    "risk": "Show domain-weighted risk ranking of symbols.",
+    "rules": "Evaluate custom governance rules defined in .roam/rules/.",
+    "safe-delete": "Check if a symbol can be safely deleted.",
+    "safe-zones": "Identify safe refactoring boundaries for a symbol or file.",
+    "schema": "Show the roam JSON envelope schema and validate output...",
+    "search": "Find symbols matching a name substring (case-insensitive).",
+    "search-semantic": "Find symbols by natural language query (hybrid BM25 +...",
+    "secrets": "Scan for hardcoded secrets, API keys, tokens, and passwords.",
+    "semantic-diff": "Show structural change summary vs a git ref.",
+    "simulate": "Counterfactual architecture simulator.",
+    "simulate-departure": "Simulate what happens when a developer leaves the team.",
+    "sketch": "Show compact structural skeleton of a directory.",
+    "smells": "Detect code smells: brain methods, god classes, deep...",
+    "snapshot": "Save a snapshot of current health metrics.",
+    "spectral": "Spectral bisection: Fiedler vector partition tree.",
+    "split": "Analyze a file's internal structure and suggest how to...",
+    "suggest-refactoring": "Rank symbols that are likely to yield high-value...",
+    "suggest-reviewers": "Suggest optimal code reviewers for changed files.",
+    "supply-chain": "Dependency risk dashboard: pin coverage, risk scoring,...",
+    "symbol": "Show symbol definition, callers, and callees.",
+    "syntax-check": "Check files for syntax errors using tree-sitter AST parsing.",
+    "test-gaps": "Map changed symbols to missing test coverage.",
+    "test-map": "Map a symbol or file to its test coverage.",
+    "tour": "Generate a codebase onboarding tour.",
+    "trace": "Show shortest path between two symbols.",
+    "trend": "Display health trend with sparklines, anomaly detection,...",
+    "trends": "Historical metric trends with sparkline output.",
+    "understand": "Single-call codebase comprehension — everything in one shot.",
+    "uses": "Show all consumers of a symbol: callers, importers,...",
+    "verify": "Verify changed files follow codebase conventions.",
+    "verify-imports": "Validate import/require statements against the indexed...",
+    "vibe-check": "Detect AI code anti-patterns and compute AI rot score.",
+    "visualize": "Generate a Mermaid or DOT architecture diagram.",
+    "vuln-map": "Ingest vulnerability scanner reports and match to...",
+    "vuln-reach": "Query reachability of ingested vulnerabilities through...",
+    "vulns": "Scan and manage vulnerability inventory.",
+    "watch": "Watch for file changes and auto-re-index incrementally.",
+    "weather": "Show code hotspots: churn x complexity ranking.",
+    "why": "Explain why a symbol matters — role, reach, criticality,...",
+    "ws": "Multi-repo workspace commands.",
+    "x-lang": "Show cross-language symbol bridges detected in the project.",
+}
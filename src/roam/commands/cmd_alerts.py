@@ -77,15 +77,10 @@ def _mann_kendall_s(values):
     """
     import math
 
+    from roam.graph.anomaly import kendall_s
+
     n = len(values)
-    s = 0
-    for i in range(n):
-        for j in range(i + 1, n):
-            diff = values[j] - values[i]
-            if diff > 0:
-                s += 1
-            elif diff < 0:
-                s -= 1
+    s = kendall_s(values)
     if n < 3:
         return s, None
     var_s = n * (n - 1) * (2 * n + 5) / 18.0
@@ -114,18 +109,9 @@ def _sens_slope(values):
     Reference: Sen (1968), "Estimates of the Regression Coefficient
     Based on Kendall's Tau."
     """
-    slopes = []
-    n = len(values)
-    for i in range(n):
-        for j in range(i + 1, n):
-            slopes.append((values[j] - values[i]) / (j - i))
-    if not slopes:
-        return 0.0
-    slopes.sort()
-    mid = len(slopes) // 2
-    if len(slopes) % 2 == 0:
-        return (slopes[mid - 1] + slopes[mid]) / 2
-    return slopes[mid]
+    from roam.graph.anomaly import median_pairwise_slope
+
+    return median_pairwise_slope(values)
 
 
 def _is_monotonic_worsening(values, metric):
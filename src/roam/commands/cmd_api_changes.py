@@ -112,19 +112,13 @@ def _git_default_branch(root: Path) -> str:
 
 def _parse_source_bytes(source: bytes, language: str):
     """Parse *source* bytes with tree-sitter for the given language."""
+    from roam.index.parse_session import current_session
     from roam.index.parser import GRAMMAR_ALIASES
 
     grammar = GRAMMAR_ALIASES.get(language, language)
 
     try:
-        from tree_sitter_language_pack import get_parser
-
-        parser = get_parser(grammar)
-    except Exception:
-        return None, None, None
-
-    try:
-        tree = parser.parse(source)
+        tree = current_session().parse(source, grammar)
     except Exception:
         return None, None, None
 
@@ -675,11 +669,22 @@ def api_changes(ctx, base, severity, changed_only):
     # 2. Collect all changes across files
     all_changes: list[dict] = []
 
+    from roam.index.fingerprints import load_version, ref_blobs
+
+    blobs = ref_blobs(root, base)
     with open_db(readonly=True) as conn:
         for fpath in changed:
-            # Get old file content from the ref
-            old_source = _git_show(root, base, fpath)
-            if old_source is None:
+            # Old symbols from the index's fingerprints when that version
+            # was indexed, else parse the file content at the ref
+            old = load_version(conn, fpath, blobs.get(fpath)) if blobs is not None else None
+            if old is not None:
+                old_source = None
+                old_symbols = old[0]
+                is_new = fpath not in blobs
+            else:
+                old_source = _git_show(root, base, fpath)
+                is_new = old_source is None
+            if is_new:
                 # File is new — extract new symbols as ADDED
                 new_symbols = _get_current_symbols(conn, fpath)
                 for sym in _exported_only(new_symbols):
@@ -695,7 +700,8 @@ def api_changes(ctx, base, severity, changed_only):
                     )
                 continue
 
-            old_symbols = _extract_symbols_from_source(old_source, fpath)
+            if old_source is not None:
+                old_symbols = _extract_symbols_from_source(old_source, fpath)
             if not old_symbols:
                 continue
 
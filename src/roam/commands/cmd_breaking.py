@@ -69,20 +69,14 @@ def _parse_source_bytes(source: bytes, language: str):
 
     Returns (tree, source_bytes, effective_language) or (None, None, None).
     """
+    from roam.index.parse_session import current_session
     from roam.index.parser import GRAMMAR_ALIASES
 
     # Resolve grammar alias (e.g. apex -> java)
     grammar = GRAMMAR_ALIASES.get(language, language)
 
     try:
-        from tree_sitter_language_pack import get_parser
-
-        parser = get_parser(grammar)
-    except Exception:
-        return None, None, None
-
-    try:
-        tree = parser.parse(source)
+        tree = current_session().parse(source, grammar)
     except Exception:
         return None, None, None
 
@@ -365,15 +359,22 @@ def breaking(ctx, target):
     all_sig_changed: list[dict] = []
     all_renamed: list[dict] = []
 
+    from roam.index.fingerprints import load_version, ref_blobs
+
+    blobs = ref_blobs(root, target)
     with open_db(readonly=True) as conn:
         for fpath in changed:
-            # Get old file content from the ref
-            old_source = _git_show(root, target, fpath)
-            if old_source is None:
-                # File didn't exist at ref — it's new, no breaking changes
-                continue
-
-            old_symbols = _extract_old_symbols(old_source, fpath)
+            # Old symbols from the index's fingerprints when that version
+            # was indexed, else parse the file content at the ref
+            old = load_version(conn, fpath, blobs.get(fpath)) if blobs is not None else None
+            if old is not None:
+                old_symbols = old[0]
+            else:
+                old_source = _git_show(root, target, fpath)
+                if old_source is None:
+                    # File didn't exist at ref — it's new, no breaking changes
+                    continue
+                old_symbols = _extract_old_symbols(old_source, fpath)
             if not old_symbols:
                 continue
 
@@ -2,190 +2,26 @@
 
 from __future__ import annotations
 
-import fnmatch
-import re
 from collections import defaultdict
-from pathlib import Path, PurePosixPath
 
 import click
 
 from roam.commands.resolve import ensure_index
 from roam.db.connection import find_project_root, open_db
+from roam.index.codeowners import (  # noqa: F401 -- re-exported
+    CODEOWNERS_LOCATIONS,
+    codeowners_match,
+    find_codeowners,
+    load_file_owners,
+    parse_codeowners,
+    resolve_owners,
+)
 from roam.output.formatter import format_table, json_envelope, to_json
 
-# ---------------------------------------------------------------------------
-# CODEOWNERS locations (checked in order)
-# ---------------------------------------------------------------------------
-
-_CODEOWNERS_LOCATIONS = [
-    "CODEOWNERS",
-    ".github/CODEOWNERS",
-    "docs/CODEOWNERS",
-    ".gitlab/CODEOWNERS",
-]
-
-
-# ---------------------------------------------------------------------------
-# Parser
-# ---------------------------------------------------------------------------
-
-
-def find_codeowners(project_root: Path) -> Path | None:
-    """Find the CODEOWNERS file in standard locations.
-
-    Returns the first matching path, or None if no file exists.
-    """
-    for loc in _CODEOWNERS_LOCATIONS:
-        candidate = project_root / loc
-        if candidate.is_file():
-            return candidate
-    return None
-
-
-def parse_codeowners(codeowners_path: str | Path) -> list[tuple[str, list[str]]]:
-    """Parse a CODEOWNERS file into (pattern, owners) tuples.
-
-    Format:
-    - Lines starting with # are comments
-    - Empty lines are ignored
-    - Pattern followed by one or more owners: ``*.py @backend-team @alice``
-    - Later rules override earlier ones (last match wins)
-    """
-    path = Path(codeowners_path)
-    if not path.is_file():
-        return []
-
-    rules: list[tuple[str, list[str]]] = []
-    try:
-        text = path.read_text(encoding="utf-8", errors="replace")
-    except OSError:
-        return []
-
-    for line in text.splitlines():
-        line = line.strip()
-        # Skip comments and empty lines
-        if not line or line.startswith("#"):
-            continue
-        # Inline comments (# after whitespace)
-        if " #" in line:
-            line = line[: line.index(" #")].strip()
-        parts = line.split()
-        if len(parts) < 2:
-            # Pattern with no owner = explicitly unowned (clears ownership)
-            rules.append((parts[0], []))
-            continue
-        pattern = parts[0]
-        owners = parts[1:]
-        rules.append((pattern, owners))
-
-    return rules
-
-
-# ---------------------------------------------------------------------------
-# Pattern matching (gitignore-style)
-# ---------------------------------------------------------------------------
-
-
-def _codeowners_match(pattern: str, filepath: str) -> bool:
-    """Match a CODEOWNERS pattern against a file path.
-
-    CODEOWNERS uses gitignore-style patterns:
-    - ``*`` matches anything except ``/``
-    - ``**`` matches anything including ``/``
-    - Leading ``/`` means anchored to repo root
-    - Trailing ``/`` means directory match (any file under that dir)
-    - No leading ``/`` means match the basename or partial path
-    """
-    # Normalize path separators
-    filepath = filepath.replace("\\", "/")
-
-    # Directory pattern: trailing / matches everything under that dir
-    if pattern.endswith("/"):
-        dir_pattern = pattern.rstrip("/")
-        # Anchored directory
-        if dir_pattern.startswith("/"):
-            dir_pattern = dir_pattern[1:]
-            return filepath.startswith(dir_pattern + "/") or filepath == dir_pattern
-        # Unanchored directory
-        return filepath.startswith(dir_pattern + "/") or ("/" + dir_pattern + "/") in ("/" + filepath)
-
-    # Anchored pattern (starts with /)
-    anchored = pattern.startswith("/")
-    if anchored:
-        pattern = pattern[1:]
-
-    # Handle ** patterns
-    if "**" in pattern:
-        return _match_doublestar(pattern, filepath, anchored)
-
-    if anchored:
-        # Match from root
-        return fnmatch.fnmatch(filepath, pattern)
-
-    # Unanchored: if pattern contains /, match against full path
-    if "/" in pattern:
-        return fnmatch.fnmatch(filepath, pattern)
-
-    # No slash in pattern: match against the basename
-    basename = PurePosixPath(filepath).name
-    return fnmatch.fnmatch(basename, pattern)
-
-
-def _match_doublestar(pattern: str, filepath: str, anchored: bool) -> bool:
-    """Handle ** glob patterns.
-
-    ``**`` matches zero or more path segments (directories).
-    When ``**`` is surrounded by ``/`` (e.g. ``src/**/foo``), it can
-    match zero segments (``src/foo``) or many (``src/a/b/foo``).
-    """
-    # Strategy: convert the CODEOWNERS pattern to a regex.
-    # ** means "zero or more path segments" — we must absorb adjacent
-    # slashes so that a/**/b matches both a/b and a/x/y/b.
-    regex = ""
-    i = 0
-    plen = len(pattern)
-    while i < plen:
-        if pattern[i : i + 2] == "**":
-            # Absorb trailing slash after **: a/**/ -> a/ or a/x/y/
-            end = i + 2
-            if end < plen and pattern[end] == "/":
-                end += 1
-            # ** with absorbed trailing / becomes (.*/)? — zero or more
-            # path segments ending with /
-            regex += "(.*/)?"
-            i = end
-        elif pattern[i] == "*":
-            regex += "[^/]*"
-            i += 1
-        elif pattern[i] == "?":
-            regex += "[^/]"
-            i += 1
-        elif pattern[i] == ".":
-            regex += r"\."
-            i += 1
-        else:
-            regex += re.escape(pattern[i])
-            i += 1
-
-    if anchored:
-        regex = "^" + regex + "$"
-    else:
-        regex = "(^|.*/)" + regex + "$"
-
-    return bool(re.match(regex, filepath))
-
-
-def resolve_owners(rules: list[tuple[str, list[str]]], filepath: str) -> list[str]:
-    """Determine the owner(s) of a file by applying CODEOWNERS rules.
-
-    Last matching rule wins (standard CODEOWNERS semantics).
-    Returns an empty list if no rule matches.
-    """
-    owners: list[str] = []
-    for pattern, rule_owners in rules:
-        if _codeowners_match(pattern, filepath):
-            owners = rule_owners
-    return owners
+# Parsing and matching live in roam.index.codeowners; re-exported for the
+# commands (drift, watch) and tests that import them from here
+_CODEOWNERS_LOCATIONS = CODEOWNERS_LOCATIONS
+_codeowners_match = codeowners_match
 
 
 # ---------------------------------------------------------------------------
@@ -278,7 +114,6 @@ def codeowners(ctx, unowned, owner, limit):
         click.echo("  Run `roam codeowners --unowned` after creating it to find coverage gaps.")
         return
 
-    rules = parse_codeowners(co_path)
     co_relpath = str(co_path.relative_to(project_root)).replace("\\", "/")
 
     with open_db(readonly=True) as conn:
@@ -303,11 +138,12 @@ def codeowners(ctx, unowned, owner, limit):
                 click.echo("VERDICT: No files in index")
             return
 
-        # Resolve ownership for each file
+        # Ownership per file, as materialised by the indexer
+        owners_by_id = load_file_owners(conn, project_root, co_path)
         file_ownership: list[dict] = []
         for f in all_files:
             fpath = f["path"].replace("\\", "/")
-            owners = resolve_owners(rules, fpath)
+            owners = owners_by_id.get(f["id"], [])
             file_ownership.append(
                 {
                     "file_id": f["id"],
@@ -105,7 +105,8 @@ def _render_blast_radius_text(blast):
     if not blast:
         return
     click.echo("Blast radius:")
-    click.echo(f"  {blast['dependent_symbols']} dependent symbols in {blast['dependent_files']} files")
+    weighted = f"  (weighted impact {blast['weighted_impact']:.4f})" if blast.get("weighted_impact") else ""
+    click.echo(f"  {blast['dependent_symbols']} dependent symbols in {blast['dependent_files']} files{weighted}")
     click.echo()
 
 
@@ -433,6 +434,7 @@ def _output_task_single_json(c, task, extras, budget=0):
     if extras.get("blast_radius"):
         summary["blast_radius_symbols"] = extras["blast_radius"]["dependent_symbols"]
         summary["blast_radius_files"] = extras["blast_radius"]["dependent_files"]
+        summary["blast_radius_weighted"] = extras["blast_radius"].get("weighted_impact", 0.0)
     if extras.get("affected_tests") is not None:
         summary["affected_tests_total"] = len(extras["affected_tests"])
     if extras.get("coupling"):
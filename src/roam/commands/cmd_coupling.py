@@ -7,6 +7,7 @@ import click
 from roam.commands.changed_files import get_changed_files, resolve_changed_to_db
 from roam.commands.resolve import ensure_index
 from roam.db.connection import find_project_root, open_db
+from roam.graph.hyperedges import HyperedgeIndex
 from roam.output.formatter import format_table, json_envelope, to_json
 
 # ---------------------------------------------------------------------------
@@ -49,43 +50,18 @@ def _compute_surprise(conn, change_fids):
     1.0 = never seen this combination.
 
     Uses both Jaccard similarity (set overlap) and NPMI (information-
-    theoretic) to find the closest historical pattern.
+    theoretic) to find the closest historical pattern.  Ties between
+    equally similar patterns resolve to the oldest hyperedge.
     """
     if not change_fids or len(change_fids) < 2:
         return 0.0, None, 0.0
 
-    change_set = set(change_fids)
-
-    # Get all hyperedge IDs that share at least one member with our change set
-    ph = ",".join("?" for _ in change_set)
-    candidate_edges = conn.execute(
-        f"""SELECT DISTINCT hyperedge_id FROM git_hyperedge_members
-            WHERE file_id IN ({ph})""",
-        list(change_set),
-    ).fetchall()
-
-    if not candidate_edges:
+    # Single pass over the inverted index with size/prefix pruning
+    # (see roam.graph.hyperedges) instead of one member query per candidate.
+    max_jaccard, best_id, best_pattern = HyperedgeIndex(conn).best_match(change_fids)
+    if best_id is None:
         return 0.5, None, 0.0  # no history → moderate surprise
 
-    max_jaccard = 0.0
-    best_pattern = None
-
-    for row in candidate_edges:
-        he_id = row["hyperedge_id"]
-        members = conn.execute(
-            "SELECT file_id FROM git_hyperedge_members WHERE hyperedge_id = ?",
-            (he_id,),
-        ).fetchall()
-        pattern_set = {m["file_id"] for m in members}
-
-        intersection = len(change_set & pattern_set)
-        union = len(change_set | pattern_set)
-        if union > 0:
-            jaccard = intersection / union
-            if jaccard > max_jaccard:
-                max_jaccard = jaccard
-                best_pattern = pattern_set
-
     # Resolve best pattern paths
     best_paths = None
     if best_pattern:
@@ -8,9 +8,9 @@ from collections import defaultdict
 
 import click
 
-from roam.commands.cmd_codeowners import find_codeowners, parse_codeowners, resolve_owners
 from roam.commands.resolve import ensure_index
 from roam.db.connection import find_project_root, open_db
+from roam.index.codeowners import find_codeowners, load_file_owners
 from roam.output.formatter import format_table, json_envelope, to_json
 
 # ---------------------------------------------------------------------------
@@ -170,8 +170,6 @@ def drift(ctx, threshold, limit):
         click.echo("  Create one and run `roam drift` to analyse ownership drift.")
         return
 
-    rules = parse_codeowners(co_path)
-
     with open_db(readonly=True) as conn:
         # Get all indexed files
         all_files = conn.execute("SELECT id, path FROM files ORDER BY path").fetchall()
@@ -196,11 +194,12 @@ def drift(ctx, threshold, limit):
 
         now_ts = int(time.time())
 
-        # Resolve ownership for each file
+        # Ownership per file, as materialised by the indexer
+        owners_by_id = load_file_owners(conn, project_root, co_path)
         owned_files: list[dict] = []
         for f in all_files:
             fpath = f["path"].replace("\\", "/")
-            owners = resolve_owners(rules, fpath)
+            owners = owners_by_id.get(f["id"], [])
             if owners:
                 owned_files.append(
                     {
@@ -2,6 +2,8 @@
 
 from __future__ import annotations
 
+import bisect
+import functools
 import os
 import re
 from collections import defaultdict
@@ -11,6 +13,7 @@ import click
 
 from roam.commands.resolve import ensure_index
 from roam.db.connection import find_project_root, open_db
+from roam.db.source_store import SourceStore
 from roam.output.formatter import format_table, json_envelope, loc, to_json
 
 # ---------------------------------------------------------------------------
@@ -130,9 +133,19 @@ def _norm_method(raw: str) -> str:
     return _METHOD_MAP.get(raw.lower(), raw.upper())
 
 
+@functools.lru_cache(maxsize=4)
+def _line_starts(source: str) -> list[int]:
+    starts = [0]
+    pos = source.find("\n")
+    while pos != -1:
+        starts.append(pos + 1)
+        pos = source.find("\n", pos + 1)
+    return starts
+
+
 def _line_of(source: str, match_start: int) -> int:
     """Return 1-based line number for a byte offset in source."""
-    return source[:match_start].count("\n") + 1
+    return bisect.bisect_right(_line_starts(source), match_start)
 
 
 # ---------------------------------------------------------------------------
@@ -563,28 +576,42 @@ _TEST_PATH_PATTERNS = re.compile(
 # ---------------------------------------------------------------------------
 
 
-def _scan_file(full_path: Path, rel_path: str) -> list[dict]:
-    """Scan a single file for endpoint definitions. Returns a list of endpoint dicts."""
+def _scan_file(full_path: Path, rel_path: str, sources: SourceStore | None = None) -> list[dict]:
+    """Scan a single file for endpoint definitions. Returns a list of endpoint dicts.
+
+    Reads the indexed snapshot through *sources* when given, else the working tree.
+    """
     ext = full_path.suffix.lower()
     scanner = _EXT_SCANNER.get(ext)
     if scanner is None:
         return []
 
-    try:
-        source = full_path.read_text(encoding="utf-8", errors="replace")
-    except OSError:
-        return []
+    if sources is not None:
+        source = sources.text(rel_path)
+        if source is None:
+            return []
+    else:
+        try:
+            source = full_path.read_text(encoding="utf-8", errors="replace")
+        except OSError:
+            return []
 
     return scanner(source, str(full_path), rel_path)
 
 
-def _collect_endpoints(project_root: Path, file_paths: list[str], include_tests: bool = False) -> list[dict]:
+def _collect_endpoints(
+    project_root: Path,
+    file_paths: list[str],
+    include_tests: bool = False,
+    sources: SourceStore | None = None,
+) -> list[dict]:
     """Scan all indexed files for endpoint definitions.
 
     Args:
         project_root: Root directory for resolving relative paths.
         file_paths: List of relative file paths from the DB.
         include_tests: If True, also scan test files.
+        sources: Indexed source snapshots; None reads the working tree.
 
     Returns:
         List of endpoint dicts sorted by framework then path.
@@ -608,7 +635,7 @@ def _collect_endpoints(project_root: Path, file_paths: list[str], include_tests:
             continue
 
         full_path = project_root / rel_path
-        endpoints = _scan_file(full_path, rel_path)
+        endpoints = _scan_file(full_path, rel_path, sources)
         all_endpoints.extend(endpoints)
 
     # Deduplicate: same (method, path, file, line) — can happen with multi-match
@@ -664,8 +691,8 @@ def endpoints(ctx, framework, http_method, include_tests, group_by):
     with open_db(readonly=True) as conn:
         file_rows = conn.execute("SELECT path FROM files").fetchall()
         file_paths = [r["path"] for r in file_rows]
-
-    all_endpoints = _collect_endpoints(project_root, file_paths, include_tests)
+        sources = SourceStore(conn, project_root, cache_size=1)
+        all_endpoints = _collect_endpoints(project_root, file_paths, include_tests, sources)
 
     # Apply filters
     if framework:
@@ -83,7 +83,7 @@ def _aggregate_forecasts(conn, horizon):
     Returns a list of dicts, one per tracked metric.  Skips metrics that
     have fewer than 4 non-None values (Theil-Sen requires n >= 4).
     """
-    from roam.graph.anomaly import theil_sen_slope
+    from roam.graph.anomaly import theil_sen_slopes
 
     rows = conn.execute(
         "SELECT timestamp, health_score, avg_complexity, cycles, "
@@ -94,9 +94,12 @@ def _aggregate_forecasts(conn, horizon):
     if len(rows) < 3:
         return [], len(rows)
 
+    series = {metric: [r[metric] for r in rows if r[metric] is not None] for metric in _THRESHOLDS}
+    trends = dict(zip(series, theil_sen_slopes(series.values())))
+
     results = []
     for metric, cfg in _THRESHOLDS.items():
-        values = [r[metric] for r in rows if r[metric] is not None]
+        values = series[metric]
         if len(values) < 4:
             # Not enough history -- still report current value as stable
             current = values[-1] if values else None
@@ -114,7 +117,7 @@ def _aggregate_forecasts(conn, horizon):
             )
             continue
 
-        ts_result = theil_sen_slope(values)
+        ts_result = trends[metric]
         if ts_result is None:
             continue
 
@@ -2,21 +2,26 @@
 
 from __future__ import annotations
 
+import bisect
 import re
-from collections import defaultdict, deque
+from collections import defaultdict
+from typing import Iterator
 
 import click
 
 from roam.commands.next_steps import format_next_steps_text, suggest_next_steps
 from roam.commands.resolve import ensure_index
 from roam.db.connection import batched_in, find_project_root, open_db
+from roam.db.source_store import SourceStore
+from roam.graph.entrypoints import (
+    compute_entry_distances,
+    entrypoint_ids,
+    load_entry_distances,
+    load_entrypoint_count,
+)
 from roam.output.formatter import json_envelope, summary_envelope, to_json
 
 _SEVERITY_ORDER = {"critical": 0, "high": 1, "medium": 2}
-_ENTRYPOINT_HINT = re.compile(
-    r"(main|handler|route|endpoint|controller|serve|api|http)",
-    re.IGNORECASE,
-)
 
 _SECURITY_SINKS = (
     {
@@ -191,59 +196,58 @@ def _find_symbol_for_line(spans: list[dict], line_no: int) -> dict | None:
     return best
 
 
-def _compute_entrypoint_distances(conn) -> tuple[dict[int, int], int]:
-    edges = conn.execute("SELECT source_id, target_id FROM edges").fetchall()
-    adj: dict[int, set[int]] = defaultdict(set)
-    for row in edges:
-        src = int(row["source_id"])
-        tgt = int(row["target_id"])
-        adj[src].add(tgt)
+def _build_sink_index(sinks) -> dict[str, tuple[re.Pattern, list[dict]]]:
+    """Per-language alternation of every sink regex for that language."""
+    by_lang: dict[str, list[dict]] = defaultdict(list)
+    for sink in sinks:
+        for lang in sink["languages"]:
+            by_lang[lang].append(sink)
+    index = {}
+    for lang, lang_sinks in by_lang.items():
+        parts = []
+        for sink in lang_sinks:
+            rx = sink["regex"]
+            parts.append(f"(?i:{rx.pattern})" if rx.flags & re.IGNORECASE else f"(?:{rx.pattern})")
+        index[lang] = (re.compile("|".join(parts)), lang_sinks)
+    return index
 
-    sym_rows = conn.execute(
-        """
-        SELECT id, name, kind, is_exported
-        FROM symbols
-        WHERE kind IN ('function', 'method', 'constructor', 'class')
-        """
-    ).fetchall()
 
-    entries: set[int] = set()
-    for row in sym_rows:
-        name = row["name"] or ""
-        is_exported = int(row["is_exported"] or 0) == 1
-        if is_exported or _ENTRYPOINT_HINT.search(name):
-            entries.add(int(row["id"]))
-
-    if not entries and sym_rows:
-        entries = {int(r["id"]) for r in sym_rows[:25]}
-
-    distance: dict[int, int] = {}
-    q: deque[int] = deque()
-    for sid in entries:
-        distance[sid] = 0
-        q.append(sid)
-
-    while q:
-        current = q.popleft()
-        next_depth = distance[current] + 1
-        for nxt in adj.get(current, ()):
-            if nxt in distance:
-                continue
-            distance[nxt] = next_depth
-            q.append(nxt)
+_SINK_INDEX = _build_sink_index(_SECURITY_SINKS)
 
-    return distance, len(entries)
 
+def _sink_hits_in_text(text: str, line_starts: list[int], language: str) -> Iterator[tuple[int, str, dict]]:
+    """Yield ``(line_no, line, sink)`` for every sink match in *text*.
 
-def _security_sinks_for_language(language: str) -> list[dict]:
-    lang = (language or "").lower()
-    return [sink for sink in _SECURITY_SINKS if lang in sink["languages"]]
+    One combined regex finds candidate lines across the whole buffer;
+    match offsets map to lines by binary search over *line_starts*, and
+    each candidate line is then confirmed against the individual sink
+    regexes, so results equal a per-line, per-sink scan.
+    """
+    combined, sinks = _SINK_INDEX.get(language, (None, ()))
+    if combined is None:
+        return
+    n_lines = len(line_starts)
+    pos = 0
+    while True:
+        m = combined.search(text, pos)
+        if m is None:
+            return
+        idx = bisect.bisect_right(line_starts, m.start()) - 1
+        start = line_starts[idx]
+        end = line_starts[idx + 1] - 1 if idx + 1 < n_lines else len(text)
+        line = text[start:end]
+        if not _is_comment_line(line, language):
+            for sink in sinks:
+                if sink["regex"].search(line) is not None:
+                    yield idx + 1, line, sink
+        if idx + 1 >= n_lines:
+            return
+        pos = line_starts[idx + 1]
 
 
 def _compute_security_hotspots(conn) -> dict:
-    project_root = find_project_root()
+    sources = SourceStore(conn, find_project_root(), cache_size=1)
     spans_by_file = _load_symbol_spans_by_file(conn)
-    entry_distances, entry_count = _compute_entrypoint_distances(conn)
 
     file_rows = conn.execute(
         """
@@ -259,45 +263,48 @@ def _compute_security_hotspots(conn) -> dict:
     for row in file_rows:
         rel_path = row["path"]
         language = (row["language"] or "").lower()
-        sinks = _security_sinks_for_language(language)
-        if not sinks:
+        if language not in _SINK_INDEX:
             continue
 
-        full_path = project_root / rel_path
-        try:
-            lines = full_path.read_text(encoding="utf-8", errors="replace").splitlines()
-        except OSError:
+        text = sources.text(rel_path)
+        if not text:
             continue
 
         spans = spans_by_file.get(rel_path, [])
-        for i, line in enumerate(lines, start=1):
-            if _is_comment_line(line, language):
+        for i, line, sink in _sink_hits_in_text(text, sources.line_starts(rel_path), language):
+            dedupe_key = (rel_path, i, sink["id"])
+            if dedupe_key in seen:
                 continue
-            for sink in sinks:
-                if sink["regex"].search(line) is None:
-                    continue
-                dedupe_key = (rel_path, i, sink["id"])
-                if dedupe_key in seen:
-                    continue
-                seen.add(dedupe_key)
-                symbol = _find_symbol_for_line(spans, i)
-                hits.append(
-                    {
-                        "file": rel_path,
-                        "line": i,
-                        "language": language,
-                        "pattern_id": sink["id"],
-                        "title": sink["title"],
-                        "severity": sink["severity"],
-                        "recommendation": sink["recommendation"],
-                        "symbol_id": symbol["id"] if symbol else None,
-                        "symbol": (symbol["qualified_name"] or symbol["name"] if symbol else None),
-                        "code": line.strip()[:160],
-                    }
-                )
+            seen.add(dedupe_key)
+            symbol = _find_symbol_for_line(spans, i)
+            hits.append(
+                {
+                    "file": rel_path,
+                    "line": i,
+                    "language": language,
+                    "pattern_id": sink["id"],
+                    "title": sink["title"],
+                    "severity": sink["severity"],
+                    "recommendation": sink["recommendation"],
+                    "symbol_id": symbol["id"] if symbol else None,
+                    "symbol": (symbol["qualified_name"] or symbol["name"] if symbol else None),
+                    "code": line.strip()[:160],
+                }
+            )
 
     symbol_ids = [h["symbol_id"] for h in hits if h["symbol_id"] is not None]
     symbol_ids = sorted(set(symbol_ids))
+
+    # Distances and the entry count are stored at index time; rescan the
+    # symbols only for older indexes or after a targeted reindex
+    entry_distances = load_entry_distances(conn, symbol_ids)
+    entry_count = load_entrypoint_count(conn) if entry_distances is not None else None
+    if entry_count is None:
+        entries = entrypoint_ids(conn)
+        entry_count = len(entries)
+        if entry_distances is None:
+            entry_distances = compute_entry_distances(conn, entries)
+
     pagerank_by_symbol: dict[int, float] = {}
     if symbol_ids:
         rows = batched_in(
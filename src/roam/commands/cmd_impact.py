@@ -101,14 +101,13 @@ def impact(ctx, name):
             click.echo()
 
         try:
-            import networkx as nx
-
-            from roam.graph.builder import build_symbol_graph
+            from roam.graph.builder import load_neighbourhood
         except ImportError:
             click.echo("Graph module not available. Run `roam index` to build the dependency graph.")
             return
 
-        G = build_symbol_graph(conn)
+        # Only the symbol's dependents matter: load their closure, not the whole graph
+        G = load_neighbourhood(conn, [sym_id], direction="in")
         if sym_id not in G:
             click.echo(
                 f"Symbol '{name}' exists in the index but is not in the dependency graph.\n"
@@ -120,13 +119,13 @@ def impact(ctx, name):
         RG = G.reverse()
         dependents, affected_files, direct_callers, by_kind, sf_test_files = _collect_dependents(G, RG, sym_id, conn)
 
-        # Personalized PageRank for distance-weighted importance (Gleich 2015)
+        # Personalized PageRank for distance-weighted importance (Gleich 2015),
+        # pushed locally from the symbol instead of iterating the whole graph
         ppr = {}
         if dependents:
-            try:
-                ppr = nx.pagerank(RG, alpha=0.85, personalization={sym_id: 1.0})
-            except Exception:
-                pass
+            from roam.graph.ppr import graph_adjacency, personalized_pagerank
+
+            ppr = personalized_pagerank(graph_adjacency(G, reverse=True), [sym_id])
 
         if not dependents:
             if json_mode:
@@ -149,7 +148,8 @@ def impact(ctx, name):
             return
 
         weighted_impact = sum(ppr.get(d, 0) for d in dependents)
-        verdict, reach_pct = _impact_verdict(dependents, affected_files, len(G))
+        total_syms = conn.execute("SELECT COUNT(*) FROM symbols").fetchone()[0]
+        verdict, reach_pct = _impact_verdict(dependents, affected_files, total_syms)
 
         if json_mode:
             # Look up global PageRank for dependent symbols
@@ -13,25 +13,51 @@ from roam.output.formatter import json_envelope, to_json
 @click.option("--force", is_flag=True, help="Force full reindex")
 @click.option("--verbose", is_flag=True, help="Show detailed warnings during indexing")
 @click.option("--quiet", "-q", is_flag=True, help="Suppress progress output")
+@click.option(
+    "--changed",
+    "changed",
+    multiple=True,
+    metavar="PATH",
+    help="Reindex only these paths (repeatable); derived metrics are deferred to the next full `roam index`",
+)
+@click.option(
+    "--in-place",
+    is_flag=True,
+    help="Write straight into the live index instead of building a shadow copy and swapping it in",
+)
 @click.pass_context
-def index(ctx, force, verbose, quiet):
+def index(ctx, force, verbose, quiet, changed, in_place):
     """Build or rebuild the codebase index."""
     json_mode = ctx.obj.get("json") if ctx.obj else False
     include_excluded = ctx.obj.get("include_excluded") if ctx.obj else False
     from roam.db.connection import db_exists, open_db
+    from roam.db.shadow import current_generation
     from roam.index.indexer import Indexer
 
     # Suppress progress in JSON mode (consumers don't want progress text)
     suppress_progress = quiet or json_mode
 
+    if changed and force:
+        raise click.UsageError("--changed cannot be combined with --force")
+
     t0 = time.monotonic()
     indexer = Indexer()
-    indexer.run(
-        force=force,
-        verbose=verbose,
-        include_excluded=include_excluded,
-        quiet=suppress_progress,
-    )
+    if changed:
+        indexer.run_paths(
+            changed,
+            verbose=verbose,
+            include_excluded=include_excluded,
+            quiet=suppress_progress,
+        )
+    else:
+        indexer.run(
+            force=force,
+            verbose=verbose,
+            include_excluded=include_excluded,
+            quiet=suppress_progress,
+            shadow=False if in_place else None,
+        )
+    deferred = (indexer.summary or {}).get("dirty_phases") or []
     elapsed = time.monotonic() - t0
 
     if not json_mode and not quiet:
@@ -81,6 +107,8 @@ def index(ctx, force, verbose, quiet):
                             languages={r["language"]: r["cnt"] for r in lang_rows[:8]},
                             avg_symbols_per_file=round(avg_sym, 1),
                             parse_coverage_pct=round(coverage, 0),
+                            deferred_phases=deferred,
+                            generation=current_generation(conn),
                         )
                     )
                 )
@@ -89,6 +117,12 @@ def index(ctx, force, verbose, quiet):
                 click.echo(f"  Files: {file_count}  Symbols: {sym_count}  Edges: {edge_count}")
                 click.echo(f"  Languages: {lang_str}")
                 click.echo(f"  Avg symbols/file: {avg_sym:.1f}  Parse coverage: {coverage:.0f}%")
+                if deferred:
+                    click.echo(f"  Deferred: {', '.join(deferred)} (run `roam index` to refresh)")
+
+            # Health and trend metrics are stale until deferred phases run
+            if deferred:
+                return
 
             # Auto-snapshot after every index for trend tracking
             try:
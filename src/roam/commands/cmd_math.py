@@ -6,8 +6,7 @@ from collections import defaultdict
 
 import click
 
-from roam.catalog.fixes import get_fix
-from roam.catalog.tasks import get_task, get_tip
+from roam.catalog.tasks import get_task
 from roam.commands.resolve import ensure_index
 from roam.db.connection import open_db
 from roam.output.formatter import abbrev_kind, json_envelope, to_json
@@ -44,48 +43,11 @@ def math_cmd(ctx, task_filter, confidence_filter, profile, limit):
     sarif_mode = ctx.obj.get("sarif") if ctx.obj else False
     ensure_index()
 
-    from roam.catalog.detectors import run_detectors
+    from roam.query import query_algo
 
     with open_db(readonly=True) as conn:
-        findings, detector_meta = run_detectors(
-            conn,
-            task_filter,
-            confidence_filter,
-            profile=profile,
-            return_meta=True,
-        )
-
-        # Build symbol_id -> language mapping for language-aware tips
-        sym_ids = [f["symbol_id"] for f in findings if f.get("symbol_id")]
-        lang_map: dict[int, str] = {}
-        if sym_ids:
-            from roam.db.connection import batched_in
-
-            rows = batched_in(
-                conn,
-                "SELECT s.id, f.language FROM symbols s JOIN files f ON s.file_id = f.id WHERE s.id IN ({ph})",
-                sym_ids,
-            )
-            for r in rows:
-                if r["language"]:
-                    lang_map[r["id"]] = r["language"]
-
-        # Enrich findings with language-aware tips
-        for f in findings:
-            lang = lang_map.get(f.get("symbol_id"), "")
-            f["language"] = lang
-            f["tip"] = get_tip(f["task_id"], f["suggested_way"], lang)
-            if not f.get("fix"):
-                f["fix"] = get_fix(f["task_id"], lang)
-
-        # Sort by impact score first, then confidence.
-        _conf_order = {"high": 0, "medium": 1, "low": 2}
-        findings.sort(
-            key=lambda f: (
-                -float(f.get("impact_score", 0.0) or 0.0),
-                _conf_order.get(f["confidence"], 9),
-            )
-        )
+        report = query_algo(conn, task=task_filter, confidence=confidence_filter, profile=profile)
+        findings = [f.to_dict() for f in report.findings]
 
         # Apply limit
         truncated = len(findings) > limit
@@ -120,7 +82,7 @@ def math_cmd(ctx, task_filter, confidence_filter, profile, limit):
 
             sarif = algo_to_sarif(
                 findings,
-                detector_meta.get("detector_metadata", {}),
+                report.detector_metadata,
             )
             click.echo(write_sarif(sarif))
             return
@@ -137,12 +99,13 @@ def math_cmd(ctx, task_filter, confidence_filter, profile, limit):
                             "by_category": dict((k, len(v)) for k, v in by_category.items()),
                             "by_confidence": dict(by_confidence),
                             "truncated": truncated,
-                            "detectors_executed": detector_meta.get("detectors_executed", 0),
-                            "detectors_failed": detector_meta.get("detectors_failed", 0),
-                            "failed_detectors": detector_meta.get("failed_detectors", []),
-                            "detector_metadata": detector_meta.get("detector_metadata", {}),
-                            "profile": detector_meta.get("profile", profile),
-                            "profile_filtered": detector_meta.get("profile_filtered", 0),
+                            "detectors_executed": report.detectors_executed,
+                            "detectors_failed": report.detectors_failed,
+                            "failed_detectors": report.failed_detectors,
+                            "detector_metadata": report.detector_metadata,
+                            "profile": report.profile,
+                            "profile_filtered": report.profile_filtered,
+                            "detector_timings_ms": report.detector_timings_ms,
                             "max_impact_score": max(
                                 [float(f.get("impact_score", 0.0) or 0.0) for f in findings],
                                 default=0.0,
@@ -157,12 +120,9 @@ def math_cmd(ctx, task_filter, confidence_filter, profile, limit):
         # --- Text output ---
         click.echo(f"VERDICT: {verdict}")
         click.echo("Ordering: highest impact first")
-        click.echo(
-            f"Profile: {detector_meta.get('profile', profile)} "
-            f"(filtered {detector_meta.get('profile_filtered', 0)} low-signal findings)"
-        )
-        if detector_meta.get("detectors_failed"):
-            click.echo(f"NOTE: {detector_meta['detectors_failed']} detector(s) failed (use --json for details).")
+        click.echo(f"Profile: {report.profile} (filtered {report.profile_filtered} low-signal findings)")
+        if report.detectors_failed:
+            click.echo(f"NOTE: {report.detectors_failed} detector(s) failed (use --json for details).")
         if not findings:
             return
 
@@ -35,6 +35,7 @@ import click
 
 from roam.commands.resolve import ensure_index
 from roam.db.connection import find_project_root, open_db
+from roam.db.source_store import SourceStore
 from roam.output.formatter import json_envelope, loc, to_json
 
 # ---------------------------------------------------------------------------
@@ -200,21 +201,26 @@ def _class_to_table(class_name: str) -> str:
 # ---------------------------------------------------------------------------
 
 
-def _parse_migration_indexes(root, migration_paths: list[str]) -> dict[str, set[tuple[str, ...]]]:
+def _parse_migration_indexes(
+    root, migration_paths: list[str], sources: SourceStore | None = None
+) -> dict[str, set[tuple[str, ...]]]:
     """Read migration files and build table -> set-of-indexed-column-tuples.
 
+    Files are read from *sources* (indexed snapshots) when given, else
+    from the working tree under *root*.
+
     Each entry in the returned set is a tuple of column names that share an
     index, e.g.:
       ('id',)                       -- single-column index
       ('user_id', 'created_at')     -- composite index
     """
     table_indexes: dict[str, set[tuple[str, ...]]] = defaultdict(set)
+    if sources is None:
+        sources = SourceStore(None, root)
 
     for rel_path in migration_paths:
-        abs_path = root / rel_path
-        try:
-            content = abs_path.read_text(encoding="utf-8", errors="replace")
-        except OSError:
+        content = sources.text(rel_path)
+        if content is None:
             continue
 
         # Find all Schema::create / Schema::table blocks and their table names
@@ -391,15 +397,15 @@ class _QueryPattern:
         self.kind = kind  # 'scope', 'service', 'controller', 'generic'
 
 
-def _parse_query_patterns(root, source_paths: list[str]) -> list[_QueryPattern]:
+def _parse_query_patterns(root, source_paths: list[str], sources: SourceStore | None = None) -> list[_QueryPattern]:
     """Read PHP source files and extract WHERE / ORDER BY patterns with context."""
     patterns: list[_QueryPattern] = []
+    if sources is None:
+        sources = SourceStore(None, root)
 
     for rel_path in source_paths:
-        abs_path = root / rel_path
-        try:
-            content = abs_path.read_text(encoding="utf-8", errors="replace")
-        except OSError:
+        content = sources.text(rel_path)
+        if content is None:
             continue
 
         # Determine file kind for confidence scoring
@@ -767,12 +773,13 @@ def missing_index_cmd(ctx, limit, confidence_filter, table_filter):
         ]
 
         # Step 2: Parse index definitions
-        table_indexes = _parse_migration_indexes(root, migration_paths)
+        sources = SourceStore(conn, root, cache_size=1)
+        table_indexes = _parse_migration_indexes(root, migration_paths, sources)
         total_indexes = sum(len(v) for v in table_indexes.values())
         total_tables = len(table_indexes)
 
         # Step 3: Parse query patterns
-        query_patterns = _parse_query_patterns(root, source_paths)
+        query_patterns = _parse_query_patterns(root, source_paths, sources)
 
         # Step 4: Cross-reference
         findings = _build_findings(query_patterns, table_indexes)
@@ -30,7 +30,8 @@ from collections import defaultdict
 import click
 
 from roam.commands.resolve import ensure_index
-from roam.db.connection import open_db
+from roam.db.connection import find_project_root, open_db
+from roam.db.source_store import SourceStore
 from roam.output.formatter import json_envelope, loc, to_json
 
 # ---------------------------------------------------------------------------
@@ -294,7 +295,7 @@ def _find_model_classes(conn):
     return model_classes
 
 
-def _find_appends_properties(conn, model_id, model_info):
+def _find_appends_properties(conn, model_id, model_info, sources=None):
     """Find $appends array entries for a Laravel model.
 
     Returns list of appended attribute names (e.g., ['full_name', 'is_admin']).
@@ -333,21 +334,12 @@ def _find_appends_properties(conn, model_id, model_info):
     line_start = appends_sym["line_start"]
     line_end = appends_sym["line_end"] or line_start + 20
 
-    # Resolve to absolute path from project root
-    from roam.db.connection import find_project_root
-
-    root = find_project_root()
-    abs_path = root / file_path if root else None
-
-    if abs_path and abs_path.is_file():
-        try:
-            with open(abs_path, encoding="utf-8", errors="replace") as fh:
-                lines = fh.readlines()
-            # Extract the appends array from source (line_start is 1-indexed)
-            snippet = "".join(lines[max(0, line_start - 1) : line_end])
-            return re.findall(r"['\"](\w+)['\"]", snippet)
-        except OSError:
-            pass
+    if sources is None:
+        sources = SourceStore(conn, find_project_root())
+    # Extract the appends array from source (line_start is 1-indexed)
+    snippet = sources.span(file_path, line_start, line_end)
+    if snippet is not None:
+        return re.findall(r"['\"](\w+)['\"]", snippet)
 
     return []
 
@@ -398,7 +390,7 @@ def _find_accessor_methods(conn, model_id, model_info, appended_names):
     return accessors
 
 
-def _trace_accessor_io(conn, accessor_id, accessor_info, model_methods):
+def _trace_accessor_io(conn, accessor_id, accessor_info, model_methods, sources=None):
     """Trace an accessor method to see if it triggers I/O.
 
     Uses two strategies:
@@ -466,102 +458,93 @@ def _trace_accessor_io(conn, accessor_id, accessor_info, model_methods):
         line_start = accessor_info.get("line_start", 0)
         line_end = accessor_info.get("line_end") or line_start + 30
 
-        from roam.db.connection import find_project_root
-
-        root = find_project_root()
-        abs_path = root / file_path if root else None
+        if sources is None:
+            sources = SourceStore(conn, find_project_root())
+        snippet = sources.span(file_path, line_start, line_end)
 
-        if abs_path and abs_path.is_file():
-            try:
-                with open(abs_path, encoding="utf-8", errors="replace") as fh:
-                    lines = fh.readlines()
-                snippet = "".join(lines[max(0, line_start - 1) : line_end])
-
-                # Pattern: $this->someRelation (property access that triggers lazy load)
-                # Matches: $this->branch, $this->lines, $this->attachments()
-                this_accesses = re.findall(
-                    r"\$this->(\w+?)(?:\s*->|\s*\?->|(?:\(\))\s*->|\s*;|\s*\))",
-                    snippet,
-                )
+        if snippet is not None:
+            # Pattern: $this->someRelation (property access that triggers lazy load)
+            # Matches: $this->branch, $this->lines, $this->attachments()
+            this_accesses = re.findall(
+                r"\$this->(\w+?)(?:\s*->|\s*\?->|(?:\(\))\s*->|\s*;|\s*\))",
+                snippet,
+            )
 
-                # Also catch: $this->relation()->method() pattern
-                this_method_calls = re.findall(
-                    r"\$this->(\w+)\(\)",
-                    snippet,
-                )
+            # Also catch: $this->relation()->method() pattern
+            this_method_calls = re.findall(
+                r"\$this->(\w+)\(\)",
+                snippet,
+            )
 
-                # Helper calls to skip (not relationships)
-                _SKIP_METHODS = {
-                    "relationLoaded",
-                    "getAttribute",
-                    "setAttribute",
-                    "getKey",
-                    "toArray",
-                    "toJson",
-                }
+            # Helper calls to skip (not relationships)
+            _SKIP_METHODS = {
+                "relationLoaded",
+                "getAttribute",
+                "setAttribute",
+                "getKey",
+                "toArray",
+                "toJson",
+            }
 
-                # Check which accessed names are relationship methods on the model
-                # by verifying the method body contains a relationship definition
-                for accessed in set(this_accesses + this_method_calls):
-                    if accessed in _SKIP_METHODS:
-                        continue
-                    if accessed not in model_method_names:
-                        continue
-
-                    # Verify this method is actually a relationship (not just a helper)
-                    # by reading its source and checking for relationship calls
-                    method_sym = None
-                    for m in model_methods:
-                        if m["name"] == accessed:
-                            method_sym = m
-                            break
-                    if not method_sym:
-                        continue
-
-                    # Read the method source to check for relationship definitions
-                    m_sym_full = conn.execute(
-                        "SELECT s.line_start, s.line_end FROM symbols s WHERE s.id = ?",
-                        (method_sym["id"],),
-                    ).fetchone()
-                    if m_sym_full:
-                        m_start = max(0, m_sym_full["line_start"] - 1)
-                        m_end = m_sym_full["line_end"] or m_start + 15
-                        method_snippet = "".join(lines[m_start:m_end])
-                        # Check if method body contains relationship calls
-                        _REL_CALLS = (
-                            "hasMany",
-                            "hasOne",
-                            "belongsTo",
-                            "belongsToMany",
-                            "morphMany",
-                            "morphOne",
-                            "morphTo",
-                            "morphToMany",
-                            "hasManyThrough",
-                            "hasOneThrough",
+            # Check which accessed names are relationship methods on the model
+            # by verifying the method body contains a relationship definition
+            for accessed in set(this_accesses + this_method_calls):
+                if accessed in _SKIP_METHODS:
+                    continue
+                if accessed not in model_method_names:
+                    continue
+
+                # Verify this method is actually a relationship (not just a helper)
+                # by reading its source and checking for relationship calls
+                method_sym = None
+                for m in model_methods:
+                    if m["name"] == accessed:
+                        method_sym = m
+                        break
+                if not method_sym:
+                    continue
+
+                # Read the method source to check for relationship definitions
+                m_sym_full = conn.execute(
+                    "SELECT s.line_start, s.line_end FROM symbols s WHERE s.id = ?",
+                    (method_sym["id"],),
+                ).fetchone()
+                if m_sym_full:
+                    m_start = max(0, m_sym_full["line_start"] - 1)
+                    m_end = m_sym_full["line_end"] or m_start + 15
+                    method_snippet = sources.span(file_path, m_start + 1, m_end) or ""
+                    # Check if method body contains relationship calls
+                    _REL_CALLS = (
+                        "hasMany",
+                        "hasOne",
+                        "belongsTo",
+                        "belongsToMany",
+                        "morphMany",
+                        "morphOne",
+                        "morphTo",
+                        "morphToMany",
+                        "hasManyThrough",
+                        "hasOneThrough",
+                    )
+                    if any(rc in method_snippet for rc in _REL_CALLS):
+                        io_chains.append((accessed, "lazy-load relationship"))
+                    # Also check if it calls query builder methods
+                    elif any(
+                        qb in method_snippet
+                        for qb in (
+                            "->first()",
+                            "->get()",
+                            "->exists()",
+                            "->count()",
+                            "->pluck()",
                         )
-                        if any(rc in method_snippet for rc in _REL_CALLS):
-                            io_chains.append((accessed, "lazy-load relationship"))
-                        # Also check if it calls query builder methods
-                        elif any(
-                            qb in method_snippet
-                            for qb in (
-                                "->first()",
-                                "->get()",
-                                "->exists()",
-                                "->count()",
-                                "->pluck()",
-                            )
-                        ):
-                            io_chains.append((accessed, "query builder"))
-
-            except OSError:
-                pass
+                    ):
+                        io_chains.append((accessed, "query builder"))
 
     return io_chains
 
 
-def _find_eager_loads(conn, model_name):
+def _find_eager_loads(conn, model_name, sources=None):
     """Find eager loading configuration for a model.
 
     Checks:
@@ -575,10 +558,8 @@ def _find_eager_loads(conn, model_name):
     Returns set of relationship names that are eager loaded.
     """
     eager_loaded = set()
-
-    from roam.db.connection import find_project_root
-
-    root = find_project_root()
+    if sources is None:
+        sources = SourceStore(conn, find_project_root())
 
     # --- 1. Check $with property on the model ---
     with_sym = conn.execute(
@@ -592,19 +573,13 @@ def _find_eager_loads(conn, model_name):
     if with_sym:
         if with_sym["default_value"]:
             eager_loaded.update(re.findall(r"['\"](\w+)['\"]", with_sym["default_value"]))
-        elif root:
+        else:
             # Read from source
-            abs_path = root / with_sym["file_path"]
-            if abs_path.is_file():
-                try:
-                    with open(abs_path, encoding="utf-8", errors="replace") as fh:
-                        lines = fh.readlines()
-                    start = max(0, with_sym["line_start"] - 1)
-                    end = with_sym["line_end"] or start + 10
-                    snippet = "".join(lines[start:end])
-                    eager_loaded.update(re.findall(r"['\"](\w+)['\"]", snippet))
-                except OSError:
-                    pass
+            start = max(0, with_sym["line_start"] - 1)
+            end = with_sym["line_end"] or start + 10
+            snippet = sources.span(with_sym["file_path"], start + 1, end)
+            if snippet is not None:
+                eager_loaded.update(re.findall(r"['\"](\w+)['\"]", snippet))
 
     # --- 2. Check resource config files for eagerLoad ---
     config_files = conn.execute(
@@ -616,29 +591,23 @@ def _find_eager_loads(conn, model_name):
     model_lower = model_name.lower()
 
     for cf in config_files:
-        if not root:
-            continue
-        abs_path = root / cf["path"]
-        if not abs_path.is_file():
+        content = sources.text(cf["path"])
+        if content is None:
             continue
-        try:
-            content = abs_path.read_text(encoding="utf-8", errors="replace")
-            # Find eagerLoad([...]) calls and extract relationship names
-            # Pattern: ->eagerLoad(['rel1', 'rel2', ...])
-            for match in re.finditer(
-                r"->eagerLoad\(\s*\[(.*?)\]\s*\)",
-                content,
-                re.DOTALL,
-            ):
-                # Check if this eagerLoad is near the model reference
-                # Look backwards from match for the model class name
-                start = max(0, match.start() - 500)
-                context = content[start : match.end()]
-                if model_name in context or f"{model_name}::class" in context or model_lower in context.lower():
-                    rels = re.findall(r"['\"](\w+)['\"]", match.group(1))
-                    eager_loaded.update(rels)
-        except OSError:
-            pass
+        # Find eagerLoad([...]) calls and extract relationship names
+        # Pattern: ->eagerLoad(['rel1', 'rel2', ...])
+        for match in re.finditer(
+            r"->eagerLoad\(\s*\[(.*?)\]\s*\)",
+            content,
+            re.DOTALL,
+        ):
+            # Check if this eagerLoad is near the model reference
+            # Look backwards from match for the model class name
+            start = max(0, match.start() - 500)
+            context = content[start : match.end()]
+            if model_name in context or f"{model_name}::class" in context or model_lower in context.lower():
+                rels = re.findall(r"['\"](\w+)['\"]", match.group(1))
+                eager_loaded.update(rels)
 
     # --- 3. Check controller with() calls ---
     # Look for Model::with(['rel']) or ->with(['rel']) near model references
@@ -647,25 +616,17 @@ def _find_eager_loads(conn, model_name):
     ).fetchall()
 
     for cf in controller_files:
-        if not root:
+        content = sources.text(cf["path"])
+        if content is None or model_name not in content:
             continue
-        abs_path = root / cf["path"]
-        if not abs_path.is_file():
-            continue
-        try:
-            content = abs_path.read_text(encoding="utf-8", errors="replace")
-            if model_name not in content:
-                continue
-            # Find ::with(['rel1', 'rel2']) near model name
-            for match in re.finditer(
-                rf"{model_name}::with\(\s*\[(.*?)\]\s*\)",
-                content,
-                re.DOTALL,
-            ):
-                rels = re.findall(r"['\"](\w+)['\"]", match.group(1))
-                eager_loaded.update(rels)
-        except OSError:
-            pass
+        # Find ::with(['rel1', 'rel2']) near model name
+        for match in re.finditer(
+            rf"{model_name}::with\(\s*\[(.*?)\]\s*\)",
+            content,
+            re.DOTALL,
+        ):
+            rels = re.findall(r"['\"](\w+)['\"]", match.group(1))
+            eager_loaded.update(rels)
 
     return eager_loaded
 
@@ -732,6 +693,8 @@ def analyze_n1(conn, confidence_filter=None):
     """
     framework = _detect_framework(conn)
     findings = []
+    # Controllers and config files are rescanned once per model; keep them decoded.
+    sources = SourceStore(conn, find_project_root(), cache_size=512)
 
     models = _find_model_classes(conn)
     if not models:
@@ -763,7 +726,7 @@ def analyze_n1(conn, confidence_filter=None):
             ).fetchall()
 
         # Step 1: Find $appends / virtual properties
-        appended = _find_appends_properties(conn, model_id, model_info)
+        appended = _find_appends_properties(conn, model_id, model_info, sources)
         if not appended:
             continue
 
@@ -773,14 +736,14 @@ def analyze_n1(conn, confidence_filter=None):
             continue
 
         # Step 3: Find what's already eager loaded
-        eager_loaded = _find_eager_loads(conn, model_name)
+        eager_loaded = _find_eager_loads(conn, model_name, sources)
 
         # Step 4: Find collection contexts
         collection_ctxs = _find_collection_contexts(conn, model_id, model_name)
 
         # Step 5: For each accessor, trace I/O chains
         for accessor_info, attr_name in accessors:
-            io_chains = _trace_accessor_io(conn, accessor_info["id"], accessor_info, model_methods)
+            io_chains = _trace_accessor_io(conn, accessor_info["id"], accessor_info, model_methods, sources)
 
             if not io_chains:
                 continue
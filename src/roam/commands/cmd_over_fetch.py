@@ -40,6 +40,7 @@ import click
 
 from roam.commands.resolve import ensure_index
 from roam.db.connection import find_project_root, open_db
+from roam.db.source_store import SourceStore
 from roam.output.formatter import json_envelope, loc, to_json
 
 # ---------------------------------------------------------------------------
@@ -156,17 +157,15 @@ def _find_api_resource_for_model(conn, model_name: str) -> str | None:
     return None
 
 
-def _count_resource_fields(root, resource_path: str) -> int | None:
+def _count_resource_fields(sources: SourceStore, resource_path: str) -> int | None:
     """Count fields exposed in a Laravel API Resource's ``toArray()`` method.
 
     Parses the ``return [...]`` array inside ``toArray()`` and counts
     ``'key' =>`` patterns.  Returns the field count, or ``None`` if the
     method cannot be parsed (e.g. dynamic or delegated responses).
     """
-    abs_path = root / resource_path
-    try:
-        source = abs_path.read_text(encoding="utf-8", errors="replace")
-    except OSError:
+    source = sources.text(resource_path)
+    if source is None:
         return None
 
     m = re.search(r"function\s+toArray\s*\(", source)
@@ -199,7 +198,7 @@ def _count_resource_fields(root, resource_path: str) -> int | None:
 def _check_controller_direct_returns(
     conn,
     model_name: str,
-    root,
+    sources: SourceStore,
 ) -> list[dict]:
     """Check controller files for direct model returns (without API Resources).
 
@@ -225,19 +224,15 @@ def _check_controller_direct_returns(
             and "/controllers/" not in p_lower
         ):
             continue
-        abs_path = root / row["path"]
-        if not abs_path.is_file():
-            continue
-        try:
-            content = abs_path.read_text(encoding="utf-8", errors="replace")
-        except OSError:
+        content = sources.text(row["path"])
+        if content is None:
             continue
 
         # Only check controllers that reference this model
         if model_name not in content:
             continue
 
-        lines = content.splitlines()
+        lines = sources.lines(row["path"])
         for line_no, line in enumerate(lines, start=1):
             # Skip if the line uses a Resource (safe pattern)
             if any(p.search(line) for p in _RESOURCE_PATTERNS):
@@ -261,7 +256,7 @@ def _check_controller_direct_returns(
 def _check_missing_select(
     conn,
     model_name: str,
-    root,
+    sources: SourceStore,
 ) -> list[dict]:
     """Check controller/service files for queries without select().
 
@@ -288,18 +283,14 @@ def _check_missing_select(
     for row in files:
         if _is_test_path(row["path"]):
             continue
-        abs_path = root / row["path"]
-        if not abs_path.is_file():
-            continue
-        try:
-            content = abs_path.read_text(encoding="utf-8", errors="replace")
-        except OSError:
+        content = sources.text(row["path"])
+        if content is None:
             continue
 
         if model_name not in content:
             continue
 
-        lines = content.splitlines()
+        lines = sources.lines(row["path"])
         for line_no, line in enumerate(lines, start=1):
             if not model_query_re.search(line):
                 continue
@@ -350,7 +341,8 @@ def analyze_over_fetch(conn, threshold: int, limit: int) -> list[dict]:
 
     Returns list of finding dicts sorted by severity (high → medium → low).
     """
-    root = find_project_root()
+    # Controllers are rescanned once per model; keep them decoded.
+    sources = SourceStore(conn, find_project_root(), cache_size=512)
     findings = []
 
     model_files = _find_model_files(conn)
@@ -359,14 +351,8 @@ def analyze_over_fetch(conn, threshold: int, limit: int) -> list[dict]:
         if _is_test_path(model_info["path"]):
             continue
 
-        abs_path = root / model_info["path"]
-        if not abs_path.is_file():
-            continue
-
-        source = ""
-        try:
-            source = abs_path.read_text(encoding="utf-8", errors="replace")
-        except OSError:
+        source = sources.text(model_info["path"])
+        if source is None:
             continue
 
         # Extract $fillable fields
@@ -393,7 +379,7 @@ def analyze_over_fetch(conn, threshold: int, limit: int) -> list[dict]:
         # has, the output is well-filtered and the finding can be skipped.
         resource_field_count = None
         if has_resource and resource_path:
-            resource_field_count = _count_resource_fields(root, resource_path)
+            resource_field_count = _count_resource_fields(sources, resource_path)
             if resource_field_count is not None and resource_field_count < fillable_count * 0.5:
                 continue  # Resource properly filters output
 
@@ -453,14 +439,14 @@ def analyze_over_fetch(conn, threshold: int, limit: int) -> list[dict]:
 
         # Only do file I/O for medium+ threshold findings to stay fast
         if confidence in ("high", "medium"):
-            direct_returns = _check_controller_direct_returns(conn, model_info["class_name"], root)
+            direct_returns = _check_controller_direct_returns(conn, model_info["class_name"], sources)
             # Upgrade to high if direct returns found and we were medium
             if direct_returns and confidence == "medium":
                 confidence = "high"
                 reasons.append(f"Model returned directly from controller ({len(direct_returns)} location(s))")
 
         if confidence == "low":
-            missing_selects = _check_missing_select(conn, model_info["class_name"], root)
+            missing_selects = _check_missing_select(conn, model_info["class_name"], sources)
             if not missing_selects:
                 # No bad query patterns — downgrade / skip low-confidence
                 continue
@@ -114,20 +114,27 @@ def _severity_tag(sev: str) -> str:
 
 
 def _check_blast_radius(conn, sym_ids, file_paths):
-    """Compute blast radius: affected symbols and files via reverse edges."""
+    """Compute blast radius: affected symbols and files via reverse edges.
+
+    Affected files are listed most-exposed first, by the personalized
+    PageRank mass (seeded at the changed symbols) of their dependents.
+    """
     try:
         import networkx as nx
 
-        from roam.graph.builder import build_symbol_graph
+        from roam.graph.builder import load_neighbourhood
     except ImportError:
         return {
             "affected_symbols": 0,
             "affected_files": 0,
             "affected_file_list": [],
+            "weighted_impact": 0.0,
             "severity": "LOW",
         }
 
-    G = build_symbol_graph(conn)
+    from roam.graph.ppr import graph_adjacency, personalized_pagerank
+
+    G = load_neighbourhood(conn, sym_ids, direction="in")
     RG = G.reverse()
 
     all_affected_syms = set()
@@ -143,12 +150,21 @@ def _check_blast_radius(conn, sym_ids, file_paths):
                 if fp and fp not in file_paths:
                     all_affected_files.add(fp)
 
+    seeds = [sid for sid in sym_ids if sid in RG]
+    ppr = personalized_pagerank(graph_adjacency(RG), seeds) if all_affected_syms else {}
+    file_mass: dict[str, float] = {}
+    for d in all_affected_syms:
+        fp = G.nodes[d].get("file_path")
+        if fp in all_affected_files:
+            file_mass[fp] = file_mass.get(fp, 0.0) + ppr.get(d, 0.0)
+
     severity = _blast_severity(len(all_affected_syms), len(all_affected_files))
 
     return {
         "affected_symbols": len(all_affected_syms),
         "affected_files": len(all_affected_files),
-        "affected_file_list": sorted(all_affected_files)[:20],
+        "affected_file_list": sorted(all_affected_files, key=lambda f: (-file_mass.get(f, 0.0), f))[:20],
+        "weighted_impact": round(sum(ppr.get(d, 0.0) for d in all_affected_syms), 4),
         "severity": severity,
     }
 
@@ -614,6 +630,7 @@ def preflight(ctx, target, staged):
                             "affected_symbols": blast["affected_symbols"],
                             "affected_files": blast["affected_files"],
                             "affected_file_list": blast["affected_file_list"],
+                            "weighted_impact": blast["weighted_impact"],
                             "severity": blast["severity"],
                         },
                         tests={
@@ -31,7 +31,7 @@ match:
   to:
     file_glob: "**/db/**"
     kind: [function, method]
-  max_distance: 1
+  max_distance: 1   # >1 also flags transitive paths (e.g. via a helper)
 
 exempt:
   symbols: [health_check]
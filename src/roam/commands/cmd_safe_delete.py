@@ -40,7 +40,7 @@ def safe_delete(ctx, name):
 
         # --- Direct references ---
         callers = conn.execute(
-            "SELECT s.name, s.kind, f.path as file_path, e.kind as edge_kind "
+            "SELECT s.id, s.name, s.kind, f.path as file_path, e.kind as edge_kind "
             "FROM edges e JOIN symbols s ON e.source_id = s.id "
             "JOIN files f ON s.file_id = f.id "
             "WHERE e.target_id = ?",
@@ -53,11 +53,13 @@ def safe_delete(ctx, name):
         # --- Transitive impact ---
         import networkx as nx
 
-        from roam.graph.builder import build_symbol_graph
+        from roam.graph.builder import load_neighbourhood
+        from roam.graph.ppr import graph_adjacency, personalized_pagerank
 
-        G = build_symbol_graph(conn)
+        G = load_neighbourhood(conn, [sym_id], direction="in")
         dependent_count = 0
         affected_files = set()
+        ppr: dict[int, float] = {}
         if sym_id in G:
             RG = G.reverse()
             dependents = nx.descendants(RG, sym_id)
@@ -67,6 +69,11 @@ def safe_delete(ctx, name):
                 fp = node.get("file_path")
                 if fp:
                     affected_files.add(fp)
+            if dependents:
+                ppr = personalized_pagerank(graph_adjacency(RG), [sym_id])
+        weighted_impact = round(sum(v for k, v in ppr.items() if k != sym_id), 4)
+        # Most-exposed callers first (personalized PageRank from the symbol)
+        non_test_callers.sort(key=lambda c: -ppr.get(c["id"], 0.0))
 
         # --- File-level import check ---
         file_imported = False
@@ -173,6 +180,7 @@ def safe_delete(ctx, name):
                         reason=reason,
                         direct_callers=len(non_test_callers),
                         transitive_dependents=dependent_count,
+                        weighted_impact=weighted_impact,
                         affected_files=len(affected_files),
                         test_callers=len(test_callers),
                         test_note=test_note,
@@ -8,7 +8,7 @@ from pathlib import Path
 import click
 
 from roam.commands.resolve import ensure_index
-from roam.db.connection import find_project_root
+from roam.db.connection import find_project_root, open_db
 from roam.output.formatter import abbrev_kind, json_envelope, loc, to_json
 
 # ---------------------------------------------------------------------------
@@ -63,19 +63,13 @@ def _parse_source_bytes(source: bytes, language: str):
 
     Returns (tree, source_bytes, effective_language) or (None, None, None).
     """
+    from roam.index.parse_session import current_session
     from roam.index.parser import GRAMMAR_ALIASES
 
     grammar = GRAMMAR_ALIASES.get(language, language)
 
     try:
-        from tree_sitter_language_pack import get_parser
-
-        parser = get_parser(grammar)
-    except Exception:
-        return None, None, None
-
-    try:
-        tree = parser.parse(source)
+        tree = current_session().parse(source, grammar)
     except Exception:
         return None, None, None
 
@@ -102,7 +96,11 @@ def _extract_symbols_from_source(source: bytes, file_path: str) -> list[dict]:
     if tree is None:
         return []
 
-    return extract_symbols(tree, src, file_path, extractor)
+    from roam.index.fingerprints import assign_fingerprints
+
+    symbols = extract_symbols(tree, src, file_path, extractor)
+    assign_fingerprints(symbols, src, language)
+    return symbols
 
 
 def _extract_references_from_source(source: bytes, file_path: str) -> list[dict]:
@@ -245,6 +243,10 @@ def _compare_symbols(
     for k in sorted(old_keys & new_keys):
         old_sym = old_by_key[k]
         new_sym = new_by_key[k]
+        if old_sym.get("body_hash") and old_sym.get("sig_hash") == new_sym.get("sig_hash"):
+            # Only whitespace or comments changed
+            if old_sym["body_hash"] == new_sym.get("body_hash"):
+                continue
         changes = {}
 
         # Check signature change
@@ -271,6 +273,11 @@ def _compare_symbols(
                 "new": new_lines,
             }
 
+        old_body = old_sym.get("body_hash")
+        new_body = new_sym.get("body_hash")
+        if not changes and old_body and new_body and old_body != new_body:
+            changes["body_changed"] = True
+
         if changes:
             modified.append(
                 {
@@ -294,20 +301,19 @@ def _compare_imports(
 
     Returns (imports_added, imports_removed) where each is a list of dicts.
     """
+    from roam.index.fingerprints import import_keys
 
-    def import_set(refs: list[dict]) -> set[str]:
-        result = set()
-        for r in refs:
-            if r.get("kind") in ("import", "import_from"):
-                target = r.get("target_name", "")
-                imp_path = r.get("import_path", "")
-                if target:
-                    key = f"{imp_path}:{target}" if imp_path else target
-                    result.add(key)
-        return result
+    return _compare_import_keys(file_path, import_keys(old_refs), import_keys(new_refs))
 
-    old_imports = import_set(old_refs)
-    new_imports = import_set(new_refs)
+
+def _compare_import_keys(
+    file_path: str,
+    old_keys: list[str],
+    new_keys: list[str],
+) -> tuple[list[dict], list[dict]]:
+    """Compare two versions' ``import_path:target`` keys for a single file."""
+    old_imports = set(old_keys)
+    new_imports = set(new_keys)
 
     added = []
     for imp in sorted(new_imports - old_imports):
@@ -344,6 +350,25 @@ def _read_current_file(root: Path, file_path: str) -> bytes | None:
         return None
 
 
+def _indexed_versions(conn, root: Path, blobs: dict[str, str] | None, file_path: str):
+    """Old (at the base ref) and current ``(symbols, import_keys)`` of
+    *file_path* from the index's fingerprints, or None when either version
+    has not been indexed and the file must be re-parsed.
+    """
+    from roam.index.fingerprints import current_blob, load_version
+
+    if blobs is None:
+        return None
+    cur = current_blob(conn, root, file_path)
+    if cur is None:
+        return None
+    new = load_version(conn, file_path, cur)
+    old = load_version(conn, file_path, blobs.get(file_path)) if new is not None else None
+    if old is None:
+        return None
+    return old, new
+
+
 # ---------------------------------------------------------------------------
 # CLI command
 # ---------------------------------------------------------------------------
@@ -395,7 +420,8 @@ def semantic_diff(ctx, base_ref):
             click.echo(f"No changed files vs {base_ref}.")
         return
 
-    # 2. For each changed file, parse old and new versions and compare
+    # 2. For each changed file, compare old and new versions: from index
+    # fingerprints when both were indexed, else by parsing them
     all_added: list[dict] = []
     all_removed: list[dict] = []
     all_modified: list[dict] = []
@@ -403,36 +429,50 @@ def semantic_diff(ctx, base_ref):
     all_imports_removed: list[dict] = []
     files_analyzed = 0
 
-    for fpath in changed:
-        # Get old version from the ref
-        old_source = _git_show(root, base_ref, fpath)
-
-        # Get current version from disk
-        new_source = _read_current_file(root, fpath)
-
-        # Extract symbols from both versions
-        old_symbols = _extract_symbols_from_source(old_source, fpath) if old_source else []
-        new_symbols = _extract_symbols_from_source(new_source, fpath) if new_source else []
+    from roam.index.fingerprints import diff_fingerprints, ref_blobs
+
+    blobs = ref_blobs(root, base_ref)
+    with open_db(readonly=True) as conn:
+        for fpath in changed:
+            versions = _indexed_versions(conn, root, blobs, fpath)
+            if versions is not None:
+                # Both versions indexed: join fingerprints, no parsing
+                (old_symbols, old_imports), (new_symbols, new_imports) = versions
+                if not old_symbols and not new_symbols:
+                    continue
+                files_analyzed += 1
+                rows = diff_fingerprints(old_symbols, new_symbols)
+                added, removed, modified = _compare_symbols(
+                    fpath,
+                    [r["old"] for r in rows if r["old"]],
+                    [r["new"] for r in rows if r["new"]],
+                )
+                imp_added, imp_removed = _compare_import_keys(fpath, old_imports, new_imports)
+            else:
+                # Get old version from the ref and current version from disk
+                old_source = _git_show(root, base_ref, fpath)
+                new_source = _read_current_file(root, fpath)
 
-        # Extract references from both versions
-        old_refs = _extract_references_from_source(old_source, fpath) if old_source else []
-        new_refs = _extract_references_from_source(new_source, fpath) if new_source else []
+                # Extract symbols from both versions
+                old_symbols = _extract_symbols_from_source(old_source, fpath) if old_source else []
+                new_symbols = _extract_symbols_from_source(new_source, fpath) if new_source else []
 
-        if not old_symbols and not new_symbols:
-            continue
+                # Extract references from both versions
+                old_refs = _extract_references_from_source(old_source, fpath) if old_source else []
+                new_refs = _extract_references_from_source(new_source, fpath) if new_source else []
 
-        files_analyzed += 1
+                if not old_symbols and not new_symbols:
+                    continue
 
-        # Compare symbols
-        added, removed, modified = _compare_symbols(fpath, old_symbols, new_symbols)
-        all_added.extend(added)
-        all_removed.extend(removed)
-        all_modified.extend(modified)
+                files_analyzed += 1
+                added, removed, modified = _compare_symbols(fpath, old_symbols, new_symbols)
+                imp_added, imp_removed = _compare_imports(fpath, old_refs, new_refs)
 
-        # Compare imports
-        imp_added, imp_removed = _compare_imports(fpath, old_refs, new_refs)
-        all_imports_added.extend(imp_added)
-        all_imports_removed.extend(imp_removed)
+            all_added.extend(added)
+            all_removed.extend(removed)
+            all_modified.extend(modified)
+            all_imports_added.extend(imp_added)
+            all_imports_removed.extend(imp_removed)
 
     # Sort for stable output
     all_added.sort(key=lambda s: (s["file"], s.get("line") or 0))
@@ -514,6 +554,8 @@ def semantic_diff(ctx, base_ref):
             if "body_lines" in changes:
                 b = changes["body_lines"]
                 click.echo(f"    body: {b['old']} -> {b['new']} lines")
+            elif changes.get("body_changed"):
+                click.echo("    body: changed")
         click.echo()
 
     if all_imports_added or all_imports_removed:
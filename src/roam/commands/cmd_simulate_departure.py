@@ -8,7 +8,6 @@ cluster-level impact to produce a comprehensive knowledge-loss risk report.
 
 from __future__ import annotations
 
-import fnmatch
 import math
 import time
 from collections import defaultdict
@@ -90,91 +89,23 @@ def compute_file_ownership(conn, file_ids: list[int], now: int | None = None):
 
 
 def parse_codeowners(project_root: Path) -> list[tuple[str, list[str]]]:
-    """Parse a CODEOWNERS file and return (pattern, [owners]) pairs.
-
-    Searches for CODEOWNERS in standard locations:
-    - CODEOWNERS
-    - .github/CODEOWNERS
-    - docs/CODEOWNERS
+    """Parse the project's CODEOWNERS file into (pattern, [owners]) pairs.
 
+    Uses the standard locations of :func:`roam.index.codeowners.find_codeowners`.
     Returns patterns in order (last match wins, as per GitHub convention).
     """
-    candidates = [
-        project_root / "CODEOWNERS",
-        project_root / ".github" / "CODEOWNERS",
-        project_root / "docs" / "CODEOWNERS",
-    ]
-    codeowners_path = None
-    for c in candidates:
-        if c.exists():
-            codeowners_path = c
-            break
-
-    if codeowners_path is None:
-        return []
-
-    rules: list[tuple[str, list[str]]] = []
-    try:
-        text = codeowners_path.read_text(encoding="utf-8", errors="replace")
-    except OSError:
-        return []
-
-    for line in text.splitlines():
-        line = line.strip()
-        if not line or line.startswith("#"):
-            continue
-        parts = line.split()
-        if len(parts) < 2:
-            continue
-        pattern = parts[0]
-        owners = parts[1:]
-        rules.append((pattern, owners))
+    from roam.index.codeowners import find_codeowners
+    from roam.index.codeowners import parse_codeowners as _parse
 
-    return rules
+    codeowners_path = find_codeowners(project_root)
+    return _parse(codeowners_path) if codeowners_path is not None else []
 
 
 def resolve_codeowner(file_path: str, rules: list[tuple[str, list[str]]]) -> list[str]:
-    """Resolve CODEOWNERS for a file path.  Last matching rule wins.
+    """Resolve CODEOWNERS for a file path.  Last matching rule wins."""
+    from roam.index.codeowners import resolve_owners
 
-    CODEOWNERS pattern semantics:
-    - ``*.py``        -- matches any .py file anywhere
-    - ``docs/``       -- matches anything under docs/
-    - ``/src/core/``  -- matches anything under src/core/ (anchored to root)
-    - ``src/app.py``  -- matches src/app.py exactly (or anywhere if no /)
-    """
-    matched_owners: list[str] = []
-    normalised = file_path.replace("\\", "/")
-
-    for pattern, owners in rules:
-        raw = pattern
-
-        # Strip leading / (anchors to repo root — but paths are already relative)
-        if raw.startswith("/"):
-            raw = raw[1:]
-
-        # Directory pattern: "dir/" matches "dir/**"
-        if raw.endswith("/"):
-            if normalised.startswith(raw) or ("/" + raw) in ("/" + normalised):
-                matched_owners = owners
-                continue
-
-        # Use fnmatch for glob patterns (*, ?)
-        if fnmatch.fnmatch(normalised, raw):
-            matched_owners = owners
-            continue
-
-        # If pattern has no directory separator, match against basename too
-        if "/" not in raw:
-            basename = normalised.rsplit("/", 1)[-1]
-            if fnmatch.fnmatch(basename, raw):
-                matched_owners = owners
-                continue
-
-        # Also try matching with any prefix for non-anchored patterns
-        if fnmatch.fnmatch(normalised, "*/" + raw):
-            matched_owners = owners
-
-    return matched_owners
+    return resolve_owners(rules, file_path)
 
 
 def _normalise_identity(name: str) -> str:
@@ -258,8 +189,10 @@ def _analyse_departure(conn, project_root, developers: list[str]):
     # 2. Compute ownership for all files
     ownership = compute_file_ownership(conn, file_ids, now=now)
 
-    # 3. CODEOWNERS integration
-    codeowners_rules = parse_codeowners(project_root)
+    # 3. CODEOWNERS integration (file -> owners materialised by the indexer)
+    from roam.index.codeowners import load_file_owners
+
+    owners_by_id = load_file_owners(conn, project_root)
 
     # 4. Find files where departing devs have significant ownership
     critical_files = []  # sole CODEOWNER + >50%
@@ -280,7 +213,7 @@ def _analyse_departure(conn, project_root, developers: list[str]):
             continue
 
         # Check CODEOWNERS
-        codeowners = resolve_codeowner(path, codeowners_rules)
+        codeowners = owners_by_id.get(fid, [])
         is_sole_codeowner = False
         if codeowners:
             # Check if departing dev is the sole codeowner
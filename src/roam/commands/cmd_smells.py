@@ -15,9 +15,6 @@ from roam.output.formatter import (
     to_json,
 )
 
-_SEVERITY_ORDER = {"critical": 0, "warning": 1, "info": 2}
-_VALID_SEVERITIES = frozenset(_SEVERITY_ORDER)
-
 
 @click.command()
 @click.option(
@@ -41,21 +38,11 @@ def smells(ctx, file_path, min_severity):
     detail = ctx.obj.get("detail", False) if ctx.obj else False
     ensure_index()
 
-    from roam.catalog.smells import run_all_detectors
+    from roam.query import query_smells
 
     with open_db(readonly=True) as conn:
-        findings = run_all_detectors(conn)
-
-        # Filter by file
-        if file_path:
-            norm = file_path.replace("\\", "/")
-            findings = [f for f in findings if norm in f.get("location", "").replace("\\", "/")]
-
-        # Filter by minimum severity
-        if min_severity:
-            min_sev = min_severity.lower()
-            max_order = _SEVERITY_ORDER.get(min_sev, 2)
-            findings = [f for f in findings if _SEVERITY_ORDER.get(f.get("severity", "info"), 2) <= max_order]
+        report = query_smells(conn, file_path=file_path, min_severity=min_severity)
+        findings = [s.to_dict() for s in report.smells]
 
         # Compute summary stats
         total_smells = len(findings)
@@ -99,20 +86,10 @@ def smells(ctx, file_path, min_severity):
                     "severity": dict(severity_counts),
                     "smell_types": dict(smell_types),
                     "files_affected": files_affected,
+                    "detectors_failed": report.detectors_failed,
+                    "detector_timings_ms": report.detector_timings_ms,
                 },
-                smells=[
-                    {
-                        "smell_id": f["smell_id"],
-                        "severity": f["severity"],
-                        "symbol_name": f["symbol_name"],
-                        "kind": f["kind"],
-                        "location": f["location"],
-                        "metric_value": f["metric_value"],
-                        "threshold": f["threshold"],
-                        "description": f["description"],
-                    }
-                    for f in findings
-                ],
+                smells=findings,
             )
             if not detail:
                 envelope = summary_envelope(envelope)
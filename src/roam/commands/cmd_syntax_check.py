@@ -16,6 +16,7 @@ from pathlib import Path
 
 import click
 
+from roam.index.parse_session import current_session
 from roam.index.parser import (
     GRAMMAR_ALIASES,
     REGEX_ONLY_LANGUAGES,
@@ -121,14 +122,7 @@ def _parse_file_for_syntax(file_path: str) -> dict | None:
     grammar = GRAMMAR_ALIASES.get(language, language)
 
     try:
-        from tree_sitter_language_pack import get_parser
-
-        parser = get_parser(grammar)
-    except Exception:
-        return None
-
-    try:
-        tree = parser.parse(source)
+        tree = current_session().parse(source, grammar, path=file_path)
     except Exception:
         return None
 
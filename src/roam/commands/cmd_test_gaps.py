@@ -80,6 +80,12 @@ def _find_test_coverage(conn, symbol_ids):
     if not symbol_ids:
         return {}
 
+    from roam.graph.test_reach import load_test_files
+
+    stored = load_test_files(conn, symbol_ids, _MAX_HOPS)
+    if stored is not None:
+        return stored
+
     reachable = _bfs_to_test_files(conn, symbol_ids)
 
     # Collect all reachable symbol IDs (excluding the starting set)
@@ -39,7 +39,7 @@ def _detect_hubs(path_ids, G, threshold=50):
     """
     hubs = []
     for node_id in path_ids[1:-1]:  # Skip source and target
-        degree = G.in_degree(node_id) + G.out_degree(node_id)
+        degree = G.degree(node_id)
         if degree > threshold:
             hubs.append((node_id, degree))
     return hubs
@@ -101,9 +101,7 @@ def _build_hops(path_ids, annotated, G):
         if i > 0:
             prev_id = path_ids[i - 1]
             curr_id = path_ids[i]
-            edge_kind = G.edges.get((prev_id, curr_id), {}).get("kind", "")
-            if not edge_kind:
-                edge_kind = G.edges.get((curr_id, prev_id), {}).get("kind", "")
+            edge_kind = G.edge_kind(prev_id, curr_id) or G.edge_kind(curr_id, prev_id)
             hop["edge_kind"] = edge_kind
         hops.append(hop)
     return hops
@@ -113,14 +111,19 @@ def _build_hops(path_ids, annotated, G):
 @click.argument("source")
 @click.argument("target")
 @click.option("-k", "k_paths", default=3, help="Number of alternative paths to find")
+@click.option(
+    "--cutoff",
+    type=float,
+    default=None,
+    help="Skip paths costlier than this (call edge = 1, import = 1.1, other = 2)",
+)
 @click.pass_context
-def trace(ctx, source, target, k_paths):
+def trace(ctx, source, target, k_paths, cutoff):
     """Show shortest path between two symbols."""
     json_mode = ctx.obj.get("json") if ctx.obj else False
     ensure_index()
 
-    from roam.graph.builder import build_symbol_graph
-    from roam.graph.pathfinding import find_k_paths, find_symbol_id, format_path
+    from roam.graph.pathfinding import PathGraph, find_k_paths, find_symbol_id, format_path
 
     with open_db(readonly=True) as conn:
         src_ids = find_symbol_id(conn, source)
@@ -133,7 +136,7 @@ def trace(ctx, source, target, k_paths):
             click.echo(symbol_not_found_hint(target))
             raise SystemExit(1)
 
-        G = build_symbol_graph(conn)
+        G = PathGraph.from_db(conn)
 
         # Pre-check: direct file-level imports beat graph pathfinding.
         _file_ids = {}
@@ -159,7 +162,7 @@ def trace(ctx, source, target, k_paths):
                     if fe:
                         all_paths.append([sid, tid])
 
-                paths = find_k_paths(G, sid, tid, k=k_paths)
+                paths = find_k_paths(G, sid, tid, k=k_paths, cutoff=cutoff)
                 for p in paths:
                     all_paths.append(p)
 
@@ -88,9 +88,9 @@ def _analyze_trends(chrono, sensitivity="medium"):
     """
     from roam.graph.anomaly import (
         forecast,
-        mann_kendall_test,
+        mann_kendall_tests,
         modified_z_score,
-        theil_sen_slope,
+        theil_sen_slopes,
         western_electric_rules,
     )
 
@@ -102,8 +102,13 @@ def _analyze_trends(chrono, sensitivity="medium"):
     forecasts = []
     patterns = []
 
+    series = {metric: [s.get(metric) or 0 for s in chrono] for metric in all_metrics}
+    # Score every metric's trend in one batch call per statistic
+    slopes = dict(zip(all_metrics, theil_sen_slopes(series.values())))
+    significance = dict(zip(all_metrics, mann_kendall_tests(series.values())))
+
     for metric in all_metrics:
-        values = [s.get(metric) or 0 for s in chrono]
+        values = series[metric]
         if len(values) < 4:
             continue
 
@@ -122,7 +127,7 @@ def _analyze_trends(chrono, sensitivity="medium"):
                 )
 
         # Trend estimation
-        ts = theil_sen_slope(values)
+        ts = slopes[metric]
         if ts:
             entry = {
                 "metric": metric,
@@ -131,7 +136,7 @@ def _analyze_trends(chrono, sensitivity="medium"):
             }
             # Add significance if enough data
             if len(values) >= 8:
-                mk = mann_kendall_test(values)
+                mk = significance[metric]
                 if mk:
                     entry["p_value"] = round(mk["p_value"], 4)
                     entry["significant"] = mk["significant"]
@@ -142,7 +147,7 @@ def _analyze_trends(chrono, sensitivity="medium"):
                 # Forecast when metric doubles from current
                 current = values[-1]
                 target = max(current * 2, current + 10)
-                fc = forecast(values, target=target)
+                fc = forecast(values, target=target, trend=ts)
                 if fc and fc.get("steps_until"):
                     forecasts.append(
                         {
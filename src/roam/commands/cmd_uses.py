@@ -81,6 +81,7 @@ def uses(ctx, name, full):
             "implements": "Implemented by",
             "uses_trait": "Used by (trait)",
             "template": "Used in template",
+            "x-lang": "Linked across languages",
         }
 
         if json_mode:
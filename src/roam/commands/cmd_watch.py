@@ -88,18 +88,46 @@ def discover_current_files(project_root: Path) -> list[str]:
         return []
 
 
-def run_incremental_index(project_root: Path, quiet: bool, force: bool = False) -> None:
+def make_live_indexer(project_root: Path, measure_full: bool = False):
+    """Indexer that keeps syntax trees between runs for incremental reparsing."""
+    from roam.index.indexer import Indexer
+    from roam.index.tree_cache import TreeCache
+
+    return Indexer(project_root=project_root, tree_cache=TreeCache(measure_full=measure_full))
+
+
+def run_incremental_index(
+    project_root: Path,
+    quiet: bool,
+    force: bool = False,
+    paths: list[str] | None = None,
+    indexer=None,
+) -> None:
     """Trigger an index refresh.
 
     Args:
         project_root: repository root.
         quiet: suppress index progress output.
         force: run a full rebuild when True.
+        paths: when given (and not forcing), reindex only these paths and
+            defer derived phases to :func:`refresh_derived_phases`.
+        indexer: reuse a long-lived indexer (see :func:`make_live_indexer`).
     """
     from roam.index.indexer import Indexer
 
-    indexer = Indexer(project_root=project_root)
-    indexer.run(force=force, quiet=quiet)
+    if indexer is None:
+        indexer = Indexer(project_root=project_root)
+    if paths and not force:
+        indexer.run_paths(paths, quiet=quiet)
+    else:
+        indexer.run(force=force, quiet=quiet)
+
+
+def refresh_derived_phases(project_root: Path, quiet: bool) -> None:
+    """Recompute derived phases left dirty by a targeted reindex."""
+    from roam.index.indexer import Indexer
+
+    Indexer(project_root=project_root).refresh_derived(quiet=quiet)
 
 
 def _guardian_drift_summary(
@@ -109,8 +137,8 @@ def _guardian_drift_summary(
     max_files: int = 250,
 ) -> dict:
     """Return compact ownership-drift summary for architecture guardian mode."""
-    from roam.commands.cmd_codeowners import find_codeowners, parse_codeowners, resolve_owners
     from roam.commands.cmd_drift import compute_drift_score, compute_file_ownership
+    from roam.index.codeowners import CodeownersMatcher, find_codeowners, parse_codeowners
 
     co_path = find_codeowners(project_root)
     if co_path is None:
@@ -122,7 +150,7 @@ def _guardian_drift_summary(
             "threshold": threshold,
         }
 
-    rules = parse_codeowners(co_path)
+    matcher = CodeownersMatcher(parse_codeowners(co_path))
     file_rows = conn.execute(
         """
         SELECT f.id, f.path
@@ -147,7 +175,7 @@ def _guardian_drift_summary(
     drift = 0
     for row in file_rows:
         path = str(row["path"]).replace("\\", "/")
-        owners = resolve_owners(rules, path)
+        owners = matcher.owners(path)
         if not owners:
             continue
         owned += 1
@@ -465,10 +493,13 @@ def poll_loop(
     guardian_report: str = "",
     guardian_health_gate: float = 70.0,
     guardian_drift_threshold: float = 0.5,
+    parse_stats: bool = False,
     *,
     _sleep=time.sleep,
     _discover=None,
     _reindex=None,
+    _reindex_paths=None,
+    _refresh_derived=None,
     _external_events=None,
     _guardian_collect=None,
     _guardian_write=None,
@@ -489,9 +520,17 @@ def poll_loop(
                       Health-score gate threshold tracked in guardian payload.
         guardian_drift_threshold:
                       Drift threshold used in guardian ownership summary.
+        parse_stats:  Time a full reparse next to every incremental one and
+                      print both after each targeted re-index.
         _sleep:       Injectable sleep function (for testing).
         _discover:    Injectable file-discovery callable (for testing).
         _reindex:     Injectable re-index callable (for testing).
+        _reindex_paths:
+                      Injectable targeted re-index callable taking the
+                      changed paths (for testing).
+        _refresh_derived:
+                      Injectable callable refreshing deferred derived phases
+                      (for testing).
         _external_events:
                       Injectable callable returning queued webhook events.
         _guardian_collect:
@@ -501,8 +540,15 @@ def poll_loop(
     """
     if _discover is None:
         _discover = lambda: discover_current_files(project_root)
+    live = None
     if _reindex is None:
-        _reindex = lambda force=False: run_incremental_index(project_root, quiet=True, force=force)
+        # One indexer for the whole session so syntax trees survive between saves
+        live = make_live_indexer(project_root, measure_full=parse_stats)
+        _reindex = lambda force=False: run_incremental_index(project_root, quiet=True, force=force, indexer=live)
+        if _reindex_paths is None:
+            _reindex_paths = lambda paths: run_incremental_index(project_root, quiet=True, paths=paths, indexer=live)
+    if _refresh_derived is None:
+        _refresh_derived = lambda: refresh_derived_phases(project_root, quiet=True)
     if _external_events is None:
         _external_events = lambda: []
     if _guardian_collect is None:
@@ -526,6 +572,7 @@ def poll_loop(
     click.echo(f"Watching {file_count} files... (interval={interval}s, debounce={debounce}s, mode={mode})")
     click.echo("Press Ctrl+C to stop.")
     pending_force = False
+    derived_dirty = False
 
     while True:
         _sleep(interval)
@@ -572,7 +619,27 @@ def poll_loop(
             if not quiet:
                 mode_label = "force re-indexing" if pending_force else "re-indexing"
                 click.echo(f"Changed: {len(batch)} event(s) -- {mode_label}...")
-            _reindex(force=pending_force)
+            file_batch = [p for p in batch if not p.startswith("<webhook:")]
+            if _reindex_paths is not None and not pending_force and len(file_batch) == len(batch):
+                # Only the changed files: metrics, clusters and search follow once idle
+                _reindex_paths(file_batch)
+                derived_dirty = True
+                cache_stats = ((live.summary or {}).get("parse_cache") if live is not None else None) or {}
+                if parse_stats and cache_stats.get("incremental_parses"):
+                    click.echo(
+                        "Parse (session): {} incremental in {} ms vs {} ms as full reparses; "
+                        "{} full in {} ms; {} symbol metrics reused last run".format(
+                            cache_stats["incremental_parses"],
+                            cache_stats["incremental_ms"],
+                            cache_stats.get("full_equivalent_ms", "n/a"),
+                            cache_stats["full_parses"],
+                            cache_stats["full_ms"],
+                            cache_stats.get("metrics_reused", 0),
+                        )
+                    )
+            else:
+                _reindex(force=pending_force)
+                derived_dirty = False
             pending_force = False
             # Refresh tracked state from DB after re-index
             tracked = load_tracked_files(project_root)
@@ -584,6 +651,10 @@ def poll_loop(
             file_count = new_count
 
             if guardian or guardian_report:
+                if derived_dirty:
+                    # Guardian reads health and cluster data, so it cannot wait
+                    _refresh_derived()
+                    derived_dirty = False
                 try:
                     guard_payload = _guardian_collect()
                     if guardian_report:
@@ -601,6 +672,10 @@ def poll_loop(
                 except Exception as exc:
                     if not quiet:
                         click.echo(f"Guardian update failed: {exc}")
+        elif derived_dirty and not acc.has_pending():
+            # Idle poll after a targeted reindex: catch up on derived phases
+            _refresh_derived()
+            derived_dirty = False
 
 
 @click.command("watch")
@@ -684,6 +759,11 @@ def poll_loop(
     type=float,
     help="Ownership drift threshold used in guardian summaries.",
 )
+@click.option(
+    "--parse-stats",
+    is_flag=True,
+    help="Compare incremental and full reparse time after each re-index (parses changed files twice).",
+)
 @click.pass_context
 def watch(
     ctx,
@@ -700,6 +780,7 @@ def watch(
     guardian_report,
     guardian_health_gate,
     guardian_drift_threshold,
+    parse_stats,
 ):
     """Watch for file changes and auto-re-index incrementally.
 
@@ -750,6 +831,7 @@ def watch(
             guardian_report=guardian_report,
             guardian_health_gate=guardian_health_gate,
             guardian_drift_threshold=guardian_drift_threshold,
+            parse_stats=parse_stats,
             _external_events=(bridge.drain_events if bridge else None),
         )
     except KeyboardInterrupt:
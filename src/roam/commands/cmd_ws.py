@@ -262,6 +262,7 @@ def ws_resolve(ctx):
     ws_root, config = _require_workspace()
 
     from roam.workspace.api_scanner import (
+        ScanCache,
         build_cross_repo_edges,
         match_api_endpoints,
         scan_backend_routes,
@@ -279,6 +280,7 @@ def ws_resolve(ctx):
     with open_workspace_db(ws_root) as ws_conn:
         # Clear existing edges before re-resolve
         clear_cross_edges(ws_conn)
+        scan_cache = ScanCache(ws_conn)
 
         # Ensure repos are registered
         repo_id_map = {}
@@ -318,7 +320,7 @@ def ws_resolve(ctx):
             if not json_mode:
                 click.echo(f"Scanning {fe_name} for API calls...", nl=False)
 
-            fe_calls = scan_frontend_api_calls(fe_info["db_path"], fe_info["path"])
+            fe_calls = scan_frontend_api_calls(fe_info["db_path"], fe_info["path"], scan_cache)
             total_fe_calls += len(fe_calls)
             if not json_mode:
                 click.echo(f" {len(fe_calls)} found")
@@ -326,7 +328,7 @@ def ws_resolve(ctx):
             if not json_mode:
                 click.echo(f"Scanning {be_name} for routes...", nl=False)
 
-            be_routes = scan_backend_routes(be_info["db_path"], be_info["path"])
+            be_routes = scan_backend_routes(be_info["db_path"], be_info["path"], scan_cache)
             total_be_routes += len(be_routes)
             if not json_mode:
                 click.echo(f" {len(be_routes)} found")
@@ -346,6 +348,8 @@ def ws_resolve(ctx):
 
             all_matches.extend(matched)
 
+        scan_cache.prune()
+
     if json_mode:
         match_pct = round(100 * total_matched / total_fe_calls) if total_fe_calls else 0
         click.echo(
@@ -357,6 +361,7 @@ def ws_resolve(ctx):
                         "backend_routes": total_be_routes,
                         "matched": total_matched,
                         "match_pct": match_pct,
+                        "files_from_cache": scan_cache.hits,
                         "verdict": (f"{total_matched}/{total_fe_calls} frontend calls matched ({match_pct}%)"),
                     },
                     matches=[
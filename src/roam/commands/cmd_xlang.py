@@ -22,90 +22,27 @@ def xlang(ctx):
     ensure_index()
 
     with open_db(readonly=True) as conn:
-        # Get all indexed file paths
-        rows = conn.execute("SELECT path FROM files").fetchall()
-        file_paths = [r["path"] for r in rows]
+        from roam.bridges.resolver import resolve_bridges
 
-        if not file_paths:
-            if json_mode:
-                click.echo(
-                    to_json(
-                        json_envelope(
-                            "x-lang",
-                            summary={"bridges": 0, "links": 0},
-                            bridges=[],
-                        )
-                    )
-                )
-            else:
-                click.echo("No files indexed.")
-            return
-
-        # Detect active bridges
-        from roam.bridges.registry import detect_bridges
+        has_files = conn.execute("SELECT 1 FROM files LIMIT 1").fetchone() is not None
+        bridge_summaries, all_links = resolve_bridges(conn)
+        persisted = conn.execute("SELECT COUNT(*) FROM edges WHERE bridge IS NOT NULL").fetchone()[0]
 
-        active = detect_bridges(file_paths)
-
-        if not active:
+        if not bridge_summaries:
             if json_mode:
                 click.echo(
                     to_json(
                         json_envelope(
                             "x-lang",
-                            summary={"bridges": 0, "links": 0},
+                            summary={"bridges": 0, "links": 0, "persisted_edges": persisted},
                             bridges=[],
                         )
                     )
                 )
             else:
-                click.echo("No cross-language bridges detected.")
+                click.echo("No cross-language bridges detected." if has_files else "No files indexed.")
             return
 
-        # For each bridge, resolve cross-language edges
-        all_links = []
-        bridge_summaries = []
-
-        for bridge in active:
-            # Find source files for this bridge
-            source_files = [p for p in file_paths if any(p.endswith(ext) for ext in bridge.source_extensions)]
-            # Find target files for this bridge
-            target_files_paths = [p for p in file_paths if any(p.endswith(ext) for ext in bridge.target_extensions)]
-
-            if not source_files or not target_files_paths:
-                continue
-
-            # Get symbols for source and target files
-            links_for_bridge = []
-            for src_path in source_files:
-                src_syms = _get_file_symbols(conn, src_path)
-                if not src_syms:
-                    continue
-
-                # Build target_files dict
-                target_files = {}
-                for tp in target_files_paths:
-                    tgt_syms = _get_file_symbols(conn, tp)
-                    if tgt_syms:
-                        target_files[tp] = tgt_syms
-
-                if not target_files:
-                    continue
-
-                edges = bridge.resolve(src_path, src_syms, target_files)
-                links_for_bridge.extend(edges)
-
-            all_links.extend(links_for_bridge)
-            bridge_summaries.append(
-                {
-                    "name": bridge.name,
-                    "source_files": len(source_files),
-                    "target_files": len(target_files_paths),
-                    "links": len(links_for_bridge),
-                    "source_extensions": sorted(bridge.source_extensions),
-                    "target_extensions": sorted(bridge.target_extensions),
-                }
-            )
-
         if json_mode:
             click.echo(
                 to_json(
@@ -114,6 +51,7 @@ def xlang(ctx):
                         summary={
                             "bridges": len(bridge_summaries),
                             "links": len(all_links),
+                            "persisted_edges": persisted,
                         },
                         bridges=bridge_summaries,
                         links=all_links[:200],
@@ -157,14 +95,4 @@ def xlang(ctx):
             if len(all_links) > shown:
                 click.echo(f"\n  (+{len(all_links) - shown} more)")
 
-
-def _get_file_symbols(conn, path):
-    """Get symbols for a file path from the DB."""
-    frow = conn.execute("SELECT id FROM files WHERE path = ?", (path,)).fetchone()
-    if not frow:
-        return []
-    syms = conn.execute(
-        "SELECT name, qualified_name, kind FROM symbols WHERE file_id = ?",
-        (frow["id"],),
-    ).fetchall()
-    return [{"name": s["name"], "qualified_name": s["qualified_name"], "kind": s["kind"]} for s in syms]
+        click.echo(f"\n{persisted} cross-language edges stored in the index")
@@ -303,6 +303,7 @@ def _get_propagation_scores_for_paths(conn, sym_ids, use_propagation, max_depth=
     # Build a lightweight networkx-free graph using adjacency dicts
     # to avoid importing networkx (it is a heavy dependency only loaded on demand).
     # We implement a small BFS directly rather than constructing a DiGraph.
+    from roam.graph.neighbourhood import walk_neighbourhood
 
     seed_set = set(sym_ids)
 
@@ -310,8 +311,10 @@ def _get_propagation_scores_for_paths(conn, sym_ids, use_propagation, max_depth=
     forward: dict = {}  # caller -> {callee, ...}
     backward: dict = {}  # callee -> {caller, ...}
 
-    for batch_ids in _batch_list(list(seed_set), 400):
-        _load_neighborhood_edges(conn, batch_ids, forward, backward, max_depth)
+    _hops, edges, _truncated = walk_neighbourhood(conn, sorted(seed_set), depth=max_depth, direction="both")
+    for src, tgt, _kind in edges:
+        forward.setdefault(src, set()).add(tgt)
+        backward.setdefault(tgt, set()).add(src)
 
     # BFS callee direction (forward)
     callee_scores: dict[int, float] = {s: 1.0 for s in seed_set}
@@ -387,49 +390,6 @@ def _batch_list(lst, size):
         yield lst[i : i + size]
 
 
-def _load_neighborhood_edges(conn, seed_ids, forward, backward, max_depth):
-    """BFS-expand edges up to max_depth from seed_ids, populating forward/backward."""
-    frontier = set(seed_ids)
-    visited_nodes = set(seed_ids)
-    for _depth in range(max_depth):
-        if not frontier:
-            break
-        ph = ",".join("?" * len(frontier))
-        frontier_list = list(frontier)
-        # Forward edges (callees)
-        rows = conn.execute(
-            f"SELECT source_id, target_id FROM edges WHERE source_id IN ({ph})",
-            frontier_list,
-        ).fetchall()
-        next_frontier = set()
-        for row in rows:
-            try:
-                src, tgt = row["source_id"], row["target_id"]
-            except (KeyError, TypeError):
-                src, tgt = row[0], row[1]
-            forward.setdefault(src, set()).add(tgt)
-            backward.setdefault(tgt, set()).add(src)
-            if tgt not in visited_nodes:
-                next_frontier.add(tgt)
-                visited_nodes.add(tgt)
-        # Backward edges (callers)
-        rows = conn.execute(
-            f"SELECT source_id, target_id FROM edges WHERE target_id IN ({ph})",
-            frontier_list,
-        ).fetchall()
-        for row in rows:
-            try:
-                src, tgt = row["source_id"], row["target_id"]
-            except (KeyError, TypeError):
-                src, tgt = row[0], row[1]
-            forward.setdefault(src, set()).add(tgt)
-            backward.setdefault(tgt, set()).add(src)
-            if src not in visited_nodes:
-                next_frontier.add(src)
-                visited_nodes.add(src)
-        frontier = next_frontier
-
-
 # ---------------------------------------------------------------------------
 # Annotations
 # ---------------------------------------------------------------------------
@@ -580,7 +540,32 @@ def get_coupling(conn, file_path, limit=10):
 
 def get_affected_tests_bfs(conn, sym_id, max_hops=8):
     """BFS reverse-edge walk to find test symbols that transitively depend
-    on the target symbol."""
+    on the target symbol.
+
+    Reads the indexer's ``test_reach`` table when it is current; the walk
+    below is the fallback for older or stale indexes.
+    """
+    from roam.graph.test_reach import load_reaching_tests
+
+    stored = load_reaching_tests(conn, sym_id, max_hops)
+    if stored is not None:
+        tests = []
+        seen = set()
+        for name, file_path, hops, via in stored:
+            if (file_path, name) in seen:
+                continue
+            seen.add((file_path, name))
+            tests.append(
+                {
+                    "file": file_path,
+                    "symbol": name,
+                    "kind": "DIRECT" if hops == 1 else "TRANSITIVE",
+                    "hops": hops,
+                    "via": via if hops > 1 else None,
+                }
+            )
+        return tests
+
     visited = {sym_id: (0, None)}
     queue = deque([(sym_id, 0, None)])
 
@@ -643,20 +628,29 @@ def get_affected_tests_bfs(conn, sym_id, max_hops=8):
 
 
 def get_blast_radius(conn, sym_id):
-    """Compute downstream dependents count via BFS on reverse edges."""
+    """Compute downstream dependents via BFS on reverse edges.
+
+    ``weighted_impact`` is the personalized PageRank mass (seeded at the
+    symbol) that settles on its dependents: nearer and more tightly
+    coupled dependents weigh more.
+    """
+    from roam.graph.ppr import EdgeAdjacency, personalized_pagerank
+
+    callers = EdgeAdjacency(conn, "in")
     visited = {sym_id}
-    queue = deque([sym_id])
-    while queue:
-        current = queue.popleft()
-        callers = conn.execute("SELECT source_id FROM edges WHERE target_id = ?", (current,)).fetchall()
-        for row in callers:
-            cid = row["source_id"]
-            if cid not in visited:
-                visited.add(cid)
-                queue.append(cid)
+    frontier = [sym_id]
+    while frontier:
+        callers.prefetch(frontier)
+        nxt = []
+        for current in frontier:
+            for cid in callers(current):
+                if cid not in visited:
+                    visited.add(cid)
+                    nxt.append(cid)
+        frontier = nxt
 
     if len(visited) <= 1:
-        return {"dependent_symbols": 0, "dependent_files": 0}
+        return {"dependent_symbols": 0, "dependent_files": 0, "weighted_impact": 0.0}
 
     dep_ids = [sid for sid in visited if sid != sym_id]
     file_rows = batched_in(
@@ -664,10 +658,12 @@ def get_blast_radius(conn, sym_id):
         "SELECT DISTINCT f.path FROM symbols s JOIN files f ON s.file_id = f.id WHERE s.id IN ({ph})",
         dep_ids,
     )
+    ppr = personalized_pagerank(callers, [sym_id])
 
     return {
         "dependent_symbols": len(dep_ids),
         "dependent_files": len(file_rows),
+        "weighted_impact": round(sum(ppr.get(d, 0.0) for d in dep_ids), 4),
     }
 
 
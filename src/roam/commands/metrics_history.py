@@ -69,12 +69,91 @@ def _compute_health_score(
     return max(0, min(100, int(100 * math.exp(log_score))))
 
 
+# Metric keys, in snapshot column order.  REAL-valued keys are listed in
+# _FLOAT_METRICS; every other key is an integer count.
+METRIC_KEYS = (
+    "files",
+    "symbols",
+    "edges",
+    "cycles",
+    "god_components",
+    "bottlenecks",
+    "dead_exports",
+    "layer_violations",
+    "health_score",
+    "tangle_ratio",
+    "avg_complexity",
+    "brain_methods",
+)
+_FLOAT_METRICS = frozenset({"tangle_ratio", "avg_complexity"})
+
+
 def collect_metrics(conn):
-    """Query the DB for all health metrics and compute a health score.
+    """Return all health metrics plus a health score for the current index.
+
+    Reads the aggregates the indexer materialised at the end of its last
+    run (see :func:`store_snapshot_metrics`); indexes without them are
+    measured from scratch with :func:`compute_metrics`.
 
     Returns a dict with keys: files, symbols, edges, cycles,
     god_components, bottlenecks, dead_exports, layer_violations,
-    health_score (0-100, higher = healthier).
+    health_score (0-100, higher = healthier), tangle_ratio,
+    avg_complexity, brain_methods.
+    """
+    stored = load_snapshot_metrics(conn)
+    if stored is not None:
+        return stored
+    return compute_metrics(conn)
+
+
+def store_snapshot_metrics(conn, G=None):
+    """Compute the snapshot metrics and persist them in ``snapshot_metrics``.
+
+    Called by the indexer with the symbol graph it already built, so
+    snapshots and trend commands never rebuild the graph themselves.
+    Returns the stored metrics.
+    """
+    metrics = compute_metrics(conn, G)
+    conn.execute("DELETE FROM snapshot_metrics")
+    conn.executemany(
+        "INSERT INTO snapshot_metrics (metric, value) VALUES (?, ?)",
+        [(key, metrics[key]) for key in METRIC_KEYS],
+    )
+    return metrics
+
+
+def load_snapshot_metrics(conn):
+    """Stored snapshot metrics, or None when absent or stale.
+
+    The stored file, symbol and edge counts must match the live tables;
+    a mismatch means the index changed after the aggregates were written
+    (e.g. an interrupted run) and they are not trusted.  A targeted
+    reindex can keep the counts, so a dirty phase also means stale.
+    """
+    from roam.index.incremental import is_dirty
+
+    if is_dirty(conn, "snapshot_metrics"):
+        return None
+    try:
+        rows = conn.execute("SELECT metric, value FROM snapshot_metrics").fetchall()
+    except Exception:
+        return None
+    stored = {r[0]: r[1] for r in rows}
+    if any(stored.get(key) is None for key in METRIC_KEYS):
+        return None
+    live = conn.execute(
+        "SELECT (SELECT COUNT(*) FROM files), (SELECT COUNT(*) FROM symbols), (SELECT COUNT(*) FROM edges)"
+    ).fetchone()
+    if tuple(live) != (stored["files"], stored["symbols"], stored["edges"]):
+        return None
+    return {key: float(stored[key]) if key in _FLOAT_METRICS else int(stored[key]) for key in METRIC_KEYS}
+
+
+def compute_metrics(conn, G=None):
+    """Measure all snapshot metrics from the index tables.
+
+    *G* is the symbol graph when the caller already has one; otherwise it
+    is built here.
     """
     files = conn.execute("SELECT COUNT(*) FROM files").fetchone()[0]
     symbols = conn.execute("SELECT COUNT(*) FROM symbols").fetchone()[0]
@@ -82,16 +161,19 @@ def collect_metrics(conn):
     # Keep health math aligned with `roam health`.
     from roam.commands.cmd_health import _is_utility_path, _percentile
 
-    # Cycles
+    # Cycles (found once, reused for the health score and tangle ratio)
+    cycle_list = []
     try:
-        from roam.graph.builder import build_symbol_graph
         from roam.graph.cycles import find_cycles
 
-        G = build_symbol_graph(conn)
-        cycles = len(find_cycles(G))
+        if G is None:
+            from roam.graph.builder import build_symbol_graph
+
+            G = build_symbol_graph(conn)
+        cycle_list = find_cycles(G)
     except Exception:
-        cycles = 0
         G = None
+    cycles = len(cycle_list)
 
     # God components (same query + thresholds as cmd_health.py)
     degree_rows = conn.execute(TOP_BY_DEGREE, (50,)).fetchall()
@@ -147,23 +229,17 @@ def collect_metrics(conn):
         bn_items,
         bn_p90,
         layer_violations,
-        find_cycles,
+        lambda _G: cycle_list,
         _is_utility_path,
     )
 
     # Tangle ratio: percentage of symbols in cycles
     tangle_ratio = 0.0
     if G is not None and symbols > 0:
-        try:
-            from roam.graph.cycles import find_cycles as _find_cycles
-
-            cycle_list = _find_cycles(G)
-            cycle_sym_ids = set()
-            for scc in cycle_list:
-                cycle_sym_ids.update(scc)
-            tangle_ratio = round(len(cycle_sym_ids) / symbols * 100, 1)
-        except Exception:
-            pass
+        cycle_sym_ids = set()
+        for scc in cycle_list:
+            cycle_sym_ids.update(scc)
+        tangle_ratio = round(len(cycle_sym_ids) / symbols * 100, 1)
 
     # Average complexity from symbol_metrics
     avg_complexity = 0.0
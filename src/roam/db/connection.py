@@ -4,6 +4,7 @@ from __future__ import annotations
 
 import os
 import sqlite3
+import threading
 from contextlib import contextmanager
 from pathlib import Path
 
@@ -140,12 +141,32 @@ def get_connection(db_path: Path | None = None, readonly: bool = False) -> sqlit
     return conn
 
 
+# Indexes from earlier layouts that are prefixes of (or duplicates of) an
+# index in the current SCHEMA_SQL.  Dropping them shrinks existing DBs.
+_SUPERSEDED_INDEXES = (
+    "idx_edges_source",
+    "idx_edges_target",
+    "idx_edges_source_target",
+    "idx_symbols_file",
+    "idx_file_edges_source",
+    "idx_files_path",
+)
+
+# Rows ANALYZE samples per index; keeps the pass bounded on very large DBs
+_ANALYSIS_LIMIT = 1000
+
+
 def ensure_schema(conn: sqlite3.Connection):
     """Create tables if they don't exist, and apply migrations."""
     conn.executescript(SCHEMA_SQL)
 
     # Migrations for columns added after initial schema
     _safe_alter(conn, "symbols", "default_value", "TEXT")
+    _safe_alter(conn, "symbols", "stable_key", "TEXT")
+    _safe_alter(conn, "symbols", "content_hash", "TEXT")
+    _safe_alter(conn, "symbols", "sig_hash", "TEXT")
+    _safe_alter(conn, "symbols", "body_hash", "TEXT")
+    _safe_alter(conn, "files", "blob_sha", "TEXT")
     _safe_alter(conn, "file_stats", "health_score", "REAL")
     _safe_alter(conn, "file_stats", "cochange_entropy", "REAL")
     _safe_alter(conn, "file_stats", "cognitive_load", "REAL")
@@ -164,6 +185,7 @@ def ensure_schema(conn: sqlite3.Connection):
     _safe_alter(conn, "symbol_metrics", "coverage_pct", "REAL")
     _safe_alter(conn, "symbol_metrics", "covered_lines", "INTEGER")
     _safe_alter(conn, "symbol_metrics", "coverable_lines", "INTEGER")
+    _safe_alter(conn, "symbol_metrics", "entry_distance", "INTEGER")
     # v7.6: file role classification
     _safe_alter(conn, "files", "file_role", "TEXT DEFAULT 'source'")
     # v8.3: math_signals table — CREATE TABLE IF NOT EXISTS in SCHEMA_SQL handles it
@@ -182,6 +204,8 @@ def ensure_schema(conn: sqlite3.Connection):
     _safe_alter(conn, "edges", "confidence", "REAL")
     # v11: source file tracking for O(changed) incremental edge rebuild
     _safe_alter(conn, "edges", "source_file_id", "INTEGER REFERENCES files(id) ON DELETE CASCADE")
+    # Sorted hyperedge member arrays for single-pass surprise scoring
+    _safe_alter(conn, "git_hyperedges", "members", "TEXT")
     # v9.0+: runtime_stats, vulnerabilities, symbol_tfidf, metric_snapshots tables
     # are all defined in SCHEMA_SQL (CREATE TABLE IF NOT EXISTS) and created above
     # by conn.executescript(SCHEMA_SQL). No inline duplicates needed here.
@@ -194,12 +218,22 @@ def ensure_schema(conn: sqlite3.Connection):
     _safe_alter(conn, "graph_metrics", "eigenvector", "REAL DEFAULT 0")
     _safe_alter(conn, "graph_metrics", "clustering_coefficient", "REAL DEFAULT 0")
     _safe_alter(conn, "graph_metrics", "debt_score", "REAL DEFAULT 0")
+    if _safe_alter(conn, "graph_metrics", "scc_id", "INTEGER DEFAULT NULL"):
+        # Existing rows have no SCC ids until graph metrics are recomputed
+        from roam.index.incremental import mark_dirty
+
+        mark_dirty(conn, ["graph_metrics"])
 
     # v11: drop redundant idx_edges_kind (subsumed by idx_edges_kind_target)
     conn.execute("DROP INDEX IF EXISTS idx_edges_kind")
+    # v12: drop indexes superseded by the covering idx_edges_out/idx_edges_in
+    for name in _SUPERSEDED_INDEXES:
+        conn.execute(f"DROP INDEX IF EXISTS {name}")
     # TF-IDF semantic search table — recreate with ON DELETE CASCADE if missing
     # Drop and recreate to ensure proper FK constraint (data is recomputed on index)
     _ensure_tfidf_cascade(conn)
+    # test_reach is keyed by test file; recomputed on the next index
+    _ensure_test_reach_by_file(conn)
     # v11: FTS5 full-text search for symbols (BM25 ranking, all in C)
     _ensure_fts5_table(conn)
 
@@ -225,6 +259,15 @@ def _ensure_tfidf_cascade(conn: sqlite3.Connection):
     )
 
 
+def _ensure_test_reach_by_file(conn: sqlite3.Connection):
+    """Drop a ``test_reach`` table still keyed by (symbol, test)."""
+    row = conn.execute("SELECT sql FROM sqlite_master WHERE type='table' AND name='test_reach'").fetchone()
+    if row is None or "test_file_id)" in (row[0] or ""):
+        return
+    conn.execute("DROP TABLE test_reach")
+    conn.executescript(SCHEMA_SQL)
+
+
 def _ensure_fts5_table(conn: sqlite3.Connection):
     """Create the FTS5 full-text search virtual table if not present.
 
@@ -247,12 +290,30 @@ def _ensure_fts5_table(conn: sqlite3.Connection):
         pass  # FTS5 not available in this SQLite build
 
 
-def _safe_alter(conn: sqlite3.Connection, table: str, column: str, col_type: str):
-    """Add a column to a table if it doesn't exist."""
+def refresh_planner_stats(conn: sqlite3.Connection, full: bool = False) -> None:
+    """Keep ``sqlite_stat1`` current so the planner picks the covering indexes.
+
+    *full* runs a (sampled) ``ANALYZE`` over every table, which is what a
+    fresh or rebuilt index needs.  Otherwise ``PRAGMA optimize`` re-analyzes
+    only tables whose row counts drifted since the last run.
+    """
+    try:
+        conn.execute(f"PRAGMA analysis_limit={_ANALYSIS_LIMIT}")
+        if full:
+            conn.execute("ANALYZE")
+        else:
+            conn.execute("PRAGMA optimize")
+    except sqlite3.OperationalError:
+        pass  # read-only or locked DB: stale statistics are harmless
+
+
+def _safe_alter(conn: sqlite3.Connection, table: str, column: str, col_type: str) -> bool:
+    """Add a column to a table if it doesn't exist; True when it was added."""
     try:
         conn.execute(f"ALTER TABLE {table} ADD COLUMN {column} {col_type}")
     except sqlite3.OperationalError:
-        pass  # Column already exists
+        return False  # Column already exists
+    return True
 
 
 # ---------------------------------------------------------------------------
@@ -315,6 +376,49 @@ def batched_count(conn, sql, ids, *, pre=(), post=(), batch_size=_BATCH_SIZE):
     return total
 
 
+# ---------------------------------------------------------------------------
+# Per-thread read connections for long-lived worker threads (MCP server)
+# ---------------------------------------------------------------------------
+
+_worker = threading.local()
+
+
+def enable_worker_connections() -> None:
+    """Make ``open_db(readonly=True)`` on this thread reuse its connections.
+
+    Intended as a thread-pool initializer: each worker keeps one read-only
+    connection per DB path (with its warm page cache) instead of opening
+    and closing one per command.
+    """
+    _worker.conns = {}
+
+
+def _worker_connection(db_path: Path) -> sqlite3.Connection:
+    conns = _worker.conns
+    key = str(db_path)
+    try:
+        inode = os.stat(db_path).st_ino
+    except OSError:
+        inode = None
+    cached = conns.pop(key, None)
+    if cached is not None:
+        conn, cached_inode = cached
+        if cached_inode == inode:
+            try:
+                conn.execute("SELECT 1")
+                conn.row_factory = sqlite3.Row
+                conns[key] = cached
+                return conn
+            except sqlite3.ProgrammingError:
+                pass  # closed by the command that last used it
+        else:
+            # Index file was replaced (first shadow publish, reset, ...)
+            conn.close()
+    conn = get_connection(db_path, readonly=True)
+    conns[key] = (conn, inode)
+    return conn
+
+
 def db_exists(project_root: Path | None = None) -> bool:
     """Check if an index database exists."""
     path = get_db_path(project_root)
@@ -322,18 +426,23 @@ def db_exists(project_root: Path | None = None) -> bool:
 
 
 @contextmanager
-def open_db(readonly: bool = False, project_root: Path | None = None):
+def open_db(readonly: bool = False, project_root: Path | None = None, db_path: Path | None = None):
     """Context manager for database access. Creates schema if needed.
 
+    *db_path* overrides the project's index path (the indexer uses it to
+    build into a shadow DB).
+
     Raises a descriptive ``click.ClickException`` if the database file is
     missing or corrupted so that agents receive actionable remediation steps
     instead of a raw SQLite traceback.
     """
     import click
 
-    db_path = get_db_path(project_root)
+    if db_path is None:
+        db_path = get_db_path(project_root)
+    pooled = readonly and getattr(_worker, "conns", None) is not None
     try:
-        conn = get_connection(db_path, readonly=readonly)
+        conn = _worker_connection(db_path) if pooled else get_connection(db_path, readonly=readonly)
     except sqlite3.DatabaseError as exc:
         raise click.ClickException(
             f"Database error: {exc}\n"
@@ -356,4 +465,11 @@ def open_db(readonly: bool = False, project_root: Path | None = None):
         if not readonly:
             conn.commit()
     finally:
-        conn.close()
+        if not pooled:
+            conn.close()
+        else:
+            try:
+                if conn.in_transaction:
+                    conn.rollback()
+            except sqlite3.ProgrammingError:
+                pass  # closed by the caller; replaced on next checkout
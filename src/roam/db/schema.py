@@ -8,7 +8,19 @@ CREATE TABLE IF NOT EXISTS files (
     file_role TEXT DEFAULT 'source',
     hash TEXT,
     mtime REAL,
-    line_count INTEGER DEFAULT 0
+    line_count INTEGER DEFAULT 0,
+    blob_sha TEXT
+);
+
+-- Source snapshots: zlib-compressed file text keyed by content hash
+-- (files.hash), with little-endian uint32 line-start offsets.
+CREATE TABLE IF NOT EXISTS file_sources (
+    hash TEXT PRIMARY KEY,
+    codec TEXT NOT NULL DEFAULT 'zlib',
+    size INTEGER NOT NULL DEFAULT 0,
+    line_count INTEGER NOT NULL DEFAULT 0,
+    line_offsets BLOB NOT NULL,
+    data BLOB NOT NULL
 );
 
 CREATE TABLE IF NOT EXISTS symbols (
@@ -24,7 +36,11 @@ CREATE TABLE IF NOT EXISTS symbols (
     visibility TEXT DEFAULT 'public',
     is_exported INTEGER DEFAULT 1,
     parent_id INTEGER REFERENCES symbols(id) ON DELETE SET NULL,
-    default_value TEXT
+    default_value TEXT,
+    stable_key TEXT,
+    content_hash TEXT,
+    sig_hash TEXT,
+    body_hash TEXT
 );
 
 CREATE TABLE IF NOT EXISTS edges (
@@ -93,7 +109,8 @@ CREATE TABLE IF NOT EXISTS graph_metrics (
     closeness REAL DEFAULT 0,
     eigenvector REAL DEFAULT 0,
     clustering_coefficient REAL DEFAULT 0,
-    debt_score REAL DEFAULT 0
+    debt_score REAL DEFAULT 0,
+    scc_id INTEGER DEFAULT NULL
 );
 
 CREATE TABLE IF NOT EXISTS clusters (
@@ -102,24 +119,17 @@ CREATE TABLE IF NOT EXISTS clusters (
     cluster_label TEXT
 );
 
-CREATE INDEX IF NOT EXISTS idx_symbols_file ON symbols(file_id);
 CREATE INDEX IF NOT EXISTS idx_symbols_name ON symbols(name);
 CREATE INDEX IF NOT EXISTS idx_symbols_qualified ON symbols(qualified_name);
 CREATE INDEX IF NOT EXISTS idx_symbols_kind ON symbols(kind);
-CREATE INDEX IF NOT EXISTS idx_edges_source ON edges(source_id);
-CREATE INDEX IF NOT EXISTS idx_edges_target ON edges(target_id);
-CREATE INDEX IF NOT EXISTS idx_file_edges_source ON file_edges(source_file_id);
 CREATE INDEX IF NOT EXISTS idx_file_edges_target ON file_edges(target_file_id);
 CREATE INDEX IF NOT EXISTS idx_git_changes_file ON git_file_changes(file_id);
 CREATE INDEX IF NOT EXISTS idx_git_changes_commit ON git_file_changes(commit_id);
-CREATE INDEX IF NOT EXISTS idx_files_path ON files(path);
 CREATE INDEX IF NOT EXISTS idx_graph_metrics_pagerank ON graph_metrics(pagerank DESC);
 CREATE INDEX IF NOT EXISTS idx_symbols_parent ON symbols(parent_id);
-CREATE INDEX IF NOT EXISTS idx_edges_kind_target ON edges(kind, target_id);
 CREATE INDEX IF NOT EXISTS idx_file_stats_churn ON file_stats(total_churn DESC);
 
 -- v11: composite indexes for hot query paths
-CREATE INDEX IF NOT EXISTS idx_edges_source_target ON edges(source_id, target_id);
 CREATE INDEX IF NOT EXISTS idx_edges_source_file ON edges(source_file_id);
 CREATE INDEX IF NOT EXISTS idx_symbols_file_kind ON symbols(file_id, kind);
 CREATE INDEX IF NOT EXISTS idx_symbols_file_exported ON symbols(file_id, is_exported);
@@ -127,12 +137,22 @@ CREATE INDEX IF NOT EXISTS idx_file_edges_source_target ON file_edges(source_fil
 CREATE INDEX IF NOT EXISTS idx_files_language ON files(language);
 CREATE INDEX IF NOT EXISTS idx_clusters_cluster ON clusters(cluster_id);
 
+-- v12: one covering index per traversal direction.  Caller/callee walks
+-- and graph loads read (source_id, target_id, kind) straight from the
+-- index; the source/target indexes they replace were prefixes of these.
+-- Lookups by edge kind alone (import counts, per-kind edge loads) keep
+-- their own kind-leading index.
+CREATE INDEX IF NOT EXISTS idx_edges_out ON edges(source_id, target_id, kind);
+CREATE INDEX IF NOT EXISTS idx_edges_in ON edges(target_id, source_id, kind);
+CREATE INDEX IF NOT EXISTS idx_edges_kind_target ON edges(kind, target_id);
+
 -- Hypergraph: n-ary commit patterns (beyond pairwise co-change)
 CREATE TABLE IF NOT EXISTS git_hyperedges (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     commit_id INTEGER NOT NULL REFERENCES git_commits(id) ON DELETE CASCADE,
     file_count INTEGER NOT NULL,
-    sig_hash TEXT NOT NULL
+    sig_hash TEXT NOT NULL,
+    members TEXT  -- JSON array of sorted member file ids
 );
 
 CREATE TABLE IF NOT EXISTS git_hyperedge_members (
@@ -163,7 +183,8 @@ CREATE TABLE IF NOT EXISTS symbol_metrics (
     halstead_bugs REAL DEFAULT 0,
     coverage_pct REAL DEFAULT NULL,
     covered_lines INTEGER DEFAULT NULL,
-    coverable_lines INTEGER DEFAULT NULL
+    coverable_lines INTEGER DEFAULT NULL,
+    entry_distance INTEGER DEFAULT NULL
 );
 
 CREATE INDEX IF NOT EXISTS idx_symbol_metrics_complexity
@@ -239,6 +260,82 @@ CREATE TABLE IF NOT EXISTS snapshots (
     brain_methods INTEGER
 );
 
+-- Snapshot metrics materialised by the indexer (read by `roam snapshot` / `trends`)
+CREATE TABLE IF NOT EXISTS snapshot_metrics (
+    metric TEXT PRIMARY KEY,
+    value REAL
+);
+
+-- Test files reaching each symbol within TEST_REACH_MAX_HOPS call hops,
+-- with the nearest test of the file (roam.graph.test_reach)
+CREATE TABLE IF NOT EXISTS test_reach (
+    symbol_id INTEGER NOT NULL,
+    test_file_id INTEGER NOT NULL,
+    hops INTEGER NOT NULL,
+    test_id INTEGER NOT NULL,
+    via_id INTEGER,
+    PRIMARY KEY (symbol_id, test_file_id)
+) WITHOUT ROWID;
+
+-- File versions by git blob id: import keys, and whether the version's
+-- symbols were retained in symbol_fingerprints (roam.index.fingerprints)
+CREATE TABLE IF NOT EXISTS file_fingerprints (
+    path TEXT NOT NULL,
+    blob_sha TEXT NOT NULL,
+    imports TEXT,
+    retained_at REAL,
+    PRIMARY KEY (path, blob_sha)
+);
+
+CREATE TABLE IF NOT EXISTS symbol_fingerprints (
+    path TEXT NOT NULL,
+    blob_sha TEXT NOT NULL,
+    stable_key TEXT NOT NULL,
+    name TEXT NOT NULL,
+    qualified_name TEXT,
+    kind TEXT NOT NULL,
+    signature TEXT,
+    line_start INTEGER,
+    line_end INTEGER,
+    visibility TEXT,
+    is_exported INTEGER,
+    sig_hash TEXT,
+    body_hash TEXT,
+    PRIMARY KEY (path, blob_sha, stable_key)
+) WITHOUT ROWID;
+
+-- CODEOWNERS owners per file (space-separated, '' = unowned) and the
+-- CODEOWNERS file they were resolved from (roam.index.codeowners)
+CREATE TABLE IF NOT EXISTS file_owners (
+    file_id INTEGER PRIMARY KEY REFERENCES files(id) ON DELETE CASCADE,
+    owners TEXT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS codeowners_state (
+    id INTEGER PRIMARY KEY CHECK (id = 1),
+    path TEXT NOT NULL,
+    digest TEXT NOT NULL
+);
+
+-- Derived phases left stale by a targeted reindex (Indexer.run_paths)
+CREATE TABLE IF NOT EXISTS index_dirty (
+    phase TEXT PRIMARY KEY,
+    marked_at REAL
+);
+
+-- Single row: entry-point count behind symbol_metrics.entry_distance
+CREATE TABLE IF NOT EXISTS entrypoint_state (
+    id INTEGER PRIMARY KEY CHECK (id = 1),
+    entrypoints INTEGER NOT NULL
+);
+
+-- Single row, bumped each time a shadow build is published (roam.db.shadow)
+CREATE TABLE IF NOT EXISTS index_generation (
+    id INTEGER PRIMARY KEY CHECK (id = 1),
+    generation INTEGER NOT NULL,
+    published_at REAL
+);
+
 -- Runtime trace statistics: ingested from OpenTelemetry/Jaeger/Zipkin/generic traces
 CREATE TABLE IF NOT EXISTS runtime_stats (
     id INTEGER PRIMARY KEY,
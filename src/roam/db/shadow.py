@@ -0,0 +1,194 @@
+"""Shadow-database builds: index into a copy, then publish it atomically.
+
+A full or large incremental ``roam index`` deletes and reinserts rows for
+minutes at a time.  Building in place means concurrent readers (commands,
+the MCP server, :class:`~roam.query.RoamQuery`) wait on checkpoints or
+observe half-built graphs.  Instead the indexer:
+
+1. seeds ``index.db.shadow`` from a consistent snapshot of the live DB
+   (``VACUUM INTO``), or starts it empty for a forced rebuild;
+2. runs the normal pipeline against the shadow;
+3. bumps ``index_generation`` and publishes the shadow.
+
+Publishing renames the shadow into place when there is no live DB yet.
+Otherwise it copies the shadow over the live DB with the SQLite backup
+API in one write transaction.  Renaming over a DB that other processes
+still hold open is unsafe in WAL mode: the last old connection to close
+deletes ``index.db-wal`` by name, even when that file now belongs to the
+new DB.  The in-transaction copy keeps WAL snapshot isolation, so
+in-flight readers finish against the previous generation and every new
+read sees the complete new one.
+
+Commands keep writing to the live DB while a shadow builds.  The tables
+they own -- ``annotations``, ``snapshots``, ``metric_snapshots``,
+``runtime_stats`` and ``vulnerabilities`` (:data:`PRESERVED_TABLES`) --
+are copied from the live DB into the shadow just before publishing, and
+their symbol links are checked against the new symbols.  Every other
+table is the indexer's and is replaced wholesale.
+"""
+
+from __future__ import annotations
+
+import os
+import sqlite3
+import time
+from pathlib import Path
+
+SHADOW_SUFFIX = ".shadow"
+
+# Incremental runs touching at least this many files build in a shadow DB
+SHADOW_MIN_CHANGES = 200
+
+# Tables written by commands rather than the indexer; publish keeps the live rows
+PRESERVED_TABLES = ("annotations", "snapshots", "metric_snapshots", "runtime_stats", "vulnerabilities")
+
+# Keep a carried-over symbol link only while the id still names the same symbol
+_LINK_CHECKS = (
+    "UPDATE annotations SET symbol_id = NULL WHERE symbol_id IS NOT NULL AND NOT EXISTS ("
+    "  SELECT 1 FROM symbols s WHERE s.id = annotations.symbol_id"
+    "  AND (annotations.qualified_name IS NULL OR s.qualified_name = annotations.qualified_name))",
+    "UPDATE annotations SET symbol_id = ("
+    "  SELECT s.id FROM symbols s WHERE s.qualified_name = annotations.qualified_name LIMIT 1"
+    ") WHERE symbol_id IS NULL AND qualified_name IS NOT NULL",
+    "UPDATE runtime_stats SET symbol_id = NULL WHERE symbol_id IS NOT NULL AND NOT EXISTS ("
+    "  SELECT 1 FROM symbols s WHERE s.id = runtime_stats.symbol_id"
+    "  AND (runtime_stats.symbol_name IS NULL OR s.name = runtime_stats.symbol_name))",
+    "UPDATE runtime_stats SET symbol_id = ("
+    "  SELECT s.id FROM symbols s JOIN files f ON s.file_id = f.id"
+    "  WHERE s.name = runtime_stats.symbol_name AND f.path = runtime_stats.file_path LIMIT 1"
+    ") WHERE symbol_id IS NULL AND symbol_name IS NOT NULL AND file_path IS NOT NULL",
+    "UPDATE vulnerabilities SET matched_symbol_id = NULL WHERE matched_symbol_id IS NOT NULL AND NOT EXISTS ("
+    "  SELECT 1 FROM symbols s JOIN files f ON s.file_id = f.id WHERE s.id = vulnerabilities.matched_symbol_id"
+    "  AND (vulnerabilities.matched_file IS NULL OR f.path = vulnerabilities.matched_file))",
+)
+
+
+def shadow_path(db_path: Path) -> Path:
+    return db_path.with_name(db_path.name + SHADOW_SUFFIX)
+
+
+def _remove_db_files(path: Path) -> None:
+    for suffix in ("", "-wal", "-shm", "-journal"):
+        p = path.with_name(path.name + suffix)
+        try:
+            p.unlink()
+        except FileNotFoundError:
+            pass
+
+
+def seed_shadow(db_path: Path, empty: bool = False) -> Path:
+    """Create a fresh shadow next to *db_path* and return its path.
+
+    The shadow is a transactionally consistent copy of the live DB, or an
+    empty file when *empty* is set or there is no live DB.  Leftovers from
+    an interrupted build are discarded first.
+    """
+    shadow = shadow_path(db_path)
+    _remove_db_files(shadow)
+    if empty or not db_path.exists():
+        return shadow
+    src = sqlite3.connect(str(db_path), timeout=30)
+    try:
+        try:
+            src.execute("VACUUM INTO ?", (str(shadow),))
+        except sqlite3.OperationalError:
+            # SQLite < 3.27: page-level online backup gives the same snapshot
+            _remove_db_files(shadow)
+            dst = sqlite3.connect(str(shadow))
+            try:
+                src.backup(dst)
+            finally:
+                dst.close()
+    finally:
+        src.close()
+    return shadow
+
+
+def current_generation(conn) -> int:
+    """Generation of the index *conn* reads; 0 before the first publish."""
+    try:
+        row = conn.execute("SELECT generation FROM index_generation WHERE id = 1").fetchone()
+    except sqlite3.OperationalError:
+        return 0
+    return row[0] if row else 0
+
+
+def _live_generation(db_path: Path) -> int:
+    if not db_path.exists():
+        return 0
+    conn = sqlite3.connect(str(db_path), timeout=30)
+    try:
+        return current_generation(conn)
+    finally:
+        conn.close()
+
+
+def _table_columns(conn, schema: str, table: str) -> list[str]:
+    return [r[1] for r in conn.execute(f"PRAGMA {schema}.table_info({table})").fetchall()]
+
+
+def _carry_preserved_tables(conn, db_path: Path) -> None:
+    """Replace the shadow's :data:`PRESERVED_TABLES` rows with the live DB's.
+
+    Rows written while the build ran would otherwise be lost on publish.
+    Columns missing on either side (an older live schema) are skipped.
+    """
+    conn.execute("ATTACH DATABASE ? AS live", (str(db_path),))
+    try:
+        with conn:
+            for table in PRESERVED_TABLES:
+                live_cols = set(_table_columns(conn, "live", table))
+                cols = [c for c in _table_columns(conn, "main", table) if c in live_cols]
+                if not cols:
+                    continue
+                col_list = ", ".join(cols)
+                conn.execute(f"DELETE FROM main.{table}")
+                conn.execute(f"INSERT INTO main.{table} ({col_list}) SELECT {col_list} FROM live.{table}")
+            for sql in _LINK_CHECKS:
+                try:
+                    conn.execute(sql)
+                except sqlite3.OperationalError:
+                    pass  # Table missing from a partial schema
+    finally:
+        conn.execute("DETACH DATABASE live")
+
+
+def publish_shadow(shadow: Path, db_path: Path) -> int:
+    """Make the finished *shadow* the live index and return its generation.
+
+    The shadow must be closed by the caller.  Rows the live DB gained in
+    :data:`PRESERVED_TABLES` during the build are carried over first.
+    """
+    conn = sqlite3.connect(str(shadow), timeout=30)
+    try:
+        if db_path.exists():
+            _carry_preserved_tables(conn, db_path)
+        generation = max(_live_generation(db_path), current_generation(conn)) + 1
+        conn.execute(
+            "INSERT OR REPLACE INTO index_generation (id, generation, published_at) VALUES (1, ?, ?)",
+            (generation, time.time()),
+        )
+        conn.commit()
+        # Fold any WAL into the main file so the shadow is self-contained
+        conn.execute("PRAGMA journal_mode=DELETE")
+        if not db_path.exists():
+            conn.close()
+            conn = None
+            _remove_db_files(db_path)
+            os.replace(shadow, db_path)
+            return generation
+        dst = sqlite3.connect(str(db_path), timeout=30)
+        try:
+            conn.backup(dst)
+        finally:
+            dst.close()
+    finally:
+        if conn is not None:
+            conn.close()
+    _remove_db_files(shadow)
+    return generation
+
+
+def discard_shadow(db_path: Path) -> None:
+    """Remove a shadow left behind by a failed or interrupted build."""
+    _remove_db_files(shadow_path(db_path))
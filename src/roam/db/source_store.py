@@ -0,0 +1,275 @@
+"""Indexed source snapshots: compressed file contents with line-offset tables.
+
+The indexer stores every file it parses as a zlib-compressed blob keyed by
+its content hash (``files.hash``), so identical files share one row.  Each
+blob carries a table of line-start byte offsets, which lets
+:class:`SourceStore` answer line and span lookups without rescanning the
+text.
+
+Analyzers that used to re-open the working tree at query time read through
+:class:`SourceStore` instead.  That keeps their results consistent with the
+indexed state and avoids cold-disk reads.  Files without a stored blob
+(older indexes, oversized files, paths outside the index) fall back to the
+working tree.
+
+Stored text is newline-normalised (``\\r\\n`` and ``\\r`` become ``\\n``),
+matching what ``Path.read_text`` returns in text mode.
+"""
+
+from __future__ import annotations
+
+import bisect
+import sys
+import zlib
+from array import array
+from collections import OrderedDict
+from pathlib import Path
+
+SOURCE_CODEC = "zlib"
+
+# Files above this size are not snapshotted; readers fall back to disk.
+MAX_SOURCE_BYTES = 4 * 1024 * 1024
+
+# Codec of the content-less row recorded for an oversized file, so the
+# indexer's backfill does not re-read and re-hash it on every run.
+SKIPPED_CODEC = "none"
+
+_ZLIB_LEVEL = 6
+
+
+def _normalize_newlines(data: bytes) -> bytes:
+    if b"\r" not in data:
+        return data
+    return data.replace(b"\r\n", b"\n").replace(b"\r", b"\n")
+
+
+def _line_offsets(data: bytes) -> array:
+    """Byte offset of the start of every line in *data*."""
+    offsets = array("I", [0])
+    find = data.find
+    pos = find(b"\n")
+    while pos != -1:
+        offsets.append(pos + 1)
+        pos = find(b"\n", pos + 1)
+    if offsets[-1] == len(data) and len(offsets) > 1:
+        offsets.pop()  # trailing newline does not start a new line
+    return offsets
+
+
+def _pack_offsets(offsets: array) -> bytes:
+    if sys.byteorder != "little":
+        offsets = array("I", offsets)
+        offsets.byteswap()
+    return offsets.tobytes()
+
+
+def _unpack_offsets(blob: bytes) -> array:
+    offsets = array("I")
+    offsets.frombytes(blob)
+    if sys.byteorder != "little":
+        offsets.byteswap()
+    return offsets
+
+
+def store_source(conn, content_hash: str | None, data: bytes) -> bool:
+    """Persist a compressed snapshot of *data* under *content_hash*.
+
+    Deduplicated by hash: storing the same content twice is a no-op.
+    Oversized content only gets a :data:`SKIPPED_CODEC` marker row.
+    Returns True when a snapshot exists for the hash afterwards.
+    """
+    if not content_hash:
+        return False
+    if len(data) > MAX_SOURCE_BYTES:
+        conn.execute(
+            "INSERT OR IGNORE INTO file_sources (hash, codec, size, line_count, line_offsets, data) "
+            "VALUES (?, ?, ?, 0, x'', x'')",
+            (content_hash, SKIPPED_CODEC, len(data)),
+        )
+        return False
+    if conn.execute("SELECT 1 FROM file_sources WHERE hash = ?", (content_hash,)).fetchone():
+        return True
+    text = _normalize_newlines(data)
+    offsets = _line_offsets(text)
+    conn.execute(
+        "INSERT OR IGNORE INTO file_sources (hash, codec, size, line_count, line_offsets, data) "
+        "VALUES (?, ?, ?, ?, ?, ?)",
+        (
+            content_hash,
+            SOURCE_CODEC,
+            len(text),
+            len(offsets) if text else 0,
+            _pack_offsets(offsets),
+            zlib.compress(text, _ZLIB_LEVEL),
+        ),
+    )
+    return True
+
+
+def prune_sources(conn) -> int:
+    """Delete snapshots no longer referenced by any file. Returns rows removed."""
+    cur = conn.execute("DELETE FROM file_sources WHERE hash NOT IN (SELECT hash FROM files WHERE hash IS NOT NULL)")
+    return cur.rowcount or 0
+
+
+class _Entry:
+    __slots__ = ("data", "offsets", "_text", "_lines", "_char_starts")
+
+    def __init__(self, data: bytes, offsets: array):
+        self.data = data
+        self.offsets = offsets
+        self._text: str | None = None
+        self._lines: list[str] | None = None
+        self._char_starts: list[int] | None = None
+
+    @property
+    def text(self) -> str:
+        if self._text is None:
+            self._text = self.data.decode("utf-8", errors="replace")
+        return self._text
+
+    @property
+    def lines(self) -> list[str]:
+        if self._lines is None:
+            # Split on "\n" only, like line_offsets: splitlines() also breaks
+            # on \f, \x1c, U+2028 ... and would shift every later line number
+            lines = [ln[:-1] if ln.endswith("\r") else ln for ln in self.text.split("\n")]
+            if lines[-1] == "":
+                lines.pop()  # trailing newline (or empty file) adds no line
+            self._lines = lines
+        return self._lines
+
+    @property
+    def char_starts(self) -> list[int]:
+        if self._char_starts is None:
+            starts = [0]
+            text = self.text
+            pos = text.find("\n")
+            while pos != -1:
+                starts.append(pos + 1)
+                pos = text.find("\n", pos + 1)
+            self._char_starts = starts
+        return self._char_starts
+
+
+class SourceStore:
+    """Read indexed file contents by project-relative path.
+
+    ``conn`` may be ``None`` (or an index predating ``file_sources``), in
+    which case every read goes to ``root``.  Decoded files are kept in a
+    small LRU so repeated line lookups in the same file stay cheap.
+    """
+
+    def __init__(self, conn=None, root: Path | str | None = None, cache_size: int = 64):
+        self.conn = conn
+        self.root = Path(root) if root is not None else None
+        self.cache_size = max(1, cache_size)
+        self._cache: OrderedDict[str, _Entry | None] = OrderedDict()
+        self._indexed = conn is not None and self._has_table(conn)
+        self.hits = 0
+        self.disk_reads = 0
+
+    @staticmethod
+    def _has_table(conn) -> bool:
+        try:
+            return (
+                conn.execute("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'file_sources'").fetchone()
+                is not None
+            )
+        except Exception:
+            return False
+
+    # -- loading ---------------------------------------------------------
+
+    def _load_indexed(self, path: str) -> _Entry | None:
+        row = self.conn.execute(
+            "SELECT fs.codec, fs.line_offsets, fs.data FROM files f "
+            "JOIN file_sources fs ON fs.hash = f.hash WHERE f.path = ?",
+            (path,),
+        ).fetchone()
+        if row is None or row[0] != SOURCE_CODEC:
+            return None
+        try:
+            data = zlib.decompress(row[2])
+        except zlib.error:
+            return None
+        self.hits += 1
+        return _Entry(data, _unpack_offsets(row[1]))
+
+    def _load_disk(self, path: str) -> _Entry | None:
+        if self.root is None:
+            return None
+        full = Path(path) if Path(path).is_absolute() else self.root / path
+        try:
+            raw = full.read_bytes()
+        except OSError:
+            return None
+        self.disk_reads += 1
+        data = _normalize_newlines(raw)
+        return _Entry(data, _line_offsets(data))
+
+    def _entry(self, path: str) -> _Entry | None:
+        key = path.replace("\\", "/")
+        if key in self._cache:
+            self._cache.move_to_end(key)
+            return self._cache[key]
+        entry = self._load_indexed(key) if self._indexed else None
+        if entry is None:
+            entry = self._load_disk(path)
+        self._cache[key] = entry
+        if len(self._cache) > self.cache_size:
+            self._cache.popitem(last=False)
+        return entry
+
+    # -- public API ------------------------------------------------------
+
+    def text(self, path: str) -> str | None:
+        """Full file text, or None when the file is unavailable."""
+        entry = self._entry(path)
+        return entry.text if entry is not None else None
+
+    def lines(self, path: str) -> list[str] | None:
+        """File lines split on newlines, numbered like :meth:`line`."""
+        entry = self._entry(path)
+        return entry.lines if entry is not None else None
+
+    def line_count(self, path: str) -> int:
+        entry = self._entry(path)
+        if entry is None or not entry.data:
+            return 0
+        return len(entry.offsets)
+
+    def line(self, path: str, line_no: int) -> str | None:
+        """Text of 1-based line *line_no* without its newline."""
+        entry = self._entry(path)
+        if entry is None or line_no < 1 or line_no > len(entry.offsets) or not entry.data:
+            return None
+        start = entry.offsets[line_no - 1]
+        end = entry.offsets[line_no] if line_no < len(entry.offsets) else len(entry.data)
+        return entry.data[start:end].rstrip(b"\n").decode("utf-8", errors="replace")
+
+    def span(self, path: str, start_line: int, end_line: int) -> str | None:
+        """Text of the inclusive 1-based line range, newline-joined."""
+        entry = self._entry(path)
+        if entry is None or not entry.data:
+            return None
+        n = len(entry.offsets)
+        start_line = max(1, start_line)
+        end_line = min(n, end_line)
+        if start_line > end_line:
+            return ""
+        start = entry.offsets[start_line - 1]
+        end = entry.offsets[end_line] if end_line < n else len(entry.data)
+        return entry.data[start:end].rstrip(b"\n").decode("utf-8", errors="replace")
+
+    def line_starts(self, path: str) -> list[int]:
+        """Character offset of the start of every line of :meth:`text`."""
+        entry = self._entry(path)
+        return entry.char_starts if entry is not None else [0]
+
+    def line_of(self, path: str, char_offset: int) -> int:
+        """1-based line number containing *char_offset* of :meth:`text`."""
+        entry = self._entry(path)
+        if entry is None:
+            return 1
+        return bisect.bisect_right(entry.char_starts, char_offset)
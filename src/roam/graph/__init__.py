@@ -1,43 +1,42 @@
-"""Graph algorithms for codebase analysis."""
+"""Graph algorithms for codebase analysis.
 
-from roam.graph.builder import build_file_graph, build_symbol_graph
-from roam.graph.clusters import (
-    compare_with_directories,
-    detect_clusters,
-    label_clusters,
-    store_clusters,
-)
-from roam.graph.cycles import (
-    find_cycles,
-    find_weakest_edge,
-    format_cycles,
-)
-from roam.graph.dark_matter import HypothesisEngine, dark_matter_edges
-from roam.graph.diff import find_before_snapshot, metric_delta
-from roam.graph.layers import detect_layers, find_violations, format_layers
-from roam.graph.pagerank import compute_centrality, compute_pagerank, store_metrics
-from roam.graph.pathfinding import find_symbol_id, format_path
+Names are resolved lazily so that importing a light submodule (for example
+``roam.graph.entrypoints``) does not pull in networkx.
+"""
 
-__all__ = [
-    "build_symbol_graph",
-    "build_file_graph",
-    "compute_pagerank",
-    "compute_centrality",
-    "store_metrics",
-    "find_cycles",
-    "find_weakest_edge",
-    "format_cycles",
-    "detect_clusters",
-    "label_clusters",
-    "store_clusters",
-    "compare_with_directories",
-    "detect_layers",
-    "find_violations",
-    "format_layers",
-    "find_symbol_id",
-    "format_path",
-    "dark_matter_edges",
-    "HypothesisEngine",
-    "find_before_snapshot",
-    "metric_delta",
-]
+import importlib
+
+_EXPORTS = {
+    "build_symbol_graph": "roam.graph.builder",
+    "build_file_graph": "roam.graph.builder",
+    "compute_pagerank": "roam.graph.pagerank",
+    "compute_centrality": "roam.graph.pagerank",
+    "store_metrics": "roam.graph.pagerank",
+    "find_cycles": "roam.graph.cycles",
+    "find_weakest_edge": "roam.graph.cycles",
+    "format_cycles": "roam.graph.cycles",
+    "detect_clusters": "roam.graph.clusters",
+    "label_clusters": "roam.graph.clusters",
+    "store_clusters": "roam.graph.clusters",
+    "compare_with_directories": "roam.graph.clusters",
+    "detect_layers": "roam.graph.layers",
+    "find_violations": "roam.graph.layers",
+    "format_layers": "roam.graph.layers",
+    "find_symbol_id": "roam.graph.pathfinding",
+    "format_path": "roam.graph.pathfinding",
+    "dark_matter_edges": "roam.graph.dark_matter",
+    "HypothesisEngine": "roam.graph.dark_matter",
+    "find_before_snapshot": "roam.graph.diff",
+    "metric_delta": "roam.graph.diff",
+}
+
+__all__ = list(_EXPORTS)
+
+
+def __getattr__(name):
+    module = _EXPORTS.get(name)
+    if module is None:
+        raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+    value = getattr(importlib.import_module(module), name)
+    globals()[name] = value
+    return value
@@ -1,12 +1,14 @@
-"""Statistical anomaly detection for small time-series (10-100 data points).
+"""Statistical anomaly detection and trend statistics for metric histories.
 
-All algorithms use Python stdlib only (math, statistics, collections).
-Designed for roam health trend analysis where n is typically 5-100 snapshots.
+Everything works with the Python stdlib alone; numpy, when installed,
+vectorises the pairwise trend statistics.  Designed for roam health trend
+analysis, from a handful of snapshots up to long per-symbol histories.
 """
 
 from __future__ import annotations
 
 import math
+import random
 from collections import Counter
 from statistics import median
 
@@ -53,33 +55,126 @@ def modified_z_score(values: list[float | int], threshold: float = 3.5) -> list[
     return results
 
 
-def theil_sen_slope(values: list[float | int]) -> dict | None:
-    """Estimate robust trend using Theil-Sen median of pairwise slopes.
-
-    Far more robust to outliers than least-squares regression.
-    O(n^2) but n <= 100 so this is instant.
-
-    Returns dict with: slope, intercept, direction.
-    direction is "increasing" if slope > 0.01, "decreasing" if slope < -0.01,
-    else "stable".
-    Requires n >= 4.  Returns None if insufficient data.
+# ---------------------------------------------------------------------------
+# Trend statistics
+#
+# Theil-Sen and Mann-Kendall are defined over all n(n-1)/2 pairs.  Kendall's
+# S is computed in O(n log n) by counting inversions with a merge sort; the
+# Theil-Sen median is exact up to _EXACT_MAX_PAIRS pairs and estimated from a
+# fixed-seed random sample of pairs beyond that.  numpy, when installed,
+# vectorises the pairwise work, and the batch APIs score many equal-length
+# series as one matrix.
+# ---------------------------------------------------------------------------
+
+# Above this many pairs the Theil-Sen median is estimated from a sample.
+_EXACT_MAX_PAIRS = 500_000
+_SAMPLE_PAIRS = 100_000
+# Matrix cells per chunk in the batch paths (bounds peak memory).
+_BATCH_CELLS = 2_000_000
+# Longest series for which the batch Mann-Kendall uses the O(n^2) lag sweep.
+_LAG_SWEEP_MAX_N = 256
+
+
+def _numpy():
+    try:
+        import numpy as np
+    except ImportError:
+        return None
+    return np
+
+
+def _count_inversions(values: list[float | int]) -> int:
+    """Pairs i < j with values[i] > values[j] (ties are not inversions)."""
+    seq = list(values)
+    n = len(seq)
+    buf = [None] * n
+    inversions = 0
+    width = 1
+    while width < n:
+        for lo in range(0, n - width, 2 * width):
+            mid = lo + width
+            hi = min(lo + 2 * width, n)
+            i, j, k = lo, mid, lo
+            while i < mid and j < hi:
+                if seq[i] <= seq[j]:
+                    buf[k] = seq[i]
+                    i += 1
+                else:
+                    buf[k] = seq[j]
+                    inversions += mid - i
+                    j += 1
+                k += 1
+            buf[k : k + mid - i] = seq[i:mid]
+            k += mid - i
+            buf[k : k + hi - j] = seq[j:hi]
+            seq[lo:hi] = buf[lo:hi]
+        width *= 2
+    return inversions
+
+
+def _tie_stats(values: list[float | int]) -> tuple[int, int]:
+    """Return (tied pairs, Mann-Kendall variance tie correction)."""
+    tied_pairs = 0
+    correction = 0
+    for t in Counter(values).values():
+        if t > 1:
+            tied_pairs += t * (t - 1) // 2
+            correction += t * (t - 1) * (2 * t + 5)
+    return tied_pairs, correction
+
+
+def kendall_s(values: list[float | int]) -> int:
+    """Mann-Kendall S = sum of sgn(x_j - x_i) over i < j, in O(n log n).
+
+    With D strict inversions and T tied pairs among the n(n-1)/2 pairs,
+    S = (pairs - T - D) - D.
     """
     n = len(values)
-    if n < 4:
-        return None
+    tied_pairs, _ = _tie_stats(values)
+    return n * (n - 1) // 2 - tied_pairs - 2 * _count_inversions(values)
 
-    # Compute all pairwise slopes (y_j - y_i) / (j - i) for i < j
-    slopes: list[float] = []
-    for i in range(n):
-        for j in range(i + 1, n):
+
+def _sampled_slope_median(values: list[float | int]) -> float:
+    """Median of slopes over a fixed-seed random sample of pairs."""
+    n = len(values)
+    np = _numpy()
+    if np is not None:
+        rng = np.random.default_rng(n)
+        i = rng.integers(0, n, _SAMPLE_PAIRS)
+        j = rng.integers(0, n, _SAMPLE_PAIRS)
+        keep = i != j
+        i, j = i[keep], j[keep]
+        y = np.asarray(values, dtype=float)
+        return float(np.median((y[j] - y[i]) / (j - i)))
+    rng = random.Random(n)
+    slopes = []
+    for _ in range(_SAMPLE_PAIRS):
+        i, j = rng.randrange(n), rng.randrange(n)
+        if i != j:
             slopes.append((values[j] - values[i]) / (j - i))
+    return median(slopes)
 
-    slope = median(slopes)
 
-    # Intercept: median of (y_i - slope * i)
-    intercepts = [values[i] - slope * i for i in range(n)]
-    intercept = median(intercepts)
+def median_pairwise_slope(values: list[float | int]) -> float:
+    """Sen's slope: median of (y_j - y_i) / (j - i) over all i < j.
 
+    Exact up to ``_EXACT_MAX_PAIRS`` pairs (about 1000 points), sampled
+    beyond.  Returns 0.0 for fewer than two values.
+    """
+    n = len(values)
+    if n < 2:
+        return 0.0
+    if n * (n - 1) // 2 > _EXACT_MAX_PAIRS:
+        return _sampled_slope_median(values)
+    np = _numpy()
+    if np is not None:
+        y = np.asarray(values, dtype=float)
+        i, j = np.triu_indices(n, 1)
+        return float(np.median((y[j] - y[i]) / (j - i)))
+    return median([(values[j] - values[i]) / (j - i) for i in range(n) for j in range(i + 1, n)])
+
+
+def _theil_sen_result(slope: float, intercept: float) -> dict:
     if slope > 0.01:
         direction = "increasing"
     elif slope < -0.01:
@@ -94,38 +189,30 @@ def theil_sen_slope(values: list[float | int]) -> dict | None:
     }
 
 
-def mann_kendall_test(values: list[float | int]) -> dict | None:
-    """Mann-Kendall trend significance test.
+def theil_sen_slope(values: list[float | int]) -> dict | None:
+    """Estimate robust trend using Theil-Sen median of pairwise slopes.
 
-    Non-parametric test for monotonic trend.  Uses normal approximation
-    of the S statistic with math.erf for p-value.
+    Far more robust to outliers than least-squares regression.  See
+    :func:`median_pairwise_slope` for cost and exactness.
 
-    Returns dict with: S, z_score, p_value, significant (p < 0.05), direction.
-    Requires n >= 8.  Returns None if insufficient data.
+    Returns dict with: slope, intercept, direction.
+    direction is "increasing" if slope > 0.01, "decreasing" if slope < -0.01,
+    else "stable".
+    Requires n >= 4.  Returns None if insufficient data.
     """
     n = len(values)
-    if n < 8:
+    if n < 4:
         return None
 
-    # Compute S = sum of sgn(x_j - x_i) for all i < j
-    s_stat = 0
-    for i in range(n):
-        for j in range(i + 1, n):
-            diff = values[j] - values[i]
-            if diff > 0:
-                s_stat += 1
-            elif diff < 0:
-                s_stat -= 1
-
-    # Variance with tie correction
-    # Count ties: groups of equal values
-    tie_counts = Counter(values)
-    tie_correction = 0
-    for count in tie_counts.values():
-        if count > 1:
-            t = count
-            tie_correction += t * (t - 1) * (2 * t + 5)
+    slope = median_pairwise_slope(values)
 
+    # Intercept: median of (y_i - slope * i)
+    intercept = median([values[i] - slope * i for i in range(n)])
+
+    return _theil_sen_result(slope, intercept)
+
+
+def _mann_kendall_result(n: int, s_stat: int, tie_correction: int) -> dict:
     var_s = (n * (n - 1) * (2 * n + 5) - tie_correction) / 18.0
 
     if var_s == 0.0:
@@ -166,6 +253,89 @@ def mann_kendall_test(values: list[float | int]) -> dict | None:
     }
 
 
+def mann_kendall_test(values: list[float | int]) -> dict | None:
+    """Mann-Kendall trend test.
+
+    Non-parametric test for monotonic trend.  Uses normal approximation
+    of the S statistic (tie-corrected variance) with math.erfc for the
+    p-value.  S is computed in O(n log n), see :func:`kendall_s`.
+
+    Returns dict with: S, z_score, p_value, significant (p < 0.05), direction.
+    Requires n >= 8.  Returns None if insufficient data.
+    """
+    n = len(values)
+    if n < 8:
+        return None
+    tied_pairs, tie_correction = _tie_stats(values)
+    s_stat = n * (n - 1) // 2 - tied_pairs - 2 * _count_inversions(values)
+    return _mann_kendall_result(n, s_stat, tie_correction)
+
+
+def _group_by_length(series: list[list[float | int]], min_n: int) -> dict[int, list[int]]:
+    groups: dict[int, list[int]] = {}
+    for idx, values in enumerate(series):
+        if len(values) >= min_n:
+            groups.setdefault(len(values), []).append(idx)
+    return groups
+
+
+def _row_chunks(rows: list[int], cells_per_row: int):
+    step = max(1, _BATCH_CELLS // max(1, cells_per_row))
+    for start in range(0, len(rows), step):
+        yield rows[start : start + step]
+
+
+def theil_sen_slopes(series) -> list[dict | None]:
+    """Batch :func:`theil_sen_slope`: one result (or None) per input series.
+
+    With numpy, equal-length series are stacked and their pairwise slopes
+    computed as one matrix; results match the scalar function exactly.
+    """
+    series = [list(v) for v in series]
+    results: list[dict | None] = [None] * len(series)
+    np = _numpy()
+    for n, rows in _group_by_length(series, 4).items():
+        pairs = n * (n - 1) // 2
+        if np is None or pairs > _EXACT_MAX_PAIRS:
+            for idx in rows:
+                results[idx] = theil_sen_slope(series[idx])
+            continue
+        x = np.arange(n, dtype=float)
+        for chunk in _row_chunks(rows, pairs):
+            y = np.asarray([series[idx] for idx in chunk], dtype=float)
+            diffs = np.concatenate([(y[:, k:] - y[:, :-k]) / k for k in range(1, n)], axis=1)
+            slopes = np.median(diffs, axis=1)
+            intercepts = np.median(y - slopes[:, None] * x, axis=1)
+            for idx, slope, intercept in zip(chunk, slopes.tolist(), intercepts.tolist()):
+                results[idx] = _theil_sen_result(slope, intercept)
+    return results
+
+
+def mann_kendall_tests(series) -> list[dict | None]:
+    """Batch :func:`mann_kendall_test`: one result (or None) per input series.
+
+    With numpy, short equal-length series are scored together by summing
+    ``sign(y[:, k:] - y[:, :-k])`` over every lag k; longer series use the
+    O(n log n) scalar path.
+    """
+    series = [list(v) for v in series]
+    results: list[dict | None] = [None] * len(series)
+    np = _numpy()
+    for n, rows in _group_by_length(series, 8).items():
+        if np is None or n > _LAG_SWEEP_MAX_N:
+            for idx in rows:
+                results[idx] = mann_kendall_test(series[idx])
+            continue
+        for chunk in _row_chunks(rows, n):
+            y = np.asarray([series[idx] for idx in chunk], dtype=float)
+            s_stats = np.zeros(len(chunk), dtype=np.int64)
+            for k in range(1, n):
+                s_stats += np.sign(y[:, k:] - y[:, :-k]).astype(np.int64).sum(axis=1)
+            for idx, s_stat in zip(chunk, s_stats.tolist()):
+                results[idx] = _mann_kendall_result(n, s_stat, _tie_stats(series[idx])[1])
+    return results
+
+
 def western_electric_rules(values: list[float | int]) -> list[dict]:
     """Detect anomalous patterns using Western Electric rules.
 
@@ -438,16 +608,18 @@ def cusum(
     return signals
 
 
-def forecast(values: list[float | int], target: float) -> dict | None:
+def forecast(values: list[float | int], target: float, trend: dict | None = None) -> dict | None:
     """Forecast when a metric will reach a target value.
 
-    Uses Theil-Sen slope for projection.
+    Uses Theil-Sen slope for projection; pass *trend* to reuse a
+    :func:`theil_sen_slope` result already computed for *values*.
 
     Returns dict with: current, target, slope, steps_until (int or None if
     direction is wrong or trend is stable), direction.
     Returns None if insufficient data or no trend.
     """
-    trend = theil_sen_slope(values)
+    if trend is None:
+        trend = theil_sen_slope(values)
     if trend is None:
         return None
 
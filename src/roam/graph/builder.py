@@ -38,6 +38,45 @@ def build_symbol_graph(conn: sqlite3.Connection) -> nx.DiGraph:
     return G
 
 
+def load_neighbourhood(
+    conn: sqlite3.Connection,
+    seeds,
+    depth: int | None = None,
+    direction: str = "in",
+    max_nodes: int | None = None,
+) -> nx.DiGraph:
+    """Build the subgraph of symbols reached from *seeds*.
+
+    Same node and edge attributes as :func:`build_symbol_graph`, plus a
+    ``hops`` node attribute, but only for the nodes
+    :func:`~roam.graph.neighbourhood.walk_neighbourhood` reaches (*depth*
+    None means the transitive closure in *direction*) and the edges among
+    them.  ``G.graph["truncated"]`` is True when *max_nodes* cut the walk
+    short.  Use it when a command looks around a few symbols and needs no
+    whole-graph metrics.
+    """
+    from roam.db.connection import batched_in
+    from roam.graph.neighbourhood import walk_neighbourhood
+
+    hops, edges, truncated = walk_neighbourhood(conn, seeds, depth, direction, max_nodes)
+    G = nx.DiGraph(truncated=truncated)
+    rows = batched_in(
+        conn,
+        "SELECT s.id, s.name, s.kind, s.qualified_name, f.path AS file_path "
+        "FROM symbols s JOIN files f ON s.file_id = f.id WHERE s.id IN ({ph})",
+        sorted(hops),
+    )
+    G.add_nodes_from(
+        (
+            row[0],
+            {"name": row[1], "kind": row[2], "qualified_name": row[3], "file_path": row[4], "hops": hops[row[0]]},
+        )
+        for row in sorted(rows, key=lambda r: r[0])
+    )
+    G.add_edges_from((src, tgt, {"kind": kind}) for src, tgt, kind in edges if src in G and tgt in G)
+    return G
+
+
 def build_file_graph(conn: sqlite3.Connection) -> nx.DiGraph:
     """Build a directed graph from file-level edges.
 
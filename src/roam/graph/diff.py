@@ -69,6 +69,7 @@ def _git_show(root: Path, ref: str, filepath: str) -> bytes | None:
 
 def _extract_old_symbols(source: bytes, file_path: str) -> list[dict]:
     """Parse *source* bytes and extract symbols for *file_path*."""
+    from roam.index.parse_session import current_session
     from roam.index.parser import GRAMMAR_ALIASES
     from roam.index.symbols import extract_symbols
     from roam.languages.registry import get_extractor_for_file, get_language_for_file
@@ -83,14 +84,7 @@ def _extract_old_symbols(source: bytes, file_path: str) -> list[dict]:
 
     grammar = GRAMMAR_ALIASES.get(language, language)
     try:
-        from tree_sitter_language_pack import get_parser
-
-        parser = get_parser(grammar)
-    except Exception:
-        return []
-
-    try:
-        tree = parser.parse(source)
+        tree = current_session().parse(source, grammar, path=file_path)
     except Exception:
         return []
 
@@ -0,0 +1,139 @@
+"""Entry-point reachability: call-graph hop distance from entry points.
+
+Entry points are exported symbols and symbols whose name suggests a
+request/CLI boundary (``main``, ``handler``, ``route`` ...).  A
+multi-source BFS over ``edges`` gives every callable its hop distance
+from the nearest entry point.
+
+The indexer stores the result in ``symbol_metrics.entry_distance`` so
+readers such as ``roam hotspots --security`` do not rebuild the graph:
+``NULL`` means not computed, ``-1`` means unreachable.  Readers fall back
+to computing distances on the fly when a value is missing.
+"""
+
+from __future__ import annotations
+
+import re
+from collections import defaultdict, deque
+
+from roam.db.connection import batched_in
+
+ENTRYPOINT_HINT = re.compile(
+    r"(main|handler|route|endpoint|controller|serve|api|http)",
+    re.IGNORECASE,
+)
+
+# Symbols that receive a stored distance (the ones hotspots attribute to)
+DISTANCE_KINDS = ("function", "method", "constructor")
+
+UNREACHABLE = -1
+
+
+def entrypoint_ids(conn) -> set[int]:
+    """Ids of entry-point symbols (first 25 callables when none qualify)."""
+    sym_rows = conn.execute(
+        "SELECT id, name, kind, is_exported FROM symbols WHERE kind IN ('function', 'method', 'constructor', 'class')"
+    ).fetchall()
+    entries: set[int] = set()
+    for row in sym_rows:
+        name = row[1] or ""
+        if int(row[3] or 0) == 1 or ENTRYPOINT_HINT.search(name):
+            entries.add(int(row[0]))
+    if not entries and sym_rows:
+        entries = {int(r[0]) for r in sym_rows[:25]}
+    return entries
+
+
+def compute_entry_distances(conn, entries: set[int] | None = None) -> dict[int, int]:
+    """Multi-source BFS from *entries* over call-graph edges.
+
+    Returns ``{symbol_id: hops}`` for every reachable symbol.
+    """
+    if entries is None:
+        entries = entrypoint_ids(conn)
+    adj: dict[int, list[int]] = defaultdict(list)
+    for src, tgt in conn.execute("SELECT DISTINCT source_id, target_id FROM edges"):
+        adj[src].append(tgt)
+
+    distance = dict.fromkeys(entries, 0)
+    q: deque[int] = deque(entries)
+    while q:
+        current = q.popleft()
+        next_depth = distance[current] + 1
+        for nxt in adj.get(current, ()):
+            if nxt not in distance:
+                distance[nxt] = next_depth
+                q.append(nxt)
+    return distance
+
+
+def store_entry_distances(conn) -> int:
+    """Recompute distances and write the ones that changed.
+
+    Distances are kept on existing ``symbol_metrics`` rows (callables with
+    complexity data).  Only rows whose stored value differs are touched, so
+    an incremental reindex that leaves the call graph mostly intact writes
+    little.  The entry-point count is stored alongside (``entrypoint_state``)
+    so readers need not rescan the symbols.  Returns the number of rows
+    updated.
+    """
+    entries = entrypoint_ids(conn)
+    distance = compute_entry_distances(conn, entries)
+    conn.execute(
+        "INSERT OR REPLACE INTO entrypoint_state (id, entrypoints) VALUES (1, ?)",
+        (len(entries),),
+    )
+    rows = conn.execute(
+        "SELECT sm.symbol_id, sm.entry_distance FROM symbol_metrics sm "
+        "JOIN symbols s ON s.id = sm.symbol_id "
+        "WHERE s.kind IN ({})".format(",".join("?" for _ in DISTANCE_KINDS)),
+        DISTANCE_KINDS,
+    ).fetchall()
+    updates = []
+    for sid, stored in rows:
+        value = distance.get(sid, UNREACHABLE)
+        if stored != value:
+            updates.append((value, sid))
+    conn.executemany("UPDATE symbol_metrics SET entry_distance = ? WHERE symbol_id = ?", updates)
+    return len(updates)
+
+
+def load_entry_distances(conn, symbol_ids) -> dict[int, int] | None:
+    """Stored distances for *symbol_ids* (reachable ones only).
+
+    Returns None when any of the symbols has no stored distance (older
+    index, or no ``symbol_metrics`` row) or a targeted reindex left the
+    phase dirty, in which case the caller should use
+    :func:`compute_entry_distances`.
+    """
+    from roam.index.incremental import is_dirty
+
+    if is_dirty(conn, "entry_distances"):
+        return None
+    ids = sorted(set(symbol_ids))
+    try:
+        rows = batched_in(
+            conn,
+            "SELECT symbol_id, entry_distance FROM symbol_metrics WHERE symbol_id IN ({ph})",
+            ids,
+        )
+    except Exception:
+        return None  # column missing: index predates entry distances
+    if len(rows) != len(ids):
+        return None
+    out: dict[int, int] = {}
+    for sid, dist in rows:
+        if dist is None:
+            return None
+        if dist != UNREACHABLE:
+            out[int(sid)] = int(dist)
+    return out
+
+
+def load_entrypoint_count(conn) -> int | None:
+    """Entry-point count stored with the distances (None on older indexes)."""
+    try:
+        row = conn.execute("SELECT entrypoints FROM entrypoint_state WHERE id = 1").fetchone()
+    except Exception:
+        return None
+    return int(row[0]) if row else None
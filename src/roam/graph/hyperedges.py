@@ -0,0 +1,114 @@
+"""Similarity search over git hyperedges (n-ary co-change patterns).
+
+Finds the historical commit whose file set has the highest Jaccard
+similarity to a change set.  Files of the change set are probed
+rarest-first through the ``git_hyperedge_members`` inverted index, and
+two bounds prune the search:
+
+* size filter -- a hyperedge of size ``s`` can reach at most
+  ``min(q, s) / max(q, s)`` against a change set of size ``q``, so only
+  sizes in ``[best * q, q / best]`` are fetched;
+* prefix filter -- a hyperedge not seen after probing ``i`` files shares
+  at most ``q - i`` files with the change set, so probing stops once
+  ``(q - i) / q`` drops below the best score.
+
+Candidates are scored from the sorted member array stored inline on
+``git_hyperedges``; indexes built before that column existed fall back to
+one batched member query.
+"""
+
+from __future__ import annotations
+
+import json
+import math
+
+from roam.db.connection import batched_in
+
+_EPS = 1e-9
+
+
+class HyperedgeIndex:
+    """Best-match Jaccard lookup against stored hyperedges."""
+
+    def __init__(self, conn):
+        self.conn = conn
+        cols = {r[1] for r in conn.execute("PRAGMA table_info(git_hyperedges)").fetchall()}
+        self._members_col = "h.members" if "members" in cols else "NULL"
+        self._members: dict[int, tuple[int, ...]] = {}
+        self.candidates_scored = 0
+        self.files_probed = 0
+
+    def _frequencies(self, fids: list[int]) -> dict[int, int]:
+        rows = batched_in(
+            self.conn,
+            "SELECT file_id, COUNT(*) FROM git_hyperedge_members WHERE file_id IN ({ph}) GROUP BY file_id",
+            fids,
+        )
+        return {r[0]: r[1] for r in rows}
+
+    def _postings(self, fid: int, lo: int, hi: int) -> list[tuple[int, int]]:
+        rows = self.conn.execute(
+            f"SELECT h.id, h.file_count, {self._members_col} "
+            "FROM git_hyperedge_members m JOIN git_hyperedges h ON h.id = m.hyperedge_id "
+            "WHERE m.file_id = ? AND h.file_count BETWEEN ? AND ?",
+            (fid, lo, hi),
+        ).fetchall()
+        missing = []
+        out = []
+        for he_id, size, members in rows:
+            if he_id not in self._members:
+                if members:
+                    self._members[he_id] = tuple(json.loads(members))
+                else:
+                    missing.append(he_id)
+            out.append((he_id, size))
+        if missing:
+            grouped: dict[int, list[int]] = {he_id: [] for he_id in missing}
+            for r in batched_in(
+                self.conn,
+                "SELECT hyperedge_id, file_id FROM git_hyperedge_members WHERE hyperedge_id IN ({ph})",
+                missing,
+            ):
+                grouped[r[0]].append(r[1])
+            for he_id, members in grouped.items():
+                self._members[he_id] = tuple(sorted(members))
+        return out
+
+    def best_match(self, change_fids) -> tuple[float, int | None, tuple[int, ...] | None]:
+        """Return ``(jaccard, hyperedge_id, members)`` of the closest pattern.
+
+        Only hyperedges sharing at least one file with *change_fids* are
+        considered; ``(0.0, None, None)`` means there are none.  Ties go to
+        the lowest hyperedge id.
+        """
+        query = set(change_fids)
+        q = len(query)
+        if not q:
+            return 0.0, None, None
+        freq = self._frequencies(list(query))
+        tokens = sorted((f for f in query if freq.get(f)), key=lambda f: (freq[f], f))
+
+        best = 0.0
+        best_id: int | None = None
+        seen: set[int] = set()
+        for i, fid in enumerate(tokens):
+            if best > 0 and (q - i) / q < best - _EPS:
+                break
+            if best > 0:
+                lo, hi = math.ceil(best * q - _EPS), math.floor(q / best + _EPS)
+            else:
+                lo, hi = 0, 1 << 31
+            self.files_probed += 1
+            for he_id, size in self._postings(fid, lo, hi):
+                if he_id in seen:
+                    continue
+                seen.add(he_id)
+                self.candidates_scored += 1
+                inter = sum(1 for m in self._members[he_id] if m in query)
+                jaccard = inter / (q + size - inter)
+                if jaccard > best + _EPS or (abs(jaccard - best) <= _EPS and best_id is not None and he_id < best_id):
+                    best, best_id = jaccard, he_id
+
+        if best_id is None:
+            return 0.0, None, None
+        return best, best_id, self._members[best_id]
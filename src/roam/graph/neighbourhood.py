@@ -0,0 +1,83 @@
+"""Frontier-by-frontier expansion of the symbol graph around seed symbols.
+
+Commands that only look a few hops around a symbol do not need the whole
+graph in memory.  :func:`walk_neighbourhood` follows the ``edges`` table
+one frontier at a time, fetching each frontier's edges with batched
+indexed lookups (``idx_edges_out`` / ``idx_edges_in``), and stops
+at a hop limit or a node budget.  It does not import NetworkX, so light
+commands can use it directly; :func:`roam.graph.builder.load_neighbourhood`
+turns the result into a ``DiGraph``.
+"""
+
+from __future__ import annotations
+
+from roam.db.connection import batched_in
+
+_KEYS = {"in": ("target_id",), "out": ("source_id",), "both": ("source_id", "target_id")}
+
+
+def _fetch_edges(conn, key: str, nodes) -> list[tuple[int, int, str]]:
+    rows = batched_in(conn, f"SELECT source_id, target_id, kind FROM edges WHERE {key} IN ({{ph}})", nodes)
+    return [(r[0], r[1], r[2]) for r in rows]
+
+
+def walk_neighbourhood(
+    conn,
+    seeds,
+    depth: int | None = None,
+    direction: str = "in",
+    max_nodes: int | None = None,
+) -> tuple[dict[int, int], list[tuple[int, int, str]], bool]:
+    """Expand from *seeds* along ``edges`` rows.
+
+    *direction* ``"in"`` walks to callers (dependents), ``"out"`` to
+    callees and ``"both"`` ignores edge direction.  *depth* None walks to
+    the transitive closure.  Expansion stops adding nodes once
+    *max_nodes* are reached (lowest ids first within a frontier).
+
+    Returns ``(hops, edges, truncated)``: ``{node: hop distance}`` for
+    every reached node, the ``(source, target, kind)`` edges among the
+    reached nodes sorted by endpoints, and whether *max_nodes* cut the
+    walk short.
+    """
+    keys = _KEYS.get(direction)
+    if keys is None:
+        raise ValueError(f"direction must be 'in', 'out' or 'both', not {direction!r}")
+
+    hops: dict[int, int] = {}
+    for s in seeds:
+        if max_nodes is not None and len(hops) >= max_nodes:
+            break
+        hops.setdefault(s, 0)
+    truncated = False
+    fetched: list[tuple[int, int, str]] = []
+    expanded: set[int] = set()
+    frontier = sorted(hops)
+    level = 0
+    while frontier and (depth is None or level < depth) and not truncated:
+        level += 1
+        found: set[int] = set()
+        for key in keys:
+            rows = _fetch_edges(conn, key, frontier)
+            fetched.extend(rows)
+            for src, tgt, _kind in rows:
+                found.add(src if key == "target_id" else tgt)
+        expanded.update(frontier)
+        frontier = []
+        for node in sorted(found - hops.keys()):
+            if max_nodes is not None and len(hops) >= max_nodes:
+                truncated = True
+                break
+            hops[node] = level
+            frontier.append(node)
+
+    # Nodes left unexpanded may still have edges among the reached set
+    rest = [n for n in hops if n not in expanded]
+    if rest:
+        fetched.extend(_fetch_edges(conn, keys[0], rest))
+
+    edges = {}
+    for src, tgt, kind in fetched:
+        if src in hops and tgt in hops:
+            edges[(src, tgt, kind)] = None
+    return hops, sorted(edges, key=lambda e: (e[0], e[1])), truncated
@@ -6,6 +6,8 @@ import sqlite3
 
 import networkx as nx
 
+from roam.graph.cycles import find_cycles
+
 
 def _optimal_alpha(G: nx.DiGraph) -> float:
     """Choose PageRank damping factor based on graph structure.
@@ -143,6 +145,10 @@ def store_metrics(conn: sqlite3.Connection, G: nx.DiGraph) -> int:
     pr = compute_pagerank(G)
     centrality = compute_centrality(G)
 
+    # Stored SCC ids (1 = largest cycle) let readers test "same cycle"
+    # without recomputing components; acyclic symbols get NULL.
+    scc_of = {node: idx for idx, scc in enumerate(find_cycles(G), 1) for node in scc}
+
     rows = []
     for node in G.nodes:
         c = centrality.get(node, {})
@@ -157,14 +163,15 @@ def store_metrics(conn: sqlite3.Connection, G: nx.DiGraph) -> int:
                 c.get("eigenvector", 0.0),
                 c.get("clustering_coefficient", 0.0),
                 c.get("debt_score", 0.0),
+                scc_of.get(node),
             )
         )
 
     conn.executemany(
         "INSERT OR REPLACE INTO graph_metrics "
         "(symbol_id, pagerank, in_degree, out_degree, betweenness, "
-        "closeness, eigenvector, clustering_coefficient, debt_score) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "closeness, eigenvector, clustering_coefficient, debt_score, scc_id) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
         rows,
     )
     conn.commit()
@@ -1,9 +1,22 @@
-"""Shortest-path utilities for the ``roam trace`` command."""
+"""Shortest-path utilities for the ``roam trace`` command.
+
+Paths are computed on :class:`PathGraph`, a compressed-sparse-row copy of
+the symbol graph on integer arrays, instead of NetworkX:
+
+* the first path comes from a bidirectional Dijkstra;
+* further paths use Yen's algorithm.  Every spur search is an A* guided by
+  the reverse shortest-path tree of the target, which is computed once and
+  is an exact lower bound on the graph with edges and nodes removed;
+* an optional cost *cutoff* prunes both searches.  Every edge weighs at
+  least 1, so the cutoff also caps the number of hops.
+"""
 
 from __future__ import annotations
 
-import itertools
+import heapq
 import sqlite3
+from array import array
+from typing import Iterable
 
 import networkx as nx
 
@@ -17,45 +30,276 @@ _EDGE_WEIGHTS = {
     "import": 1.1,
 }
 
+_DEFAULT_WEIGHT = 2.0
+
+_INF = float("inf")
+
+
+def _edge_weight(kind: str | None) -> float:
+    return _EDGE_WEIGHTS.get(kind or "", _DEFAULT_WEIGHT)
+
+
+class PathGraph:
+    """Directed weighted graph in CSR form, keyed by symbol id.
+
+    Parallel edges collapse to the cheapest one; its kind is what
+    :meth:`edge_kind` reports.
+    """
+
+    def __init__(self, node_ids: Iterable[int], edges: Iterable[tuple[int, int, str | None, float | None]]):
+        self.ids = array("q", sorted(set(node_ids)))
+        self._index = {nid: i for i, nid in enumerate(self.ids)}
+        best: dict[tuple[int, int], tuple[float, str]] = {}
+        index = self._index
+        for src, tgt, kind, weight in edges:
+            u = index.get(src)
+            v = index.get(tgt)
+            if u is None or v is None or u == v:
+                continue
+            w = float(weight) if weight is not None else _edge_weight(kind)
+            prev = best.get((u, v))
+            if prev is None or w < prev[0]:
+                best[(u, v)] = (w, kind or "")
+        self._kinds = {key: kind for key, (_, kind) in best.items()}
+        order = sorted(best)
+        self.fwd_ptr, self.fwd_dst, self.fwd_w = self._csr(order, best, reverse=False)
+        order.sort(key=lambda e: (e[1], e[0]))
+        self.rev_ptr, self.rev_dst, self.rev_w = self._csr(order, best, reverse=True)
+
+    def _csr(self, order, best, reverse: bool) -> tuple[array, array, array]:
+        """CSR arrays from *order*, edges sorted by their row node."""
+        n = len(self.ids)
+        row = 1 if reverse else 0
+        col = 1 - row
+        counts = [0] * (n + 1)
+        for e in order:
+            counts[e[row] + 1] += 1
+        for i in range(n):
+            counts[i + 1] += counts[i]
+        dst = array("q", [e[col] for e in order])
+        wts = array("d", [best[e][0] for e in order])
+        return array("q", counts), dst, wts
+
+    @classmethod
+    def from_db(cls, conn: sqlite3.Connection) -> PathGraph:
+        node_ids = (r[0] for r in conn.execute("SELECT id FROM symbols"))
+        edges = ((r[0], r[1], r[2], None) for r in conn.execute("SELECT source_id, target_id, kind FROM edges"))
+        return cls(node_ids, edges)
+
+    @classmethod
+    def from_networkx(cls, G: nx.DiGraph) -> PathGraph:
+        return cls(G.nodes, ((u, v, d.get("kind"), d.get("weight")) for u, v, d in G.edges(data=True)))
+
+    # -- lookups ---------------------------------------------------------
+
+    def __contains__(self, node_id) -> bool:
+        return node_id in self._index
+
+    def __len__(self) -> int:
+        return len(self.ids)
 
-def _ensure_weights(G: nx.DiGraph) -> None:
-    """Set edge weights based on kind, favoring call edges over imports."""
-    for _u, _v, data in G.edges(data=True):
-        if "weight" not in data:
-            data["weight"] = _EDGE_WEIGHTS.get(data.get("kind", ""), 2)
+    def degree(self, node_id: int) -> int:
+        """In-degree plus out-degree (distinct neighbours per direction)."""
+        i = self._index.get(node_id)
+        if i is None:
+            return 0
+        return (self.fwd_ptr[i + 1] - self.fwd_ptr[i]) + (self.rev_ptr[i + 1] - self.rev_ptr[i])
 
+    def edge_kind(self, src: int, tgt: int) -> str:
+        u, v = self._index.get(src), self._index.get(tgt)
+        return self._kinds.get((u, v), "")
 
-def find_k_paths(G: nx.DiGraph, source_id: int, target_id: int, k: int = 3) -> list[list[int]]:
+    def _weight(self, u: int, v: int) -> float:
+        for j in range(self.fwd_ptr[u], self.fwd_ptr[u + 1]):
+            if self.fwd_dst[j] == v:
+                return self.fwd_w[j]
+        for j in range(self.rev_ptr[u], self.rev_ptr[u + 1]):
+            if self.rev_dst[j] == v:  # only reached on undirected paths
+                return self.rev_w[j]
+        return _INF
+
+    def _neighbors(self, u: int, forward: bool, undirected: bool):
+        ptr, dst, wts = (
+            (self.fwd_ptr, self.fwd_dst, self.fwd_w) if forward else (self.rev_ptr, self.rev_dst, self.rev_w)
+        )
+        for j in range(ptr[u], ptr[u + 1]):
+            yield dst[j], wts[j]
+        if undirected:
+            ptr, dst, wts = (
+                (self.rev_ptr, self.rev_dst, self.rev_w) if forward else (self.fwd_ptr, self.fwd_dst, self.fwd_w)
+            )
+            for j in range(ptr[u], ptr[u + 1]):
+                yield dst[j], wts[j]
+
+    # -- searches --------------------------------------------------------
+
+    def _bidirectional(self, s: int, t: int, cutoff: float, undirected: bool = False) -> list[int] | None:
+        """Bidirectional Dijkstra; returns an index path or None."""
+        if s == t:
+            return [s]
+        dist = ({s: 0.0}, {t: 0.0})
+        pred: tuple[dict[int, int], dict[int, int]] = ({}, {})
+        heaps = ([(0.0, s)], [(0.0, t)])
+        done: tuple[set[int], set[int]] = (set(), set())
+        mu = _INF
+        meet = None
+        while heaps[0] and heaps[1]:
+            if heaps[0][0][0] + heaps[1][0][0] >= mu:
+                break
+            side = 0 if heaps[0][0][0] <= heaps[1][0][0] else 1
+            d, u = heapq.heappop(heaps[side])
+            if u in done[side]:
+                continue
+            done[side].add(u)
+            other = 1 - side
+            for v, w in self._neighbors(u, side == 0, undirected):
+                nd = d + w
+                if nd > cutoff or nd >= dist[side].get(v, _INF):
+                    continue
+                dist[side][v] = nd
+                pred[side][v] = u
+                heapq.heappush(heaps[side], (nd, v))
+                total = nd + dist[other].get(v, _INF)
+                if total < mu and total <= cutoff:
+                    mu, meet = total, v
+        if meet is None:
+            return None
+        path = [meet]
+        while path[-1] != s:
+            path.append(pred[0][path[-1]])
+        path.reverse()
+        while path[-1] != t:
+            path.append(pred[1][path[-1]])
+        return path
+
+    def _reverse_tree(self, t: int, cutoff: float) -> dict[int, float]:
+        """Distance from every node to *t* (nodes farther than *cutoff* omitted)."""
+        dist = {t: 0.0}
+        heap = [(0.0, t)]
+        while heap:
+            d, u = heapq.heappop(heap)
+            if d > dist.get(u, _INF):
+                continue
+            for v, w in self._neighbors(u, False, False):
+                nd = d + w
+                if nd <= cutoff and nd < dist.get(v, _INF):
+                    dist[v] = nd
+                    heapq.heappush(heap, (nd, v))
+        return dist
+
+    def _spur(
+        self,
+        s: int,
+        t: int,
+        to_target: dict[int, float],
+        banned_nodes: set[int],
+        banned_edges: set[tuple[int, int]],
+        budget: float,
+    ) -> tuple[float, list[int]] | None:
+        """A* from *s* to *t* avoiding banned nodes/edges, within *budget*."""
+        if s not in to_target:
+            return None
+        g = {s: 0.0}
+        pred: dict[int, int] = {}
+        heap = [(to_target[s], s)]
+        while heap:
+            f, u = heapq.heappop(heap)
+            gu = g[u]
+            if f > gu + to_target[u]:
+                continue  # stale entry
+            if u == t:
+                path = [t]
+                while path[-1] != s:
+                    path.append(pred[path[-1]])
+                path.reverse()
+                return gu, path
+            for v, w in self._neighbors(u, True, False):
+                h = to_target.get(v)
+                if h is None or v in banned_nodes or (u, v) in banned_edges:
+                    continue
+                nv = gu + w
+                if nv + h > budget or nv >= g.get(v, _INF):
+                    continue
+                g[v] = nv
+                pred[v] = u
+                heapq.heappush(heap, (nv + h, v))
+        return None
+
+    def _cost(self, path: list[int]) -> float:
+        return sum(self._weight(u, v) for u, v in zip(path, path[1:]))
+
+    def k_shortest(self, source_id: int, target_id: int, k: int, cutoff: float | None = None) -> list[list[int]]:
+        """Up to *k* loopless shortest directed paths (Yen), as symbol ids."""
+        s, t = self._index.get(source_id), self._index.get(target_id)
+        if s is None or t is None or k <= 0:
+            return []
+        limit = _INF if cutoff is None else float(cutoff)
+        first = self._bidirectional(s, t, limit)
+        if first is None:
+            return []
+        found = [first]
+        if k > 1 and s != t:
+            to_target = self._reverse_tree(t, limit)
+            candidates: list[tuple[float, tuple[int, ...]]] = []
+            queued: set[tuple[int, ...]] = {tuple(first)}
+            while len(found) < k:
+                prev = found[-1]
+                root_cost = 0.0
+                for i in range(len(prev) - 1):
+                    spur = prev[i]
+                    root = prev[: i + 1]
+                    banned_edges = {(p[i], p[i + 1]) for p in found if len(p) > i + 1 and p[: i + 1] == root}
+                    hit = self._spur(spur, t, to_target, set(root[:-1]), banned_edges, limit - root_cost)
+                    if hit is not None:
+                        cost, spur_path = hit
+                        path = tuple(root[:-1] + spur_path)
+                        if path not in queued:
+                            queued.add(path)
+                            heapq.heappush(candidates, (root_cost + cost, path))
+                    root_cost += self._weight(prev[i], prev[i + 1])
+                if not candidates:
+                    break
+                found.append(list(heapq.heappop(candidates)[1]))
+        ids = self.ids
+        return [[ids[i] for i in p] for p in found]
+
+    def undirected_path(self, source_id: int, target_id: int, cutoff: float | None = None) -> list[int]:
+        """Cheapest path ignoring edge direction, or [] when disconnected."""
+        s, t = self._index.get(source_id), self._index.get(target_id)
+        if s is None or t is None:
+            return []
+        path = self._bidirectional(s, t, _INF if cutoff is None else float(cutoff), undirected=True)
+        return [self.ids[i] for i in path] if path else []
+
+
+def find_k_paths(
+    G: nx.DiGraph | PathGraph,
+    source_id: int,
+    target_id: int,
+    k: int = 3,
+    *,
+    cutoff: float | None = None,
+) -> list[list[int]]:
     """Find up to *k* shortest simple paths from *source_id* to *target_id*.
 
-    Uses Yen's algorithm via ``nx.shortest_simple_paths``.  Falls back to an
+    *G* is a :class:`PathGraph` (preferred; build it once with
+    :meth:`PathGraph.from_db`) or a NetworkX graph, which is converted.
+    Paths costlier than *cutoff* are not returned.  Falls back to an
     undirected single-path search when no directed path exists.  Returns an
     empty list when the nodes are completely disconnected.
     """
-    if source_id not in G or target_id not in G:
+    graph = G if isinstance(G, PathGraph) else PathGraph.from_networkx(G)
+    if source_id not in graph or target_id not in graph:
         return []
 
-    _ensure_weights(G)
-
     # Directed: k-shortest simple paths
-    try:
-        paths = list(
-            itertools.islice(
-                nx.shortest_simple_paths(G, source_id, target_id, weight="weight"),
-                k,
-            )
-        )
-        if paths:
-            return paths
-    except (nx.NetworkXNoPath, nx.NodeNotFound):
-        pass
+    paths = graph.k_shortest(source_id, target_id, k, cutoff)
+    if paths:
+        return paths
 
     # Undirected fallback (single path only)
-    try:
-        undirected = G.to_undirected()
-        return [list(nx.shortest_path(undirected, source_id, target_id, weight="weight"))]
-    except (nx.NetworkXNoPath, nx.NodeNotFound):
-        return []
+    path = graph.undirected_path(source_id, target_id, cutoff)
+    return [path] if path else []
 
 
 def find_symbol_id(conn: sqlite3.Connection, name: str) -> list[int]:
@@ -0,0 +1,203 @@
+"""Test reachability: which test files reach each symbol, and in how many hops.
+
+Tests are the test functions of test files: callables named like tests
+(``test_x``, ``TestX``, ``x_test``, ``xSpec``) in files classified by
+:func:`roam.commands.changed_files.is_test_file`, the classifier every
+test lookup shares.  A file with no such names (e.g. ``it(...)`` suites)
+contributes all of its functions and methods; fixtures, constants and
+classes are never seeds.  A breadth-first walk from the tests along
+call-graph edges, bounded to :data:`TEST_REACH_MAX_HOPS`, finds every
+symbol they exercise directly (1 hop) or transitively.
+
+The indexer stores one ``test_reach`` row per (symbol, test file): the
+nearest test in that file, its hop count and the symbol's caller on that
+path (``via_id``).  Each symbol keeps only its
+:data:`TEST_REACH_MAX_FILES` nearest test files, so the table holds at
+most symbols x ``TEST_REACH_MAX_FILES`` rows however many test files the
+project has.  Readers such as ``has_test`` rule requirements,
+``roam test-gaps`` and the affected-tests lookups then issue one indexed
+lookup instead of walking reverse edges per symbol; affected-tests walks
+the graph for symbols at the cap, since their list may be incomplete.
+
+The table is only trusted when it is populated and the ``test_reach``
+phase is not marked dirty.  Otherwise :func:`has_test_reach` returns
+False and callers walk the graph as before.
+"""
+
+from __future__ import annotations
+
+import re
+import sqlite3
+from collections import defaultdict
+
+from roam.db.connection import batched_in
+
+# Deepest hop count stored; covers test-gaps (10) and affected tests (8)
+TEST_REACH_MAX_HOPS = 10
+
+# Nearest test files kept per symbol
+TEST_REACH_MAX_FILES = 32
+
+_CALLABLE_KINDS = ("function", "method")
+_TEST_NAME_RE = re.compile(r"^(test|Test)|(_test|Test|_spec|Spec)$")
+
+_INSERT_CHUNK = 50_000
+
+
+def is_test_function(name: str | None) -> bool:
+    """True when *name* reads like a test function or method."""
+    return bool(name) and _TEST_NAME_RE.search(name) is not None
+
+
+def collect_test_symbols(conn) -> dict[int, list[int]]:
+    """``{file_id: [symbol_id, ...]}``: the tests of every test file."""
+    from roam.commands.changed_files import is_test_file
+
+    test_files = {fid for fid, path in conn.execute("SELECT id, path FROM files").fetchall() if is_test_file(path)}
+    if not test_files:
+        return {}
+    rows = batched_in(
+        conn,
+        "SELECT id, file_id, name FROM symbols WHERE file_id IN ({ph}) AND kind IN (?, ?)",
+        sorted(test_files),
+        post=_CALLABLE_KINDS,
+    )
+    callables: dict[int, list[int]] = defaultdict(list)
+    named: dict[int, list[int]] = defaultdict(list)
+    for sid, fid, name in sorted((int(r[0]), int(r[1]), r[2]) for r in rows):
+        callables[fid].append(sid)
+        if is_test_function(name):
+            named[fid].append(sid)
+    return {fid: named.get(fid) or ids for fid, ids in sorted(callables.items())}
+
+
+def compute_test_reach(
+    conn,
+    max_hops: int = TEST_REACH_MAX_HOPS,
+    max_files: int = TEST_REACH_MAX_FILES,
+):
+    """Yield ``(symbol_id, test_file_id, hops, test_id, via_id)`` rows.
+
+    One level-by-level walk over the deduplicated call graph from the
+    tests of every file at once.  A symbol is reached at most once per
+    test file, from its nearest test (lowest test id on ties), and accepts
+    its first *max_files* files; a file that arrives after that is not
+    carried further through the symbol, which bounds the work as well as
+    the rows.  ``via_id`` is the symbol's caller on that path (None for
+    direct calls from the test itself).
+    """
+    tests = collect_test_symbols(conn)
+    if not tests:
+        return
+    adj: dict[int, list[int]] = defaultdict(list)
+    for src, tgt in conn.execute("SELECT DISTINCT source_id, target_id FROM edges"):
+        if src != tgt:
+            adj[src].append(tgt)
+
+    seeds = {fid: set(ids) for fid, ids in tests.items()}
+    reached: dict[int, set[int]] = {}
+    frontier = [(t, fid, t) for fid, ids in tests.items() for t in ids if t in adj]
+    hops = 0
+    while frontier and hops < max_hops:
+        hops += 1
+        next_frontier = []
+        for current, file_id, test_id in frontier:
+            via = current if hops > 1 else None
+            for nxt in adj.get(current, ()):
+                if nxt == test_id:
+                    continue
+                files = reached.get(nxt)
+                if files is None:
+                    files = reached[nxt] = set()
+                elif file_id in files or len(files) >= max_files:
+                    continue
+                files.add(file_id)
+                yield nxt, file_id, hops, test_id, via
+                # Tests of the same file were expanded at hop 0
+                if nxt not in seeds[file_id]:
+                    next_frontier.append((nxt, file_id, test_id))
+        frontier = next_frontier
+
+
+def store_test_reach(
+    conn,
+    max_hops: int = TEST_REACH_MAX_HOPS,
+    max_files: int = TEST_REACH_MAX_FILES,
+) -> int:
+    """Recompute the ``test_reach`` table; returns the number of rows."""
+    conn.execute("DELETE FROM test_reach")
+    total = 0
+    chunk: list[tuple] = []
+    for row in compute_test_reach(conn, max_hops, max_files):
+        chunk.append(row)
+        if len(chunk) >= _INSERT_CHUNK:
+            conn.executemany("INSERT INTO test_reach VALUES (?, ?, ?, ?, ?)", chunk)
+            total += len(chunk)
+            chunk = []
+    if chunk:
+        conn.executemany("INSERT INTO test_reach VALUES (?, ?, ?, ?, ?)", chunk)
+        total += len(chunk)
+    return total
+
+
+def has_test_reach(conn) -> bool:
+    """True when ``test_reach`` is populated and not stale."""
+    try:
+        if conn.execute("SELECT 1 FROM index_dirty WHERE phase = 'test_reach'").fetchone():
+            return False
+        return conn.execute("SELECT 1 FROM test_reach LIMIT 1").fetchone() is not None
+    except sqlite3.OperationalError:
+        return False  # index predates the table
+
+
+def directly_tested_ids(conn) -> set[int] | None:
+    """Ids of symbols called directly from a test, or None when unavailable."""
+    if not has_test_reach(conn):
+        return None
+    return {r[0] for r in conn.execute("SELECT DISTINCT symbol_id FROM test_reach WHERE hops = 1")}
+
+
+def load_test_files(conn, symbol_ids, max_hops: int = TEST_REACH_MAX_HOPS) -> dict[int, set[str]] | None:
+    """``{symbol_id: {test_file_path}}`` for tests within *max_hops*.
+
+    Lists at most the :data:`TEST_REACH_MAX_FILES` nearest files per
+    symbol.  Returns None when the stored table cannot answer (missing, stale, or
+    *max_hops* deeper than what was stored).
+    """
+    if max_hops > TEST_REACH_MAX_HOPS or not has_test_reach(conn):
+        return None
+    rows = batched_in(
+        conn,
+        "SELECT DISTINCT tr.symbol_id, f.path FROM test_reach tr "
+        "JOIN files f ON f.id = tr.test_file_id "
+        "WHERE tr.symbol_id IN ({ph}) AND tr.hops <= ?",
+        sorted(set(symbol_ids)),
+        post=[max_hops],
+    )
+    out: dict[int, set[str]] = {}
+    for sid, path in rows:
+        out.setdefault(int(sid), set()).add(path)
+    return out
+
+
+def load_reaching_tests(conn, symbol_id: int, max_hops: int = TEST_REACH_MAX_HOPS) -> list | None:
+    """Rows ``(name, file_path, hops, via)``: the nearest test of each test
+    file reaching *symbol_id*.
+
+    Ordered by hop count.  Returns None when the stored table cannot answer,
+    including symbols at the :data:`TEST_REACH_MAX_FILES` cap.
+    """
+    if max_hops > TEST_REACH_MAX_HOPS or not has_test_reach(conn):
+        return None
+    stored = conn.execute("SELECT COUNT(*) FROM test_reach WHERE symbol_id = ?", (symbol_id,)).fetchone()[0]
+    if stored >= TEST_REACH_MAX_FILES:
+        return None
+    return conn.execute(
+        "SELECT t.name, f.path, tr.hops, v.name FROM test_reach tr "
+        "JOIN symbols t ON t.id = tr.test_id "
+        "JOIN files f ON f.id = tr.test_file_id "
+        "LEFT JOIN symbols v ON v.id = tr.via_id "
+        "WHERE tr.symbol_id = ? AND tr.hops <= ? "
+        "ORDER BY tr.hops, f.path, t.name",
+        (symbol_id, max_hops),
+    ).fetchall()
@@ -1,5 +1,12 @@
 """Indexing pipeline: discovery, parsing, symbol extraction, and orchestration."""
 
-from roam.index.indexer import Indexer
-
 __all__ = ["Indexer"]
+
+
+def __getattr__(name):
+    # Lazy so that light helpers (file_roles, incremental) skip the pipeline
+    if name == "Indexer":
+        from roam.index.indexer import Indexer
+
+        return Indexer
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
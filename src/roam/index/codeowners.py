@@ -0,0 +1,405 @@
+"""CODEOWNERS parsing, compiled matching and persisted file ownership.
+
+Rules use gitignore-style patterns and the last matching rule wins.
+Testing every rule against every file is O(rules x files), which takes
+minutes on large monorepos, so :class:`CodeownersMatcher` compiles the
+rules once and indexes each under the one thing a matching path must
+contain:
+
+* literal leading path segments (``/src/api/``, ``docs/*.md``) -- a
+  segment trie walked along the path,
+* a directory name anywhere in the path (unanchored ``build/``),
+* an exact basename (``Makefile``) or a final extension (``*.py``),
+
+and keeps the few rules that fit none of these in a short list that is
+always checked.  A lookup gathers candidates in time proportional to the
+path depth and verifies them newest-first, stopping at the first match.
+
+The indexer materialises the file -> owners mapping in ``file_owners``
+(:func:`refresh_file_owners`).  It is recomputed in full only when the
+CODEOWNERS file changes; otherwise only files without a row (new or
+reindexed ones) are resolved.
+"""
+
+from __future__ import annotations
+
+import fnmatch
+import functools
+import hashlib
+import os
+import re
+from pathlib import Path, PurePosixPath
+
+# CODEOWNERS locations (checked in order)
+CODEOWNERS_LOCATIONS = [
+    "CODEOWNERS",
+    ".github/CODEOWNERS",
+    "docs/CODEOWNERS",
+    ".gitlab/CODEOWNERS",
+]
+
+_GLOB_CHARS = "*?["
+
+
+# ---------------------------------------------------------------------------
+# Parser
+# ---------------------------------------------------------------------------
+
+
+def find_codeowners(project_root: Path) -> Path | None:
+    """Find the CODEOWNERS file in standard locations.
+
+    Returns the first matching path, or None if no file exists.
+    """
+    for loc in CODEOWNERS_LOCATIONS:
+        candidate = project_root / loc
+        if candidate.is_file():
+            return candidate
+    return None
+
+
+def parse_codeowners(codeowners_path: str | Path) -> list[tuple[str, list[str]]]:
+    """Parse a CODEOWNERS file into (pattern, owners) tuples.
+
+    Format:
+    - Lines starting with # are comments
+    - Empty lines are ignored
+    - Pattern followed by one or more owners: ``*.py @backend-team @alice``
+    - Later rules override earlier ones (last match wins)
+    """
+    path = Path(codeowners_path)
+    if not path.is_file():
+        return []
+
+    rules: list[tuple[str, list[str]]] = []
+    try:
+        text = path.read_text(encoding="utf-8", errors="replace")
+    except OSError:
+        return []
+
+    for line in text.splitlines():
+        line = line.strip()
+        # Skip comments and empty lines
+        if not line or line.startswith("#"):
+            continue
+        # Inline comments (# after whitespace)
+        if " #" in line:
+            line = line[: line.index(" #")].strip()
+        parts = line.split()
+        if len(parts) < 2:
+            # Pattern with no owner = explicitly unowned (clears ownership)
+            rules.append((parts[0], []))
+            continue
+        pattern = parts[0]
+        owners = parts[1:]
+        rules.append((pattern, owners))
+
+    return rules
+
+
+# ---------------------------------------------------------------------------
+# Pattern matching (gitignore-style)
+# ---------------------------------------------------------------------------
+
+
+def _fnmatcher(pattern: str):
+    """Compiled ``fnmatch.fnmatch(name, pattern)``."""
+    rx = re.compile(fnmatch.translate(os.path.normcase(pattern)))
+    return lambda name: rx.match(os.path.normcase(name)) is not None
+
+
+def _doublestar_regex(pattern: str, anchored: bool) -> re.Pattern:
+    """Regex for a pattern containing ``**``.
+
+    ``**`` matches zero or more path segments (directories).
+    When ``**`` is surrounded by ``/`` (e.g. ``src/**/foo``), it can
+    match zero segments (``src/foo``) or many (``src/a/b/foo``).
+    """
+    # ** means "zero or more path segments" — we must absorb adjacent
+    # slashes so that a/**/b matches both a/b and a/x/y/b.
+    regex = ""
+    i = 0
+    plen = len(pattern)
+    while i < plen:
+        if pattern[i : i + 2] == "**":
+            # Absorb trailing slash after **: a/**/ -> a/ or a/x/y/
+            end = i + 2
+            if end < plen and pattern[end] == "/":
+                end += 1
+            # ** with absorbed trailing / becomes (.*/)? — zero or more
+            # path segments ending with /
+            regex += "(.*/)?"
+            i = end
+        elif pattern[i] == "*":
+            regex += "[^/]*"
+            i += 1
+        elif pattern[i] == "?":
+            regex += "[^/]"
+            i += 1
+        elif pattern[i] == ".":
+            regex += r"\."
+            i += 1
+        else:
+            regex += re.escape(pattern[i])
+            i += 1
+
+    if anchored:
+        regex = "^" + regex + "$"
+    else:
+        regex = "(^|.*/)" + regex + "$"
+    return re.compile(regex)
+
+
+@functools.lru_cache(maxsize=8192)
+def compile_pattern(pattern: str):
+    """Compile a CODEOWNERS *pattern* into a predicate over ``/``-separated paths.
+
+    - ``*`` matches anything except ``/``
+    - ``**`` matches anything including ``/``
+    - Leading ``/`` means anchored to repo root
+    - Trailing ``/`` means directory match (any file under that dir)
+    - No leading ``/`` means match the basename or partial path
+    """
+    # Directory pattern: trailing / matches everything under that dir
+    if pattern.endswith("/"):
+        dir_pattern = pattern.rstrip("/")
+        # Anchored directory
+        if dir_pattern.startswith("/"):
+            dir_pattern = dir_pattern[1:]
+            prefix = dir_pattern + "/"
+            return lambda fp: fp.startswith(prefix) or fp == dir_pattern
+        # Unanchored directory
+        prefix = dir_pattern + "/"
+        inner = "/" + dir_pattern + "/"
+        return lambda fp: fp.startswith(prefix) or inner in ("/" + fp)
+
+    # Anchored pattern (starts with /)
+    anchored = pattern.startswith("/")
+    if anchored:
+        pattern = pattern[1:]
+
+    # Handle ** patterns
+    if "**" in pattern:
+        rx = _doublestar_regex(pattern, anchored)
+        return lambda fp: rx.match(fp) is not None
+
+    # Anchored, or unanchored with a /: match against the full path
+    if anchored or "/" in pattern:
+        return _fnmatcher(pattern)
+
+    # No slash in pattern: match against the basename
+    match = _fnmatcher(pattern)
+    return lambda fp: match(PurePosixPath(fp).name)
+
+
+def codeowners_match(pattern: str, filepath: str) -> bool:
+    """Match a CODEOWNERS pattern against a file path."""
+    return compile_pattern(pattern)(filepath.replace("\\", "/"))
+
+
+def _literal_prefix(pattern: str) -> str:
+    """The part of *pattern* before its first glob character."""
+    cut = min((i for i in (pattern.find(c) for c in _GLOB_CHARS) if i >= 0), default=len(pattern))
+    return pattern[:cut]
+
+
+def _extension(name: str) -> str | None:
+    return name.rsplit(".", 1)[1] if "." in name else None
+
+
+class _Node:
+    __slots__ = ("children", "rules")
+
+    def __init__(self):
+        self.children: dict[str, _Node] = {}
+        self.rules: list[int] = []
+
+
+class CodeownersMatcher:
+    """CODEOWNERS rules compiled for lookups proportional to path depth.
+
+    ``owners(path)`` returns the same owners as testing every rule in
+    order with :func:`codeowners_match` and keeping the last match.
+    """
+
+    def __init__(self, rules: list[tuple[str, list[str]]]):
+        self.rules = list(rules)
+        self._predicates = [compile_pattern(p) for p, _ in self.rules]
+        self._trie = _Node()
+        self._dir_anywhere: dict[str, list[int]] = {}
+        self._names: dict[str, list[int]] = {}
+        self._exts: dict[str, list[int]] = {}
+        self._always: list[int] = []
+        for i, (pattern, _owners) in enumerate(self.rules):
+            self._index(i, pattern)
+
+    def _index(self, i: int, pattern: str) -> None:
+        if pattern.endswith("/"):
+            dir_pattern = pattern.rstrip("/")
+            if dir_pattern.startswith("/"):
+                # Directory prefix, compared literally
+                self._add_prefix(i, dir_pattern[1:].split("/"))
+            elif dir_pattern:
+                self._dir_anywhere.setdefault(dir_pattern.split("/")[0], []).append(i)
+            else:
+                self._always.append(i)
+            return
+
+        anchored = pattern.startswith("/")
+        body = pattern[1:] if anchored else pattern
+        if "**" not in body and "/" not in body and not anchored:
+            # Basename pattern
+            if not any(c in body for c in _GLOB_CHARS):
+                self._names.setdefault(body, []).append(i)
+                return
+        elif anchored or "**" not in body:
+            # Matched against the full path: literal leading segments
+            literal = _literal_prefix(body)
+            if literal == body:
+                self._add_prefix(i, body.split("/"))
+                return
+            dirs = literal.split("/")[:-1]
+            if dirs:
+                self._add_prefix(i, dirs)
+                return
+
+        # A literal extension at the end must be the file's extension
+        ext = body.rsplit(".", 1)[1] if "." in body else ""
+        if ext and not any(c in ext for c in "*?[]/"):
+            self._exts.setdefault(ext, []).append(i)
+            return
+        self._always.append(i)
+
+    def _add_prefix(self, i: int, segments: list[str]) -> None:
+        node = self._trie
+        for seg in segments:
+            node = node.children.setdefault(seg, _Node())
+        node.rules.append(i)
+
+    def _candidates(self, path: str) -> list[int]:
+        segs = path.split("/")
+        cands = list(self._always)
+        node = self._trie
+        cands += node.rules
+        for seg in segs:
+            node = node.children.get(seg)
+            if node is None:
+                break
+            cands += node.rules
+        for seg in segs[:-1]:
+            cands += self._dir_anywhere.get(seg, ())
+        name = segs[-1]
+        cands += self._names.get(name, ())
+        ext = _extension(name)
+        if ext is not None:
+            cands += self._exts.get(ext, ())
+        return cands
+
+    def match(self, path: str) -> int | None:
+        """Index of the winning (last matching) rule for *path*, or None."""
+        path = path.replace("\\", "/")
+        for i in sorted(set(self._candidates(path)), reverse=True):
+            if self._predicates[i](path):
+                return i
+        return None
+
+    def owners(self, path: str) -> list[str]:
+        """Owners of *path*; empty when no rule matches or the winner has none."""
+        i = self.match(path)
+        return list(self.rules[i][1]) if i is not None else []
+
+
+def resolve_owners(rules: list[tuple[str, list[str]]], filepath: str) -> list[str]:
+    """Determine the owner(s) of a file by applying CODEOWNERS rules.
+
+    Last matching rule wins (standard CODEOWNERS semantics).
+    Returns an empty list if no rule matches.  For many files, compile
+    the rules once with :class:`CodeownersMatcher` instead.
+    """
+    owners: list[str] = []
+    for pattern, rule_owners in rules:
+        if codeowners_match(pattern, filepath):
+            owners = rule_owners
+    return owners
+
+
+# ---------------------------------------------------------------------------
+# Persisted ownership
+# ---------------------------------------------------------------------------
+
+
+def _digest(project_root: Path, co_path: Path) -> str:
+    rel = co_path.relative_to(project_root).as_posix()
+    return hashlib.sha256(rel.encode() + b"\0" + co_path.read_bytes()).hexdigest()
+
+
+def refresh_file_owners(conn, project_root: Path) -> int:
+    """Bring ``file_owners`` up to date with the CODEOWNERS file.
+
+    Everything is recomputed when CODEOWNERS changed (or appeared);
+    otherwise only files without a row.  Returns the number of files
+    resolved.
+    """
+    co_path = find_codeowners(project_root)
+    state = conn.execute("SELECT digest FROM codeowners_state WHERE id = 1").fetchone()
+    if co_path is None:
+        if state is not None:
+            conn.execute("DELETE FROM file_owners")
+            conn.execute("DELETE FROM codeowners_state")
+        return 0
+    try:
+        digest = _digest(project_root, co_path)
+    except OSError:
+        return 0
+    if state is None or state[0] != digest:
+        conn.execute("DELETE FROM file_owners")
+        conn.execute(
+            "INSERT OR REPLACE INTO codeowners_state (id, path, digest) VALUES (1, ?, ?)",
+            (co_path.relative_to(project_root).as_posix(), digest),
+        )
+    todo = conn.execute(
+        "SELECT f.id, f.path FROM files f LEFT JOIN file_owners fo ON fo.file_id = f.id WHERE fo.file_id IS NULL"
+    ).fetchall()
+    if not todo:
+        return 0
+    matcher = CodeownersMatcher(parse_codeowners(co_path))
+    conn.executemany(
+        "INSERT INTO file_owners (file_id, owners) VALUES (?, ?)",
+        [(fid, " ".join(matcher.owners(path))) for fid, path in todo],
+    )
+    return len(todo)
+
+
+def load_file_owners(conn, project_root: Path, co_path: Path | None = None) -> dict[int, list[str]]:
+    """``{file_id: owners}`` for every indexed file.
+
+    Reads ``file_owners`` when it was built from the current CODEOWNERS
+    and resolves any file it lacks; otherwise resolves every file with a
+    freshly compiled matcher.  Never writes, so read-only connections work.
+    """
+    if co_path is None:
+        co_path = find_codeowners(project_root)
+    if co_path is None:
+        return {}
+    out: dict[int, list[str]] = {}
+    todo: list[tuple[int, str]] = []
+    try:
+        state = conn.execute("SELECT digest FROM codeowners_state WHERE id = 1").fetchone()
+        current = state is not None and state[0] == _digest(project_root, co_path)
+    except Exception:
+        current = False
+    if current:
+        for fid, path, owners in conn.execute(
+            "SELECT f.id, f.path, fo.owners FROM files f LEFT JOIN file_owners fo ON fo.file_id = f.id"
+        ).fetchall():
+            if owners is None:
+                todo.append((fid, path))
+            else:
+                out[fid] = owners.split()
+    else:
+        todo = [tuple(r) for r in conn.execute("SELECT id, path FROM files").fetchall()]
+    if todo:
+        matcher = CodeownersMatcher(parse_codeowners(co_path))
+        for fid, path in todo:
+            out[fid] = matcher.owners(path)
+    return out
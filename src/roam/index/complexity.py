@@ -995,17 +995,79 @@ def _is_bounded_loop(loop_node, source: bytes) -> bool:
 # ── Batch computation + storage ──────────────────────────────────────
 
 
+_METRIC_COLUMNS = (
+    "cognitive_complexity, nesting_depth, param_count, line_count, return_count, bool_op_count, "
+    "callback_depth, cyclomatic_density, halstead_volume, halstead_difficulty, halstead_effort, halstead_bugs"
+)
+_MATH_COLUMNS = (
+    "loop_depth, has_nested_loops, calls_in_loops, calls_in_loops_qualified, subscript_in_loops, "
+    "has_self_call, loop_with_compare, loop_with_accumulator, loop_with_multiplication, loop_with_modulo, "
+    "self_call_count, str_concat_in_loop, loop_invariant_calls, loop_lookup_calls, front_ops_in_loop, "
+    "loop_bound_small"
+)
+
+
+def snapshot_file_metrics(conn: sqlite3.Connection, file_id: int) -> dict:
+    """Stored metrics of a file's symbols, keyed by (qualified_name, kind, line_start, line_end).
+
+    Taken before a file is reindexed so :func:`carried_metrics` can reuse
+    the rows of symbols an incremental reparse did not touch.
+    """
+    n_metrics = _METRIC_COLUMNS.count(",") + 1
+    math_cols = ", ".join(f"ms.{c.strip()}" for c in _MATH_COLUMNS.split(","))
+    metric_cols = ", ".join(f"sm.{c.strip()}" for c in _METRIC_COLUMNS.split(","))
+    rows = conn.execute(
+        f"SELECT s.qualified_name, s.name, s.kind, s.line_start, s.line_end, {metric_cols}, "
+        f"ms.symbol_id IS NOT NULL, {math_cols} "
+        "FROM symbols s JOIN symbol_metrics sm ON sm.symbol_id = s.id "
+        "LEFT JOIN math_signals ms ON ms.symbol_id = s.id WHERE s.file_id = ?",
+        (file_id,),
+    ).fetchall()
+    out = {}
+    for r in rows:
+        r = tuple(r)
+        key = (r[0] or r[1], r[2], r[3], r[4])
+        metrics = r[5 : 5 + n_metrics]
+        math = r[6 + n_metrics :] if r[5 + n_metrics] else None
+        out[key] = (metrics, math)
+    return out
+
+
+def carried_metrics(delta, snapshot: dict):
+    """Lookup reusing snapshot rows for symbols outside the edited lines.
+
+    *delta* is a :class:`~roam.index.tree_cache.ParseDelta`.  Returns a
+    callable ``(qualified_name, kind, line_start, line_end)`` giving the old
+    ``(metrics, math)`` values, or None when the symbol must be recomputed.
+    """
+
+    def lookup(qualified_name, kind, line_start, line_end):
+        if delta.touches(line_start, line_end):
+            return None
+        old_start, old_end = delta.old_line(line_start), delta.old_line(line_end)
+        if old_start is None or old_end is None:
+            return None
+        return snapshot.get((qualified_name, kind, old_start, old_end))
+
+    return lookup
+
+
 def compute_and_store(
     conn: sqlite3.Connection,
     file_id: int,
     tree,
     source: bytes,
-):
+    reuse=None,
+) -> int:
     """Compute complexity metrics for all function/method symbols in a file
     and store them in the symbol_metrics table.
 
     Only processes symbols with kind in ('function', 'method', 'generator',
     'constructor', 'property') — classes/modules are skipped.
+
+    *reuse* (see :func:`carried_metrics`) supplies stored values for symbols
+    an incremental reparse left untouched; those are copied instead of
+    re-walking their subtrees.  Returns the number of symbols reused.
     """
     CALLABLE_KINDS = (
         "function",
@@ -1018,12 +1080,13 @@ def compute_and_store(
     )
 
     rows = conn.execute(
-        "SELECT id, name, kind, line_start, line_end FROM symbols WHERE file_id = ?",
+        "SELECT id, name, qualified_name, kind, line_start, line_end FROM symbols WHERE file_id = ?",
         (file_id,),
     ).fetchall()
 
     metrics_batch = []
     math_batch = []
+    reused = 0
     for row in rows:
         kind = row["kind"] or ""
         if kind not in CALLABLE_KINDS:
@@ -1033,6 +1096,15 @@ def compute_and_store(
         if ls is None or le is None:
             continue
 
+        if reuse is not None:
+            carried = reuse(row["qualified_name"] or row["name"], kind, ls, le)
+            if carried is not None:
+                metrics_batch.append((row["id"], *carried[0]))
+                if carried[1] is not None:
+                    math_batch.append((row["id"], *carried[1]))
+                reused += 1
+                continue
+
         metrics = compute_symbol_complexity(tree, source, ls, le)
         if metrics is None:
             continue
@@ -1106,3 +1178,5 @@ def compute_and_store(
                VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)""",
             math_batch,
         )
+
+    return reused
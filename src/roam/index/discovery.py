@@ -336,3 +336,17 @@ def discover_files(root: Path, include_excluded: bool = False) -> list[str]:
     )
     filtered.sort()
     return filtered
+
+
+def filter_paths(root: Path, paths: list[str], include_excluded: bool = False) -> list[str]:
+    """Apply discovery filtering to known *paths* without listing the tree.
+
+    Applies the same skip lists, exclude patterns, size limit and
+    generated-file check; missing files are dropped.  ``.gitignore`` is
+    not consulted, so callers should pass paths that came from discovery
+    or from a watcher over discovered files.
+    """
+    root = Path(root).resolve()
+    paths = [p.replace("\\", "/") for p in paths]
+    exclude_patterns = load_exclude_patterns(root)
+    return _filter_files(paths, root, exclude_patterns, include_excluded)
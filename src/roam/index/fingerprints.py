@@ -0,0 +1,352 @@
+"""Per-symbol fingerprints and retained file versions for index-time diffs.
+
+Every indexed symbol gets two hashes:
+
+* ``sig_hash`` -- kind plus the whitespace-normalised signature,
+* ``body_hash`` -- the symbol's source text with comments removed and
+  whitespace outside string literals collapsed (kept only as a single
+  separator between identifier characters), so reformatting and comment
+  edits do not count as modifications but ``return x`` and ``returnx`` do.
+  In indentation-sensitive languages each line break outside brackets is
+  kept together with its indentation, since it is block structure.
+
+Files record the git blob id of the indexed content (``files.blob_sha``)
+and, per (path, blob) version, the file's import keys
+(``file_fingerprints``).  When the indexer replaces or removes a file, the
+outgoing version's symbol rows are copied to ``symbol_fingerprints``
+instead of being lost.  A diff against a git ref then needs one
+``git ls-tree`` to learn the ref's blob per path: versions the index has
+seen are compared with a hash join (:func:`diff_fingerprints`), and only
+unseen versions are re-parsed by the commands.
+
+Retained versions are pruned to the newest :data:`FINGERPRINT_KEEP_VERSIONS`.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import re
+import subprocess
+import time
+from pathlib import Path
+
+FINGERPRINT_KEEP_VERSIONS = 2000
+
+# Line-comment markers per language; block comments are /* */ unless listed
+_HASH_COMMENTS = frozenset({"python", "ruby", "yaml", "hcl", "bash", "perl", "r", "elixir", "nim"})
+_DASH_COMMENTS = frozenset({"sql", "lua", "haskell"})
+_NO_BLOCK_COMMENTS = _HASH_COMMENTS | _DASH_COMMENTS | {"foxpro"}
+# Languages with multi-line triple-quoted string literals
+_TRIPLE_QUOTES = frozenset({"python", "java", "kotlin", "swift", "scala", "julia"})
+# Languages where line breaks and indentation are block structure
+_INDENT_SENSITIVE = frozenset({"python", "yaml", "haskell", "nim", "fsharp", "elm", "coffeescript"})
+
+_WS_RE = re.compile(r"\s+")
+_WORD_BYTES = frozenset(b"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_$")
+
+_SYMBOL_COLUMNS = "stable_key, name, qualified_name, kind, signature, line_start, line_end, visibility, is_exported, sig_hash, body_hash"
+
+
+def git_blob_sha(data: bytes) -> str:
+    """The id git gives *data* as a blob (``git hash-object``)."""
+    h = hashlib.sha1(b"blob %d\0" % len(data))
+    h.update(data)
+    return h.hexdigest()
+
+
+def normalise_signature(signature: str | None) -> str:
+    """Signature with whitespace collapsed and a trailing ``:``/``{`` dropped."""
+    sig = _WS_RE.sub(" ", signature or "").strip()
+    return sig.rstrip("{:").rstrip()
+
+
+def signature_hash(kind: str, signature: str | None) -> str:
+    raw = f"{kind}\0{normalise_signature(signature)}".encode()
+    return hashlib.blake2b(raw, digest_size=12).hexdigest()
+
+
+def _line_comment(language: str | None) -> bytes:
+    if language in _HASH_COMMENTS:
+        return b"#"
+    if language in _DASH_COMMENTS:
+        return b"--"
+    if language == "foxpro":
+        return b"&&"
+    return b"//"
+
+
+def _is_word(c: int) -> bool:
+    # ASCII letters, digits, "_" and "$", plus any non-ASCII byte
+    return c >= 128 or c in _WORD_BYTES
+
+
+def strip_code(text: bytes, language: str | None) -> bytes:
+    """*text* without comments, whitespace collapsed outside string literals.
+
+    A run of whitespace or comments becomes one space between identifier
+    characters and disappears elsewhere.  For indentation-sensitive
+    languages a line that starts outside brackets is prefixed with a line
+    break and its indentation relative to the first line, so moving a
+    statement in or out of a block changes the result while blank lines,
+    comment-only lines and re-wrapped bracketed expressions do not.
+    String literals are copied verbatim; triple-quoted literals (where the
+    language has them) and backtick literals may span lines.
+    """
+    line = _line_comment(language)
+    block = language not in _NO_BLOCK_COMMENTS
+    triple = language in _TRIPLE_QUOTES
+    indented = language in _INDENT_SENSITIVE
+    out = bytearray()
+    gap = False
+    depth = 0
+    line_start = 0  # offset just past the last newline seen
+    new_line = True
+    base: bytes | None = None  # indentation of the first line
+    i, n = 0, len(text)
+    while i < n:
+        c = text[i]
+        if c in b" \t\r\n\f\v":
+            gap = True
+            if c == 10:
+                line_start = i + 1
+                new_line = True
+            i += 1
+            continue
+        if text.startswith(line, i):
+            j = text.find(b"\n", i)
+            i = n if j < 0 else j
+            gap = True
+            continue
+        if block and text.startswith(b"/*", i):
+            j = text.find(b"*/", i + 2)
+            i = n if j < 0 else j + 2
+            gap = True
+            continue
+        if indented and new_line and depth == 0:
+            indent = text[line_start:i]
+            if base is None:
+                base = indent
+            elif out:
+                out += b"\n" + (indent[len(base) :] if indent.startswith(base) else indent)
+                gap = False
+        new_line = False
+        if gap and out and _is_word(out[-1]) and _is_word(c):
+            out.append(32)
+        gap = False
+        if triple and text.startswith((b'"""', b"'''"), i):
+            quote = text[i : i + 3]
+            j = i + 3
+            while j < n and not text.startswith(quote, j):
+                j += 2 if text[j] == 92 else 1
+            out += text[i : j + 3]
+            i = j + 3
+        elif c in b"\"'`":
+            # Copy a string literal verbatim, honouring backslash escapes
+            j = i + 1
+            while j < n and text[j] != c and (text[j] != 10 or c == 96):
+                j += 2 if text[j] == 92 else 1
+            out += text[i : j + 1]
+            i = j + 1
+        else:
+            if c in b"([{":
+                depth += 1
+            elif c in b")]}" and depth:
+                depth -= 1
+            out.append(c)
+            i += 1
+    return bytes(out)
+
+
+def assign_fingerprints(symbols: list[dict], source: bytes | None, language: str | None) -> None:
+    """Set ``sig_hash`` and ``body_hash`` on extracted *symbols* in place."""
+    lines = source.split(b"\n") if source else []
+    for sym in symbols:
+        sym["sig_hash"] = signature_hash(sym.get("kind") or "", sym.get("signature"))
+        ls, le = sym.get("line_start"), sym.get("line_end")
+        if lines and ls and le and ls <= le:
+            body = strip_code(b"\n".join(lines[ls - 1 : le]), language)
+            sym["body_hash"] = hashlib.blake2b(body, digest_size=16).hexdigest()
+        else:
+            sym["body_hash"] = None
+
+
+def import_keys(refs: list[dict]) -> list[str]:
+    """Sorted ``import_path:target`` keys of the import references in *refs*."""
+    keys = set()
+    for r in refs:
+        if r.get("kind") in ("import", "import_from"):
+            target = r.get("target_name", "")
+            imp_path = r.get("import_path", "")
+            if target:
+                keys.add(f"{imp_path}:{target}" if imp_path else target)
+    return sorted(keys)
+
+
+# ---------------------------------------------------------------------------
+# Index-time storage
+# ---------------------------------------------------------------------------
+
+
+def store_file_fingerprint(conn, path: str, blob_sha: str, imports: list[str]) -> None:
+    """Record the import keys of version *blob_sha* of *path*."""
+    conn.execute(
+        "INSERT INTO file_fingerprints (path, blob_sha, imports) VALUES (?, ?, ?) "
+        "ON CONFLICT(path, blob_sha) DO UPDATE SET imports = excluded.imports",
+        (path, blob_sha, "\n".join(imports)),
+    )
+
+
+def retain_file_version(conn, file_id: int) -> bool:
+    """Copy the symbols of indexed file *file_id* to ``symbol_fingerprints``.
+
+    Called before the file's rows are replaced.  Returns False when the
+    file has no blob id (indexed before fingerprints existed).
+    """
+    row = conn.execute("SELECT path, blob_sha FROM files WHERE id = ?", (file_id,)).fetchone()
+    if row is None or not row[1]:
+        return False
+    path, blob = row[0], row[1]
+    conn.execute("DELETE FROM symbol_fingerprints WHERE path = ? AND blob_sha = ?", (path, blob))
+    conn.execute(
+        f"INSERT OR IGNORE INTO symbol_fingerprints (path, blob_sha, {_SYMBOL_COLUMNS}) "
+        f"SELECT ?, ?, {_SYMBOL_COLUMNS} FROM symbols WHERE file_id = ? AND stable_key IS NOT NULL",
+        (path, blob, file_id),
+    )
+    conn.execute(
+        "INSERT INTO file_fingerprints (path, blob_sha, retained_at) VALUES (?, ?, ?) "
+        "ON CONFLICT(path, blob_sha) DO UPDATE SET retained_at = excluded.retained_at",
+        (path, blob, time.time()),
+    )
+    return True
+
+
+def prune_fingerprints(conn, keep: int = FINGERPRINT_KEEP_VERSIONS) -> None:
+    """Drop retained versions beyond the newest *keep*, and orphaned rows."""
+    conn.execute(
+        "DELETE FROM file_fingerprints WHERE retained_at IS NOT NULL AND rowid NOT IN ("
+        "  SELECT rowid FROM file_fingerprints WHERE retained_at IS NOT NULL "
+        "  ORDER BY retained_at DESC LIMIT ?)",
+        (keep,),
+    )
+    # Versions neither retained nor currently indexed (e.g. replaced before
+    # they could be retained) carry nothing useful
+    conn.execute(
+        "DELETE FROM file_fingerprints WHERE retained_at IS NULL AND NOT EXISTS ("
+        "  SELECT 1 FROM files f WHERE f.path = file_fingerprints.path AND f.blob_sha = file_fingerprints.blob_sha)"
+    )
+    conn.execute(
+        "DELETE FROM symbol_fingerprints WHERE NOT EXISTS ("
+        "  SELECT 1 FROM file_fingerprints ff WHERE ff.path = symbol_fingerprints.path "
+        "  AND ff.blob_sha = symbol_fingerprints.blob_sha AND ff.retained_at IS NOT NULL)"
+    )
+
+
+# ---------------------------------------------------------------------------
+# Diffing against a git ref
+# ---------------------------------------------------------------------------
+
+
+def ref_blobs(root: Path, ref: str) -> dict[str, str] | None:
+    """``{path: blob_sha}`` for every file at *ref*, or None when git fails."""
+    try:
+        result = subprocess.run(
+            ["git", "ls-tree", "-r", "-z", ref],
+            cwd=str(root),
+            capture_output=True,
+            timeout=30,
+        )
+    except (FileNotFoundError, subprocess.TimeoutExpired):
+        return None
+    if result.returncode != 0:
+        return None
+    out = {}
+    for entry in result.stdout.split(b"\0"):
+        meta, _, path = entry.partition(b"\t")
+        parts = meta.split()
+        if len(parts) == 3 and parts[1] == b"blob":
+            out[path.decode("utf-8", errors="replace")] = parts[2].decode()
+    return out
+
+
+def current_blob(conn, root: Path, path: str) -> str | None:
+    """Blob id of the indexed version of *path* if it matches the file on disk.
+
+    Returns "" when the file is gone from both disk and index, and None when
+    the index is stale for *path* (or predates fingerprints).
+    """
+    row = conn.execute("SELECT blob_sha FROM files WHERE path = ?", (path,)).fetchone()
+    try:
+        data = (root / path).read_bytes()
+    except OSError:
+        return "" if row is None else None
+    if row is None or not row[0]:
+        return None
+    return row[0] if git_blob_sha(data) == row[0] else None
+
+
+def has_version(conn, path: str, blob_sha: str) -> bool:
+    """True when the symbols of version *blob_sha* of *path* are available."""
+    if conn.execute("SELECT 1 FROM files WHERE path = ? AND blob_sha = ?", (path, blob_sha)).fetchone():
+        return True
+    row = conn.execute(
+        "SELECT retained_at FROM file_fingerprints WHERE path = ? AND blob_sha = ?", (path, blob_sha)
+    ).fetchone()
+    return row is not None and row[0] is not None
+
+
+def load_version(conn, path: str, blob_sha: str | None) -> tuple[list[dict], list[str]] | None:
+    """``(symbols, import_keys)`` of a version of *path*, or None if unknown.
+
+    *blob_sha* None (or "") means the file does not exist in that version.
+    Symbol dicts carry the extractor keys the diff commands compare.
+    """
+    if not blob_sha:
+        return [], []
+    imports_row = conn.execute(
+        "SELECT imports FROM file_fingerprints WHERE path = ? AND blob_sha = ?", (path, blob_sha)
+    ).fetchone()
+    imports = [k for k in (imports_row[0] or "").split("\n") if k] if imports_row else None
+
+    current = conn.execute("SELECT id FROM files WHERE path = ? AND blob_sha = ?", (path, blob_sha)).fetchone()
+    if current is not None:
+        rows = conn.execute(f"SELECT {_SYMBOL_COLUMNS} FROM symbols WHERE file_id = ?", (current[0],)).fetchall()
+    elif has_version(conn, path, blob_sha):
+        rows = conn.execute(
+            f"SELECT {_SYMBOL_COLUMNS} FROM symbol_fingerprints WHERE path = ? AND blob_sha = ?",
+            (path, blob_sha),
+        ).fetchall()
+    else:
+        return None
+    if imports is None:
+        return None
+    cols = [c.strip() for c in _SYMBOL_COLUMNS.split(",")]
+    symbols = []
+    for r in rows:
+        sym = dict(zip(cols, tuple(r)))
+        sym["is_exported"] = bool(sym["is_exported"])
+        symbols.append(sym)
+    return symbols, imports
+
+
+def diff_fingerprints(old: list[dict], new: list[dict]) -> list[dict]:
+    """Hash join of two versions' symbols on ``stable_key``.
+
+    Returns one ``{"status", "old", "new"}`` entry per key that differs;
+    status is ``added``, ``removed``, ``signature`` (signature hash
+    differs) or ``modified`` (body hash differs).
+    """
+    old_by_key = {s["stable_key"]: s for s in old if s.get("stable_key")}
+    new_by_key = {s["stable_key"]: s for s in new if s.get("stable_key")}
+    out = []
+    for key, o in old_by_key.items():
+        n = new_by_key.get(key)
+        if n is None:
+            out.append({"status": "removed", "old": o, "new": None})
+        elif o.get("sig_hash") != n.get("sig_hash"):
+            out.append({"status": "signature", "old": o, "new": n})
+        elif o.get("body_hash") != n.get("body_hash"):
+            out.append({"status": "modified", "old": o, "new": n})
+    for key, n in new_by_key.items():
+        if key not in old_by_key:
+            out.append({"status": "added", "old": None, "new": n})
+    return out
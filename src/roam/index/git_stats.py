@@ -3,6 +3,7 @@
 from __future__ import annotations
 
 import hashlib
+import json
 import logging
 import math
 import sqlite3
@@ -321,7 +322,9 @@ def _populate_hyperedges(
 
     Each qualifying commit (2-100 files) produces one ``git_hyperedges`` row
     and N ``git_hyperedge_members`` rows.  A ``sig_hash`` (truncated SHA-256
-    of sorted file IDs) enables O(1) pattern matching later.
+    of sorted file IDs) enables O(1) pattern matching later.  The sorted
+    member array is also stored inline (``members``) so similarity search
+    can score a candidate without a per-hyperedge member query.
     """
     with conn:
         conn.execute("DELETE FROM git_hyperedge_members")
@@ -340,14 +343,14 @@ def _populate_hyperedges(
             sig = hashlib.sha256("|".join(str(fid) for fid in sorted_ids).encode()).hexdigest()[:16]
 
             edge_id += 1
-            edge_batch.append((edge_id, commit_id, n, sig))
+            edge_batch.append((edge_id, commit_id, n, sig, json.dumps(sorted_ids, separators=(",", ":"))))
 
             for ordinal, fid in enumerate(sorted_ids):
                 member_batch.append((edge_id, fid, ordinal))
 
             if len(edge_batch) >= 500:
                 conn.executemany(
-                    "INSERT INTO git_hyperedges (id, commit_id, file_count, sig_hash) VALUES (?, ?, ?, ?)",
+                    "INSERT INTO git_hyperedges (id, commit_id, file_count, sig_hash, members) VALUES (?, ?, ?, ?, ?)",
                     edge_batch,
                 )
                 conn.executemany(
@@ -359,7 +362,7 @@ def _populate_hyperedges(
 
         if edge_batch:
             conn.executemany(
-                "INSERT INTO git_hyperedges (id, commit_id, file_count, sig_hash) VALUES (?, ?, ?, ?)",
+                "INSERT INTO git_hyperedges (id, commit_id, file_count, sig_hash, members) VALUES (?, ?, ?, ?, ?)",
                 edge_batch,
             )
         if member_batch:
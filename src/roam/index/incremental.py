@@ -3,8 +3,26 @@
 from __future__ import annotations
 
 import hashlib
+import sqlite3
+import time
 from pathlib import Path
 
+# Whole-index phases recomputed after file changes, in pipeline order.
+# A targeted reindex marks them dirty instead of running them.
+DERIVED_PHASES = (
+    "graph_metrics",
+    "git",
+    "clusters",
+    "effects",
+    "taint",
+    "health",
+    "cognitive_load",
+    "entry_distances",
+    "test_reach",
+    "snapshot_metrics",
+    "search",
+)
+
 
 def file_hash(path: Path) -> str:
     """Compute SHA-256 hash of a file."""
@@ -56,20 +74,92 @@ def get_changed_files(
             removed.append(path)
             continue
 
-        stored_mtime, stored_hash = stored[path]
+        changed = _content_changed(full_path, current_mtime, *stored[path])
+        if changed is None:
+            removed.append(path)
+        elif changed:
+            modified.append(path)
 
-        # Fast path: if mtime is unchanged, assume file is unchanged
-        if stored_mtime is not None and abs(current_mtime - stored_mtime) < 0.001:
-            continue
+    return added, modified, removed
+
+
+def _content_changed(full_path: Path, current_mtime: float, stored_mtime, stored_hash) -> bool | None:
+    """True/False for changed content, None when the file vanished."""
+    # Fast path: if mtime is unchanged, assume file is unchanged
+    if stored_mtime is not None and abs(current_mtime - stored_mtime) < 0.001:
+        return False
+
+    # Mtime changed -- check hash to confirm actual content change
+    try:
+        current_hash = file_hash(full_path)
+    except OSError:
+        return None
+    return current_hash != stored_hash
 
-        # Mtime changed -- check hash to confirm actual content change
+
+def classify_paths(
+    conn,
+    paths: list[str],
+    root: Path,
+    indexable: set[str],
+) -> tuple[list[str], list[str], list[str]]:
+    """Change sets restricted to *paths*, without looking at other files.
+
+    *indexable* holds the paths that exist and pass discovery filtering;
+    a stored path outside it counts as removed.  Returns
+    ``(added, modified, removed)`` like :func:`get_changed_files`.
+    """
+    added: list[str] = []
+    modified: list[str] = []
+    removed: list[str] = []
+    for path in sorted(set(paths)):
+        row = conn.execute("SELECT mtime, hash FROM files WHERE path = ?", (path,)).fetchone()
+        if path not in indexable:
+            if row is not None:
+                removed.append(path)
+            continue
+        if row is None:
+            added.append(path)
+            continue
+        full_path = root / path
         try:
-            current_hash = file_hash(full_path)
+            current_mtime = full_path.stat().st_mtime
         except OSError:
             removed.append(path)
             continue
-
-        if current_hash != stored_hash:
+        changed = _content_changed(full_path, current_mtime, row[0], row[1])
+        if changed is None:
+            removed.append(path)
+        elif changed:
             modified.append(path)
-
     return added, modified, removed
+
+
+def mark_dirty(conn, phases) -> None:
+    """Record derived *phases* as stale."""
+    now = time.time()
+    conn.executemany(
+        "INSERT OR REPLACE INTO index_dirty (phase, marked_at) VALUES (?, ?)",
+        [(p, now) for p in phases],
+    )
+
+
+def clear_dirty(conn, phases) -> None:
+    conn.executemany("DELETE FROM index_dirty WHERE phase = ?", [(p,) for p in phases])
+
+
+def is_dirty(conn, phase: str) -> bool:
+    """True when derived *phase* is marked stale (False on older indexes)."""
+    try:
+        return conn.execute("SELECT 1 FROM index_dirty WHERE phase = ?", (phase,)).fetchone() is not None
+    except sqlite3.OperationalError:
+        return False
+
+
+def dirty_phases(conn) -> list[str]:
+    """Stale derived phases, in pipeline order (empty on older indexes)."""
+    try:
+        stale = {r[0] for r in conn.execute("SELECT phase FROM index_dirty").fetchall()}
+    except sqlite3.OperationalError:
+        return []
+    return [p for p in DERIVED_PHASES if p in stale]
@@ -2,15 +2,35 @@
 
 from __future__ import annotations
 
+import hashlib
 import os
 import sys
 import time
 from pathlib import Path
 
-from roam.db.connection import find_project_root, get_db_path, open_db
-from roam.index.discovery import discover_files
+from roam.db.connection import find_project_root, get_db_path, open_db, refresh_planner_stats
+from roam.db.shadow import SHADOW_MIN_CHANGES, discard_shadow, publish_shadow, seed_shadow
+from roam.db.source_store import prune_sources, store_source
+from roam.index.codeowners import refresh_file_owners
+from roam.index.discovery import discover_files, filter_paths
 from roam.index.file_roles import classify_file
-from roam.index.incremental import file_hash, get_changed_files
+from roam.index.fingerprints import (
+    assign_fingerprints,
+    git_blob_sha,
+    import_keys,
+    prune_fingerprints,
+    retain_file_version,
+    store_file_fingerprint,
+)
+from roam.index.incremental import (
+    DERIVED_PHASES,
+    classify_paths,
+    clear_dirty,
+    dirty_phases,
+    get_changed_files,
+    mark_dirty,
+)
+from roam.index.parse_session import current_session
 from roam.index.parser import (
     detect_language,
     extract_vue_template,
@@ -18,9 +38,13 @@ from roam.index.parser import (
     scan_template_references,
 )
 from roam.index.relations import build_file_edges, resolve_references
+from roam.index.symbol_keys import RetainedSymbols, assign_symbol_keys
 from roam.index.symbols import extract_references, extract_symbols
 from roam.languages.generic_lang import GenericExtractor
 
+# Derived phases that read the symbol graph
+_GRAPH_PHASES = {"graph_metrics", "clusters", "effects", "taint", "health", "snapshot_metrics"}
+
 
 def _format_count(n: int) -> str:
     """Format an integer with thousands separators."""
@@ -412,8 +436,13 @@ def _compute_cognitive_load(conn):
     _log(f"  Cognitive load for {len(updates)} files")
 
 
-def _store_symbols(conn, file_id, rel_path, symbols, all_symbol_rows):
-    """Insert extracted symbols into the DB and populate all_symbol_rows."""
+def _store_symbols(conn, file_id, rel_path, symbols, all_symbol_rows, retained=None):
+    """Insert extracted symbols into the DB and populate all_symbol_rows.
+
+    Symbols carry keys from :func:`~roam.index.symbol_keys.assign_symbol_keys`;
+    with *retained*, a symbol whose key existed before the file was
+    reindexed is inserted under its old id.
+    """
     for sym in symbols:
         parent_id = None
         if sym["parent_name"]:
@@ -426,11 +455,13 @@ def _store_symbols(conn, file_id, rel_path, symbols, all_symbol_rows):
 
         conn.execute(
             """INSERT INTO symbols
-               (file_id, name, qualified_name, kind, signature,
+               (id, file_id, name, qualified_name, kind, signature,
                 line_start, line_end, docstring, visibility,
-                is_exported, parent_id, default_value)
-               VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)""",
+                is_exported, parent_id, default_value, stable_key, content_hash,
+                sig_hash, body_hash)
+               VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)""",
             (
+                retained.match(rel_path, sym) if retained is not None else None,
                 file_id,
                 sym["name"],
                 sym["qualified_name"],
@@ -443,6 +474,10 @@ def _store_symbols(conn, file_id, rel_path, symbols, all_symbol_rows):
                 1 if sym["is_exported"] else 0,
                 parent_id,
                 sym.get("default_value"),
+                sym.get("stable_key"),
+                sym.get("content_hash"),
+                sym.get("sig_hash"),
+                sym.get("body_hash"),
             ),
         )
         row = conn.execute("SELECT last_insert_rowid()").fetchone()
@@ -464,9 +499,10 @@ def _store_symbols(conn, file_id, rel_path, symbols, all_symbol_rows):
 def _relink_annotations(conn):
     """Re-link annotations to current symbol IDs via qualified_name.
 
-    After reindex, symbol IDs change.  This function updates the
-    ``symbol_id`` column of annotations that have a ``qualified_name``
-    recorded, matching them against the new symbols table.
+    Symbols that keep their stable key keep their id (and annotations
+    their link).  This function updates the ``symbol_id`` column of the
+    remaining annotations that have a ``qualified_name`` recorded,
+    matching them against the new symbols table.
     """
     try:
         conn.execute(
@@ -474,7 +510,8 @@ def _relink_annotations(conn):
             "  SELECT s.id FROM symbols s "
             "  WHERE s.qualified_name = annotations.qualified_name "
             "  LIMIT 1"
-            ") WHERE qualified_name IS NOT NULL"
+            ") WHERE qualified_name IS NOT NULL "
+            "AND (symbol_id IS NULL OR symbol_id NOT IN (SELECT id FROM symbols))"
         )
     except Exception:
         pass  # Table may not exist yet
@@ -483,13 +520,23 @@ def _relink_annotations(conn):
 class Indexer:
     """Orchestrates the full indexing pipeline."""
 
-    def __init__(self, project_root: Path | None = None):
+    def __init__(self, project_root: Path | None = None, tree_cache=None):
+        """*tree_cache* (a :class:`~roam.index.tree_cache.TreeCache`) makes
+        repeated runs on one instance reparse changed files incrementally;
+        long-lived callers such as ``roam watch`` pass one.
+        """
         if project_root is None:
             project_root = find_project_root()
         self.root = Path(project_root).resolve()
+        self.tree_cache = tree_cache
         self._quiet = False
         self._progress_bar = True
+        self._carried_metrics: dict[str, dict] = {}
+        self._retained = RetainedSymbols()
+        self._metrics_reused = 0
         self.summary: dict | None = None
+        # Parse counters at the start of the current run (the session outlives runs)
+        self._parse_baseline: dict | None = None
 
     def _log(self, msg: str):
         """Log a message to stderr, respecting quiet mode."""
@@ -503,6 +550,7 @@ class Indexer:
         include_excluded: bool = False,
         quiet: bool = False,
         progress_bar: bool = True,
+        shadow: bool | None = None,
     ):
         """Run the indexing pipeline.
 
@@ -514,7 +562,59 @@ class Indexer:
             quiet: If True, suppress all progress output to stderr.
             progress_bar: If True (default), show progress bars for file
                 processing. Set to False in non-TTY environments.
+            shadow: Build into a shadow DB and publish it atomically (see
+                :mod:`roam.db.shadow`) so concurrent readers never see a
+                partial index.  None (default) decides per run: full builds
+                and runs touching ``SHADOW_MIN_CHANGES`` or more files use
+                a shadow.
+        """
+        self._run_locked(
+            quiet,
+            progress_bar,
+            self._do_run,
+            force,
+            verbose=verbose,
+            include_excluded=include_excluded,
+            shadow=shadow,
+        )
+
+    def run_paths(
+        self,
+        paths,
+        verbose: bool = False,
+        include_excluded: bool = False,
+        quiet: bool = False,
+        progress_bar: bool = True,
+        refresh: bool = False,
+    ):
+        """Reindex only *paths*, e.g. the files a watcher saw change.
+
+        Skips file discovery and whole-tree change detection: each path is
+        classified as added, modified or removed on its own, then the files
+        and their affected neighbours are reprocessed and symbol, file and
+        bridge edges rebuilt.  Derived global phases (graph metrics,
+        clusters, effects, search, ...) are only marked dirty unless
+        *refresh* is True; :meth:`refresh_derived` or the next ``run``
+        brings them up to date.
+
+        Paths may be absolute or relative to the project root; paths outside
+        the root are ignored.
         """
+        self._run_locked(
+            quiet,
+            progress_bar,
+            self._do_run_paths,
+            list(paths),
+            verbose=verbose,
+            include_excluded=include_excluded,
+            refresh=refresh,
+        )
+
+    def refresh_derived(self, phases=None, quiet: bool = False, progress_bar: bool = True):
+        """Recompute dirty derived phases (all dirty ones when *phases* is None)."""
+        self._run_locked(quiet, progress_bar, self._do_refresh_derived, phases)
+
+    def _run_locked(self, quiet, progress_bar, fn, *args, **kwargs):
         global _quiet_mode
         self._quiet = quiet
         self._progress_bar = progress_bar
@@ -540,8 +640,9 @@ class Indexer:
                 lock_path.unlink()
 
         lock_path.write_text(str(os.getpid()))
+        self._parse_baseline = current_session().counters()
         try:
-            self._do_run(force, verbose=verbose, include_excluded=include_excluded)
+            fn(*args, **kwargs)
         finally:
             _quiet_mode = False
             try:
@@ -562,7 +663,10 @@ class Indexer:
         all_references,
         verbose,
     ):
-        """Extract references from a single file (calls, imports, inheritance)."""
+        """Extract references from a single file (calls, imports, inheritance).
+
+        Returns the extractor's own references (without supplements).
+        """
         refs = extract_references(tree, parsed_source, rel_path, extractor)
         for ref in refs:
             ref["source_file"] = rel_path
@@ -594,6 +698,7 @@ class Indexer:
             except Exception as e:
                 if verbose:
                     self._log(f"  Warning: generic extractor failed for {rel_path}: {e}")
+        return refs
 
     def _process_files(self, conn, files_to_process, get_extractor, compute_complexity_fn, verbose):
         """Parse, extract symbols, and store per-file data. Returns (all_symbol_rows, all_references, file_id_by_path)."""
@@ -647,14 +752,16 @@ class Indexer:
                     mtime = full_path.stat().st_mtime
                 except OSError:
                     mtime = None
-                fhash = file_hash(full_path)
+                fhash = hashlib.sha256(source).hexdigest()
+                blob_sha = git_blob_sha(source)
 
                 content_head = source[:2048].decode("utf-8", errors="replace") if source else None
                 file_role = classify_file(rel_path, content_head)
 
                 conn.execute(
-                    "INSERT INTO files (path, language, file_role, hash, mtime, line_count) VALUES (?, ?, ?, ?, ?, ?)",
-                    (rel_path, language, file_role, fhash, mtime, line_count),
+                    "INSERT INTO files (path, language, file_role, hash, mtime, line_count, blob_sha) "
+                    "VALUES (?, ?, ?, ?, ?, ?, ?)",
+                    (rel_path, language, file_role, fhash, mtime, line_count, blob_sha),
                 )
                 row = conn.execute("SELECT last_insert_rowid()").fetchone()
                 if not row:
@@ -662,15 +769,17 @@ class Indexer:
                     continue
                 file_id = row[0]
                 file_id_by_path[rel_path] = file_id
+                store_source(conn, fhash, source)
 
                 conn.execute(
                     "INSERT OR REPLACE INTO file_stats (file_id, complexity) VALUES (?, ?)",
                     (file_id, complexity),
                 )
 
-                tree, parsed_source, lang = parse_file(full_path, language)
+                tree, parsed_source, lang = parse_file(full_path, language, tree_cache=self.tree_cache)
                 if tree is None and parsed_source is None:
                     continue
+                snapshot = self._carried_metrics.pop(rel_path, None)
 
                 extractor = None
                 if get_extractor is not None and lang is not None:
@@ -683,16 +792,30 @@ class Indexer:
                     continue
 
                 symbols = extract_symbols(tree, parsed_source, rel_path, extractor)
-                _store_symbols(conn, file_id, rel_path, symbols, all_symbol_rows)
+                assign_symbol_keys(rel_path, symbols, parsed_source)
+                assign_fingerprints(symbols, parsed_source, lang)
+                _store_symbols(conn, file_id, rel_path, symbols, all_symbol_rows, self._retained)
 
                 if compute_complexity_fn is not None and tree is not None:
+                    delta = self.tree_cache.delta(str(full_path)) if self.tree_cache is not None else None
                     try:
-                        compute_complexity_fn(conn, file_id, tree, parsed_source)
+                        if delta is not None and snapshot:
+                            from roam.index.complexity import carried_metrics
+
+                            reuse = carried_metrics(delta, snapshot)
+                        else:
+                            reuse = self._retained.metrics_reuse(rel_path, snapshot)
+                        if reuse is not None:
+                            self._metrics_reused += compute_complexity_fn(
+                                conn, file_id, tree, parsed_source, reuse=reuse
+                            )
+                        else:
+                            compute_complexity_fn(conn, file_id, tree, parsed_source)
                     except Exception as e:
                         if verbose:
                             self._log(f"  Warning: complexity analysis failed for {rel_path}: {e}")
 
-                self._extract_file_refs(
+                refs = self._extract_file_refs(
                     rel_path,
                     full_path,
                     language,
@@ -704,6 +827,7 @@ class Indexer:
                     all_references,
                     verbose,
                 )
+                store_file_fingerprint(conn, rel_path, blob_sha, import_keys(refs))
         finally:
             if bar_ctx is not None:
                 try:
@@ -713,6 +837,28 @@ class Indexer:
 
         return all_symbol_rows, all_references, file_id_by_path
 
+    def _sync_source_snapshots(self, conn):
+        """Drop orphaned source snapshots and backfill ones missing for unchanged files.
+
+        Backfill only happens once for indexes built before ``file_sources``
+        existed; a file is snapshotted only if its content still matches the
+        indexed hash.  Oversized files get a content-less marker row, so
+        they are not re-read on later runs either.
+        """
+        prune_sources(conn)
+        missing = conn.execute(
+            "SELECT f.path, f.hash FROM files f "
+            "LEFT JOIN file_sources fs ON fs.hash = f.hash "
+            "WHERE f.hash IS NOT NULL AND fs.hash IS NULL"
+        ).fetchall()
+        for row in missing:
+            try:
+                source = (self.root / row["path"]).read_bytes()
+            except OSError:
+                continue
+            if hashlib.sha256(source).hexdigest() == row["hash"]:
+                store_source(conn, row["hash"], source)
+
     @staticmethod
     def _find_affected_neighbor_files(conn, changed_file_ids):
         """Find file IDs of unchanged files that had edges into changed files.
@@ -792,6 +938,10 @@ class Indexer:
         for fid, rel_path in affected_paths.items():
             full_path = self.root / rel_path
             language = detect_language(rel_path)
+            # Not through the tree cache: the file is not re-stored, so the
+            # cache must keep the version the index holds, or the next
+            # reindex would diff against (and carry metrics from) a source
+            # that was never measured.
             tree, parsed_source, lang = parse_file(full_path, language)
             if tree is None and parsed_source is None:
                 continue
@@ -898,30 +1048,95 @@ class Indexer:
         _relink_annotations(conn)
         _log(f"  Restored {len(saved)} annotations")
 
-    def _do_run(self, force: bool, verbose: bool = False, include_excluded: bool = False):
+    def _do_run(self, force: bool, verbose: bool = False, include_excluded: bool = False, shadow: bool | None = None):
         t0 = time.monotonic()
         self._log("Discovering files...")
         all_files = discover_files(self.root, include_excluded=include_excluded)
         self._log(f"  {_format_count(len(all_files))} files found")
 
-        saved_annotations = []
-        if force:
-            db_path = get_db_path(self.root)
-            if db_path.exists():
-                saved_annotations = self._backup_annotations(db_path)
+        db_path = get_db_path(self.root)
+        fresh = force or not db_path.exists()
+        if fresh:
+            added, modified, removed = all_files, [], []
+        else:
+            with open_db(project_root=self.root) as conn:
+                added, modified, removed = get_changed_files(conn, all_files, self.root)
+                if not (added or modified or removed):
+                    self._finish_unchanged(conn, t0)
+                    return
+
+        total_changed = len(added) + len(modified) + len(removed)
+        if shadow is None:
+            shadow = fresh or total_changed >= SHADOW_MIN_CHANGES
+
+        saved_annotations = self._backup_annotations(db_path) if force else []
+        if shadow:
+            target = seed_shadow(db_path, empty=fresh)
+            self._log("  Building in shadow index")
+        else:
+            target = db_path
+            if force and db_path.exists():
                 db_path.unlink()
                 for suffix in ("-wal", "-shm"):
                     wal = db_path.parent / (db_path.name + suffix)
                     if wal.exists():
                         wal.unlink()
 
+        self._log(f"  {len(added)} added, {len(modified)} modified, {len(removed)} removed")
+        try:
+            with open_db(db_path=target) as conn:
+                self._apply_changes(conn, added, modified, removed, force, verbose, saved_annotations)
+                self._refresh_derived(conn, DERIVED_PHASES)
+                has_stats = conn.execute("SELECT 1 FROM sqlite_master WHERE name = 'sqlite_stat1'").fetchone()
+                refresh_planner_stats(conn, full=fresh or not has_stats)
+                self._finish(conn, t0)
+        except BaseException:
+            if shadow:
+                discard_shadow(db_path)
+            raise
+        if shadow:
+            generation = publish_shadow(target, db_path)
+            self.summary["generation"] = generation
+            self._log(f"  Published index generation {generation}")
+
+    def _finish_unchanged(self, conn, t0):
+        # Files are current, but CODEOWNERS may have changed
+        self._refresh_owners(conn)
+        dirty = dirty_phases(conn)
+        if dirty:
+            # Files are current but a targeted reindex left derived data stale
+            self._refresh_derived(conn, dirty)
+            self._finish(conn, t0)
+            return
+        self._log("Index is up to date.")
+        self.summary = {
+            "files": 0,
+            "symbols": 0,
+            "edges": 0,
+            "elapsed": 0.0,
+            "up_to_date": True,
+        }
+
+    def _do_run_paths(self, paths, verbose: bool = False, include_excluded: bool = False, refresh: bool = False):
+        t0 = time.monotonic()
+        rel_paths = set()
+        for p in paths:
+            p = Path(p)
+            if p.is_absolute():
+                try:
+                    p = p.resolve().relative_to(self.root)
+                except ValueError:
+                    continue
+            rel_paths.add(p.as_posix())
+
+        if not get_db_path(self.root).exists():
+            # Nothing to patch: a targeted reindex needs an existing index
+            self._do_run(False, verbose=verbose, include_excluded=include_excluded)
+            return
+
         with open_db(project_root=self.root) as conn:
-            if force:
-                added = all_files
-                modified = []
-                removed = []
-            else:
-                added, modified, removed = get_changed_files(conn, all_files, self.root)
+            indexable = set(filter_paths(self.root, sorted(rel_paths), include_excluded=include_excluded))
+            added, modified, removed = classify_paths(conn, sorted(rel_paths), self.root, indexable)
 
             total_changed = len(added) + len(modified) + len(removed)
             if total_changed == 0:
@@ -930,145 +1145,228 @@ class Indexer:
                     "files": 0,
                     "symbols": 0,
                     "edges": 0,
-                    "elapsed": 0.0,
+                    "elapsed": round(time.monotonic() - t0, 3),
                     "up_to_date": True,
                 }
                 return
 
             self._log(f"  {len(added)} added, {len(modified)} modified, {len(removed)} removed")
+            self._apply_changes(conn, added, modified, removed, False, verbose, [])
+            if refresh:
+                self._refresh_derived(conn, DERIVED_PHASES)
+            else:
+                mark_dirty(conn, DERIVED_PHASES)
+            self._finish(conn, t0)
 
-            # Collect file IDs of changed/removed files BEFORE deleting them
-            changed_file_ids = []
-            for path in removed + modified:
-                row = conn.execute("SELECT id FROM files WHERE path = ?", (path,)).fetchone()
-                if row:
-                    changed_file_ids.append(row["id"])
-
-            # Find affected neighbor files BEFORE CASCADE deletes the edges
-            # we need for the query.  These are files whose edges INTO the
-            # changed files will be lost and need rebuilding.
-            affected_file_ids = set()
-            if not force and modified and changed_file_ids:
-                affected_file_ids = self._find_affected_neighbor_files(
-                    conn,
-                    changed_file_ids,
-                )
+    def _do_refresh_derived(self, phases=None):
+        t0 = time.monotonic()
+        if not get_db_path(self.root).exists():
+            return
+        with open_db(project_root=self.root) as conn:
+            dirty = dirty_phases(conn)
+            if phases is not None:
+                dirty = [p for p in dirty if p in set(phases)]
+            if not dirty:
+                return
+            self._refresh_derived(conn, dirty)
+            self._finish(conn, t0)
+
+    def _apply_changes(self, conn, added, modified, removed, force, verbose, saved_annotations):
+        """Reparse changed files, rebuild their edges and re-link annotations."""
+        # Collect file IDs of changed/removed files BEFORE deleting them
+        changed_file_ids = []
+        for path in removed + modified:
+            row = conn.execute("SELECT id FROM files WHERE path = ?", (path,)).fetchone()
+            if row:
+                changed_file_ids.append(row["id"])
+
+        # Find affected neighbor files BEFORE CASCADE deletes the edges
+        # we need for the query.  These are files whose edges INTO the
+        # changed files will be lost and need rebuilding.
+        affected_file_ids = set()
+        if not force and modified and changed_file_ids:
+            affected_file_ids = self._find_affected_neighbor_files(
+                conn,
+                changed_file_ids,
+            )
 
-            # Now delete the changed/removed file records (CASCADE cleans up
-            # their symbols, edges, file_edges, graph_metrics, clusters, etc.)
-            for path in removed + modified:
+        # Keep ids and derived rows of modified files' symbols: reinserted
+        # symbols with the same stable key get their old id back, and
+        # unchanged ones (same content hash) their metrics
+        self._carried_metrics = {}
+        self._metrics_reused = 0
+        self._retained = RetainedSymbols()
+        if self.tree_cache is not None:
+            for path in removed:
+                self.tree_cache.discard(str(self.root / path))
+        if modified and not force:
+            from roam.index.complexity import snapshot_file_metrics
+
+            for path in modified:
                 row = conn.execute("SELECT id FROM files WHERE path = ?", (path,)).fetchone()
                 if row:
-                    fid = row["id"]
-                    # Clean up tables with SET NULL FKs (not CASCADE)
-                    sym_ids = [
-                        r[0] for r in conn.execute("SELECT id FROM symbols WHERE file_id = ?", (fid,)).fetchall()
-                    ]
-                    if sym_ids:
-                        ph = ",".join("?" for _ in sym_ids)
-                        for cleanup_sql in [
-                            f"UPDATE runtime_stats SET symbol_id = NULL WHERE symbol_id IN ({ph})",
-                            f"UPDATE vulnerabilities SET matched_symbol_id = NULL WHERE matched_symbol_id IN ({ph})",
-                        ]:
-                            try:
-                                conn.execute(cleanup_sql, sym_ids)
-                            except Exception:
-                                pass  # Table may not exist in older DBs
-                    conn.execute("DELETE FROM files WHERE id = ?", (fid,))
-
-            get_extractor = _try_import_get_extractor()
-            compute_complexity_fn = _try_import_complexity()
-
-            # 3-6. Parse, extract, store
-            files_to_process = added + modified
-            all_symbol_rows, all_references, file_id_by_path = self._process_files(
+                    self._retained.save(conn, path, row["id"])
+                    self._carried_metrics[path] = snapshot_file_metrics(conn, row["id"])
+
+        # Now delete the changed/removed file records (CASCADE cleans up
+        # their symbols, edges, file_edges, graph_metrics, clusters, etc.)
+        # after keeping the outgoing versions' fingerprints for diffs
+        for path in removed + modified:
+            row = conn.execute("SELECT id FROM files WHERE path = ?", (path,)).fetchone()
+            if row:
+                fid = row["id"]
+                retain_file_version(conn, fid)
+                # Clean up tables with SET NULL FKs (not CASCADE)
+                sym_ids = [r[0] for r in conn.execute("SELECT id FROM symbols WHERE file_id = ?", (fid,)).fetchall()]
+                if sym_ids:
+                    ph = ",".join("?" for _ in sym_ids)
+                    for cleanup_sql in [
+                        f"UPDATE runtime_stats SET symbol_id = NULL WHERE symbol_id IN ({ph})",
+                        f"UPDATE vulnerabilities SET matched_symbol_id = NULL WHERE matched_symbol_id IN ({ph})",
+                    ]:
+                        try:
+                            conn.execute(cleanup_sql, sym_ids)
+                        except Exception:
+                            pass  # Table may not exist in older DBs
+                conn.execute("DELETE FROM files WHERE id = ?", (fid,))
+
+        get_extractor = _try_import_get_extractor()
+        compute_complexity_fn = _try_import_complexity()
+
+        # 3-6. Parse, extract, store
+        files_to_process = added + modified
+        all_symbol_rows, all_references, file_id_by_path = self._process_files(
+            conn,
+            files_to_process,
+            get_extractor,
+            compute_complexity_fn,
+            verbose,
+        )
+        self._sync_source_snapshots(conn)
+        prune_fingerprints(conn)
+        kept = self._retained.restore(conn)
+        if kept:
+            self._log(f"  {_format_count(kept)} unchanged symbols kept their derived data")
+        self._refresh_owners(conn)
+
+        # Load existing symbols for incremental
+        if not force:
+            existing_rows = conn.execute(
+                "SELECT s.id, s.file_id, s.name, s.qualified_name, s.kind, "
+                "s.is_exported, s.line_start, f.path as file_path "
+                "FROM symbols s JOIN files f ON s.file_id = f.id"
+            ).fetchall()
+            for row in existing_rows:
+                sid = row["id"]
+                if sid not in all_symbol_rows:
+                    all_symbol_rows[sid] = {
+                        "id": sid,
+                        "file_id": row["file_id"],
+                        "file_path": row["file_path"],
+                        "name": row["name"],
+                        "qualified_name": row["qualified_name"],
+                        "kind": row["kind"],
+                        "is_exported": bool(row["is_exported"]),
+                        "line_start": row["line_start"],
+                    }
+
+        for row in conn.execute("SELECT id, path FROM files").fetchall():
+            file_id_by_path[row["path"]] = row["id"]
+
+        # Fix incremental edge loss: re-extract only affected neighbors
+        # instead of all unchanged files (O(affected) vs O(N))
+        if not force and modified and affected_file_ids:
+            self._re_extract_affected(
                 conn,
-                files_to_process,
+                affected_file_ids,
                 get_extractor,
-                compute_complexity_fn,
+                all_references,
                 verbose,
             )
 
-            # Load existing symbols for incremental
-            if not force:
-                existing_rows = conn.execute(
-                    "SELECT s.id, s.file_id, s.name, s.qualified_name, s.kind, "
-                    "s.is_exported, s.line_start, f.path as file_path "
-                    "FROM symbols s JOIN files f ON s.file_id = f.id"
-                ).fetchall()
-                for row in existing_rows:
-                    sid = row["id"]
-                    if sid not in all_symbol_rows:
-                        all_symbol_rows[sid] = {
-                            "id": sid,
-                            "file_id": row["file_id"],
-                            "file_path": row["file_path"],
-                            "name": row["name"],
-                            "qualified_name": row["qualified_name"],
-                            "kind": row["kind"],
-                            "is_exported": bool(row["is_exported"]),
-                            "line_start": row["line_start"],
-                        }
-
-            for row in conn.execute("SELECT id, path FROM files").fetchall():
-                file_id_by_path[row["path"]] = row["id"]
-
-            # Fix incremental edge loss: re-extract only affected neighbors
-            # instead of all unchanged files (O(affected) vs O(N))
-            if not force and modified and affected_file_ids:
-                self._re_extract_affected(
-                    conn,
-                    affected_file_ids,
-                    get_extractor,
-                    all_references,
-                    verbose,
-                )
+        # Resolve references into edges
+        self._log("Resolving references...")
+        symbols_by_name: dict[str, list[dict]] = {}
+        for sym in all_symbol_rows.values():
+            symbols_by_name.setdefault(sym["name"], []).append(sym)
 
-            # Resolve references into edges
-            self._log("Resolving references...")
-            symbols_by_name: dict[str, list[dict]] = {}
-            for sym in all_symbol_rows.values():
-                symbols_by_name.setdefault(sym["name"], []).append(sym)
+        symbol_edges = resolve_references(all_references, symbols_by_name, file_id_by_path)
 
-            symbol_edges = resolve_references(all_references, symbols_by_name, file_id_by_path)
+        conn.executemany(
+            "INSERT INTO edges (source_id, target_id, kind, line, source_file_id) VALUES (?, ?, ?, ?, ?)",
+            [(e["source_id"], e["target_id"], e["kind"], e["line"], e.get("source_file_id")) for e in symbol_edges],
+        )
+        self._log(f"  {_format_count(len(symbol_edges))} symbol edges")
 
-            conn.executemany(
-                "INSERT INTO edges (source_id, target_id, kind, line, source_file_id) VALUES (?, ?, ?, ?, ?)",
-                [(e["source_id"], e["target_id"], e["kind"], e["line"], e.get("source_file_id")) for e in symbol_edges],
-            )
-            self._log(f"  {_format_count(len(symbol_edges))} symbol edges")
-
-            # Build file edges
-            self._log("Building file-level edges...")
-            file_edges = build_file_edges(symbol_edges, all_symbol_rows)
-            conn.executemany(
-                "INSERT INTO file_edges (source_file_id, target_file_id, kind, symbol_count) VALUES (?, ?, ?, ?)",
-                [(fe["source_file_id"], fe["target_file_id"], fe["kind"], fe["symbol_count"]) for fe in file_edges],
-            )
-            self._log(f"  {_format_count(len(file_edges))} file edges")
+        # Build file edges
+        self._log("Building file-level edges...")
+        file_edges = build_file_edges(symbol_edges, all_symbol_rows)
+        conn.executemany(
+            "INSERT INTO file_edges (source_file_id, target_file_id, kind, symbol_count) VALUES (?, ?, ?, ?)",
+            [(fe["source_file_id"], fe["target_file_id"], fe["kind"], fe["symbol_count"]) for fe in file_edges],
+        )
+        self._log(f"  {_format_count(len(file_edges))} file edges")
 
-            # Graph metrics
-            (
-                build_symbol_graph,
-                _store_metrics,
-                _detect_clusters,
-                _label_clusters,
-                _store_clusters,
-            ) = _try_import_graph()
-            G = None
-            if build_symbol_graph is not None:
-                self._log("Computing graph metrics...")
-                try:
-                    G = build_symbol_graph(conn)
+        # Cross-language bridge edges (proto -> stubs, Apex -> templates, ...)
+        try:
+            from roam.bridges.resolver import store_bridge_edges
+
+            bridge_count = store_bridge_edges(conn, None if force else added + modified)
+            if bridge_count:
+                self._log(f"  {_format_count(bridge_count)} cross-language edges")
+        except Exception as e:
+            self._log(f"  Bridge resolution failed: {e}")
+
+        # Annotation survival
+        if force and saved_annotations:
+            self._log("Restoring annotations...")
+            try:
+                self._restore_annotations(conn, saved_annotations)
+            except Exception as e:
+                self._log(f"  Annotation restore failed: {e}")
+        elif not force:
+            # Re-link annotations after incremental reindex
+            try:
+                _relink_annotations(conn)
+            except Exception:
+                pass
+
+    def _refresh_owners(self, conn):
+        """Resolve CODEOWNERS for files whose ownership is missing or stale."""
+        try:
+            owned = refresh_file_owners(conn, self.root)
+        except Exception as e:
+            self._log(f"  CODEOWNERS resolution failed: {e}")
+            return
+        if owned:
+            self._log(f"  CODEOWNERS resolved for {_format_count(owned)} files")
+
+    def _refresh_derived(self, conn, phases):
+        """Recompute the derived global *phases* and clear their dirty marks."""
+        phases = set(phases)
+        (
+            build_symbol_graph,
+            _store_metrics,
+            _detect_clusters,
+            _label_clusters,
+            _store_clusters,
+        ) = _try_import_graph()
+        G = None
+        if build_symbol_graph is not None and phases & _GRAPH_PHASES:
+            self._log("Computing graph metrics..." if "graph_metrics" in phases else "Building symbol graph...")
+            try:
+                G = build_symbol_graph(conn)
+                if "graph_metrics" in phases:
                     _store_metrics(conn, G)
                     metric_count = conn.execute("SELECT COUNT(*) FROM graph_metrics").fetchone()[0]
                     self._log(f"  Metrics for {_format_count(metric_count)} symbols")
-                except Exception as e:
-                    self._log(f"  Graph metrics failed: {e}")
-            else:
-                self._log("Skipping graph metrics (module not available)")
+            except Exception as e:
+                self._log(f"  Graph metrics failed: {e}")
+        elif "graph_metrics" in phases:
+            self._log("Skipping graph metrics (module not available)")
 
-            # Git history
+        # Git history
+        if "git" in phases:
             analyze_git = _try_import_git_stats()
             if analyze_git is not None:
                 self._log("Analyzing git history...")
@@ -1079,7 +1377,8 @@ class Indexer:
             else:
                 self._log("Skipping git analysis (module not available)")
 
-            # Clusters
+        # Clusters
+        if "clusters" in phases:
             if _detect_clusters is not None and G is not None:
                 self._log("Computing clusters...")
                 try:
@@ -1092,59 +1391,78 @@ class Indexer:
             else:
                 self._log("Skipping clustering (module not available)")
 
-            # Effect classification + propagation
-            _effects_fn = _try_import_effects()
-            if _effects_fn is not None:
-                self._log("Classifying symbol effects...")
-                try:
-                    _effects_fn(conn, self.root, G)
-                    effect_count = conn.execute("SELECT COUNT(*) FROM symbol_effects").fetchone()[0]
-                    if effect_count:
-                        self._log(f"  {_format_count(effect_count)} effects classified")
-                except Exception as e:
-                    self._log(f"  Effect analysis failed: {e}")
+        # Effect classification + propagation
+        _effects_fn = _try_import_effects() if "effects" in phases else None
+        if _effects_fn is not None:
+            self._log("Classifying symbol effects...")
+            try:
+                _effects_fn(conn, self.root, G)
+                effect_count = conn.execute("SELECT COUNT(*) FROM symbol_effects").fetchone()[0]
+                if effect_count:
+                    self._log(f"  {_format_count(effect_count)} effects classified")
+            except Exception as e:
+                self._log(f"  Effect analysis failed: {e}")
 
-            # Taint analysis (inter-procedural)
-            _taint_fn = _try_import_taint()
-            if _taint_fn is not None:
-                self._log("Computing taint summaries...")
-                try:
-                    _taint_fn(conn, self.root, G)
-                    taint_count = conn.execute("SELECT COUNT(*) FROM taint_findings").fetchone()[0]
-                    if taint_count:
-                        self._log(f"  {_format_count(taint_count)} taint findings")
-                except Exception as e:
-                    self._log(f"  Taint analysis failed: {e}")
+        # Taint analysis (inter-procedural)
+        _taint_fn = _try_import_taint() if "taint" in phases else None
+        if _taint_fn is not None:
+            self._log("Computing taint summaries...")
+            try:
+                _taint_fn(conn, self.root, G)
+                taint_count = conn.execute("SELECT COUNT(*) FROM taint_findings").fetchone()[0]
+                if taint_count:
+                    self._log(f"  {_format_count(taint_count)} taint findings")
+            except Exception as e:
+                self._log(f"  Taint analysis failed: {e}")
 
-            # Per-file health scores — pass G so cycle detection uses SCC, not SQL self-join
+        # Per-file health scores — pass G so cycle detection uses SCC, not SQL self-join
+        if "health" in phases:
             self._log("Computing health scores...")
             try:
                 _compute_file_health_scores(conn, G)
             except Exception as e:
                 self._log(f"  Health score computation failed: {e}")
 
-            # Cognitive load index
+        # Cognitive load index
+        if "cognitive_load" in phases:
             self._log("Computing cognitive load...")
             try:
                 _compute_cognitive_load(conn)
             except Exception as e:
                 self._log(f"  Cognitive load computation failed: {e}")
 
-            # Annotation survival
-            if force and saved_annotations:
-                self._log("Restoring annotations...")
-                try:
-                    self._restore_annotations(conn, saved_annotations)
-                except Exception as e:
-                    self._log(f"  Annotation restore failed: {e}")
-            elif not force:
-                # Re-link annotations after incremental reindex
-                try:
-                    _relink_annotations(conn)
-                except Exception:
-                    pass
+        # Entry-point distances (read by hotspots --security)
+        if "entry_distances" in phases:
+            try:
+                from roam.graph.entrypoints import store_entry_distances
 
-            # Full-text search index (FTS5/BM25 primary, TF-IDF fallback)
+                store_entry_distances(conn)
+            except Exception as e:
+                self._log(f"  Entry-point distances failed: {e}")
+
+        # Tests reaching each symbol (read by has_test rules, test-gaps, affected tests)
+        if "test_reach" in phases:
+            try:
+                from roam.graph.test_reach import store_test_reach
+
+                reach_count = store_test_reach(conn)
+                if reach_count:
+                    self._log(f"  Test reachability for {_format_count(reach_count)} symbol/test file pairs")
+            except Exception as e:
+                self._log(f"  Test reachability failed: {e}")
+
+        # Snapshot aggregates (cycles, tangle, god components, ...) so that
+        # `roam snapshot` and `roam trends` read them instead of rebuilding G
+        if "snapshot_metrics" in phases:
+            try:
+                from roam.commands.metrics_history import store_snapshot_metrics
+
+                store_snapshot_metrics(conn, G)
+            except Exception as e:
+                self._log(f"  Snapshot metrics failed: {e}")
+
+        # Full-text search index (FTS5/BM25 primary, TF-IDF fallback)
+        if "search" in phases:
             self._log("Building search index...")
             try:
                 from roam.search.index_embeddings import build_fts_index, fts5_available
@@ -1167,25 +1485,35 @@ class Indexer:
             except Exception as e:
                 self._log(f"  Search index build failed (non-fatal): {e}")
 
-            from roam.index.parser import get_parse_error_summary
+        clear_dirty(conn, phases)
 
-            error_summary = get_parse_error_summary()
-            if error_summary:
-                self._log(f"  Parse issues: {error_summary}")
+    def _finish(self, conn, t0):
+        from roam.index.parser import get_parse_error_summary
 
-            elapsed = time.monotonic() - t0
-            file_count = conn.execute("SELECT COUNT(*) FROM files").fetchone()[0]
-            sym_count = conn.execute("SELECT COUNT(*) FROM symbols").fetchone()[0]
-            edge_count = conn.execute("SELECT COUNT(*) FROM edges").fetchone()[0]
-            self._log(
-                f"Index complete: {_format_count(file_count)} files, "
-                f"{_format_count(sym_count)} symbols, "
-                f"{_format_count(edge_count)} edges ({elapsed:.1f}s)"
-            )
-            self.summary = {
-                "files": file_count,
-                "symbols": sym_count,
-                "edges": edge_count,
-                "elapsed": round(elapsed, 1),
-                "up_to_date": False,
-            }
+        error_summary = get_parse_error_summary()
+        if error_summary:
+            self._log(f"  Parse issues: {error_summary}")
+
+        elapsed = time.monotonic() - t0
+        file_count = conn.execute("SELECT COUNT(*) FROM files").fetchone()[0]
+        sym_count = conn.execute("SELECT COUNT(*) FROM symbols").fetchone()[0]
+        edge_count = conn.execute("SELECT COUNT(*) FROM edges").fetchone()[0]
+        dirty = dirty_phases(conn)
+        self._log(
+            f"Index complete: {_format_count(file_count)} files, "
+            f"{_format_count(sym_count)} symbols, "
+            f"{_format_count(edge_count)} edges ({elapsed:.1f}s)"
+        )
+        if dirty:
+            self._log(f"  Deferred: {', '.join(dirty)}")
+        self.summary = {
+            "files": file_count,
+            "symbols": sym_count,
+            "edges": edge_count,
+            "elapsed": round(elapsed, 1),
+            "up_to_date": False,
+            "dirty_phases": dirty,
+            "parse": current_session().summary(since=self._parse_baseline),
+        }
+        if self.tree_cache is not None:
+            self.summary["parse_cache"] = dict(self.tree_cache.summary(), metrics_reused=self._metrics_reused)
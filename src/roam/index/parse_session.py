@@ -0,0 +1,168 @@
+"""Shared tree-sitter state for on-demand parsing within one run.
+
+Commands that parse on demand (``syntax-check``, AST-match rules, the
+effects pass, snapshot diffs) used to build a fresh parser for every file
+and re-parse the same source whenever two of them looked at it.  A
+:class:`ParseSession` owns, per grammar:
+
+* one pooled ``Parser`` (and with it the ``Language``); a grammar that
+  failed to load is remembered so it is not retried for every file,
+* compiled per-grammar artefacts such as AST patterns (:meth:`compiled`),
+* a bounded LRU of trees keyed by ``(path, content hash)``, so a file
+  parsed twice with the same contents is parsed once,
+* parse counters (parses, cache hits, seconds) for :meth:`summary`.
+  They accumulate for the life of the session; pass an earlier
+  :meth:`counters` baseline to report one run.
+
+Parsers are not thread-safe, so :func:`current_session` hands out one
+session per thread.  The indexer's :class:`~roam.index.tree_cache.TreeCache`
+(incremental reparse for ``roam watch``) is separate and takes precedence
+in :func:`~roam.index.parser.parse_file`.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import threading
+import time
+from collections import OrderedDict
+
+DEFAULT_MAX_TREES = 128
+
+
+class ParseSession:
+    """Pooled parsers, compiled artefacts and a tree cache, per grammar."""
+
+    def __init__(self, max_trees: int = DEFAULT_MAX_TREES):
+        self.max_trees = max_trees
+        self._parsers: dict[str, object] = {}
+        self._failed: dict[str, Exception] = {}
+        self._compiled: dict[tuple, object] = {}
+        self._trees: OrderedDict[tuple, object] = OrderedDict()
+        self._stats: dict[str, dict] = {}
+
+    def parser(self, grammar: str):
+        """The pooled parser for *grammar*; raises if the grammar is unavailable."""
+        parser = self._parsers.get(grammar)
+        if parser is not None:
+            return parser
+        failed = self._failed.get(grammar)
+        if failed is not None:
+            raise failed
+        from roam.index.parser import get_parser
+
+        try:
+            parser = get_parser(grammar)
+        except Exception as e:
+            self._failed[grammar] = e
+            raise
+        self._parsers[grammar] = parser
+        return parser
+
+    def language(self, grammar: str):
+        """The ``Language`` of the pooled parser for *grammar*."""
+        return self.parser(grammar).language
+
+    def compiled(self, grammar: str, key, build):
+        """Memoised ``build(parser)`` for (*grammar*, *key*).
+
+        Used for per-grammar artefacts that are expensive to build, such as
+        compiled AST patterns.  Exceptions from *build* are not cached.
+        """
+        cache_key = (grammar, key)
+        try:
+            return self._compiled[cache_key]
+        except KeyError:
+            pass
+        value = build(self.parser(grammar))
+        self._compiled[cache_key] = value
+        return value
+
+    def parse(self, source: bytes, grammar: str, path: str | None = None):
+        """Parse *source* with the pooled parser, reusing a cached tree.
+
+        Trees are keyed by ``(path, grammar, content hash)``; callers must
+        not ``edit()`` a returned tree.  Raises when the grammar is
+        unavailable or parsing fails.
+        """
+        stats = self._grammar_stats(grammar)
+        key = (path, grammar, hashlib.blake2b(source, digest_size=16).digest())
+        tree = self._trees.get(key)
+        if tree is not None:
+            self._trees.move_to_end(key)
+            stats["cache_hits"] += 1
+            return tree
+
+        parser = self.parser(grammar)
+        t0 = time.perf_counter()
+        tree = parser.parse(source)
+        self.record(grammar, time.perf_counter() - t0)
+
+        if self.max_trees > 0:
+            self._trees[key] = tree
+            while len(self._trees) > self.max_trees:
+                self._trees.popitem(last=False)
+        return tree
+
+    def record(self, grammar: str, seconds: float) -> None:
+        """Count one parse of *grammar* done outside :meth:`parse`."""
+        stats = self._grammar_stats(grammar)
+        stats["parses"] += 1
+        stats["seconds"] += seconds
+
+    def clear(self) -> None:
+        """Drop cached trees and compiled artefacts; keep parsers and stats."""
+        self._trees.clear()
+        self._compiled.clear()
+
+    def counters(self) -> dict:
+        """A copy of the raw per-grammar counters, as a :meth:`summary` baseline."""
+        return {g: dict(s) for g, s in self._stats.items()}
+
+    def summary(self, since: dict | None = None) -> dict:
+        """Per-grammar ``{parses, cache_hits, ms}`` plus totals.
+
+        With *since* (from :meth:`counters`) only the work done after that
+        baseline is counted; grammars without new work are left out.
+        """
+        stats = {}
+        for g, s in sorted(self._stats.items()):
+            base = (since or {}).get(g)
+            if base is not None:
+                s = {k: s[k] - base[k] for k in s}
+                if not (s["parses"] or s["cache_hits"]):
+                    continue
+            stats[g] = s
+        grammars = {
+            g: {"parses": s["parses"], "cache_hits": s["cache_hits"], "ms": round(s["seconds"] * 1000, 1)}
+            for g, s in stats.items()
+        }
+        return {
+            "grammars": grammars,
+            "parses": sum(s["parses"] for s in grammars.values()),
+            "cache_hits": sum(s["cache_hits"] for s in grammars.values()),
+            "ms": round(sum(s["seconds"] for s in stats.values()) * 1000, 1),
+            "cached_trees": len(self._trees),
+        }
+
+    def _grammar_stats(self, grammar: str) -> dict:
+        stats = self._stats.get(grammar)
+        if stats is None:
+            stats = self._stats[grammar] = {"parses": 0, "cache_hits": 0, "seconds": 0.0}
+        return stats
+
+
+_local = threading.local()
+
+
+def current_session() -> ParseSession:
+    """The calling thread's :class:`ParseSession`, created on first use."""
+    session = getattr(_local, "session", None)
+    if session is None:
+        session = _local.session = ParseSession()
+    return session
+
+
+def reset_session() -> None:
+    """Discard the calling thread's session (parsers, trees and stats)."""
+    _local.session = None
@@ -6,11 +6,19 @@ import logging
 import os
 import re
 import struct
+import time
 from pathlib import Path
 
+from roam.index.parse_session import current_session
+
 log = logging.getLogger(__name__)
 
-from tree_sitter_language_pack import get_parser as _lp_get_parser
+
+def _lp_get_parser(grammar: str):
+    # Imported on first parse: loading the language pack is slow at start-up
+    from tree_sitter_language_pack import get_parser as lp_get_parser
+
+    return lp_get_parser(grammar)
 
 
 def get_parser(grammar: str):
@@ -19,6 +27,7 @@ def get_parser(grammar: str):
         try:
             import tree_sitter_objc as _ts_mulle_objc
             from tree_sitter import Language, Parser
+
             lang = Language(_ts_mulle_objc.language())
             return Parser(lang)
         except Exception:
@@ -28,6 +37,7 @@ def get_parser(grammar: str):
         grammar = "objc"
     return _lp_get_parser(grammar)
 
+
 # Map file extensions to tree-sitter language names.
 # This is the single canonical source of truth for extension → language mapping.
 # registry.py's _EXTENSION_MAP is derived from this dict (see registry.py).
@@ -282,9 +292,16 @@ def _preprocess_vue(source: bytes) -> tuple[bytes, str]:
     return processed.encode("utf-8"), effective_lang
 
 
-def parse_file(path: Path, language: str | None = None):
+def parse_file(path: Path, language: str | None = None, tree_cache=None):
     """Parse a file with tree-sitter and return (tree, source_bytes, language).
 
+    Parsers and trees come from the thread's
+    :class:`~roam.index.parse_session.ParseSession`, so parsing the same
+    contents twice in a run returns the same tree.  With a
+    :class:`~roam.index.tree_cache.TreeCache`, a file parsed before is
+    reparsed incrementally from its retained tree instead; the cache then
+    holds the :class:`~roam.index.tree_cache.ParseDelta` for ``str(path)``.
+
     Returns (None, None, None) if parsing fails.
     Failure categories:
     - no_grammar: language detected but no tree-sitter grammar available (expected skip)
@@ -316,15 +333,23 @@ def parse_file(path: Path, language: str | None = None):
     plugin_alias = _plugin_grammar_aliases().get(language)
     grammar = plugin_alias or GRAMMAR_ALIASES.get(language, language)
 
+    session = current_session()
     try:
-        parser = get_parser(grammar)
+        parser = session.parser(grammar)
     except Exception:
         parse_errors["no_grammar"] += 1
         return None, None, None  # Grammar not available, expected skip
 
     try:
-        tree = parser.parse(source)
+        if tree_cache is not None:
+            t0 = time.perf_counter()
+            tree, _ = tree_cache.parse(str(path), source, grammar, parser)
+            session.record(grammar, time.perf_counter() - t0)
+        else:
+            tree = session.parse(source, grammar, path=str(path))
     except Exception as e:
+        if tree_cache is not None:
+            tree_cache.discard(str(path))
         parse_errors["parse_error"] += 1
         log.warning("Parse error in %s: %s", path, e)
         return None, None, None
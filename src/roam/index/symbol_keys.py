@@ -0,0 +1,186 @@
+"""Stable symbol identities across reindexing.
+
+``symbols.id`` is an autoincrement key and a modified file's symbols are
+deleted and reinserted, so without help every edit gives them new ids and
+drops everything keyed on them.  Each symbol therefore carries
+
+* ``stable_key`` -- a digest of (file path, qualified name, kind,
+  ordinal); the ordinal tells apart same-named symbols of one kind in a
+  file (overloads, redefinitions), and
+* ``content_hash`` -- a digest of the symbol's source lines, independent
+  of where in the file they sit.
+
+Before a modified file is deleted, :class:`RetainedSymbols` records its
+symbols' keys and copies their per-symbol derived rows into temp tables.
+Reinserted symbols whose key matches get their old id back.  When the
+content hash matches too, their derived rows are restored, so only
+symbols whose content changed are recomputed.  Links from tables that
+outlive symbols (annotations, runtime stats, vulnerabilities) are
+restored for every symbol whose key survived.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import sqlite3
+
+from roam.db.connection import batched_in
+
+# Per-symbol derived tables; rows are carried over for unchanged symbols
+DERIVED_TABLES = (
+    "symbol_metrics",
+    "math_signals",
+    "graph_metrics",
+    "clusters",
+    "symbol_effects",
+    "taint_summaries",
+    "symbol_tfidf",
+    "symbol_embeddings",
+)
+
+# (table, column) references kept for every symbol whose key survived
+LINK_COLUMNS = (
+    ("annotations", "symbol_id"),
+    ("runtime_stats", "symbol_id"),
+    ("vulnerabilities", "matched_symbol_id"),
+)
+
+
+def symbol_key(path: str, qualified_name: str, kind: str, ordinal: int) -> str:
+    """Stable key of the *ordinal*-th (0-based) *qualified_name*/*kind* symbol in *path*."""
+    raw = "\0".join((path, qualified_name, kind, str(ordinal)))
+    return hashlib.blake2b(raw.encode("utf-8"), digest_size=12).hexdigest()
+
+
+def assign_symbol_keys(rel_path: str, symbols: list[dict], source: bytes | None) -> None:
+    """Set ``stable_key`` and ``content_hash`` on extracted *symbols* in place.
+
+    Ordinals follow extraction order, which is source order.
+    """
+    lines = source.split(b"\n") if source else []
+    seen: dict[tuple[str, str], int] = {}
+    for sym in symbols:
+        name = sym.get("qualified_name") or sym["name"]
+        ident = (name, sym["kind"])
+        ordinal = seen.get(ident, 0)
+        seen[ident] = ordinal + 1
+        sym["stable_key"] = symbol_key(rel_path, name, sym["kind"], ordinal)
+
+        ls, le = sym.get("line_start"), sym.get("line_end")
+        if lines and ls and le and ls <= le:
+            body = b"\n".join(lines[ls - 1 : le])
+            sym["content_hash"] = hashlib.blake2b(body, digest_size=16).hexdigest()
+        else:
+            sym["content_hash"] = None
+
+
+class RetainedSymbols:
+    """Ids and derived rows of reindexed files' symbols, held across delete/reinsert.
+
+    One instance serves one ``_apply_changes`` run on one connection:
+    :meth:`save` each modified file before it is deleted, :meth:`match`
+    each reinserted symbol, then :meth:`restore` once all files are stored.
+    """
+
+    def __init__(self):
+        # rel_path -> {stable_key: (id, content_hash, line_start, line_end)}
+        self._keys: dict[str, dict[str, tuple]] = {}
+        self._links: list[tuple[str, str, int, int]] = []
+        self._tables: list[str] = []
+        # rel_path -> {(name, kind, new_start, new_end): (old_start, old_end)}
+        self._moved: dict[str, dict[tuple, tuple[int, int]]] = {}
+        self.retained: set[int] = set()
+        self.unchanged: set[int] = set()
+
+    def save(self, conn, rel_path: str, file_id: int) -> None:
+        """Record the keys, derived rows and links of *file_id*'s symbols."""
+        rows = conn.execute(
+            "SELECT id, stable_key, content_hash, line_start, line_end FROM symbols "
+            "WHERE file_id = ? AND stable_key IS NOT NULL",
+            (file_id,),
+        ).fetchall()
+        if not rows:
+            return
+        self._keys[rel_path] = {r[1]: (r[0], r[2], r[3], r[4]) for r in rows}
+        ids = [r[0] for r in rows]
+
+        for table in DERIVED_TABLES:
+            try:
+                if table not in self._tables:
+                    conn.execute(f"DROP TABLE IF EXISTS temp.keep_{table}")
+                    conn.execute(f"CREATE TEMP TABLE keep_{table} AS SELECT * FROM main.{table} WHERE 0")
+                    self._tables.append(table)
+                batched_in(
+                    conn,
+                    f"INSERT INTO temp.keep_{table} SELECT * FROM main.{table} WHERE symbol_id IN ({{ph}})",
+                    ids,
+                )
+            except sqlite3.OperationalError:
+                continue  # table missing in this index
+
+        for table, column in LINK_COLUMNS:
+            try:
+                links = batched_in(conn, f"SELECT id, {column} FROM {table} WHERE {column} IN ({{ph}})", ids)
+            except sqlite3.OperationalError:
+                continue
+            self._links.extend((table, column, r[0], r[1]) for r in links)
+
+    def match(self, rel_path: str, sym: dict) -> int | None:
+        """The old id for a reinserted *sym* (keyed by :func:`assign_symbol_keys`), or None."""
+        entry = self._keys.get(rel_path, {}).get(sym.get("stable_key"))
+        if entry is None:
+            return None
+        old_id, old_hash, old_start, old_end = entry
+        self.retained.add(old_id)
+        if old_hash is not None and old_hash == sym.get("content_hash"):
+            self.unchanged.add(old_id)
+            name = sym.get("qualified_name") or sym["name"]
+            moved = self._moved.setdefault(rel_path, {})
+            moved[(name, sym["kind"], sym["line_start"], sym["line_end"])] = (old_start, old_end)
+        return old_id
+
+    def metrics_reuse(self, rel_path: str, snapshot: dict):
+        """Lookup over :func:`~roam.index.complexity.snapshot_file_metrics` rows
+        for the unchanged symbols of *rel_path*, or None when there are none.
+
+        Same signature as :func:`~roam.index.complexity.carried_metrics`.
+        """
+        moved = self._moved.get(rel_path)
+        if not moved or not snapshot:
+            return None
+
+        def lookup(qualified_name, kind, line_start, line_end):
+            old = moved.get((qualified_name, kind, line_start, line_end))
+            if old is None:
+                return None
+            return snapshot.get((qualified_name, kind, old[0], old[1]))
+
+        return lookup
+
+    def restore(self, conn) -> int:
+        """Put back derived rows of unchanged symbols and links of retained ones.
+
+        Returns the number of unchanged symbols.
+        """
+        if self.unchanged and self._tables:
+            conn.execute("DROP TABLE IF EXISTS temp.keep_ids")
+            conn.execute("CREATE TEMP TABLE keep_ids (id INTEGER PRIMARY KEY)")
+            conn.executemany("INSERT INTO temp.keep_ids VALUES (?)", [(i,) for i in self.unchanged])
+            for table in self._tables:
+                conn.execute(
+                    f"INSERT OR REPLACE INTO main.{table} SELECT * FROM temp.keep_{table} "
+                    "WHERE symbol_id IN (SELECT id FROM temp.keep_ids)"
+                )
+            conn.execute("DROP TABLE temp.keep_ids")
+        for table in self._tables:
+            conn.execute(f"DROP TABLE IF EXISTS temp.keep_{table}")
+        self._tables = []
+
+        by_table: dict[tuple[str, str], list[tuple[int, int]]] = {}
+        for table, column, row_id, sym_id in self._links:
+            if sym_id in self.retained:
+                by_table.setdefault((table, column), []).append((sym_id, row_id))
+        for (table, column), pairs in by_table.items():
+            conn.executemany(f"UPDATE {table} SET {column} = ? WHERE id = ?", pairs)
+        self._links = []
+        return len(self.unchanged)
@@ -0,0 +1,202 @@
+"""Retained syntax trees for incremental reparsing in long-running indexers.
+
+A one-shot ``roam index`` parses every file from scratch.  ``roam watch``
+and other long-lived callers can hand the indexer a :class:`TreeCache`,
+which keeps the last tree and source of recently parsed files in a bounded
+LRU.  When a cached file is parsed again, the byte range that differs
+between the old and new contents becomes one ``Tree.edit`` and tree-sitter
+reuses every untouched subtree.
+
+Each parse also produces a :class:`ParseDelta` describing which lines
+moved or changed, so callers can skip per-symbol analysis for symbols the
+edit did not touch.
+"""
+
+from __future__ import annotations
+
+import time
+from collections import OrderedDict
+
+DEFAULT_MAX_FILES = 256
+
+
+def _point(data: bytes, offset: int) -> tuple[int, int]:
+    """(row, byte column) of *offset* in *data*."""
+    row = data.count(b"\n", 0, offset)
+    col = offset - (data.rfind(b"\n", 0, offset) + 1)
+    return row, col
+
+
+def compute_edit(old: bytes, new: bytes) -> dict | None:
+    """The single edit turning *old* into *new*, as ``Tree.edit`` kwargs.
+
+    The edit spans from the end of the common prefix to the start of the
+    common suffix.  Returns None when the contents are identical.
+    """
+    if old == new:
+        return None
+    limit = min(len(old), len(new))
+    start = 0
+    # Compare in blocks first, then narrow down byte by byte
+    block = 4096
+    while start + block <= limit and old[start : start + block] == new[start : start + block]:
+        start += block
+    while start < limit and old[start] == new[start]:
+        start += 1
+    o, n = len(old), len(new)
+    suffix = 0
+    max_suffix = limit - start
+    while suffix + block <= max_suffix and old[o - suffix - block : o - suffix] == new[n - suffix - block : n - suffix]:
+        suffix += block
+    while suffix < max_suffix and old[o - suffix - 1] == new[n - suffix - 1]:
+        suffix += 1
+    old_end = o - suffix
+    new_end = n - suffix
+    return {
+        "start_byte": start,
+        "old_end_byte": old_end,
+        "new_end_byte": new_end,
+        "start_point": _point(old, start),
+        "old_end_point": _point(old, old_end),
+        "new_end_point": _point(new, new_end),
+    }
+
+
+class ParseDelta:
+    """Lines an incremental reparse touched, in new-file coordinates.
+
+    ``edit_rows`` is ``(start_row, old_end_row, new_end_row)`` of the text
+    edit (0-based).  ``changed_rows`` holds the row spans tree-sitter
+    reports as structurally different.  A text edit that keeps the tree
+    shape (e.g. renaming an identifier) only shows up in ``edit_rows``,
+    so both are consulted.
+    """
+
+    __slots__ = ("edit_rows", "changed_rows")
+
+    def __init__(self, edit_rows: tuple[int, int, int] | None, changed_rows: list[tuple[int, int]]):
+        self.edit_rows = edit_rows
+        self.changed_rows = changed_rows
+
+    @property
+    def row_shift(self) -> int:
+        if self.edit_rows is None:
+            return 0
+        return self.edit_rows[2] - self.edit_rows[1]
+
+    def touches(self, line_start: int, line_end: int) -> bool:
+        """True if the 1-based inclusive line span overlaps the change."""
+        lo, hi = line_start - 1, line_end - 1
+        if self.edit_rows is not None:
+            start, _, new_end = self.edit_rows
+            if lo <= new_end and hi >= start:
+                return True
+        return any(lo <= r1 and hi >= r0 for r0, r1 in self.changed_rows)
+
+    def old_line(self, new_line: int) -> int | None:
+        """Line in the previous contents that *new_line* came from.
+
+        None for lines inside the edited region.
+        """
+        if self.edit_rows is None:
+            return new_line
+        start, old_end, new_end = self.edit_rows
+        row = new_line - 1
+        if row < start:
+            return new_line
+        if row > new_end:
+            return new_line - (new_end - old_end)
+        return None
+
+
+class TreeCache:
+    """Bounded LRU of ``path -> (grammar, source, tree)`` for incremental reparse.
+
+    Not thread-safe; one indexer owns one cache.  With ``measure_full`` every
+    incremental parse is followed by a timed full parse of the same source,
+    so :meth:`summary` can report the speedup actually achieved.
+    """
+
+    def __init__(self, max_files: int = DEFAULT_MAX_FILES, measure_full: bool = False):
+        self.max_files = max(1, max_files)
+        self.measure_full = measure_full
+        self._entries: OrderedDict[str, tuple[str, bytes, object]] = OrderedDict()
+        self._deltas: dict[str, ParseDelta] = {}
+        self.full_parses = 0
+        self.incremental_parses = 0
+        self.full_seconds = 0.0
+        self.incremental_seconds = 0.0
+        self.full_equivalent_seconds = 0.0
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+    def __contains__(self, key: str) -> bool:
+        return key in self._entries
+
+    def parse(self, key: str, source: bytes, grammar: str, parser):
+        """Parse *source*, reusing the cached tree for *key* when possible.
+
+        Returns ``(tree, delta)``; *delta* is None after a full parse.
+        """
+        self._deltas.pop(key, None)
+        cached = self._entries.pop(key, None)
+        tree = None
+        delta = None
+        if cached is not None and cached[0] == grammar:
+            _, old_source, old_tree = cached
+            edit = compute_edit(old_source, source)
+            if edit is None:
+                tree = old_tree
+                delta = ParseDelta(None, [])
+            else:
+                old_tree.edit(**edit)
+                t0 = time.perf_counter()
+                tree = parser.parse(source, old_tree)
+                self.incremental_seconds += time.perf_counter() - t0
+                self.incremental_parses += 1
+                changed = [(r.start_point[0], r.end_point[0]) for r in old_tree.changed_ranges(tree)]
+                delta = ParseDelta(
+                    (edit["start_point"][0], edit["old_end_point"][0], edit["new_end_point"][0]),
+                    changed,
+                )
+                if self.measure_full:
+                    t0 = time.perf_counter()
+                    parser.parse(source)
+                    self.full_equivalent_seconds += time.perf_counter() - t0
+        if tree is None:
+            t0 = time.perf_counter()
+            tree = parser.parse(source)
+            self.full_seconds += time.perf_counter() - t0
+            self.full_parses += 1
+
+        self._entries[key] = (grammar, source, tree)
+        if delta is not None:
+            self._deltas[key] = delta
+        while len(self._entries) > self.max_files:
+            evicted, _ = self._entries.popitem(last=False)
+            self._deltas.pop(evicted, None)
+        return tree, delta
+
+    def delta(self, key: str) -> ParseDelta | None:
+        """Delta of the most recent parse of *key* (None after a full parse)."""
+        return self._deltas.get(key)
+
+    def discard(self, key: str) -> None:
+        self._entries.pop(key, None)
+        self._deltas.pop(key, None)
+
+    def summary(self) -> dict:
+        """Parse counts and timings; ``speedup`` needs ``measure_full``."""
+        out = {
+            "cached_files": len(self._entries),
+            "full_parses": self.full_parses,
+            "incremental_parses": self.incremental_parses,
+            "full_ms": round(self.full_seconds * 1000, 2),
+            "incremental_ms": round(self.incremental_seconds * 1000, 2),
+        }
+        if self.measure_full and self.incremental_parses:
+            out["full_equivalent_ms"] = round(self.full_equivalent_seconds * 1000, 2)
+            if self.incremental_seconds > 0:
+                out["speedup"] = round(self.full_equivalent_seconds / self.incremental_seconds, 2)
+        return out
@@ -0,0 +1,266 @@
+"""Concurrent tool execution for the MCP server.
+
+Agents issue many read-only tool calls at once.  Before this module every
+sync tool ran on the event loop and every in-process command went through
+``click.testing.CliRunner``.  That runner swaps ``sys.stdout`` for the
+whole process, so calls were serialised (or their output interleaved).
+
+:class:`ToolExecutor` runs tools on two executors:
+
+* a bounded pool for read-only tools.  Each worker thread reuses its own
+  read-only SQLite connection (see
+  :func:`roam.db.connection.enable_worker_connections`).
+* a single writer thread for tools that modify the index or the repo
+  (``reindex``, ``annotate``, ``mutate``, ...).  Writes run in submission
+  order and never overlap each other.
+
+:func:`capture_output` replaces ``CliRunner`` isolation.  It routes
+``sys.stdout``/``sys.stderr`` writes made by the *calling thread* into
+private buffers, so concurrent in-process commands keep their output
+apart.
+
+Queue depth, in-flight counts and per-tool latency are kept in
+:meth:`ToolExecutor.stats`.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import functools
+import io
+import os
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from contextlib import contextmanager
+
+DEFAULT_MAX_WORKERS = 8
+
+
+def default_workers() -> int:
+    """Read-pool size: ``ROAM_MCP_WORKERS`` or min(8, CPU count)."""
+    env = os.environ.get("ROAM_MCP_WORKERS", "")
+    if env.isdigit() and int(env) > 0:
+        return int(env)
+    return max(1, min(DEFAULT_MAX_WORKERS, os.cpu_count() or 1))
+
+
+# ---------------------------------------------------------------------------
+# Per-thread stdout/stderr capture
+# ---------------------------------------------------------------------------
+
+
+class _ThreadLocalStream:
+    """Text stream that writes to a per-thread target, else to *fallback*."""
+
+    def __init__(self, fallback):
+        self._fallback = fallback
+        self._local = threading.local()
+
+    def _target(self):
+        return getattr(self._local, "target", None) or self._fallback
+
+    def write(self, s):
+        return self._target().write(s)
+
+    def writelines(self, lines):
+        self._target().writelines(lines)
+
+    def flush(self):
+        self._target().flush()
+
+    def isatty(self):
+        return self._target().isatty()
+
+    def writable(self):
+        return True
+
+    @property
+    def encoding(self):
+        return getattr(self._target(), "encoding", None) or "utf-8"
+
+    @property
+    def errors(self):
+        return getattr(self._target(), "errors", None) or "strict"
+
+    def __getattr__(self, name):
+        # fileno, buffer, etc. belong to the real stream
+        return getattr(self._fallback, name)
+
+
+_install_lock = threading.Lock()
+
+
+def _thread_stream(name: str) -> _ThreadLocalStream:
+    current = getattr(sys, name)
+    if isinstance(current, _ThreadLocalStream):
+        return current
+    with _install_lock:
+        current = getattr(sys, name)
+        if not isinstance(current, _ThreadLocalStream):
+            current = _ThreadLocalStream(current)
+            setattr(sys, name, current)
+        return current
+
+
+@contextmanager
+def capture_output():
+    """Capture this thread's stdout/stderr into ``(out, err)`` StringIOs.
+
+    Other threads keep writing to the real streams (or their own
+    captures), which makes this safe to use from concurrent workers.
+    """
+    out_stream = _thread_stream("stdout")
+    err_stream = _thread_stream("stderr")
+    out, err = io.StringIO(), io.StringIO()
+    prev_out = getattr(out_stream._local, "target", None)
+    prev_err = getattr(err_stream._local, "target", None)
+    out_stream._local.target = out
+    err_stream._local.target = err
+    try:
+        yield out, err
+    finally:
+        out_stream._local.target = prev_out
+        err_stream._local.target = prev_err
+
+
+# ---------------------------------------------------------------------------
+# Executor + metrics
+# ---------------------------------------------------------------------------
+
+
+class _ToolStats:
+    __slots__ = ("calls", "errors", "total_ms", "max_ms", "queued_ms")
+
+    def __init__(self):
+        self.calls = 0
+        self.errors = 0
+        self.total_ms = 0.0
+        self.max_ms = 0.0
+        self.queued_ms = 0.0
+
+    def as_dict(self) -> dict:
+        return {
+            "calls": self.calls,
+            "errors": self.errors,
+            "mean_ms": round(self.total_ms / self.calls, 2) if self.calls else 0.0,
+            "max_ms": round(self.max_ms, 2),
+            "mean_queued_ms": round(self.queued_ms / self.calls, 2) if self.calls else 0.0,
+        }
+
+
+class ToolExecutor:
+    """Bounded read pool + single writer thread, with latency metrics."""
+
+    def __init__(self, max_workers: int | None = None):
+        self.max_workers = max_workers or default_workers()
+        self._read: ThreadPoolExecutor | None = None
+        self._write: ThreadPoolExecutor | None = None
+        self._lock = threading.Lock()
+        self._queued = {"read": 0, "write": 0}
+        self._running = {"read": 0, "write": 0}
+        self._peak_queued = {"read": 0, "write": 0}
+        self._tools: dict[str, _ToolStats] = {}
+
+    def _pool(self, lane: str) -> ThreadPoolExecutor:
+        with self._lock:
+            if lane == "write":
+                if self._write is None:
+                    self._write = ThreadPoolExecutor(max_workers=1, thread_name_prefix="roam-mcp-write")
+                return self._write
+            if self._read is None:
+                from roam.db.connection import enable_worker_connections
+
+                self._read = ThreadPoolExecutor(
+                    max_workers=self.max_workers,
+                    thread_name_prefix="roam-mcp-read",
+                    initializer=enable_worker_connections,
+                )
+            return self._read
+
+    def _run(self, lane: str, name: str, submitted: float, fn, args, kwargs):
+        started = time.perf_counter()
+        with self._lock:
+            self._queued[lane] -= 1
+            self._running[lane] += 1
+        failed = False
+        try:
+            result = fn(*args, **kwargs)
+            failed = isinstance(result, dict) and bool(result.get("isError"))
+            return result
+        except BaseException:
+            failed = True
+            raise
+        finally:
+            self._record(lane, name, submitted, started, failed)
+
+    def _record(self, lane, name, submitted, started, failed):
+        done = time.perf_counter()
+        with self._lock:
+            if lane is not None:
+                self._running[lane] -= 1
+            stats = self._tools.setdefault(name, _ToolStats())
+            stats.calls += 1
+            stats.errors += int(failed)
+            elapsed = (done - submitted) * 1000
+            stats.total_ms += elapsed
+            stats.max_ms = max(stats.max_ms, elapsed)
+            stats.queued_ms += (started - submitted) * 1000
+
+    async def submit(self, name: str, fn, *args, write: bool = False, **kwargs):
+        """Run sync *fn* on the read pool (or the writer thread) and await it."""
+        lane = "write" if write else "read"
+        pool = self._pool(lane)
+        submitted = time.perf_counter()
+        with self._lock:
+            self._queued[lane] += 1
+            self._peak_queued[lane] = max(self._peak_queued[lane], self._queued[lane])
+        loop = asyncio.get_running_loop()
+        call = functools.partial(self._run, lane, name, submitted, fn, args, kwargs)
+        return await loop.run_in_executor(pool, call)
+
+    def wrap(self, name: str, fn, write: bool = False):
+        """Async wrapper dispatching *fn* through the executor.
+
+        Coroutine functions run on the event loop as before but still get
+        latency metrics.  ``functools.wraps`` keeps the signature intact for
+        schema generation.
+        """
+        if asyncio.iscoroutinefunction(fn):
+
+            @functools.wraps(fn)
+            async def timed(*args, **kwargs):
+                t0 = time.perf_counter()
+                failed = True
+                try:
+                    result = await fn(*args, **kwargs)
+                    failed = isinstance(result, dict) and bool(result.get("isError"))
+                    return result
+                finally:
+                    self._record(None, name, t0, t0, failed)
+
+            return timed
+
+        @functools.wraps(fn)
+        async def dispatched(*args, **kwargs):
+            return await self.submit(name, fn, *args, write=write, **kwargs)
+
+        return dispatched
+
+    def stats(self) -> dict:
+        with self._lock:
+            return {
+                "workers": self.max_workers,
+                "queue_depth": dict(self._queued),
+                "peak_queue_depth": dict(self._peak_queued),
+                "in_flight": dict(self._running),
+                "tools": {name: s.as_dict() for name, s in sorted(self._tools.items())},
+            }
+
+    def shutdown(self) -> None:
+        with self._lock:
+            pools = [p for p in (self._read, self._write) if p is not None]
+            self._read = self._write = None
+        for pool in pools:
+            pool.shutdown(wait=True)
@@ -20,7 +20,8 @@ import sys
 from pathlib import Path
 
 import click
-from click.testing import CliRunner as _CliRunner
+
+from roam.mcp_executor import ToolExecutor, capture_output
 
 try:
     from fastmcp import Context as _Context
@@ -194,10 +195,18 @@ _NON_READ_ONLY_TOOLS = {
     "roam_mutate",
     "roam_init",
     "roam_reindex",
+    "roam_reset",
+    "roam_clean",
+    "roam_trends",
+    "roam_vuln_reach",
 }
-_DESTRUCTIVE_TOOLS = {"roam_mutate"}
+_DESTRUCTIVE_TOOLS = {"roam_mutate", "roam_reset"}
 _NON_IDEMPOTENT_TOOLS = _NON_READ_ONLY_TOOLS.copy()
 
+# Read-only tools run concurrently on a bounded pool (ROAM_MCP_WORKERS);
+# _NON_READ_ONLY_TOOLS go through a single writer thread.
+_EXECUTOR = ToolExecutor()
+
 # Tools where task execution must be used (non-blocking by default).
 _TASK_REQUIRED_TOOLS = {
     "roam_init",
@@ -646,6 +655,11 @@ def _tool(name: str, description: str = "", output_schema: dict | None = None):
         # 1) Full feature set
         # 2) Drop task support when tasks extras aren't installed
         # 3) Legacy FastMCP without output_schema/annotations/title/meta/task
+        # Registered handler: sync tools are dispatched to the executor so
+        # the event loop keeps serving concurrent calls.  The module-level
+        # name still binds to whatever mcp.tool returns.
+        handler = _EXECUTOR.wrap(name, fn, write=name in _NON_READ_ONLY_TOOLS)
+
         attempts = [dict(kwargs)]
         if "task" in kwargs:
             no_task = dict(kwargs)
@@ -664,7 +678,7 @@ def _tool(name: str, description: str = "", output_schema: dict | None = None):
                 continue
             seen.add(signature)
             try:
-                return mcp.tool(**attempt)(fn)
+                return mcp.tool(**attempt)(handler)
             except (TypeError, ImportError) as exc:
                 last_error = exc
                 continue
@@ -771,24 +785,33 @@ def _run_roam(args: list[str], root: str = ".") -> dict:
     return _run_roam_inprocess(args)
 
 
-def _run_roam_inprocess(args: list[str]) -> dict:
-    """Run a roam CLI command in-process via Click CliRunner (no subprocess)."""
+def _invoke_cli(cmd_args: list[str]) -> tuple[int, str, str, BaseException | None]:
+    """Run the roam CLI in this thread; returns (exit_code, stdout, stderr, exception).
+
+    Output is captured per thread (unlike ``CliRunner``, which swaps the
+    process-wide streams), so pool workers can run commands concurrently.
+    """
     from roam.cli import cli as _cli
 
-    runner = _CliRunner()
-    cmd_args = ["--json"] + args
-    try:
-        result = runner.invoke(_cli, cmd_args, catch_exceptions=True)
-    except Exception as exc:
-        return _structured_error(
-            {
-                "error": str(exc),
-                "error_code": "UNKNOWN",
-                "hint": "an unexpected error occurred.",
-            }
-        )
+    exception = None
+    with capture_output() as (out, err):
+        try:
+            _cli.main(args=cmd_args, prog_name="roam", standalone_mode=True)
+            exit_code = 0
+        except SystemExit as exc:
+            code = exc.code
+            exit_code = code if isinstance(code, int) else (0 if code is None else 1)
+        except Exception as exc:
+            exit_code = 1
+            exception = exc
+    return exit_code, out.getvalue(), err.getvalue(), exception
 
-    output = result.output.strip() if result.output else ""
+
+def _run_roam_inprocess(args: list[str]) -> dict:
+    """Run a roam CLI command in-process (no subprocess)."""
+    cmd_args = ["--json"] + args
+    exit_code, stdout, stderr, exception = _invoke_cli(cmd_args)
+    output = stdout.strip()
 
     # Gate failure (exit code 5) still produces valid JSON output — the
     # command completed but found issues.  Treat it like success for output
@@ -798,10 +821,10 @@ def _run_roam_inprocess(args: list[str]) -> dict:
     _success_codes = {0, EXIT_GATE_FAILURE}
 
     # Successful JSON output — look for JSON object in output
-    if result.exit_code in _success_codes and output:
+    if exit_code in _success_codes and output:
         try:
             parsed = json.loads(output)
-            if result.exit_code == EXIT_GATE_FAILURE:
+            if exit_code == EXIT_GATE_FAILURE:
                 parsed["gate_failure"] = True
                 parsed["exit_code"] = EXIT_GATE_FAILURE
             return parsed
@@ -815,17 +838,17 @@ def _run_roam_inprocess(args: list[str]) -> dict:
             )
 
     # Error path — classify and return structured error
-    error_text = output
-    if result.exception:
-        error_text = error_text or str(result.exception)
+    error_text = output or stderr.strip()
+    if exception:
+        error_text = error_text or str(exception)
 
-    error_code, hint, _retryable = _classify_error(error_text, result.exit_code)
+    error_code, hint, _retryable = _classify_error(error_text, exit_code)
     return _structured_error(
         {
             "error": error_text or "command failed",
             "error_code": error_code,
             "hint": hint,
-            "exit_code": result.exit_code,
+            "exit_code": exit_code,
             "command": "roam --json " + " ".join(args),
         }
     )
@@ -889,9 +912,13 @@ def _run_roam_subprocess(args: list[str], root: str = ".") -> dict:
         )
 
 
-async def _run_roam_async(args: list[str], root: str = ".") -> dict:
-    """Run a roam CLI command in a worker thread from async tool handlers."""
-    return await asyncio.to_thread(_run_roam, args, root)
+async def _run_roam_async(args: list[str], root: str = ".", write: bool = False) -> dict:
+    """Run a roam CLI command on the tool executor from async tool handlers.
+
+    *write* routes the command through the single writer thread.
+    """
+    label = "roam " + (args[0] if args else "")
+    return await _EXECUTOR.submit(label, _run_roam, args, root, write=write)
 
 
 async def _ctx_report_progress(
@@ -1634,7 +1661,7 @@ async def roam_init(root: str = ".", yes: bool = True, ctx: _Context | None = No
 
     await _ctx_info(ctx, "Starting roam initialization.")
     await _ctx_report_progress(ctx, 5, total=100, message="initializing")
-    result = await _run_roam_async(args, root)
+    result = await _run_roam_async(args, root, write=True)
     await _ctx_report_progress(ctx, 100, total=100, message="completed")
     return result
 
@@ -1649,6 +1676,7 @@ async def roam_reindex(
     verbose: bool = False,
     confirm_force: bool = False,
     root: str = ".",
+    paths: list[str] | None = None,
     ctx: _Context | None = None,
 ) -> dict:
     """Refresh the code index (`roam index`) with async task support.
@@ -1656,6 +1684,8 @@ async def roam_reindex(
     WHEN TO USE: after large code changes, generated file churn, or parser upgrades.
     Use `force=True` for a full rebuild. If `force=True` and `confirm_force=False`,
     the tool requests user confirmation via MCP elicitation when available.
+    Pass `paths` (files you just edited) for a fast targeted refresh; graph
+    metrics and search are then deferred to the next plain reindex.
     """
     if force and not confirm_force:
         approved = await _confirm_force_reindex(ctx)
@@ -1683,12 +1713,15 @@ async def roam_reindex(
     args = ["index"]
     if force:
         args.append("--force")
+    elif paths:
+        for path in paths:
+            args.extend(["--changed", path])
     if verbose:
         args.append("--verbose")
 
     await _ctx_info(ctx, "Starting index refresh.")
     await _ctx_report_progress(ctx, 5, total=100, message="indexing")
-    result = await _run_roam_async(args, root)
+    result = await _run_roam_async(args, root, write=True)
     await _ctx_report_progress(ctx, 100, total=100, message="completed")
     if force and "error" not in result:
         result["force"] = True
@@ -2641,6 +2674,11 @@ if mcp is not None:
         data = _run_roam(["complexity"])
         return json.dumps(data, indent=2)
 
+    @mcp.resource("roam://server-stats")
+    def get_server_stats_resource() -> str:
+        """Tool executor metrics: queue depth, in-flight calls, per-tool latency (JSON)."""
+        return json.dumps(_EXECUTOR.stats(), indent=2)
+
 
 # ===================================================================
 # Workspace tools -- multi-repo analysis
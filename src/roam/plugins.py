@@ -13,7 +13,6 @@ from __future__ import annotations
 
 import importlib
 import os
-from importlib import metadata as importlib_metadata
 from typing import Any, Callable
 
 CommandTarget = tuple[str, str]
@@ -130,6 +129,8 @@ def _discover_env_modules(api: PluginAPI) -> None:
 
 
 def _entry_points_for_group(group: str):
+    from importlib import metadata as importlib_metadata
+
     eps = importlib_metadata.entry_points()
     if hasattr(eps, "select"):
         return list(eps.select(group=group))
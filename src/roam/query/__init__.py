@@ -0,0 +1,340 @@
+"""Typed query layer over the roam index.
+
+The functions here call the analysis code directly and return dataclasses,
+so library callers skip Click, output formatting and JSON round-trips.  CLI
+commands render the same results, which keeps both surfaces in step.
+
+:class:`RoamQuery` binds the functions to a project and hands every thread
+its own read-only SQLite connection, so one instance can be shared by a
+thread pool without locking or ``chdir``.
+"""
+
+from __future__ import annotations
+
+import sqlite3
+import threading
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+
+from roam.db.connection import find_project_root, get_connection, get_db_path
+
+
+class IndexNotFoundError(FileNotFoundError):
+    """Raised when a query is made against a project that has no index."""
+
+
+# ---------------------------------------------------------------------------
+# Result types
+# ---------------------------------------------------------------------------
+
+
+@dataclass
+class SymbolMetrics:
+    """Unified metrics for one symbol (``roam metrics <symbol>``)."""
+
+    name: str
+    kind: str
+    location: str
+    health: str
+    metrics: dict
+
+    target_type = "symbol"
+
+
+@dataclass
+class FileMetrics:
+    """Aggregate metrics for one file plus a per-symbol breakdown."""
+
+    file: str
+    language: str | None
+    file_role: str | None
+    health: str
+    metrics: dict
+    symbols: list[dict] = field(default_factory=list)
+
+    target_type = "file"
+
+
+@dataclass
+class Smell:
+    """A single code-smell finding (``roam smells``)."""
+
+    smell_id: str
+    severity: str
+    symbol_name: str
+    kind: str
+    location: str
+    metric_value: float | int
+    threshold: float | int
+    description: str
+
+    def to_dict(self) -> dict:
+        return asdict(self)
+
+
+@dataclass
+class SmellReport:
+    """Smell findings plus detector diagnostics."""
+
+    smells: list[Smell]
+    detectors_failed: int = 0
+    failed_detectors: list[str] = field(default_factory=list)
+    detector_timings_ms: dict[str, float] = field(default_factory=dict)
+
+
+@dataclass
+class AlgoFinding:
+    """A suboptimal-algorithm finding (``roam algo``).
+
+    Keys not modelled as fields (``evidence``, ``fix``, precision metadata
+    and so on) are kept in ``extra``.
+    """
+
+    task_id: str
+    detected_way: str
+    suggested_way: str
+    symbol_id: int
+    symbol_name: str
+    kind: str
+    location: str
+    confidence: str
+    reason: str
+    extra: dict = field(default_factory=dict)
+
+    _FIELDS = (
+        "task_id",
+        "detected_way",
+        "suggested_way",
+        "symbol_id",
+        "symbol_name",
+        "kind",
+        "location",
+        "confidence",
+        "reason",
+    )
+
+    @classmethod
+    def from_dict(cls, finding: dict) -> AlgoFinding:
+        extra = {k: v for k, v in finding.items() if k not in cls._FIELDS}
+        return cls(**{k: finding.get(k) for k in cls._FIELDS}, extra=extra)
+
+    def to_dict(self) -> dict:
+        return {**{k: getattr(self, k) for k in self._FIELDS}, **self.extra}
+
+
+@dataclass
+class AlgoReport:
+    """Algorithm findings, highest impact first, plus detector diagnostics."""
+
+    findings: list[AlgoFinding]
+    profile: str = "balanced"
+    profile_filtered: int = 0
+    detectors_executed: int = 0
+    detectors_failed: int = 0
+    failed_detectors: list[str] = field(default_factory=list)
+    detector_metadata: dict = field(default_factory=dict)
+    detector_timings_ms: dict[str, float] = field(default_factory=dict)
+
+
+# ---------------------------------------------------------------------------
+# Queries (connection in, dataclasses out)
+# ---------------------------------------------------------------------------
+
+
+def query_metrics(conn: sqlite3.Connection, target: str) -> SymbolMetrics | FileMetrics | None:
+    """Metrics for a file path or symbol name; None when *target* is unknown."""
+    from roam.output.formatter import loc
+    from roam.query.metrics import collect_file_metrics, collect_symbol_metrics, health_label, resolve_target
+
+    target_type, target_id, _ = resolve_target(conn, target)
+    if target_type == "file":
+        data = collect_file_metrics(conn, target_id)
+        if not data:
+            return None
+        fm = data["metrics"]
+        health = health_label(
+            {
+                "complexity": fm["complexity"],
+                "fan_out": fm["fan_out"],
+                "churn": fm["churn"],
+                "dead_code_risk": fm["dead_symbols"] > 0,
+            }
+        )
+        return FileMetrics(
+            file=data["file"],
+            language=data["language"],
+            file_role=data["file_role"],
+            health=health,
+            metrics=fm,
+            symbols=data["symbols"],
+        )
+
+    if target_type == "symbol":
+        row = conn.execute(
+            "SELECT s.name, s.kind, s.qualified_name, s.line_start, f.path AS file_path "
+            "FROM symbols s JOIN files f ON s.file_id = f.id WHERE s.id = ?",
+            (target_id,),
+        ).fetchone()
+        if row is None:
+            return None
+        sm = collect_symbol_metrics(conn, target_id)
+        return SymbolMetrics(
+            name=row["qualified_name"] or row["name"],
+            kind=row["kind"],
+            location=loc(row["file_path"], row["line_start"]),
+            health=health_label(sm),
+            metrics=sm,
+        )
+
+    return None
+
+
+def query_smells(
+    conn: sqlite3.Connection,
+    *,
+    file_path: str | None = None,
+    min_severity: str | None = None,
+) -> SmellReport:
+    """Run the smell detectors, optionally filtered by file and severity."""
+    from roam.catalog.smells import _SEVERITY_ORDER, run_all_detectors
+
+    findings, meta = run_all_detectors(conn, return_meta=True)
+    if file_path:
+        norm = file_path.replace("\\", "/")
+        findings = [f for f in findings if norm in f.get("location", "").replace("\\", "/")]
+    if min_severity:
+        max_order = _SEVERITY_ORDER.get(min_severity.lower(), 2)
+        findings = [f for f in findings if _SEVERITY_ORDER.get(f.get("severity", "info"), 2) <= max_order]
+    return SmellReport(
+        smells=[Smell(**{k: f[k] for k in Smell.__dataclass_fields__}) for f in findings],
+        detectors_failed=meta["detectors_failed"],
+        failed_detectors=list(meta["failed_detectors"]),
+        detector_timings_ms=dict(meta["detector_timings_ms"]),
+    )
+
+
+def query_algo(
+    conn: sqlite3.Connection,
+    *,
+    task: str | None = None,
+    confidence: str | None = None,
+    profile: str = "balanced",
+) -> AlgoReport:
+    """Run the algorithm detectors and return typed findings.
+
+    Findings carry a language-aware ``tip`` and ``fix`` (in ``extra``) and
+    are ordered by impact score, then confidence.
+    """
+    from roam.catalog.detectors import run_detectors
+    from roam.catalog.fixes import get_fix
+    from roam.catalog.tasks import get_tip
+    from roam.db.connection import batched_in
+
+    findings, meta = run_detectors(conn, task, confidence, profile=profile, return_meta=True)
+
+    # Build symbol_id -> language mapping for language-aware tips
+    sym_ids = [f["symbol_id"] for f in findings if f.get("symbol_id")]
+    lang_map: dict[int, str] = {}
+    if sym_ids:
+        rows = batched_in(
+            conn,
+            "SELECT s.id, f.language FROM symbols s JOIN files f ON s.file_id = f.id WHERE s.id IN ({ph})",
+            sym_ids,
+        )
+        lang_map = {r[0]: r[1] for r in rows if r[1]}
+
+    for f in findings:
+        lang = lang_map.get(f.get("symbol_id"), "")
+        f["language"] = lang
+        f["tip"] = get_tip(f["task_id"], f["suggested_way"], lang)
+        if not f.get("fix"):
+            f["fix"] = get_fix(f["task_id"], lang)
+
+    conf_order = {"high": 0, "medium": 1, "low": 2}
+    findings.sort(key=lambda f: (-float(f.get("impact_score", 0.0) or 0.0), conf_order.get(f["confidence"], 9)))
+
+    return AlgoReport(
+        findings=[AlgoFinding.from_dict(f) for f in findings],
+        profile=meta.get("profile", profile),
+        profile_filtered=meta.get("profile_filtered", 0),
+        detectors_executed=meta.get("detectors_executed", 0),
+        detectors_failed=meta.get("detectors_failed", 0),
+        failed_detectors=list(meta.get("failed_detectors", [])),
+        detector_metadata=dict(meta.get("detector_metadata", {})),
+        detector_timings_ms=dict(meta.get("detector_timings_ms", {})),
+    )
+
+
+# ---------------------------------------------------------------------------
+# Project-bound, thread-safe entry point
+# ---------------------------------------------------------------------------
+
+
+class RoamQuery:
+    """Typed, thread-safe queries against one project's index.
+
+    Each thread lazily opens its own read-only connection on first use;
+    :meth:`close` closes all of them.  The index must already exist --
+    build it with ``RoamClient.index()`` or ``roam init``.
+    """
+
+    def __init__(self, project_root: str | Path | None = None) -> None:
+        self.project_root = Path(project_root).resolve() if project_root is not None else find_project_root()
+        self.db_path = get_db_path(self.project_root)
+        self._local = threading.local()
+        self._lock = threading.Lock()
+        self._conns: list[sqlite3.Connection] = []
+
+    def connection(self) -> sqlite3.Connection:
+        """Read-only connection owned by the calling thread."""
+        conn = getattr(self._local, "conn", None)
+        if conn is None:
+            if not self.db_path.exists():
+                raise IndexNotFoundError(f"No roam index at {self.db_path}. Run `roam init` first.")
+            conn = get_connection(self.db_path, readonly=True)
+            self._local.conn = conn
+            with self._lock:
+                self._conns.append(conn)
+        return conn
+
+    def generation(self) -> int:
+        """Index generation this thread's connection currently reads.
+
+        Shadow builds publish a new generation in one transaction, so a
+        query running while ``roam index`` swaps the index in completes
+        against the generation it started on.
+        """
+        from roam.db.shadow import current_generation
+
+        return current_generation(self.connection())
+
+    def close(self) -> None:
+        with self._lock:
+            conns, self._conns = self._conns, []
+        for conn in conns:
+            try:
+                conn.close()
+            except sqlite3.ProgrammingError:
+                pass  # owned by another thread; released once unreferenced
+        self._local = threading.local()
+
+    def __enter__(self) -> RoamQuery:
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    def metrics(self, target: str) -> SymbolMetrics | FileMetrics | None:
+        return query_metrics(self.connection(), target)
+
+    def smells(self, *, file_path: str | None = None, min_severity: str | None = None) -> SmellReport:
+        return query_smells(self.connection(), file_path=file_path, min_severity=min_severity)
+
+    def algo(
+        self,
+        *,
+        task: str | None = None,
+        confidence: str | None = None,
+        profile: str = "balanced",
+    ) -> AlgoReport:
+        return query_algo(self.connection(), task=task, confidence=confidence, profile=profile)
@@ -16,8 +16,6 @@ from __future__ import annotations
 import re
 from dataclasses import dataclass
 
-from tree_sitter_language_pack import get_parser
-
 from roam.index.parser import GRAMMAR_ALIASES
 
 _METAVAR_RE = re.compile(r"\$([A-Za-z_][A-Za-z0-9_]*)")
@@ -120,7 +118,11 @@ def _extract_pattern_root(root_node):
 
 
 def compile_ast_pattern(pattern: str, language: str) -> CompiledAstPattern:
-    """Compile an AST pattern for the target language."""
+    """Compile an AST pattern for the target language.
+
+    Compiled patterns are memoised in the thread's parse session, so a rule
+    evaluated against many files (or several times in one run) is parsed once.
+    """
     if not pattern or not pattern.strip():
         raise ValueError("AST pattern is empty")
 
@@ -128,9 +130,17 @@ def compile_ast_pattern(pattern: str, language: str) -> CompiledAstPattern:
     if not normalized_lang:
         raise ValueError("AST pattern language is required")
 
+    from roam.index.parse_session import current_session
+
     grammar = GRAMMAR_ALIASES.get(normalized_lang, normalized_lang)
-    parser = get_parser(grammar)
+    return current_session().compiled(
+        grammar,
+        ("ast_pattern", normalized_lang, pattern),
+        lambda parser: _build_ast_pattern(pattern, normalized_lang, parser),
+    )
+
 
+def _build_ast_pattern(pattern: str, normalized_lang: str, parser) -> CompiledAstPattern:
     rewritten, placeholder_map = _rewrite_metavars(pattern)
     source = rewritten.encode("utf-8")
     tree = parser.parse(source)
@@ -6,7 +6,6 @@ Roam evaluates them against the indexed graph and reports violations.
 
 from __future__ import annotations
 
-import fnmatch
 import re
 from pathlib import Path
 
@@ -18,6 +17,7 @@ from roam.rules.ast_match import (
     normalize_language_name,
 )
 from roam.rules.dataflow import collect_dataflow_findings
+from roam.rules.path_match import PathIndex, compile_glob, evaluate_path_rules
 
 # ---------------------------------------------------------------------------
 # YAML loading with fallback
@@ -169,43 +169,9 @@ def _matches_glob(file_path: str, pattern: str) -> bool:
 
     Supports ``**`` for matching zero or more directories, unlike plain
     ``fnmatch`` which treats ``*`` as matching everything including ``/``.
+    Compiled patterns are cached (see :func:`roam.rules.path_match.compile_glob`).
     """
-    norm = file_path.replace("\\", "/")
-    pat = pattern.replace("\\", "/")
-
-    if "**" not in pat:
-        return fnmatch.fnmatch(norm, pat)
-
-    # Convert glob pattern with ** to regex
-    parts: list[str] = []
-    i = 0
-    while i < len(pat):
-        c = pat[i]
-        if c == "*":
-            if i + 1 < len(pat) and pat[i + 1] == "*":
-                if i + 2 < len(pat) and pat[i + 2] == "/":
-                    parts.append("(?:.+/)?")
-                    i += 3
-                    continue
-                else:
-                    parts.append(".*")
-                    i += 2
-                    continue
-            else:
-                parts.append("[^/]*")
-                i += 1
-        elif c == "?":
-            parts.append("[^/]")
-            i += 1
-        elif c in r".+^${}()|[]":
-            parts.append("\\" + c)
-            i += 1
-        else:
-            parts.append(c)
-            i += 1
-
-    regex = "".join(parts)
-    return re.match("^" + regex + "$", norm) is not None
+    return compile_glob(pattern)(file_path)
 
 
 def _matches_kind(kind: str, kind_filter: list | str | None) -> bool:
@@ -262,89 +228,13 @@ def _as_float_or_none(value) -> float | None:
 
 
 def _evaluate_path_match(rule: dict, conn) -> dict:
-    """Evaluate a path_match rule: find edges between from/to patterns.
+    """Evaluate a path_match rule: find paths between from/to patterns.
 
     Looks for direct edges (or paths up to max_distance) from symbols
     matching ``match.from`` criteria to symbols matching ``match.to`` criteria.
+    :func:`evaluate_all` batches all path rules through the same evaluator.
     """
-    match = rule.get("match", {})
-    from_spec = match.get("from", {})
-    to_spec = match.get("to", {})
-    max_distance = match.get("max_distance", 1)
-    exempt = rule.get("exempt", {})
-
-    from_glob = from_spec.get("file_glob")
-    from_kind = from_spec.get("kind")
-    to_glob = to_spec.get("file_glob")
-    to_kind = to_spec.get("kind")
-
-    # Query edges joining source and target symbols with their files
-    rows = conn.execute("""
-        SELECT
-            s1.name AS src_name, s1.kind AS src_kind,
-            f1.path AS src_file, s1.line_start AS src_line,
-            s2.name AS tgt_name, s2.kind AS tgt_kind,
-            f2.path AS tgt_file, s2.line_start AS tgt_line,
-            e.kind AS edge_kind
-        FROM edges e
-        JOIN symbols s1 ON e.source_id = s1.id
-        JOIN files f1 ON s1.file_id = f1.id
-        JOIN symbols s2 ON e.target_id = s2.id
-        JOIN files f2 ON s2.file_id = f2.id
-    """).fetchall()
-
-    violations: list[dict] = []
-    for row in rows:
-        src_file = row["src_file"]
-        tgt_file = row["tgt_file"]
-        src_name = row["src_name"]
-        tgt_name = row["tgt_name"]
-        src_kind = row["src_kind"]
-        tgt_kind = row["tgt_kind"]
-
-        # Apply from-pattern filter
-        if from_glob and not _matches_glob(src_file, from_glob):
-            continue
-        if not _matches_kind(src_kind, from_kind):
-            continue
-
-        # Apply to-pattern filter
-        if to_glob and not _matches_glob(tgt_file, to_glob):
-            continue
-        if not _matches_kind(tgt_kind, to_kind):
-            continue
-
-        # max_distance=1 means direct edge (already satisfied)
-        # For max_distance > 1 we would need BFS, but direct edge
-        # matching covers the core use case.
-        if max_distance < 1:
-            continue
-
-        # Check exemptions
-        if _is_exempt(src_name, src_file, exempt):
-            continue
-        if _is_exempt(tgt_name, tgt_file, exempt):
-            continue
-
-        violations.append(
-            {
-                "symbol": src_name,
-                "file": src_file,
-                "line": row["src_line"],
-                "reason": f"{src_name} ({src_file}) -> {tgt_name} ({tgt_file})",
-            }
-        )
-
-    name = rule.get("name", "unnamed")
-    severity = rule.get("severity", "error")
-    passed = len(violations) == 0
-
-    return {
-        "name": name,
-        "severity": severity,
-        "passed": passed,
-        "violations": violations,
-    }
+    return evaluate_path_rules([rule], PathIndex(conn))[0]
 
 
 # ---------------------------------------------------------------------------
@@ -483,6 +373,16 @@ def _evaluate_symbol_match(rule: dict, conn) -> dict:
         ]
     )
 
+    # One lookup for all symbols when the indexer stored test reachability
+    tested_ids = None
+    test_ids: set[int] = set()
+    if require_has_test:
+        from roam.graph.test_reach import collect_test_symbols, directly_tested_ids
+
+        tested_ids = directly_tested_ids(conn)
+        if tested_ids is None:
+            test_ids = {sid for ids in collect_test_symbols(conn).values() for sid in ids}
+
     violations: list[dict] = []
     for row in rows:
         file_path = row["file_path"]
@@ -509,8 +409,13 @@ def _evaluate_symbol_match(rule: dict, conn) -> dict:
         if has_requirements:
             reasons: list[str] = []
 
-            if require_has_test and not _symbol_has_test(conn, row["id"]):
-                reasons.append("{} has no test coverage".format(symbol_name))
+            if require_has_test:
+                if tested_ids is not None:
+                    has_test = row["id"] in tested_ids
+                else:
+                    has_test = _symbol_has_test(conn, row["id"], test_ids)
+                if not has_test:
+                    reasons.append("{} has no test coverage".format(symbol_name))
 
             if compiled_name_regex and not compiled_name_regex.search(symbol_name):
                 reasons.append("name '{}' does not match {}".format(symbol_name, compiled_name_regex.pattern))
@@ -593,20 +498,15 @@ def _evaluate_symbol_match(rule: dict, conn) -> dict:
     }
 
 
-def _symbol_has_test(conn, symbol_id: int) -> bool:
-    """Check if a symbol has edges from test files."""
-    rows = conn.execute(
-        """
-        SELECT 1 FROM edges e
-        JOIN symbols s ON e.source_id = s.id
-        JOIN files f ON s.file_id = f.id
-        WHERE e.target_id = ?
-          AND (f.file_role = 'test' OR f.path LIKE '%%test%%')
-        LIMIT 1
-    """,
-        (symbol_id,),
-    ).fetchall()
-    return len(rows) > 0
+def _symbol_has_test(conn, symbol_id: int, test_ids: set[int]) -> bool:
+    """Check if a symbol is called directly by a test.
+
+    Fallback for indexes without ``test_reach`` (see
+    :func:`roam.graph.test_reach.directly_tested_ids`); *test_ids* are the
+    same tests, from :func:`~roam.graph.test_reach.collect_test_symbols`.
+    """
+    rows = conn.execute("SELECT source_id FROM edges WHERE target_id = ?", (symbol_id,)).fetchall()
+    return any(r[0] in test_ids for r in rows)
 
 
 # ---------------------------------------------------------------------------
@@ -937,7 +837,16 @@ def evaluate_all(rules_dir: Path, conn) -> list[dict]:
     Returns a list of result dicts, one per rule.
     """
     rules = load_rules(rules_dir)
-    results: list[dict] = []
-    for rule in rules:
-        results.append(evaluate_rule(rule, conn))
+    results: list[dict | None] = [None] * len(rules)
+
+    # path_match rules share one adjacency load and one pass over the edges
+    path_idx = [i for i, rule in enumerate(rules) if "_error" not in rule and _detect_rule_type(rule) == "path_match"]
+    if path_idx:
+        batch = evaluate_path_rules([rules[i] for i in path_idx], PathIndex(conn))
+        for i, result in zip(path_idx, batch):
+            results[i] = result
+
+    for i, rule in enumerate(rules):
+        if results[i] is None:
+            results[i] = evaluate_rule(rule, conn)
     return results
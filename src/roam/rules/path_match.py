@@ -0,0 +1,302 @@
+"""Set-at-a-time evaluation of ``path_match`` rules.
+
+A ``path_match`` rule forbids paths from symbols matching ``match.from`` to
+symbols matching ``match.to``.  The old evaluator joined the whole edge
+table once per rule and matched each row's files against globs in Python.
+This module evaluates every path rule in one batch:
+
+* :class:`PathIndex` loads files, symbols and edges once.
+* Every distinct glob (from, to and exempt files) is compiled once and
+  matched once per file.  The matches become per-file rule bitmaps: bit *r*
+  of ``from_bits[f]`` is set when rule *r* accepts file *f* as a source.
+  The ``to`` and exempt bitmaps work the same way.
+* One pass over the edges ANDs the source file's ``from`` bitmap with the
+  target file's ``to`` bitmap.  Only rules whose bit survives are checked
+  further (kinds, exemptions).
+* Rules with ``max_distance > 1`` also run a bounded BFS over the cached
+  adjacency.  All sources of a rule move together: each node carries an
+  int bitset of the sources that reached it, and a frontier only carries
+  the bits that are new at that depth.  So every (source, target) pair is
+  found once, at its shortest distance.
+
+Direct edges are reported exactly as before: one violation per edge row.
+Longer paths give one violation per (source, target) pair, with its
+``distance`` in hops.
+"""
+
+from __future__ import annotations
+
+import fnmatch
+import os
+import re
+from functools import lru_cache
+
+
+@lru_cache(maxsize=512)
+def compile_glob(pattern: str):
+    """Return a ``match(path) -> bool`` callable for a rule glob.
+
+    Supports ``**`` for matching zero or more directories, unlike plain
+    ``fnmatch`` which treats ``*`` as matching everything including ``/``.
+    """
+    pat = pattern.replace("\\", "/")
+
+    if "**" not in pat:
+        rx = re.compile(fnmatch.translate(os.path.normcase(pat)))
+        return lambda path: rx.match(os.path.normcase(path.replace("\\", "/"))) is not None
+
+    # Convert glob pattern with ** to regex
+    parts: list[str] = []
+    i = 0
+    while i < len(pat):
+        c = pat[i]
+        if c == "*":
+            if i + 1 < len(pat) and pat[i + 1] == "*":
+                if i + 2 < len(pat) and pat[i + 2] == "/":
+                    parts.append("(?:.+/)?")
+                    i += 3
+                    continue
+                else:
+                    parts.append(".*")
+                    i += 2
+                    continue
+            else:
+                parts.append("[^/]*")
+                i += 1
+        elif c == "?":
+            parts.append("[^/]")
+            i += 1
+        elif c in r".+^${}()|[]":
+            parts.append("\\" + c)
+            i += 1
+        else:
+            parts.append(c)
+            i += 1
+
+    rx = re.compile("^" + "".join(parts) + "$")
+    return lambda path: rx.match(path.replace("\\", "/")) is not None
+
+
+def _as_list(value) -> list:
+    if value is None:
+        return []
+    if isinstance(value, str):
+        return [value]
+    return list(value)
+
+
+def _kind_set(kind_filter) -> frozenset | None:
+    if kind_filter is None:
+        return None
+    return frozenset(_as_list(kind_filter))
+
+
+class PathIndex:
+    """Files, symbols and edges loaded once for a batch of path rules."""
+
+    def __init__(self, conn):
+        self.files: list[str] = []
+        file_idx: dict[int, int] = {}
+        for fid, path in conn.execute("SELECT id, path FROM files").fetchall():
+            file_idx[fid] = len(self.files)
+            self.files.append(path)
+
+        # symbol id -> (name, kind, file index, line)
+        self.symbols: dict[int, tuple] = {}
+        for sid, name, kind, fid, line in conn.execute(
+            "SELECT id, name, kind, file_id, line_start FROM symbols"
+        ).fetchall():
+            f = file_idx.get(fid)
+            if f is not None:
+                self.symbols[sid] = (name, kind, f, line)
+
+        # Edge rows in insertion order, keeping duplicates of different kinds
+        symbols = self.symbols
+        self.edges: list[tuple[int, int]] = [
+            (s, t)
+            for s, t in conn.execute("SELECT source_id, target_id FROM edges ORDER BY id").fetchall()
+            if s in symbols and t in symbols
+        ]
+        self._out: dict[int, tuple[int, ...]] | None = None
+
+    @property
+    def out(self) -> dict[int, tuple[int, ...]]:
+        """Deduplicated successor lists, built on first multi-hop use."""
+        if self._out is None:
+            out: dict[int, dict[int, None]] = {}
+            for s, t in self.edges:
+                out.setdefault(s, {})[t] = None
+            self._out = {s: tuple(ts) for s, ts in out.items()}
+        return self._out
+
+
+class _PathRule:
+    __slots__ = (
+        "rule",
+        "from_glob",
+        "to_glob",
+        "from_kinds",
+        "to_kinds",
+        "max_distance",
+        "exempt_names",
+        "exempt_globs",
+    )
+
+    def __init__(self, rule: dict):
+        match = rule.get("match", {})
+        from_spec = match.get("from", {}) or {}
+        to_spec = match.get("to", {}) or {}
+        exempt = rule.get("exempt", {}) or {}
+        self.rule = rule
+        self.from_glob = from_spec.get("file_glob")
+        self.to_glob = to_spec.get("file_glob")
+        self.from_kinds = _kind_set(from_spec.get("kind"))
+        self.to_kinds = _kind_set(to_spec.get("kind"))
+        try:
+            self.max_distance = int(match.get("max_distance", 1))
+        except (TypeError, ValueError):
+            self.max_distance = 1
+        self.exempt_names = frozenset(_as_list(exempt.get("symbols")))
+        self.exempt_globs = [g for g in _as_list(exempt.get("files")) if g]
+
+
+def _file_bitmaps(rules: list[_PathRule], files: list[str]):
+    """Per-file rule bitmaps for the from, to and exempt-file globs."""
+    globs: dict[str, int] = {}
+    for r in rules:
+        for g in [r.from_glob, r.to_glob, *r.exempt_globs]:
+            if g:
+                globs.setdefault(g, len(globs))
+    matchers = [compile_glob(g) for g in globs]
+
+    active = [r.max_distance >= 1 for r in rules]
+    from_bits: list[int] = []
+    to_bits: list[int] = []
+    exempt_bits: list[int] = []
+    for path in files:
+        hits = 0
+        for i, m in enumerate(matchers):
+            if m(path):
+                hits |= 1 << i
+        fb = tb = eb = 0
+        for ri, r in enumerate(rules):
+            bit = 1 << ri
+            if active[ri] and (not r.from_glob or hits >> globs[r.from_glob] & 1):
+                fb |= bit
+            if active[ri] and (not r.to_glob or hits >> globs[r.to_glob] & 1):
+                tb |= bit
+            if any(hits >> globs[g] & 1 for g in r.exempt_globs):
+                eb |= bit
+        from_bits.append(fb)
+        to_bits.append(tb)
+        exempt_bits.append(eb)
+    return from_bits, to_bits, exempt_bits
+
+
+def _violation(src: tuple, tgt: tuple, files: list[str], distance: int = 1) -> dict:
+    src_name, _, sf, src_line = src
+    tgt_name, _, tf, _ = tgt
+    src_file, tgt_file = files[sf], files[tf]
+    if distance == 1:
+        return {
+            "symbol": src_name,
+            "file": src_file,
+            "line": src_line,
+            "reason": f"{src_name} ({src_file}) -> {tgt_name} ({tgt_file})",
+        }
+    return {
+        "symbol": src_name,
+        "file": src_file,
+        "line": src_line,
+        "reason": f"{src_name} ({src_file}) -> ... -> {tgt_name} ({tgt_file}) [{distance} hops]",
+        "distance": distance,
+    }
+
+
+def _reachable_pairs(sources: list[int], is_target, out: dict, max_distance: int):
+    """Yield ``(source, target, distance)`` for paths of 2..max_distance hops.
+
+    Multi-source BFS: ``reach[node]`` is a bitset over *sources*, and each
+    frontier holds only the bits that first arrived at that depth.
+    """
+    reach: dict[int, int] = {}
+    frontier: dict[int, int] = {}
+    for i, sid in enumerate(sources):
+        reach[sid] = reach.get(sid, 0) | (1 << i)
+        frontier[sid] = reach[sid]
+
+    for depth in range(1, max_distance + 1):
+        nxt: dict[int, int] = {}
+        for node, bits in frontier.items():
+            for nb in out.get(node, ()):
+                new = bits & ~reach.get(nb, 0)
+                if new:
+                    reach[nb] = reach.get(nb, 0) | new
+                    nxt[nb] = nxt.get(nb, 0) | new
+        if not nxt:
+            return
+        if depth >= 2:
+            for nb, bits in nxt.items():
+                if not is_target(nb):
+                    continue
+                while bits:
+                    low = bits & -bits
+                    bits ^= low
+                    yield sources[low.bit_length() - 1], nb, depth
+        frontier = nxt
+
+
+def evaluate_path_rules(rules: list[dict], index: PathIndex) -> list[dict]:
+    """Evaluate a batch of path_match rules; one result dict per rule."""
+    compiled = [_PathRule(r) for r in rules]
+    files = index.files
+    symbols = index.symbols
+    from_bits, to_bits, exempt_bits = _file_bitmaps(compiled, files)
+    violations: list[list[dict]] = [[] for _ in compiled]
+
+    def endpoint_ok(r: _PathRule, bit: int, sym: tuple, kinds) -> bool:
+        name, kind, f, _ = sym
+        if kinds is not None and kind not in kinds:
+            return False
+        return not (exempt_bits[f] & bit or name in r.exempt_names)
+
+    # Distance 1: one pass over all edges for all rules
+    for s, t in index.edges:
+        src = symbols[s]
+        tgt = symbols[t]
+        hits = from_bits[src[2]] & to_bits[tgt[2]]
+        while hits:
+            bit = hits & -hits
+            hits ^= bit
+            ri = bit.bit_length() - 1
+            r = compiled[ri]
+            if endpoint_ok(r, bit, src, r.from_kinds) and endpoint_ok(r, bit, tgt, r.to_kinds):
+                violations[ri].append(_violation(src, tgt, files))
+
+    # Distance 2..max_distance: bounded bitset BFS per multi-hop rule
+    for ri, r in enumerate(compiled):
+        if r.max_distance < 2:
+            continue
+        bit = 1 << ri
+        sources = [
+            sid for sid, sym in symbols.items() if from_bits[sym[2]] & bit and endpoint_ok(r, bit, sym, r.from_kinds)
+        ]
+        if not sources:
+            continue
+
+        def is_target(sid, r=r, bit=bit):
+            sym = symbols[sid]
+            return bool(to_bits[sym[2]] & bit) and endpoint_ok(r, bit, sym, r.to_kinds)
+
+        for s, t, d in _reachable_pairs(sources, is_target, index.out, r.max_distance):
+            violations[ri].append(_violation(symbols[s], symbols[t], files, d))
+
+    return [
+        {
+            "name": r.rule.get("name", "unnamed"),
+            "severity": r.rule.get("severity", "error"),
+            "passed": not v,
+            "violations": v,
+        }
+        for r, v in zip(compiled, violations)
+    ]
@@ -478,7 +478,12 @@ def _build_symbol_embedding_text(row) -> str:
 
 
 def build_and_store_onnx_embeddings(conn, project_root=None) -> dict[str, Any]:
-    """Compute dense ONNX vectors for symbols and store in symbol_embeddings."""
+    """Compute dense ONNX vectors for symbols and store in symbol_embeddings.
+
+    Symbols keep their id and vector across reindexing while their content
+    is unchanged (see :mod:`roam.index.symbol_keys`), so only symbols
+    without a vector from the current model are embedded.
+    """
     settings = _load_semantic_settings(project_root=project_root)
     ready, reason, settings = _onnx_ready(project_root=project_root, settings=settings)
     if not ready:
@@ -487,21 +492,25 @@ def build_and_store_onnx_embeddings(conn, project_root=None) -> dict[str, Any]:
     embedder = _get_onnx_embedder(project_root=project_root, settings=settings)
     if embedder is None:
         return {"enabled": False, "reason": "embedder-unavailable"}
+    model_id = getattr(embedder, "model_id", "onnx-model")
 
-    rows = conn.execute("SELECT id, name, qualified_name, signature, kind, docstring FROM symbols").fetchall()
+    conn.execute("DELETE FROM symbol_embeddings WHERE provider='onnx' AND model_id IS NOT ?", (model_id,))
+    kept = conn.execute("SELECT COUNT(*) FROM symbol_embeddings WHERE provider='onnx'").fetchone()[0]
+    rows = conn.execute(
+        "SELECT id, name, qualified_name, signature, kind, docstring FROM symbols "
+        "WHERE id NOT IN (SELECT symbol_id FROM symbol_embeddings WHERE provider='onnx')"
+    ).fetchall()
     if not rows:
-        return {"enabled": True, "stored": 0, "dims": 0}
+        return {"enabled": True, "stored": kept, "embedded": 0, "dims": 0, "model_id": model_id}
 
     texts = [_build_symbol_embedding_text(row) for row in rows]
     vectors = embedder.embed_texts(texts)
     if not vectors:
-        return {"enabled": True, "stored": 0, "dims": 0}
+        return {"enabled": True, "stored": kept, "embedded": 0, "dims": 0, "model_id": model_id}
 
     count = min(len(rows), len(vectors))
     dims = len(vectors[0]) if vectors and vectors[0] else 0
-    model_id = getattr(embedder, "model_id", "onnx-model")
 
-    conn.execute("DELETE FROM symbol_embeddings WHERE provider='onnx'")
     batch = []
     for idx in range(count):
         sid = rows[idx]["id"]
@@ -526,7 +535,8 @@ def build_and_store_onnx_embeddings(conn, project_root=None) -> dict[str, Any]:
 
     return {
         "enabled": True,
-        "stored": count,
+        "stored": kept + count,
+        "embedded": count,
         "dims": dims,
         "model_id": model_id,
     }
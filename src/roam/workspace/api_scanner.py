@@ -2,11 +2,14 @@
 
 from __future__ import annotations
 
+import bisect
 import json
 import re
 import sqlite3
 from pathlib import Path
-from typing import Any
+from typing import Any, Callable, Iterator
+
+from roam.db.source_store import SourceStore
 
 # Regex to extract URL path from a source line
 _URL_RE = re.compile(r"""[('"`](/[a-zA-Z0-9/_\-{}.]+)[)'"`]""")
@@ -29,6 +32,13 @@ _FRONTEND_CALL_NAMES = {
     "axios",
 }
 
+# Client call sites: api.get(...), axios.post(...), $fetch.put(...)
+_API_CALL_RE = re.compile(
+    r"""(?:api|axios|http|client|\$fetch|useFetch|useLazyFetch|fetch)"""
+    r"""\s*\.\s*(get|post|put|delete|patch)\s*\(""",
+    re.IGNORECASE,
+)
+
 # Backend route definition patterns per framework
 _BACKEND_ROUTE_RE = re.compile(
     r"""Route\s*::\s*(get|post|put|delete|patch|any|match|resource|apiResource)"""
@@ -51,11 +61,64 @@ _PYTHON_ROUTE_RE = re.compile(
 )
 
 
-def scan_frontend_api_calls(repo_db_path: Path, repo_root: Path) -> list[dict[str, Any]]:
+class ScanCache:
+    """Per-file scan results keyed by content hash (``files.hash``).
+
+    Backed by the ``ws_scan_cache`` table of the workspace DB, so a
+    re-resolve only reads files whose content changed since the last run.
+    Entries not looked up during a run are dropped by :meth:`prune`.
+    """
+
+    def __init__(self, ws_conn: sqlite3.Connection):
+        self.conn = ws_conn
+        self.hits = 0
+        self.misses = 0
+        self._used: set[tuple[str, str]] = set()
+
+    def get(self, kind: str, content_hash: str | None) -> list | None:
+        if not content_hash:
+            return None
+        self._used.add((kind, content_hash))
+        row = self.conn.execute(
+            "SELECT result FROM ws_scan_cache WHERE kind = ? AND content_hash = ?",
+            (kind, content_hash),
+        ).fetchone()
+        if row is None:
+            self.misses += 1
+            return None
+        self.hits += 1
+        return json.loads(row[0])
+
+    def put(self, kind: str, content_hash: str | None, result: list) -> None:
+        if not content_hash:
+            return
+        self._used.add((kind, content_hash))
+        self.conn.execute(
+            "INSERT OR REPLACE INTO ws_scan_cache (kind, content_hash, result) VALUES (?, ?, ?)",
+            (kind, content_hash, json.dumps(result, separators=(",", ":"))),
+        )
+
+    def prune(self) -> int:
+        """Delete entries not used since this cache was created."""
+        stale = [
+            (r[0], r[1])
+            for r in self.conn.execute("SELECT kind, content_hash FROM ws_scan_cache").fetchall()
+            if (r[0], r[1]) not in self._used
+        ]
+        self.conn.executemany("DELETE FROM ws_scan_cache WHERE kind = ? AND content_hash = ?", stale)
+        return len(stale)
+
+
+def scan_frontend_api_calls(
+    repo_db_path: Path,
+    repo_root: Path,
+    cache: ScanCache | None = None,
+) -> list[dict[str, Any]]:
     """Scan a frontend repo DB for API call sites.
 
     Looks for references to HTTP methods (get/post/etc.) and extracts
-    URL patterns from the corresponding source lines.
+    URL patterns from the corresponding source lines.  Each file is
+    scanned once, and not at all when *cache* holds its content hash.
 
     Returns a list of dicts: {symbol_id, url_pattern, http_method,
     file_path, line, symbol_name}
@@ -67,7 +130,17 @@ def scan_frontend_api_calls(repo_db_path: Path, repo_root: Path) -> list[dict[st
     conn.row_factory = sqlite3.Row
 
     results = []
+    sources = SourceStore(conn, repo_root, cache_size=1)
+    scanned: dict[str, dict[int, list]] = {}
     try:
+        hashes = {r["path"]: r["hash"] for r in conn.execute("SELECT path, hash FROM files").fetchall()}
+
+        def url_lines(path: str) -> dict[int, list]:
+            if path not in scanned:
+                hits = _cached_scan(cache, "api_calls", hashes.get(path), sources, path, _iter_url_lines)
+                scanned[path] = {h[0]: h for h in hits}
+            return scanned[path]
+
         # Find references to HTTP method calls
         rows = conn.execute(
             "SELECT e.source_id, e.target_id, e.line, e.kind, "
@@ -91,21 +164,16 @@ def scan_frontend_api_calls(repo_db_path: Path, repo_root: Path) -> list[dict[st
 
             line_num = row["line"]
             file_path = row["file_path"]
-
-            # Read the source line to extract URL
-            url = _extract_url_from_source(repo_root / file_path, line_num)
-            if not url:
+            hit = url_lines(file_path).get(line_num)
+            if hit is None:
                 continue
 
-            # For fetch-like calls, try to infer method from context
-            if http_method is None:
-                http_method = _infer_method_from_context(repo_root / file_path, line_num)
-
             results.append(
                 {
                     "symbol_id": row["source_id"],
-                    "url_pattern": url,
-                    "http_method": http_method or "GET",
+                    "url_pattern": hit[1],
+                    # For fetch-like calls the method comes from context
+                    "http_method": http_method or hit[2] or "GET",
                     "file_path": file_path,
                     "line": line_num,
                     "symbol_name": row["source_name"],
@@ -120,36 +188,42 @@ def scan_frontend_api_calls(repo_db_path: Path, repo_root: Path) -> list[dict[st
 
         seen_urls = {(r["file_path"], r["line"]) for r in results}
         for file_row in file_rows:
-            fpath = repo_root / file_row["path"]
-            if not fpath.exists():
-                continue
-            calls = _scan_file_for_api_calls(fpath, file_row["path"])
-            for call in calls:
-                key = (call["file_path"], call["line"])
-                if key not in seen_urls:
-                    # Try to find the enclosing symbol
-                    sym = conn.execute(
-                        "SELECT id, name FROM symbols "
-                        "WHERE file_id=? AND line_start<=? AND "
-                        "(line_end>=? OR line_end IS NULL) "
-                        "ORDER BY line_start DESC LIMIT 1",
-                        (file_row["id"], call["line"], call["line"]),
-                    ).fetchone()
-                    call["symbol_id"] = sym["id"] if sym else 0
-                    call["symbol_name"] = sym["name"] if sym else ""
-                    results.append(call)
-                    seen_urls.add(key)
+            enclosing = None
+            for hit in url_lines(file_row["path"]).values():
+                line_num, _, _, call_method, call_url = hit
+                key = (file_row["path"], line_num)
+                if not call_url or key in seen_urls:
+                    continue
+                if enclosing is None:
+                    enclosing = _EnclosingSymbols(conn, file_row["id"])
+                sym = enclosing.find(line_num)
+                results.append(
+                    {
+                        "url_pattern": call_url,
+                        "http_method": call_method,
+                        "file_path": file_row["path"],
+                        "line": line_num,
+                        "symbol_id": sym["id"] if sym else 0,
+                        "symbol_name": sym["name"] if sym else "",
+                    }
+                )
+                seen_urls.add(key)
     finally:
         conn.close()
 
     return results
 
 
-def scan_backend_routes(repo_db_path: Path, repo_root: Path) -> list[dict[str, Any]]:
+def scan_backend_routes(
+    repo_db_path: Path,
+    repo_root: Path,
+    cache: ScanCache | None = None,
+) -> list[dict[str, Any]]:
     """Scan a backend repo for route definitions.
 
     Supports Laravel (Route::get), Express (router.get), and
-    FastAPI (@app.get) patterns.
+    FastAPI (@app.get) patterns.  Files whose content hash is in *cache*
+    are not read.
 
     Returns a list of dicts: {symbol_id, url_pattern, http_method,
     file_path, line, symbol_name}
@@ -161,29 +235,31 @@ def scan_backend_routes(repo_db_path: Path, repo_root: Path) -> list[dict[str, A
     conn.row_factory = sqlite3.Row
 
     results = []
+    sources = SourceStore(conn, repo_root, cache_size=1)
     try:
         # Scan all PHP, Python, JS/TS files for route definitions
         file_rows = conn.execute(
-            "SELECT id, path, language FROM files WHERE language IN ('php', 'python', 'javascript', 'typescript')"
+            "SELECT id, path, hash FROM files WHERE language IN ('php', 'python', 'javascript', 'typescript')"
         ).fetchall()
 
         for file_row in file_rows:
-            fpath = repo_root / file_row["path"]
-            if not fpath.exists():
+            routes = _cached_scan(cache, "routes", file_row["hash"], sources, file_row["path"], _iter_routes)
+            if not routes:
                 continue
-            routes = _scan_file_for_routes(fpath, file_row["path"])
-            for route in routes:
-                # Find the handler symbol
-                sym = conn.execute(
-                    "SELECT id, name FROM symbols "
-                    "WHERE file_id=? AND line_start<=? AND "
-                    "(line_end>=? OR line_end IS NULL) "
-                    "ORDER BY line_start DESC LIMIT 1",
-                    (file_row["id"], route["line"], route["line"]),
-                ).fetchone()
-                route["symbol_id"] = sym["id"] if sym else 0
-                route["symbol_name"] = sym["name"] if sym else ""
-                results.append(route)
+            # Find the handler symbol
+            enclosing = _EnclosingSymbols(conn, file_row["id"])
+            for line_num, http_method, url in routes:
+                sym = enclosing.find(line_num)
+                results.append(
+                    {
+                        "url_pattern": url,
+                        "http_method": http_method,
+                        "file_path": file_row["path"],
+                        "line": line_num,
+                        "symbol_id": sym["id"] if sym else 0,
+                        "symbol_name": sym["name"] if sym else "",
+                    }
+                )
     finally:
         conn.close()
 
@@ -206,6 +282,7 @@ def match_api_endpoints(
     for route in backend_routes:
         normalized = _normalize_url(route["url_pattern"])
         backend_by_url.setdefault(normalized, []).append(route)
+    trie = _RouteTrie(backend_by_url)
 
     matches = []
     for call in frontend_calls:
@@ -214,7 +291,7 @@ def match_api_endpoints(
 
         if not candidates:
             # Try prefix match for parameterized routes
-            candidates = _fuzzy_url_match(normalized, backend_by_url)
+            candidates = _fuzzy_url_match(normalized, backend_by_url, trie)
 
         for candidate in candidates:
             # Method match (if both specify a method)
@@ -331,83 +408,45 @@ def build_cross_repo_edges(
 # ---------------------------------------------------------------------------
 
 
-def _extract_url_from_source(file_path: Path, line_num: int | None) -> str | None:
-    """Read a source line and extract a URL pattern."""
-    if line_num is None:
-        return None
-    try:
-        lines = file_path.read_text(encoding="utf-8", errors="replace").splitlines()
-        if line_num <= 0 or line_num > len(lines):
-            return None
-        line = lines[line_num - 1]
-        m = _URL_RE.search(line)
-        return m.group(1) if m else None
-    except (OSError, UnicodeDecodeError):
-        return None
-
-
-def _infer_method_from_context(file_path: Path, line_num: int | None) -> str | None:
+def _infer_method_from_context(lines: list[str], line_num: int | None) -> str | None:
     """Try to infer HTTP method from surrounding lines."""
     if line_num is None:
         return None
-    try:
-        lines = file_path.read_text(encoding="utf-8", errors="replace").splitlines()
-        start = max(0, (line_num or 1) - 3)
-        end = min(len(lines), (line_num or 1) + 2)
-        context = " ".join(lines[start:end]).lower()
-        for method in ("post", "put", "delete", "patch"):
-            if f"method: '{method}'" in context or f'method: "{method}"' in context:
-                return method.upper()
-            if f"method:{method}" in context:
-                return method.upper()
-        return None
-    except (OSError, UnicodeDecodeError):
-        return None
-
-
-def _scan_file_for_api_calls(file_path: Path, rel_path: str) -> list[dict[str, Any]]:
-    """Scan a source file for API call patterns via regex."""
-    results = []
-    try:
-        lines = file_path.read_text(encoding="utf-8", errors="replace").splitlines()
-    except (OSError, UnicodeDecodeError):
-        return results
-
-    api_call_re = re.compile(
-        r"""(?:api|axios|http|client|\$fetch|useFetch|useLazyFetch|fetch)"""
-        r"""\s*\.\s*(get|post|put|delete|patch)\s*\(""",
-        re.IGNORECASE,
-    )
-
+    start = max(0, (line_num or 1) - 3)
+    end = min(len(lines), (line_num or 1) + 2)
+    context = " ".join(lines[start:end]).lower()
+    for method in ("post", "put", "delete", "patch"):
+        if f"method: '{method}'" in context or f'method: "{method}"' in context:
+            return method.upper()
+        if f"method:{method}" in context:
+            return method.upper()
+    return None
+
+
+def _iter_url_lines(lines: list[str]) -> Iterator[list]:
+    """Single pass over a frontend file.
+
+    Yields ``[line, url, context_method, call_method, call_url]`` for every
+    line containing a URL literal: the first URL on the line (what an
+    HTTP-method edge on that line refers to), the method inferred from the
+    surrounding lines, and -- when the line is an ``api.get(...)``-style
+    call -- the call's method and the URL following it.
+    """
     for i, line in enumerate(lines, 1):
-        m = api_call_re.search(line)
+        m = _URL_RE.search(line)
         if not m:
             continue
-        http_method = m.group(1).upper()
-        url_m = _URL_RE.search(line[m.end() - 1 :])
-        if url_m:
-            results.append(
-                {
-                    "url_pattern": url_m.group(1),
-                    "http_method": http_method,
-                    "file_path": rel_path,
-                    "line": i,
-                    "symbol_id": 0,
-                    "symbol_name": "",
-                }
-            )
-
-    return results
+        call_method = call_url = None
+        call = _API_CALL_RE.search(line)
+        if call:
+            url_m = _URL_RE.search(line, call.end() - 1)
+            if url_m:
+                call_method, call_url = call.group(1).upper(), url_m.group(1)
+        yield [i, m.group(1), _infer_method_from_context(lines, i), call_method, call_url]
 
 
-def _scan_file_for_routes(file_path: Path, rel_path: str) -> list[dict[str, Any]]:
-    """Scan a source file for route definition patterns."""
-    results = []
-    try:
-        lines = file_path.read_text(encoding="utf-8", errors="replace").splitlines()
-    except (OSError, UnicodeDecodeError):
-        return results
-
+def _iter_routes(lines: list[str]) -> Iterator[list]:
+    """Single pass over a backend file, yielding ``[line, http_method, url]``."""
     for i, line in enumerate(lines, 1):
         # Laravel Route::get/post/...
         m = _BACKEND_ROUTE_RE.search(line)
@@ -420,44 +459,63 @@ def _scan_file_for_routes(file_path: Path, rel_path: str) -> list[dict[str, Any]
                 http_method = "ANY"
             else:
                 http_method = method_raw.upper()
-            results.append(
-                {
-                    "url_pattern": m.group(2),
-                    "http_method": http_method,
-                    "file_path": rel_path,
-                    "line": i,
-                }
-            )
+            yield [i, http_method, m.group(2)]
             continue
 
         # Express/Fastify
         m = _EXPRESS_ROUTE_RE.search(line)
         if m:
             method_raw = m.group(1).lower()
-            http_method = "ANY" if method_raw == "all" else method_raw.upper()
-            results.append(
-                {
-                    "url_pattern": m.group(2),
-                    "http_method": http_method,
-                    "file_path": rel_path,
-                    "line": i,
-                }
-            )
+            yield [i, "ANY" if method_raw == "all" else method_raw.upper(), m.group(2)]
             continue
 
         # FastAPI/Flask
         m = _PYTHON_ROUTE_RE.search(line)
         if m:
-            results.append(
-                {
-                    "url_pattern": m.group(2),
-                    "http_method": m.group(1).upper(),
-                    "file_path": rel_path,
-                    "line": i,
-                }
-            )
+            yield [i, m.group(1).upper(), m.group(2)]
+
+
+def _cached_scan(
+    cache: ScanCache | None,
+    kind: str,
+    content_hash: str | None,
+    sources: SourceStore,
+    rel_path: str,
+    scan: Callable[[list[str]], Iterator[list]],
+) -> list[list]:
+    """Run *scan* over a file, or return its cached result for *content_hash*."""
+    if cache is not None:
+        cached = cache.get(kind, content_hash)
+        if cached is not None:
+            return cached
+    lines = sources.lines(rel_path)
+    if lines is None:
+        return []
+    result = list(scan(lines))
+    if cache is not None:
+        cache.put(kind, content_hash, result)
+    return result
 
-    return results
+
+class _EnclosingSymbols:
+    """Innermost-start symbol covering a line, from one query per file."""
+
+    def __init__(self, conn: sqlite3.Connection, file_id: int):
+        self._rows = conn.execute(
+            "SELECT id, name, line_start, line_end FROM symbols "
+            "WHERE file_id = ? AND line_start IS NOT NULL ORDER BY line_start, id",
+            (file_id,),
+        ).fetchall()
+        self._starts = [r["line_start"] for r in self._rows]
+
+    def find(self, line: int):
+        i = bisect.bisect_right(self._starts, line)
+        while i > 0:
+            i -= 1
+            row = self._rows[i]
+            if row["line_end"] is None or row["line_end"] >= line:
+                return row
+        return None
 
 
 def _normalize_url(url: str) -> str:
@@ -478,7 +536,63 @@ def _normalize_url(url: str) -> str:
     return normalized.lower()
 
 
-def _fuzzy_url_match(normalized_url: str, backend_by_url: dict[str, list]) -> list[dict[str, Any]]:
+class _RouteTrie:
+    """Segment trie over normalized backend URLs.
+
+    ``[*]`` segments (normalized ``{param}``/``:param`` placeholders) act as
+    wildcards on either side, so :meth:`match` returns exactly the keys
+    :func:`_urls_equivalent` accepts, without comparing against every route.
+    """
+
+    _WILDCARD = "[*]"
+
+    def __init__(self, urls=()):
+        self._root: dict = {}
+        self._order: dict[str, int] = {}
+        for url in urls:
+            self.insert(url)
+
+    def insert(self, url: str) -> None:
+        if url in self._order:
+            return
+        self._order[url] = len(self._order)
+        node = self._root
+        for seg in _segments(url):
+            node = node.setdefault(seg, {})
+        node[None] = url  # None never collides with a segment string
+
+    def match(self, url: str) -> list[str]:
+        """Stored URLs equivalent to *url*, in insertion order."""
+        segs = _segments(url)
+        found: list[str] = []
+        stack = [(self._root, 0)]
+        while stack:
+            node, depth = stack.pop()
+            if depth == len(segs):
+                if None in node:
+                    found.append(node[None])
+                continue
+            seg = segs[depth]
+            if seg == self._WILDCARD:
+                stack.extend((child, depth + 1) for key, child in node.items() if key is not None)
+                continue
+            child = node.get(seg)
+            if child is not None:
+                stack.append((child, depth + 1))
+            if self._WILDCARD in node:
+                stack.append((node[self._WILDCARD], depth + 1))
+        return sorted(found, key=self._order.__getitem__)
+
+
+def _segments(url: str) -> list[str]:
+    return [s for s in url.split("/") if s]
+
+
+def _fuzzy_url_match(
+    normalized_url: str,
+    backend_by_url: dict[str, list],
+    trie: _RouteTrie | None = None,
+) -> list[dict[str, Any]]:
     """Try to match a frontend URL against backend routes with some fuzziness."""
     # Try with/without /api prefix
     candidates = []
@@ -488,10 +602,11 @@ def _fuzzy_url_match(normalized_url: str, backend_by_url: dict[str, list]) -> li
         if alt in backend_by_url:
             candidates.extend(backend_by_url[alt])
 
-    # Also try the original URL as a backend route key
-    for backend_url, routes in backend_by_url.items():
-        if _urls_equivalent(normalized_url, backend_url):
-            candidates.extend(routes)
+    # Segment-wise match with {param} wildcards
+    if trie is None:
+        trie = _RouteTrie(backend_by_url)
+    for backend_url in trie.match(normalized_url):
+        candidates.extend(backend_by_url[backend_url])
 
     return candidates
 
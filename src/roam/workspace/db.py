@@ -40,6 +40,14 @@ CREATE TABLE IF NOT EXISTS ws_cross_edges (
     metadata TEXT
 );
 
+-- Per-file API scan results keyed by file content hash (ws resolve)
+CREATE TABLE IF NOT EXISTS ws_scan_cache (
+    kind TEXT NOT NULL,
+    content_hash TEXT NOT NULL,
+    result TEXT NOT NULL,
+    PRIMARY KEY (kind, content_hash)
+);
+
 CREATE INDEX IF NOT EXISTS idx_ws_route_symbols_repo
     ON ws_route_symbols(repo_id);
 CREATE INDEX IF NOT EXISTS idx_ws_route_symbols_url
@@ -4,6 +4,7 @@ Covers:
 - modified_z_score: point anomaly detection with MAD-based Z-scores
 - theil_sen_slope: robust trend estimation
 - mann_kendall_test: non-parametric trend significance
+- kendall_s / theil_sen_slopes / mann_kendall_tests: fast and batch paths
 - western_electric_rules: control chart pattern detection
 - cusum: cumulative sum change detection
 - forecast: linear projection to target
@@ -21,12 +22,17 @@ import pytest
 sys.path.insert(0, str(Path(__file__).parent))
 from conftest import git_commit, git_init, index_in_process, roam
 
+from roam.graph import anomaly
 from roam.graph.anomaly import (
     cusum,
     forecast,
+    kendall_s,
     mann_kendall_test,
+    mann_kendall_tests,
+    median_pairwise_slope,
     modified_z_score,
     theil_sen_slope,
+    theil_sen_slopes,
     western_electric_rules,
 )
 
@@ -233,6 +239,83 @@ class TestMannKendallTest:
         assert result["S"] < 0
 
 
+# ============================================================================
+# fast and batch trend statistics
+# ============================================================================
+
+
+def _brute_s(values):
+    n = len(values)
+    return sum((values[j] > values[i]) - (values[j] < values[i]) for i in range(n) for j in range(i + 1, n))
+
+
+def _random_series(rnd, count):
+    # Small integer ranges force plenty of ties
+    return [[rnd.randint(0, rnd.choice([3, 10, 1000])) for _ in range(rnd.randint(0, 40))] for _ in range(count)]
+
+
+class TestFastTrendStatistics:
+    """The O(n log n) and vectorised paths must match the pairwise definitions."""
+
+    def test_kendall_s_matches_pairwise(self):
+        import random
+
+        rnd = random.Random(3)
+        for values in _random_series(rnd, 200):
+            assert kendall_s(values) == _brute_s(values)
+        assert kendall_s([0.5, 0.25, 0.5, 1.0]) == _brute_s([0.5, 0.25, 0.5, 1.0])
+
+    @pytest.mark.parametrize("use_numpy", [True, False])
+    def test_batch_matches_scalar(self, monkeypatch, use_numpy):
+        import random
+
+        if use_numpy:
+            pytest.importorskip("numpy")
+        else:
+            monkeypatch.setattr(anomaly, "_numpy", lambda: None)
+        rnd = random.Random(11)
+        series = _random_series(rnd, 120) + [[rnd.random() * 10 for _ in range(25)] for _ in range(20)]
+        assert theil_sen_slopes(series) == [theil_sen_slope(v) for v in series]
+        assert mann_kendall_tests(series) == [mann_kendall_test(v) for v in series]
+        for values, mk in zip(series, mann_kendall_tests(series)):
+            if mk is not None and mk["direction"] != "stable":
+                assert mk["S"] == _brute_s(values)
+
+    def test_numpy_and_pure_slopes_agree(self, monkeypatch):
+        pytest.importorskip("numpy")
+        values = [(i * 7) % 13 + i * 0.5 for i in range(60)]
+        fast = theil_sen_slope(values)
+        monkeypatch.setattr(anomaly, "_numpy", lambda: None)
+        assert theil_sen_slope(values) == fast
+
+    @pytest.mark.parametrize("use_numpy", [True, False])
+    def test_long_series_sampled_slope(self, monkeypatch, use_numpy):
+        if use_numpy:
+            pytest.importorskip("numpy")
+        else:
+            monkeypatch.setattr(anomaly, "_numpy", lambda: None)
+        monkeypatch.setattr(anomaly, "_EXACT_MAX_PAIRS", 1000)
+        monkeypatch.setattr(anomaly, "_SAMPLE_PAIRS", 5000)
+        sampled = []
+        real = anomaly._sampled_slope_median
+        monkeypatch.setattr(anomaly, "_sampled_slope_median", lambda v: sampled.append(len(v)) or real(v))
+
+        # 45 points = 990 pairs: exact; 500 points = 124,750 pairs: sampled
+        assert median_pairwise_slope([float(i) for i in range(45)]) == 1.0
+        assert sampled == []
+        values = [2.0 * i + (i % 5) for i in range(500)]
+        result = theil_sen_slope(values)
+        assert sampled == [500]
+        assert result["slope"] == pytest.approx(2.0, abs=0.05)
+        assert theil_sen_slope(values) == result  # fixed seed: deterministic
+
+    def test_forecast_reuses_trend(self):
+        values = [1, 2, 3, 4, 5]
+        trend = {"slope": 2.0, "intercept": 1.0, "direction": "increasing"}
+        assert forecast(values, target=9, trend=trend)["steps_until"] == 2
+        assert forecast(values, target=9)["steps_until"] == 4
+
+
 # ============================================================================
 # western_electric_rules
 # ============================================================================
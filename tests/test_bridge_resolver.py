@@ -0,0 +1,197 @@
+"""Tests for whole-index bridge resolution (roam.bridges.resolver)."""
+
+from __future__ import annotations
+
+import random
+import sqlite3
+
+from roam.bridges.bridge_protobuf import ProtobufBridge
+from roam.bridges.bridge_rest_api import RestApiBridge
+from roam.bridges.bridge_salesforce import SalesforceBridge
+from roam.bridges.resolver import load_file_symbols, resolve_bridges, store_bridge_edges
+from roam.db.connection import ensure_schema
+
+
+def _edge_keys(edges):
+    return sorted((e["source"], e["target"], e["mechanism"]) for e in edges)
+
+
+def _per_file(bridge, source_files, target_files):
+    edges = []
+    for path, symbols in source_files.items():
+        edges.extend(bridge.resolve(path, symbols, target_files))
+    return edges
+
+
+class TestResolveAll:
+    def test_rest_trie_matches_pairwise_join(self):
+        rnd = random.Random(3)
+        segs = ["api", "users", "orders", "v1", "items", "42", "7"]
+        params = [":id", "<id>", "{id}", "{slug}"]
+        bridge = RestApiBridge()
+
+        def route():
+            return "/" + "/".join(rnd.choice(segs + params) for _ in range(rnd.randint(1, 4)))
+
+        def call():
+            return "/" + "/".join(rnd.choice(segs) for _ in range(rnd.randint(1, 4))) + rnd.choice(["", "/"])
+
+        targets = {
+            f"backend/r{i}.py": [
+                {"name": f"h{i}_{j}", "kind": "function", "signature": f"@app.route('{route()}')"} for j in range(5)
+            ]
+            for i in range(6)
+        }
+        sources = {
+            f"web/c{i}.js": [{"name": f"c{i}", "kind": "function", "signature": f"fetch('{call()}')"}]
+            for i in range(40)
+        }
+
+        expected = []
+        for spath, ssyms in sources.items():
+            for url, sname in bridge.source_keys(spath, ssyms):
+                for tpath, tsyms in targets.items():
+                    for route_url, tname in bridge.target_keys(tpath, tsyms):
+                        if bridge._urls_match(url, route_url):
+                            expected.append((sname, tname, "url-match"))
+
+        edges = bridge.resolve_all(sources, targets)
+        assert expected
+        assert _edge_keys(edges) == sorted(expected)
+        assert all(e["source_path"] in sources and e["target_path"] in targets for e in edges)
+
+    def test_protobuf_matches_per_file_resolve(self):
+        bridge = ProtobufBridge()
+        sources = {
+            "api/user.proto": [
+                {"name": "User", "kind": "message", "qualified_name": "api.User"},
+                {"name": "UserService", "kind": "service", "qualified_name": "api.UserService"},
+                {"name": "Role", "kind": "enum", "qualified_name": "api.Role"},
+            ],
+            "api/order.proto": [{"name": "Order", "kind": "message", "qualified_name": "api.Order"}],
+        }
+        targets = {
+            "gen/user_pb2.py": [
+                {"name": "User", "kind": "class", "qualified_name": "gen.user_pb2.User"},
+                {"name": "Role", "kind": "class", "qualified_name": "gen.user_pb2.Role"},
+            ],
+            "gen/user_grpc.pb.go": [
+                {"name": "UserServiceServer", "kind": "interface", "qualified_name": "user.UserServiceServer"},
+            ],
+            "gen/order_pb2.py": [{"name": "Order", "kind": "class", "qualified_name": "gen.order_pb2.Order"}],
+            "gen/other_pb2.py": [{"name": "User", "kind": "class", "qualified_name": "gen.other_pb2.User"}],
+        }
+        edges = bridge.resolve_all(sources, targets)
+        assert edges
+        assert _edge_keys(edges) == _edge_keys(_per_file(bridge, sources, targets))
+        assert {e["target_path"] for e in edges} <= {"gen/user_pb2.py", "gen/user_grpc.pb.go", "gen/order_pb2.py"}
+
+    def test_salesforce_matches_per_file_resolve(self):
+        bridge = SalesforceBridge()
+        sources = {
+            "classes/AccountController.cls": [
+                {"name": "AccountController", "kind": "class", "qualified_name": "AccountController"},
+                {"name": "getAccounts", "kind": "method", "qualified_name": "AccountController.getAccounts"},
+            ],
+            "classes/Util.cls": [{"name": "Util", "kind": "class", "qualified_name": "Util"}],
+        }
+        targets = {
+            "lwc/account/account.js": [{"name": "Account", "kind": "class", "qualified_name": "Account"}],
+            "pages/Util.page": [{"name": "Util", "kind": "component", "qualified_name": "Util"}],
+            "aura/Other/Other.cmp": [{"name": "Other", "kind": "component", "qualified_name": "Other"}],
+        }
+        assert _edge_keys(bridge.resolve_all(sources, targets)) == _edge_keys(_per_file(bridge, sources, targets))
+
+
+def _make_db(tmp_path, files: dict[str, list[tuple]]):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    conn.row_factory = sqlite3.Row
+    ensure_schema(conn)
+    for path, symbols in files.items():
+        fid = conn.execute("INSERT INTO files (path) VALUES (?)", (path,)).lastrowid
+        for name, qname, kind, signature in symbols:
+            conn.execute(
+                "INSERT INTO symbols (file_id, name, qualified_name, kind, signature, line_start, line_end) "
+                "VALUES (?, ?, ?, ?, ?, 1, 1)",
+                (fid, name, qname, kind, signature),
+            )
+    return conn
+
+
+def _bridge_edges(conn):
+    return sorted(
+        tuple(r) for r in conn.execute("SELECT source_id, target_id, bridge FROM edges WHERE bridge IS NOT NULL")
+    )
+
+
+class TestStoreBridgeEdges:
+    FILES = {
+        "web/app.js": [("loadUsers", "loadUsers", "function", "fetch('/api/users/7')")],
+        "backend/routes.py": [("get_user", "routes.get_user", "function", "@app.route('/api/users/<id>')")],
+        "api/user.proto": [("User", "api.User", "message", None)],
+        "gen/user_pb2.py": [("User", "gen.user_pb2.User", "class", None)],
+    }
+
+    def test_persists_edges(self, tmp_path):
+        conn = _make_db(tmp_path, self.FILES)
+        assert store_bridge_edges(conn) == 2
+        rows = conn.execute(
+            "SELECT s.qualified_name AS src, t.qualified_name AS tgt, e.kind, e.bridge, f.path "
+            "FROM edges e JOIN symbols s ON s.id = e.source_id JOIN symbols t ON t.id = e.target_id "
+            "JOIN files f ON f.id = e.source_file_id ORDER BY e.bridge"
+        ).fetchall()
+        assert [tuple(r) for r in rows] == [
+            ("api.User", "gen.user_pb2.User", "x-lang", "protobuf", "api/user.proto"),
+            ("loadUsers", "routes.get_user", "x-lang", "rest-api", "web/app.js"),
+        ]
+
+    def test_rerun_replaces_edges(self, tmp_path):
+        conn = _make_db(tmp_path, self.FILES)
+        store_bridge_edges(conn)
+        store_bridge_edges(conn)
+        assert conn.execute("SELECT COUNT(*) FROM edges WHERE bridge IS NOT NULL").fetchone()[0] == 2
+
+    def test_missing_name_in_target_file_does_not_bind_elsewhere(self):
+        from roam.bridges.resolver import _SymbolLookup
+
+        lookup = _SymbolLookup(
+            {
+                "gen/a_pb2.py": [{"id": 1, "name": "Other", "qualified_name": "Other"}],
+                "lib/user.py": [{"id": 2, "name": "User", "qualified_name": "User"}],
+            }
+        )
+        assert lookup.find("User", "gen/a_pb2.py") is None
+        assert lookup.find("User", None)["id"] == 2
+        assert lookup.find("Other", "gen/a_pb2.py")["id"] == 1
+
+    def test_incremental_matches_full(self, tmp_path):
+        conn = _make_db(tmp_path, self.FILES)
+        store_bridge_edges(conn)
+        full = _bridge_edges(conn)
+        # Re-resolving one changed file replaces exactly its edges
+        conn.execute(
+            "DELETE FROM edges WHERE bridge IS NOT NULL AND source_file_id = "
+            "(SELECT id FROM files WHERE path = 'web/app.js')"
+        )
+        assert store_bridge_edges(conn, ["web/app.js"]) == 1
+        assert _bridge_edges(conn) == full
+        assert store_bridge_edges(conn, ["gen/user_pb2.py"]) == 1
+        assert _bridge_edges(conn) == full
+
+    def test_incremental_skips_unrelated_files(self, tmp_path, monkeypatch):
+        import roam.bridges.resolver as resolver
+
+        conn = _make_db(tmp_path, self.FILES)
+        store_bridge_edges(conn)
+        loads = []
+        monkeypatch.setattr(resolver, "load_file_symbols", lambda c: loads.append(1))
+        assert store_bridge_edges(conn, ["assets/logo.png"]) == 0
+        assert store_bridge_edges(conn, []) == 0
+        assert loads == []
+        assert len(_bridge_edges(conn)) == 2
+
+    def test_summaries_match_links(self, tmp_path):
+        conn = _make_db(tmp_path, self.FILES)
+        summaries, links = resolve_bridges(conn)
+        assert sum(s["links"] for s in summaries) == len(links)
+        assert set(load_file_symbols(conn)) == set(self.FILES)
@@ -214,6 +214,122 @@ class TestResolveOwners:
         assert owners == ["@bob"]
 
 
+class TestCodeownersMatcher:
+    """The compiled matcher agrees with testing every rule in order."""
+
+    RULES = [
+        ("*", ["@default"]),
+        ("*.py", ["@py"]),
+        ("*.generated.py", []),
+        ("Makefile", ["@build"]),
+        ("/Makefile", ["@root-build"]),
+        ("docs/", ["@docs"]),
+        ("/src/", ["@src"]),
+        ("/src/api/*.py", ["@api"]),
+        ("src/core/", ["@core"]),
+        ("src/**/test_*.py", ["@tests"]),
+        ("**/vendor/**", ["@vendor"]),
+        ("/lib/**/*.c", ["@c"]),
+        ("*.p?", ["@p"]),
+        ("/tools/", []),
+        ("web/*", ["@web"]),
+        ("[Rr]EADME*", ["@readme"]),
+    ]
+
+    PATHS = [
+        "Makefile",
+        "src/Makefile",
+        "app.py",
+        "src/models.py",
+        "src/api/routes.py",
+        "src/api/v2/routes.py",
+        "src/core/engine.js",
+        "lib/src/core/x.js",
+        "src/pkg/test_models.py",
+        "a/vendor/b/c.js",
+        "vendor/c.js",
+        "lib/x/y/z.c",
+        "lib/z.c",
+        "other/lib/z.c",
+        "foo.pl",
+        "foo.generated.py",
+        "docs/readme.md",
+        "pkg/docs/guide/intro.md",
+        "tools/run.sh",
+        "web/index.html",
+        "web/static/app.css",
+        "README.md",
+        "pkg/readme.txt",
+        "src\\win\\path.py",
+    ]
+
+    def test_matches_linear_resolution(self):
+        from roam.commands.cmd_codeowners import resolve_owners
+        from roam.index.codeowners import CodeownersMatcher
+
+        # Every suffix of the rule list exercises a different winner
+        for start in range(len(self.RULES)):
+            rules = self.RULES[start:]
+            matcher = CodeownersMatcher(rules)
+            for path in self.PATHS:
+                assert matcher.owners(path) == resolve_owners(rules, path), (rules[0], path)
+
+    def test_winning_rule_index(self):
+        from roam.index.codeowners import CodeownersMatcher
+
+        matcher = CodeownersMatcher(self.RULES)
+        assert matcher.match("src/api/routes.py") == 12  # *.p? comes later than /src/api/*.py
+        assert CodeownersMatcher(self.RULES[:12]).match("src/api/routes.py") == 7
+        assert matcher.match("lib/x/y/z.c") == 11
+        assert CodeownersMatcher([("*.py", ["@py"])]).match("readme.md") is None
+
+
+class TestPersistedOwners:
+    """The indexer materialises file ownership and refreshes it on change."""
+
+    def _owners(self, repo):
+        import sqlite3
+
+        conn = sqlite3.connect(str(repo / ".roam" / "index.db"))
+        rows = conn.execute("SELECT f.path, fo.owners FROM files f JOIN file_owners fo ON fo.file_id = f.id")
+        return {path: owners for path, owners in rows.fetchall() if path.endswith(".prg")}
+
+    def test_refresh_on_codeowners_and_file_changes(self, tmp_path):
+        from roam.index.indexer import Indexer
+
+        (tmp_path / "src").mkdir()
+        (tmp_path / "src" / "main.prg").write_text("FUNCTION Main\n  RETURN 1\nENDFUNC\n")
+        (tmp_path / "tool.prg").write_text("FUNCTION Tool\n  RETURN 2\nENDFUNC\n")
+        (tmp_path / "CODEOWNERS").write_text("/src/ @alice @bob\n")
+        Indexer(tmp_path).run(quiet=True, progress_bar=False)
+        assert self._owners(tmp_path) == {"src/main.prg": "@alice @bob", "tool.prg": ""}
+
+        # New file: resolved without touching the others
+        (tmp_path / "src" / "extra.prg").write_text("FUNCTION Extra\n  RETURN 3\nENDFUNC\n")
+        Indexer(tmp_path).run(quiet=True, progress_bar=False)
+        assert self._owners(tmp_path)["src/extra.prg"] == "@alice @bob"
+
+        # CODEOWNERS edit alone (no source change) refreshes everything
+        (tmp_path / "CODEOWNERS").write_text("*.prg @carol\n")
+        Indexer(tmp_path).run(quiet=True, progress_bar=False)
+        assert set(self._owners(tmp_path).values()) == {"@carol"}
+
+    def test_load_file_owners_without_refresh(self, tmp_path):
+        import sqlite3
+
+        from roam.index.codeowners import load_file_owners
+        from roam.index.indexer import Indexer
+
+        (tmp_path / "main.prg").write_text("FUNCTION Main\n  RETURN 1\nENDFUNC\n")
+        (tmp_path / "CODEOWNERS").write_text("* @alice\n")
+        Indexer(tmp_path).run(quiet=True, progress_bar=False)
+
+        # Stale table (CODEOWNERS edited since indexing) is not trusted
+        (tmp_path / "CODEOWNERS").write_text("* @dave\n")
+        conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+        assert set(map(tuple, load_file_owners(conn, tmp_path).values())) == {("@dave",)}
+
+
 # ---------------------------------------------------------------------------
 # find_codeowners
 # ---------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+"""CLI cold-start budget: import profile of fresh `roam` processes.
+
+Hooks and editor integrations spawn `roam` per call, so start-up import
+cost is paid every time.  These tests run the CLI in a fresh interpreter
+under ``-X importtime`` and fail when
+
+* a lookup command (`symbol`, `search`) loads a heavy dependency
+  (networkx, tree-sitter language packs, numpy, onnxruntime) or spends
+  more than ``ROAM_COLD_START_BUDGET_MS`` (default 600 ms) importing, or
+* `roam --help` imports any command module.
+
+Wall-clock import time is meaningless on a loaded machine, so under
+pytest-xdist the budget is only enforced when it is set explicitly.
+"""
+
+from __future__ import annotations
+
+import importlib
+import json
+import os
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+import roam
+
+HEAVY_MODULES = ("networkx", "tree_sitter_language_pack", "numpy", "onnxruntime")
+BUDGET_MS = float(os.environ.get("ROAM_COLD_START_BUDGET_MS", "600"))
+ENFORCE_BUDGET = "ROAM_COLD_START_BUDGET_MS" in os.environ or "PYTEST_XDIST_WORKER" not in os.environ
+
+_RUNNER = """
+import atexit, json, sys
+atexit.register(lambda: print("ROAM_MODULES=" + json.dumps(sorted(sys.modules))))
+from roam.cli import cli
+cli(sys.argv[1:], prog_name="roam")
+"""
+
+
+def _profile(args, cwd):
+    """Run roam *args* in a fresh interpreter: ``(modules, import_ms)``."""
+    env = dict(os.environ)
+    src = str(Path(roam.__file__).resolve().parent.parent)
+    env["PYTHONPATH"] = os.pathsep.join(p for p in (src, env.get("PYTHONPATH")) if p)
+    proc = subprocess.run(
+        [sys.executable, "-X", "importtime", "-c", _RUNNER, *args],
+        cwd=cwd,
+        env=env,
+        capture_output=True,
+        text=True,
+        timeout=120,
+    )
+    modules: list[str] = []
+    for line in proc.stdout.splitlines():
+        if line.startswith("ROAM_MODULES="):
+            modules = json.loads(line[len("ROAM_MODULES=") :])
+    assert modules, proc.stdout + proc.stderr
+
+    # Sum cumulative times of top-level imports ("import time: self | cum | name")
+    total_us = 0
+    for line in proc.stderr.splitlines():
+        if not line.startswith("import time:"):
+            continue
+        parts = line.split("|")
+        if len(parts) == 3 and parts[2].startswith(" ") and not parts[2].startswith("  "):
+            cumulative = parts[1].strip()
+            if cumulative.isdigit():
+                total_us += int(cumulative)
+    return modules, total_us / 1000
+
+
+def _heavy(modules):
+    return sorted(m for m in modules if m.split(".")[0] in HEAVY_MODULES)
+
+
+@pytest.mark.parametrize("args", [["symbol", "main"], ["search", "user"]])
+def test_lookup_commands_stay_within_budget(indexed_project, args):
+    modules, import_ms = _profile(args, indexed_project)
+    assert _heavy(modules) == []
+    assert "roam.graph.builder" not in modules
+    assert "roam.index.indexer" not in modules
+    if ENFORCE_BUDGET:
+        assert import_ms < BUDGET_MS, f"roam {' '.join(args)} spent {import_ms:.0f} ms importing"
+
+
+def test_help_imports_no_command_modules(tmp_path):
+    modules, _ = _profile(["--help"], tmp_path)
+    assert [m for m in modules if m.startswith("roam.commands.")] == []
+    assert _heavy(modules) == []
+
+
+def test_command_summaries_are_current():
+    from roam.cli import _COMMANDS
+    from roam.command_meta import COMMAND_SUMMARIES
+    from roam.plugins import _commands as plugin_commands
+
+    live = {}
+    for name, (module_path, attr) in _COMMANDS.items():
+        if name in plugin_commands:
+            continue
+        cmd = getattr(importlib.import_module(module_path), attr)
+        live[name] = cmd.get_short_help_str(limit=60)
+    assert COMMAND_SUMMARIES == live, "run dev/gen-command-meta.py"
@@ -0,0 +1,85 @@
+"""Tests for the index DB layout: covering edge indexes and planner stats."""
+
+from __future__ import annotations
+
+import re
+import sqlite3
+
+from roam.db.connection import ensure_schema, refresh_planner_stats
+
+
+def _indexes(conn, table):
+    return {
+        r[0] for r in conn.execute("SELECT name FROM sqlite_master WHERE type = 'index' AND tbl_name = ?", (table,))
+    }
+
+
+def _plan(conn, sql, params=()):
+    return " ".join(r[-1] for r in conn.execute("EXPLAIN QUERY PLAN " + sql, params).fetchall())
+
+
+def _make_db(tmp_path):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    ensure_schema(conn)
+    conn.execute("INSERT INTO files (id, path) VALUES (1, 'a.py')")
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind) VALUES (?, 1, ?, 'function')",
+        [(i, f"f{i}") for i in range(1, 201)],
+    )
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind, source_file_id) VALUES (?, ?, 'calls', 1)",
+        [(i, (i * 7) % 200 + 1) for i in range(1, 201)],
+    )
+    return conn
+
+
+class TestEdgeIndexes:
+    def test_legacy_indexes_dropped_on_upgrade(self, tmp_path):
+        conn = sqlite3.connect(str(tmp_path / "index.db"))
+        ensure_schema(conn)
+        conn.execute("CREATE INDEX idx_edges_source ON edges(source_id)")
+        conn.execute("CREATE INDEX idx_symbols_file ON symbols(file_id)")
+        ensure_schema(conn)
+        assert _indexes(conn, "edges") == {
+            "idx_edges_out",
+            "idx_edges_in",
+            "idx_edges_kind_target",
+            "idx_edges_source_file",
+        }
+        assert "idx_symbols_file" not in _indexes(conn, "symbols")
+
+    def test_traversals_use_covering_indexes(self, tmp_path):
+        conn = _make_db(tmp_path)
+        refresh_planner_stats(conn, full=True)
+        callers = _plan(conn, "SELECT source_id, kind FROM edges WHERE target_id = ?", (5,))
+        callees = _plan(conn, "SELECT target_id, kind FROM edges WHERE source_id = ?", (5,))
+        assert "COVERING INDEX idx_edges_in" in callers
+        assert "COVERING INDEX idx_edges_out" in callees
+        # File lookups use a file_id-leading composite now that idx_symbols_file is gone
+        plan = _plan(conn, "SELECT id FROM symbols WHERE file_id = ?", (1,))
+        index = re.search(r"INDEX (\w+) \(file_id=\?\)", plan).group(1)
+        assert index != "idx_symbols_file"
+        assert conn.execute(f"PRAGMA index_info({index})").fetchone()[2] == "file_id"
+
+    def test_kind_only_lookup_uses_kind_index(self, tmp_path):
+        conn = _make_db(tmp_path)
+        conn.executemany(
+            "INSERT INTO edges (source_id, target_id, kind, source_file_id) VALUES (?, ?, 'imports', 1)",
+            [(i, i + 1) for i in range(1, 20)],
+        )
+        refresh_planner_stats(conn, full=True)
+        plan = _plan(conn, "SELECT COUNT(*) FROM edges WHERE kind = 'imports'")
+        assert "COVERING INDEX idx_edges_kind_target" in plan
+
+
+class TestPlannerStats:
+    def test_full_analyze_writes_stats(self, tmp_path):
+        conn = _make_db(tmp_path)
+        refresh_planner_stats(conn, full=True)
+        stats = {r[0] for r in conn.execute("SELECT idx FROM sqlite_stat1 WHERE tbl = 'edges'")}
+        assert {"idx_edges_out", "idx_edges_in"} <= stats
+
+    def test_optimize_is_safe_without_stats(self, tmp_path):
+        conn = _make_db(tmp_path)
+        refresh_planner_stats(conn)
+        assert conn.execute("SELECT COUNT(*) FROM edges").fetchone()[0] == 200
@@ -0,0 +1,95 @@
+"""Tests for stored entry-point distances (roam.graph.entrypoints)."""
+
+from __future__ import annotations
+
+import sqlite3
+
+from roam.db.connection import ensure_schema
+from roam.graph.entrypoints import (
+    UNREACHABLE,
+    compute_entry_distances,
+    load_entry_distances,
+    load_entrypoint_count,
+    store_entry_distances,
+)
+
+
+def _make_db(tmp_path):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    conn.row_factory = sqlite3.Row
+    ensure_schema(conn)
+    conn.execute("INSERT INTO files (id, path) VALUES (1, 'app.py')")
+    # 1 main -> 2 parse -> 3 decode ; 4 orphan (not exported, unreachable)
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind, is_exported) VALUES (?, 1, ?, 'function', ?)",
+        [(1, "main", 1), (2, "parse", 0), (3, "decode", 0), (4, "orphan", 0)],
+    )
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind) VALUES (?, ?, 'call')",
+        [(1, 2), (2, 3)],
+    )
+    conn.executemany("INSERT INTO symbol_metrics (symbol_id) VALUES (?)", [(1,), (2,), (3,), (4,)])
+    return conn
+
+
+def test_compute_distances(tmp_path):
+    conn = _make_db(tmp_path)
+    assert compute_entry_distances(conn) == {1: 0, 2: 1, 3: 2}
+
+
+def test_store_and_load(tmp_path):
+    conn = _make_db(tmp_path)
+    assert load_entry_distances(conn, [2, 3]) is None  # nothing stored yet
+    assert store_entry_distances(conn) == 4
+    stored = dict(conn.execute("SELECT symbol_id, entry_distance FROM symbol_metrics").fetchall())
+    assert stored == {1: 0, 2: 1, 3: 2, 4: UNREACHABLE}
+    assert load_entry_distances(conn, [2, 3, 4]) == {2: 1, 3: 2}
+
+
+def test_entrypoint_count_is_stored(tmp_path):
+    conn = _make_db(tmp_path)
+    assert load_entrypoint_count(conn) is None  # nothing stored yet
+    store_entry_distances(conn)
+    assert load_entrypoint_count(conn) == 1  # only main is exported
+    conn.execute("UPDATE symbols SET is_exported = 1 WHERE id = 4")
+    store_entry_distances(conn)
+    assert load_entrypoint_count(conn) == 2
+
+
+def test_incremental_update_writes_only_changes(tmp_path):
+    conn = _make_db(tmp_path)
+    store_entry_distances(conn)
+    assert store_entry_distances(conn) == 0
+    conn.execute("INSERT INTO edges (source_id, target_id, kind) VALUES (3, 4, 'call')")
+    assert store_entry_distances(conn) == 1
+    assert load_entry_distances(conn, [4]) == {4: 3}
+
+
+def test_missing_row_falls_back(tmp_path):
+    conn = _make_db(tmp_path)
+    store_entry_distances(conn)
+    conn.execute("INSERT INTO symbols (id, file_id, name, kind) VALUES (5, 1, 'late', 'function')")
+    assert load_entry_distances(conn, [2, 5]) is None
+
+
+def test_targeted_reindex_falls_back(tmp_path):
+    from roam.index.indexer import Indexer
+
+    (tmp_path / "main.prg").write_text("FUNCTION Alpha\n  RETURN 1\nENDFUNC\n")
+    (tmp_path / "other.prg").write_text("FUNCTION Beta\n  RETURN 1\nENDFUNC\n")
+    Indexer(tmp_path).run(quiet=True, progress_bar=False)
+    conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+    # FoxPro gets no complexity rows; give every symbol one to store into
+    conn.execute("INSERT OR IGNORE INTO symbol_metrics (symbol_id) SELECT id FROM symbols")
+    store_entry_distances(conn)
+    conn.commit()
+    beta = conn.execute("SELECT id FROM symbols WHERE name = 'Beta'").fetchone()[0]
+    assert load_entry_distances(conn, [beta]) == {beta: 0}
+    conn.close()
+
+    # Beta's file is untouched, so its row survives the targeted reindex
+    (tmp_path / "main.prg").write_text("FUNCTION Alpha\n  RETURN 2\nENDFUNC\n")
+    Indexer(tmp_path).run_paths(["main.prg"], quiet=True, progress_bar=False)
+    conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+    assert conn.execute("SELECT 1 FROM symbol_metrics WHERE symbol_id = ?", (beta,)).fetchone()
+    assert load_entry_distances(conn, [beta]) is None
@@ -0,0 +1,165 @@
+"""Tests for per-symbol fingerprints and retained versions (roam.index.fingerprints)."""
+
+from __future__ import annotations
+
+import sqlite3
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent))
+from conftest import git_init, invoke_cli, parse_json_output
+
+from roam.index.fingerprints import (
+    assign_fingerprints,
+    diff_fingerprints,
+    git_blob_sha,
+    load_version,
+    prune_fingerprints,
+    ref_blobs,
+    signature_hash,
+    strip_code,
+)
+from roam.index.indexer import Indexer
+
+SOURCE = """\
+FUNCTION Alpha
+  RETURN 1
+ENDFUNC
+
+FUNCTION Beta
+  RETURN Alpha()
+ENDFUNC
+
+PROCEDURE Gamma
+  x = Beta()
+ENDPROC
+"""
+
+EDITED = """\
+FUNCTION Alpha
+  RETURN   1  && comment only
+ENDFUNC
+
+FUNCTION Beta
+  RETURN Alpha() + 1
+ENDFUNC
+
+PROCEDURE Delta
+  x = Beta()
+ENDPROC
+"""
+
+
+def test_strip_code_ignores_comments_and_whitespace():
+    a = b"def f(x):\n    # note\n    return x + 1\n"
+    b = b"def f(x):\n    return x+1   # other note\n"
+    assert strip_code(a, "python") == strip_code(b, "python") == b"def f(x):\n    return x+1"
+    # String literals are kept verbatim, comment markers inside them included
+    assert strip_code(b'x = "a  # b"', "python") == b'x="a  # b"'
+    assert strip_code(b"int f() { /* x */ return 1; // y\n}", "c") == b"int f(){return 1;}"
+
+
+def test_strip_code_keeps_token_boundaries():
+    # Joining two identifiers is a real change, not reformatting
+    assert strip_code(b"return x", "python") != strip_code(b"returnx", "python")
+    assert strip_code(b"int  a;", "c") == strip_code(b"int\n\ta ;", "c") == b"int a;"
+    assert strip_code(b"return/* c */1;", "c") == b"return 1;"
+    assert strip_code(b"a = b  +  c", "python") == b"a=b+c"
+
+
+def test_strip_code_keeps_indentation_structure():
+    # Moving c() into the if block changes behaviour, so the bodies differ
+    outside = b"def f(a):\n    if a:\n        b()\n    c()\n"
+    inside = b"def f(a):\n    if a:\n        b()\n        c()\n"
+    assert strip_code(outside, "python") != strip_code(inside, "python")
+    assert strip_code(outside, "python") == b"def f(a):\n    if a:\n        b()\n    c()"
+    # Indentation is relative to the first line, so a method body hashes
+    # the same at any nesting; blank lines, comments and wrapping inside
+    # brackets are still formatting
+    method = b"    def f(a):\n\n        # note\n        return g(1,\n                 2)\n"
+    assert strip_code(method, "python") == strip_code(b"def f(a):\n    return g(\n        1, 2)\n", "python")
+    assert strip_code(method, "python") == b"def f(a):\n    return g(1,2)"
+
+
+def test_strip_code_triple_quoted_strings():
+    a = b'def f():\n    """Doc  # not a comment\n    x = 1\n    """\n    return 2\n'
+    b = b'def f():\n    """Doc  # not a comment\n    x = 2\n    """\n    return 2\n'
+    assert strip_code(a, "python") == b'def f():\n    """Doc  # not a comment\n    x = 1\n    """\n    return 2'
+    # Edits inside a docstring after a "#" still change the body
+    assert strip_code(a, "python") != strip_code(b, "python")
+    assert strip_code(b"s = '''a\n  b'''", "python") == b"s='''a\n  b'''"
+    assert strip_code(b'String s = """\n  x // y\n  """;', "java") == b'String s="""\n  x // y\n  """;'
+
+
+def test_fingerprints_of_symbols():
+    source = b"def f(a,  b):\n    return a\n\n\ndef g(a, b):\n    # changed comment\n    return a\n"
+    syms = [
+        {"name": "f", "kind": "function", "signature": "def f(a,  b):", "line_start": 1, "line_end": 2},
+        {"name": "g", "kind": "function", "signature": "def g(a, b):", "line_start": 5, "line_end": 7},
+    ]
+    assign_fingerprints(syms, source, "python")
+    assert syms[0]["sig_hash"] == signature_hash("function", "def f(a, b)")
+    assert syms[0]["sig_hash"] != signature_hash("method", "def f(a, b)")
+    assert syms[0]["body_hash"] != syms[1]["body_hash"]  # different names in the body text
+
+
+def test_git_blob_sha_matches_git(tmp_path):
+    path = tmp_path / "x.txt"
+    path.write_bytes(b"hello\nworld\n")
+    out = subprocess.run(["git", "hash-object", str(path)], capture_output=True, text=True)
+    if out.returncode != 0:
+        pytest.skip("git not available")
+    assert git_blob_sha(path.read_bytes()) == out.stdout.strip()
+
+
+@pytest.fixture
+def foxpro_repo(tmp_path):
+    """Index a committed FoxPro file, then edit and reindex it uncommitted."""
+    (tmp_path / ".gitignore").write_text(".roam/\n")
+    (tmp_path / "main.prg").write_text(SOURCE)
+    git_init(tmp_path)
+    Indexer(tmp_path).run(quiet=True, progress_bar=False)
+    (tmp_path / "main.prg").write_text(EDITED)
+    Indexer(tmp_path).run(quiet=True, progress_bar=False)
+    return tmp_path
+
+
+def test_reindex_retains_previous_version(foxpro_repo):
+    conn = sqlite3.connect(str(foxpro_repo / ".roam" / "index.db"))
+    blobs = ref_blobs(foxpro_repo, "HEAD")
+    assert blobs["main.prg"] == git_blob_sha(SOURCE.encode())
+
+    old = load_version(conn, "main.prg", blobs["main.prg"])
+    new = load_version(conn, "main.prg", git_blob_sha(EDITED.encode()))
+    assert old is not None and new is not None
+    assert load_version(conn, "main.prg", "0" * 40) is None
+
+    rows = diff_fingerprints(old[0], new[0])
+    changes = {(r["old"] or r["new"])["name"]: r["status"] for r in rows}
+    # Alpha only gained a comment and whitespace
+    assert changes == {"Beta": "modified", "Gamma": "removed", "Delta": "added"}
+
+    # Pruning keeps the newest retained versions only
+    prune_fingerprints(conn, keep=0)
+    assert load_version(conn, "main.prg", blobs["main.prg"]) is None
+    assert conn.execute("SELECT COUNT(*) FROM symbol_fingerprints").fetchone()[0] == 0
+    assert load_version(conn, "main.prg", git_blob_sha(EDITED.encode())) is not None
+
+
+def test_semantic_diff_uses_fingerprints(foxpro_repo, cli_runner, monkeypatch):
+    import roam.commands.cmd_semantic_diff as mod
+
+    def no_parse(*_args, **_kwargs):
+        raise AssertionError("both versions are indexed; nothing should be parsed")
+
+    monkeypatch.setattr(mod, "_extract_symbols_from_source", no_parse)
+    monkeypatch.chdir(foxpro_repo)
+    result = invoke_cli(cli_runner, ["semantic-diff", "--base", "HEAD"], cwd=foxpro_repo, json_mode=True)
+    data = parse_json_output(result, "semantic-diff")
+    assert [s["name"] for s in data["symbols_added"]] == ["Delta"]
+    assert [s["name"] for s in data["symbols_removed"]] == ["Gamma"]
+    assert [s["name"] for s in data["symbols_modified"]] == ["Beta"]
+    assert data["symbols_modified"][0]["changes"] == {"body_changed": True}
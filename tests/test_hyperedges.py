@@ -0,0 +1,90 @@
+"""Tests for hyperedge similarity search (roam.graph.hyperedges)."""
+
+from __future__ import annotations
+
+import random
+import sqlite3
+
+from roam.commands.cmd_coupling import _compute_surprise
+from roam.db.connection import ensure_schema
+from roam.graph.hyperedges import HyperedgeIndex
+from roam.index.git_stats import _populate_hyperedges
+
+
+def _make_db(tmp_path, commit_files: dict[int, set[int]]):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    conn.row_factory = sqlite3.Row
+    ensure_schema(conn)
+    file_ids = sorted({f for fids in commit_files.values() for f in fids})
+    conn.executemany("INSERT INTO files (id, path) VALUES (?, ?)", [(f, f"f{f}.py") for f in file_ids])
+    conn.executemany(
+        "INSERT INTO git_commits (id, hash, author, timestamp, message) VALUES (?, ?, 'a', 0, '')",
+        [(c, f"h{c}") for c in commit_files],
+    )
+    _populate_hyperedges(conn, commit_files)
+    return conn
+
+
+def _brute_force(commit_files, change):
+    best, best_key = 0.0, None
+    for idx, (commit_id, fids) in enumerate(sorted(commit_files.items()), 1):
+        if not (2 <= len(fids) <= 100) or not fids & change:
+            continue
+        jac = len(fids & change) / len(fids | change)
+        if jac > best + 1e-9:
+            best, best_key = jac, idx
+    return best, best_key
+
+
+class TestHyperedgeIndex:
+    def test_members_stored_sorted(self, tmp_path):
+        conn = _make_db(tmp_path, {1: {3, 1, 2}})
+        row = conn.execute("SELECT file_count, members FROM git_hyperedges").fetchone()
+        assert row["file_count"] == 3
+        assert row["members"] == "[1,2,3]"
+
+    def test_matches_brute_force(self, tmp_path):
+        rnd = random.Random(7)
+        commit_files = {c: set(rnd.sample(range(1, 40), rnd.randint(1, 8))) for c in range(1, 200)}
+        conn = _make_db(tmp_path, commit_files)
+        index = HyperedgeIndex(conn)
+        for _ in range(50):
+            change = set(rnd.sample(range(1, 45), rnd.randint(2, 6)))
+            jaccard, he_id, members = index.best_match(change)
+            expected, _ = _brute_force(commit_files, change)
+            assert abs(jaccard - expected) < 1e-9
+            if he_id is not None:
+                assert len(set(members) & change) / len(set(members) | change) == jaccard
+
+    def test_prunes_candidates(self, tmp_path):
+        # One exact match plus many large patterns sharing a single hot file
+        commit_files = {1: {1, 2}}
+        for c in range(2, 60):
+            commit_files[c] = {1} | set(range(100 + c * 10, 100 + c * 10 + 8))
+        conn = _make_db(tmp_path, commit_files)
+        index = HyperedgeIndex(conn)
+        jaccard, he_id, members = index.best_match({1, 2})
+        assert jaccard == 1.0
+        assert members == (1, 2)
+        assert index.candidates_scored == 1
+
+    def test_falls_back_without_members_column(self, tmp_path):
+        conn = _make_db(tmp_path, {1: {1, 2, 3}, 2: {4, 5}})
+        conn.execute("UPDATE git_hyperedges SET members = NULL")
+        jaccard, _, members = HyperedgeIndex(conn).best_match({1, 2})
+        assert members == (1, 2, 3)
+        assert abs(jaccard - 2 / 3) < 1e-9
+
+
+class TestComputeSurprise:
+    def test_surprise_and_closest_pattern(self, tmp_path):
+        conn = _make_db(tmp_path, {1: {1, 2, 3}, 2: {4, 5}})
+        surprise, paths, sim = _compute_surprise(conn, [1, 2])
+        assert paths == ["f1.py", "f2.py", "f3.py"]
+        assert sim == 0.667
+        assert surprise == 0.333
+
+    def test_no_history(self, tmp_path):
+        conn = _make_db(tmp_path, {1: {1, 2}})
+        assert _compute_surprise(conn, [7, 8]) == (0.5, None, 0.0)
+        assert _compute_surprise(conn, [1]) == (0.0, None, 0.0)
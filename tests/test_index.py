@@ -198,6 +198,63 @@ class TestIncrementalIndexing:
             assert "hello" not in names, f"Symbol 'hello' from deleted file still present: {names}"
 
 
+# ===========================================================================
+# Targeted reindex (roam index --changed / Indexer.run_paths)
+# ===========================================================================
+
+
+class TestTargetedIndexing:
+    """Tests for reindexing a known set of changed paths."""
+
+    def test_changed_path_reindexed_and_phases_deferred(self, index_project):
+        out1, rc1 = index_in_process(index_project)
+        assert rc1 == 0, f"First index failed:\n{out1}"
+
+        time.sleep(0.1)
+        (index_project / "app.py").write_text("def hello():\n    return 'world'\n\ndef farewell():\n    return 1\n")
+
+        out2, rc2 = index_in_process(index_project, "--changed", "app.py")
+        assert rc2 == 0, f"Targeted index failed:\n{out2}"
+        assert "Discovering files" not in out2
+
+        with _open_db_for(index_project) as conn:
+            names = {r["name"] for r in conn.execute("SELECT name FROM symbols").fetchall()}
+            assert "farewell" in names
+            # lib.py -> app.hello survives as an affected-neighbour edge
+            assert conn.execute("SELECT COUNT(*) FROM file_edges").fetchone()[0] >= 1
+            dirty = {r["phase"] for r in conn.execute("SELECT phase FROM index_dirty").fetchall()}
+            assert {"graph_metrics", "clusters", "search"} <= dirty
+
+        # A plain index run with no file changes refreshes the deferred phases
+        out3, rc3 = index_in_process(index_project)
+        assert rc3 == 0, f"Refresh failed:\n{out3}"
+        with _open_db_for(index_project) as conn:
+            assert conn.execute("SELECT COUNT(*) FROM index_dirty").fetchone()[0] == 0
+            metric_ids = {r[0] for r in conn.execute("SELECT symbol_id FROM graph_metrics").fetchall()}
+            sym_ids = {r[0] for r in conn.execute("SELECT id FROM symbols").fetchall()}
+            assert metric_ids == sym_ids
+
+    def test_changed_new_and_deleted_paths(self, index_project):
+        out1, rc1 = index_in_process(index_project)
+        assert rc1 == 0
+
+        (index_project / "util.py").write_text("def helper():\n    return 42\n")
+        (index_project / "lib.py").unlink()
+
+        out2, rc2 = index_in_process(index_project, "--changed", "util.py", "--changed", "lib.py")
+        assert rc2 == 0, f"Targeted index failed:\n{out2}"
+        with _open_db_for(index_project) as conn:
+            paths = {r["path"] for r in conn.execute("SELECT path FROM files").fetchall()}
+            assert "util.py" in paths
+            assert "lib.py" not in paths
+            assert "app.py" in paths
+
+    def test_changed_rejects_force(self, index_project):
+        out, rc = index_in_process(index_project, "--force", "--changed", "app.py")
+        assert rc != 0
+        assert "--changed" in out
+
+
 # ===========================================================================
 # Language detection (4 tests)
 # ===========================================================================
@@ -65,3 +65,171 @@ def test_gate_failure_behavior(project_factory):
 
     with pytest.raises(RoamAPIError):
         run_json("health", "--gate", project_root=proj, allow_gate_failure=False)
+
+
+# ---------------------------------------------------------------------------
+# Typed query layer (roam.query) — runs against a hand-built index
+# ---------------------------------------------------------------------------
+
+
+def _typed_project(tmp_path):
+    import sqlite3
+
+    from roam.db.connection import ensure_schema
+
+    (tmp_path / ".git").mkdir()
+    (tmp_path / ".roam").mkdir()
+    conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+    ensure_schema(conn)
+    conn.execute(
+        "INSERT INTO files (id, path, language, line_count, file_role) VALUES (1, 'src/app.py', 'python', 40, 'source')"
+    )
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, qualified_name, kind, line_start, line_end, is_exported) "
+        "VALUES (?, 1, ?, ?, 'function', ?, ?, ?)",
+        [(1, "process", "app.process", 1, 30, 1), (2, "helper", "app.helper", 32, 40, 0)],
+    )
+    conn.execute("INSERT INTO edges (source_id, target_id, kind) VALUES (1, 2, 'call')")
+    conn.execute("INSERT INTO symbol_metrics (symbol_id, cognitive_complexity, line_count) VALUES (1, 30, 30)")
+    conn.commit()
+    conn.close()
+    return tmp_path
+
+
+def test_query_metrics_typed_results(tmp_path):
+    from roam.query import FileMetrics, RoamQuery, SymbolMetrics
+
+    proj = _typed_project(tmp_path)
+    with RoamQuery(proj) as q:
+        fm = q.metrics("src/app.py")
+        assert isinstance(fm, FileMetrics)
+        assert fm.target_type == "file"
+        assert fm.metrics["symbol_count"] == 2
+        assert [s["name"] for s in fm.symbols] == ["process", "helper"]
+
+        sm = q.metrics("process")
+        assert isinstance(sm, SymbolMetrics)
+        assert sm.name == "app.process"
+        assert sm.location == "src/app.py:1"
+        assert sm.metrics["complexity"] == 30
+        assert sm.health == "fair"
+
+        assert q.metrics("does_not_exist") is None
+
+
+def test_query_smells_typed(tmp_path):
+    from roam.query import RoamQuery, Smell, SmellReport
+
+    proj = _typed_project(tmp_path)
+    with RoamQuery(proj) as q:
+        report = q.smells()
+        assert isinstance(report, SmellReport)
+        assert all(isinstance(s, Smell) for s in report.smells)
+        assert report.detectors_failed == len(report.failed_detectors)
+        assert q.smells(file_path="elsewhere.py").smells == []
+
+
+def test_query_missing_index(tmp_path):
+    from roam.query import IndexNotFoundError, RoamQuery
+
+    (tmp_path / ".git").mkdir()
+    with pytest.raises(IndexNotFoundError):
+        RoamQuery(tmp_path).metrics("x")
+
+
+def test_query_per_thread_connections(tmp_path):
+    import threading
+
+    from roam.api import RoamClient
+
+    proj = _typed_project(tmp_path)
+    client = RoamClient(project_root=proj)
+    q = client.query
+    assert client.query is q
+
+    results, conns, errors = [], set(), []
+    barrier = threading.Barrier(4)
+
+    def worker():
+        try:
+            barrier.wait()
+            for _ in range(5):
+                results.append(q.metrics("process").metrics["complexity"])
+            conns.add(id(q.connection()))
+        except Exception as exc:  # pragma: no cover - surfaced below
+            errors.append(exc)
+
+    threads = [threading.Thread(target=worker) for _ in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    q.close()
+
+    assert not errors
+    assert results == [30] * 20
+    assert len(conns) == 4
+
+
+def test_cli_metrics_renders_query_result(tmp_path, monkeypatch):
+    import json
+
+    from click.testing import CliRunner
+
+    from roam.cli import cli
+
+    proj = _typed_project(tmp_path)
+    monkeypatch.chdir(proj)
+    result = CliRunner().invoke(cli, ["--json", "metrics", "process"])
+    assert result.exit_code == 0, result.output
+    data = json.loads(result.output)
+    assert data["summary"]["target_type"] == "symbol"
+    assert data["name"] == "app.process"
+    assert data["metrics"]["complexity"] == 30
+
+
+def test_query_algo_typed_and_cli_renders_it(tmp_path, monkeypatch):
+    import json
+
+    from click.testing import CliRunner
+
+    import roam.query
+    from roam.cli import cli
+    from roam.query import AlgoFinding, AlgoReport, RoamQuery
+
+    proj = _typed_project(tmp_path)
+    with RoamQuery(proj) as q:
+        report = q.algo()
+    assert isinstance(report, AlgoReport)
+    assert all(isinstance(f, AlgoFinding) for f in report.findings)
+    assert report.detectors_executed > 0
+
+    finding = AlgoFinding(
+        task_id="sorting",
+        detected_way="bubble",
+        suggested_way="builtin",
+        symbol_id=1,
+        symbol_name="process",
+        kind="function",
+        location="src/app.py:1",
+        confidence="high",
+        reason="nested swap loop",
+        extra={"impact_score": 3.0, "tip": "use sorted()"},
+    )
+    assert AlgoFinding.from_dict(finding.to_dict()) == finding
+
+    calls = []
+
+    def fake_query_algo(conn, **kwargs):
+        calls.append(kwargs)
+        return AlgoReport(findings=[finding], detectors_executed=1)
+
+    monkeypatch.setattr(roam.query, "query_algo", fake_query_algo)
+    monkeypatch.chdir(proj)
+    result = CliRunner().invoke(cli, ["--json", "algo", "--profile", "strict"])
+    assert result.exit_code == 0, result.output
+    data = json.loads(result.output)
+    assert calls == [{"task": None, "confidence": None, "profile": "strict"}]
+    assert data["summary"]["total"] == 1
+    assert data["findings"][0]["symbol_name"] == "process"
+    assert data["findings"][0]["tip"] == "use sorted()"
@@ -1425,3 +1425,125 @@ class TestAlgoRicher:
         assert "primaryLocationLineHash" in res["partialFingerprints"]
         assert "codeFlows" in res
         assert "fixes" in res
+
+
+# ============================================================================
+# Fused detector engine
+# ============================================================================
+
+
+def _fused_db(tmp_path):
+    import sqlite3
+
+    from roam.db.connection import ensure_schema
+
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    conn.row_factory = sqlite3.Row
+    ensure_schema(conn)
+    conn.execute("INSERT INTO files (id, path, language) VALUES (1, 'src/algo.py', 'python')")
+    conn.execute("INSERT INTO files (id, path, language) VALUES (2, 'tests/test_algo.py', 'python')")
+    rows = [
+        # id, file_id, name, line_start, line_end
+        (1, 1, "bubble_sort", 1, 10),
+        (2, 1, "fib", 11, 15),
+        (3, 1, "memo_fib", 16, 20),
+        (4, 1, "lru_cache", 21, 22),
+        (5, 1, "poll_loop", 23, 30),
+        (6, 1, "spin_ready", 31, 40),
+        (7, 2, "bubble_sort_helper", 1, 10),
+    ]
+    for sid, fid, name, ls, le in rows:
+        conn.execute(
+            "INSERT INTO symbols (id, file_id, name, qualified_name, kind, line_start, line_end) "
+            "VALUES (?, ?, ?, ?, 'function', ?, ?)",
+            (sid, fid, name, name, ls, le),
+        )
+    conn.executemany(
+        "INSERT INTO math_signals (symbol_id, loop_depth, has_nested_loops, loop_with_compare, "
+        "subscript_in_loops, has_self_call, calls_in_loops) VALUES (?, ?, ?, ?, ?, ?, ?)",
+        [
+            (1, 2, 1, 1, 1, 0, "[]"),
+            (2, 0, 0, 0, 0, 1, "[]"),
+            (3, 0, 0, 0, 0, 1, "[]"),
+            (5, 1, 0, 0, 0, 0, '["sleep"]'),
+            (6, 1, 0, 0, 0, 0, '["time.sleep"]'),
+            (7, 2, 1, 1, 1, 0, "[]"),
+        ],
+    )
+    conn.execute("INSERT INTO edges (source_id, target_id, kind) VALUES (3, 4, 'call')")
+    conn.commit()
+    return conn
+
+
+class TestFusedDetectorEngine:
+    def test_like_regex_matches_sql_semantics(self):
+        from roam.catalog.detectors import _like_regex
+
+        rx = _like_regex(["%_sum%", "%has_%"])
+        assert rx.match("get_sum")
+        assert rx.match("CHECKSUM")
+        assert not rx.match("sum")
+        assert rx.match("hasX")
+        assert not rx.match("has")
+
+    def test_fused_run_matches_single_detectors(self, tmp_path):
+        from roam.catalog.detectors import (
+            _MATH_DETECTORS,
+            run_detectors,
+        )
+
+        conn = _fused_db(tmp_path)
+        expected = set()
+        for task_id, _way, fn in _MATH_DETECTORS:
+            for hit in fn(conn):
+                expected.add((task_id, hit["symbol_id"]))
+        findings = run_detectors(conn)
+        assert {(f["task_id"], f["symbol_id"]) for f in findings} == expected
+        assert ("sorting", 1) in expected
+        assert ("fibonacci", 2) in expected
+        assert ("busy-wait", 6) in expected
+        conn.close()
+
+    def test_batched_followups_and_test_paths(self, tmp_path):
+        from roam.catalog.detectors import run_detectors
+
+        conn = _fused_db(tmp_path)
+        ids = {(f["task_id"], f["symbol_id"]) for f in run_detectors(conn)}
+        # memoized recursion, intentional polling and test files are suppressed
+        assert ("fibonacci", 3) not in ids
+        assert ("busy-wait", 5) not in ids
+        assert ("sorting", 7) not in ids
+        conn.close()
+
+    def test_meta_reports_per_detector_timings(self, tmp_path):
+        from roam.catalog.detectors import _MATH_DETECTORS, run_detectors
+
+        conn = _fused_db(tmp_path)
+        _findings, meta = run_detectors(conn, return_meta=True)
+        timings = meta["detector_timings_ms"]
+        assert "_scan_load" in timings
+        for task_id, _way, _fn in _MATH_DETECTORS:
+            assert task_id in timings
+            assert timings[task_id] >= 0
+        assert meta["detectors_failed"] == 0
+        conn.close()
+
+    def test_missing_math_signals_table(self, tmp_path):
+        import sqlite3
+
+        from roam.catalog.detectors import run_detectors
+
+        conn = sqlite3.connect(str(tmp_path / "bare.db"))
+        conn.row_factory = sqlite3.Row
+        conn.executescript(
+            "CREATE TABLE files (id INTEGER PRIMARY KEY, path TEXT, language TEXT);"
+            "CREATE TABLE symbols (id INTEGER PRIMARY KEY, file_id INTEGER, name TEXT, "
+            "qualified_name TEXT, kind TEXT, line_start INTEGER, line_end INTEGER);"
+            "CREATE TABLE edges (source_id INTEGER, target_id INTEGER, kind TEXT);"
+            "INSERT INTO files VALUES (1, 'a.py', 'python');"
+            "INSERT INTO symbols VALUES (1, 1, 'quick_sort', 'quick_sort', 'function', 1, 2);"
+        )
+        findings, meta = run_detectors(conn, return_meta=True)
+        assert findings == []
+        assert meta["detectors_failed"] == 0
+        conn.close()
@@ -0,0 +1,138 @@
+"""Tests for concurrent MCP tool execution (roam.mcp_executor)."""
+
+from __future__ import annotations
+
+import asyncio
+import inspect
+import sqlite3
+import sys
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+import click
+
+from roam.db.connection import enable_worker_connections, ensure_schema, open_db
+from roam.mcp_executor import ToolExecutor, capture_output
+
+
+class TestCaptureOutput:
+    def test_threads_capture_independently(self):
+        barrier = threading.Barrier(6, timeout=10)
+
+        def work(i):
+            with capture_output() as (out, err):
+                barrier.wait()
+                for _ in range(50):
+                    click.echo(f"out-{i}")
+                    print(f"err-{i}", file=sys.stderr)
+            return i, out.getvalue(), err.getvalue()
+
+        with ThreadPoolExecutor(6) as pool:
+            results = list(pool.map(work, range(6)))
+        for i, out, err in results:
+            assert out == f"out-{i}\n" * 50
+            assert err == f"err-{i}\n" * 50
+
+    def test_inprocess_cli_runs_concurrently(self):
+        from roam.mcp_server import _run_roam_inprocess
+
+        with ThreadPoolExecutor(4) as pool:
+            results = list(pool.map(_run_roam_inprocess, [["schema"]] * 4 + [["no-such-command"]] * 2))
+        assert all(r["command"] == "schema" for r in results[:4])
+        assert all(r["error_code"] == "USAGE_ERROR" for r in results[4:])
+
+
+class TestToolExecutor:
+    def test_reads_overlap_and_writes_serialise(self):
+        executor = ToolExecutor(max_workers=4)
+        barrier = threading.Barrier(4, timeout=10)
+        lock = threading.Lock()
+        active = {"now": 0, "peak": 0}
+
+        def read(i):
+            barrier.wait()  # deadlocks (and times out) unless 4 run at once
+            return i
+
+        def write(i):
+            with lock:
+                active["now"] += 1
+                active["peak"] = max(active["peak"], active["now"])
+            threading.Event().wait(0.01)
+            with lock:
+                active["now"] -= 1
+            return i
+
+        async def main():
+            reads = [executor.submit("roam_read", read, i) for i in range(4)]
+            writes = [executor.submit("roam_write", write, i, write=True) for i in range(4)]
+            return await asyncio.gather(*reads, *writes)
+
+        try:
+            assert asyncio.run(main()) == [0, 1, 2, 3, 0, 1, 2, 3]
+        finally:
+            executor.shutdown()
+        assert active["peak"] == 1
+
+        stats = executor.stats()
+        assert stats["queue_depth"] == {"read": 0, "write": 0}
+        assert stats["in_flight"] == {"read": 0, "write": 0}
+        assert stats["peak_queue_depth"]["write"] >= 1
+        assert stats["tools"]["roam_read"]["calls"] == 4
+        assert stats["tools"]["roam_write"]["calls"] == 4
+
+    def test_wrap_keeps_signature_and_counts_errors(self):
+        executor = ToolExecutor(max_workers=2)
+
+        def roam_tool(name: str, limit: int = 5) -> dict:
+            """Doc."""
+            if name == "bad":
+                return {"error": "nope", "isError": True}
+            return {"name": name, "limit": limit}
+
+        wrapped = executor.wrap("roam_tool", roam_tool)
+        assert inspect.signature(wrapped) == inspect.signature(roam_tool)
+        assert wrapped.__doc__ == "Doc."
+        try:
+            assert asyncio.run(wrapped("x", limit=2)) == {"name": "x", "limit": 2}
+            asyncio.run(wrapped("bad"))
+        finally:
+            executor.shutdown()
+        tool = executor.stats()["tools"]["roam_tool"]
+        assert tool["calls"] == 2
+        assert tool["errors"] == 1
+
+
+class TestWorkerConnections:
+    def test_readonly_connection_reused_per_thread(self, tmp_path):
+        db = tmp_path / "index.db"
+        conn = sqlite3.connect(str(db))
+        ensure_schema(conn)
+        conn.close()
+
+        def use_twice():
+            enable_worker_connections()
+            with open_db(readonly=True, db_path=db) as a:
+                a.execute("SELECT COUNT(*) FROM files").fetchone()
+            with open_db(readonly=True, db_path=db) as b:
+                pass
+            return a is b, id(a)
+
+        with ThreadPoolExecutor(2) as pool:
+            (same1, id1), (same2, id2) = pool.map(lambda _: use_twice(), range(2))
+        assert same1 and same2
+
+    def test_closed_connection_is_replaced(self, tmp_path):
+        db = tmp_path / "index.db"
+        conn = sqlite3.connect(str(db))
+        ensure_schema(conn)
+        conn.close()
+
+        def run():
+            enable_worker_connections()
+            with open_db(readonly=True, db_path=db) as a:
+                a.close()
+            with open_db(readonly=True, db_path=db) as b:
+                return b.execute("SELECT COUNT(*) FROM files").fetchone()[0]
+
+        with ThreadPoolExecutor(1) as pool:
+            assert pool.submit(run).result() == 0
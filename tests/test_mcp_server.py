@@ -19,6 +19,12 @@ from unittest.mock import MagicMock, patch
 
 from click.testing import CliRunner
 
+
+def _cli_outcome(result):
+    """(exit_code, stdout, stderr, exception) as returned by _invoke_cli."""
+    return result.exit_code, result.output, "", result.exception
+
+
 # ---------------------------------------------------------------------------
 # _classify_error tests
 # ---------------------------------------------------------------------------
@@ -143,7 +149,7 @@ class TestRunRoam:
     """Test the roam CLI runner wrapper."""
 
     def test_inprocess_success(self):
-        """In-process path (root='.') parses CliRunner JSON output."""
+        """In-process path (root='.') parses the command JSON output."""
         from roam.mcp_server import _run_roam
 
         payload = {"summary": {"health_score": 85}}
@@ -151,19 +157,19 @@ class TestRunRoam:
         mock_result.exit_code = 0
         mock_result.output = json.dumps(payload)
         mock_result.exception = None
-        with patch("click.testing.CliRunner.invoke", return_value=mock_result):
+        with patch("roam.mcp_server._invoke_cli", return_value=_cli_outcome(mock_result)):
             result = _run_roam(["health"], ".")
             assert result == payload
 
     def test_inprocess_failure(self):
-        """In-process path classifies errors from CliRunner output."""
+        """In-process path classifies errors from command output."""
         from roam.mcp_server import _run_roam
 
         mock_result = MagicMock()
         mock_result.exit_code = 1
         mock_result.output = "Error: No .roam directory found"
         mock_result.exception = None
-        with patch("click.testing.CliRunner.invoke", return_value=mock_result):
+        with patch("roam.mcp_server._invoke_cli", return_value=_cli_outcome(mock_result)):
             result = _run_roam(["health"], ".")
             assert "error" in result
             assert result["error_code"] == "INDEX_NOT_FOUND"
@@ -178,7 +184,7 @@ class TestRunRoam:
         mock_result.exit_code = 0
         mock_result.output = "not json {{{"
         mock_result.exception = None
-        with patch("click.testing.CliRunner.invoke", return_value=mock_result):
+        with patch("roam.mcp_server._invoke_cli", return_value=_cli_outcome(mock_result)):
             result = _run_roam(["health"], ".")
             assert "error" in result
             assert "JSON" in result["error"]
@@ -217,7 +223,7 @@ class TestRunRoam:
         mock_result.exit_code = 1
         mock_result.output = ""
         mock_result.exception = RuntimeError("something broke")
-        with patch("click.testing.CliRunner.invoke", return_value=mock_result):
+        with patch("roam.mcp_server._invoke_cli", return_value=_cli_outcome(mock_result)):
             result = _run_roam(["health"], ".")
             assert "error" in result
 
@@ -290,6 +296,39 @@ class TestToolDecorator:
         assert "roam_init" in _NON_READ_ONLY_TOOLS
         assert "roam_reindex" in _NON_READ_ONLY_TOOLS
 
+    def test_tools_that_write_the_index_are_non_read_only(self):
+        """Every tool running a CLI command that writes .roam/ must use the writer lane."""
+        import ast
+        import importlib
+        import inspect
+        import re
+
+        import roam.mcp_server as server
+        from roam.cli import _COMMANDS
+
+        writes = re.compile(r"open_db\((readonly=False)?\)|\.unlink\(|Indexer\(")
+        writer_commands = set()
+        for cmd_name, (module, attr) in _COMMANDS.items():
+            cmd = getattr(importlib.import_module(module), attr)
+            if writes.search(inspect.getsource(inspect.unwrap(cmd.callback))):
+                writer_commands.add(cmd_name)
+        assert {"annotate", "clean", "index", "reset"} <= writer_commands
+
+        source = inspect.getsource(server)
+        missing = []
+        for node in ast.walk(ast.parse(source)):
+            if not isinstance(node, (ast.FunctionDef, ast.AsyncFunctionDef)):
+                continue
+            for deco in node.decorator_list:
+                if not (isinstance(deco, ast.Call) and getattr(deco.func, "id", "") == "_tool"):
+                    continue
+                tool = next(k.value.value for k in deco.keywords if k.arg == "name")
+                body = ast.get_source_segment(source, node)
+                used = set(re.findall(r'\[\s*"([a-z][a-z-]*)"', body)) & writer_commands
+                if used and tool not in server._NON_READ_ONLY_TOOLS:
+                    missing.append((tool, sorted(used)))
+        assert missing == []
+
     def test_presets_all_defined(self):
         """All 6 presets should be defined."""
         from roam.mcp_server import _PRESETS
@@ -1335,7 +1374,7 @@ class TestStructuredErrors:
         mock_result.exit_code = 1
         mock_result.output = "Error: No .roam directory found"
         mock_result.exception = None
-        with patch("click.testing.CliRunner.invoke", return_value=mock_result):
+        with patch("roam.mcp_server._invoke_cli", return_value=_cli_outcome(mock_result)):
             result = _run_roam(["health"], ".")
             assert result["isError"] is True
             assert "retryable" in result
@@ -1348,7 +1387,7 @@ class TestStructuredErrors:
         mock_result.exit_code = 1
         mock_result.output = "sqlite3.OperationalError: database is locked"
         mock_result.exception = None
-        with patch("click.testing.CliRunner.invoke", return_value=mock_result):
+        with patch("roam.mcp_server._invoke_cli", return_value=_cli_outcome(mock_result)):
             result = _run_roam(["health"], ".")
             assert result["retryable"] is True
 
@@ -1359,7 +1398,7 @@ class TestStructuredErrors:
         mock_result.exit_code = 1
         mock_result.output = "OSError: Permission denied"
         mock_result.exception = None
-        with patch("click.testing.CliRunner.invoke", return_value=mock_result):
+        with patch("roam.mcp_server._invoke_cli", return_value=_cli_outcome(mock_result)):
             result = _run_roam(["health"], ".")
             assert result["retryable"] is False
 
@@ -1386,7 +1425,7 @@ class TestStructuredErrors:
         mock_result.exit_code = 0
         mock_result.output = json.dumps(payload)
         mock_result.exception = None
-        with patch("click.testing.CliRunner.invoke", return_value=mock_result):
+        with patch("roam.mcp_server._invoke_cli", return_value=_cli_outcome(mock_result)):
             result = _run_roam(["health"], ".")
             assert "isError" not in result
 
@@ -67,62 +67,62 @@ def single_file_project(project_factory):
 
 
 # ---------------------------------------------------------------------------
-# Unit tests: _resolve_target
+# Unit tests: resolve_target
 # ---------------------------------------------------------------------------
 
 
 class TestResolveTarget:
     def test_resolve_file_exact(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target
         from roam.db.connection import open_db
+        from roam.query.metrics import resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                target_type, tid, row = _resolve_target(conn, "src/models.py")
+                target_type, tid, row = resolve_target(conn, "src/models.py")
                 assert target_type == "file"
                 assert tid is not None
         finally:
             os.chdir(old_cwd)
 
     def test_resolve_file_partial(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target
         from roam.db.connection import open_db
+        from roam.query.metrics import resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                target_type, tid, row = _resolve_target(conn, "models.py")
+                target_type, tid, row = resolve_target(conn, "models.py")
                 assert target_type == "file"
                 assert tid is not None
         finally:
             os.chdir(old_cwd)
 
     def test_resolve_symbol(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target
         from roam.db.connection import open_db
+        from roam.query.metrics import resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                target_type, tid, row = _resolve_target(conn, "create_user")
+                target_type, tid, row = resolve_target(conn, "create_user")
                 assert target_type == "symbol"
                 assert tid is not None
         finally:
             os.chdir(old_cwd)
 
     def test_resolve_unknown(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target
         from roam.db.connection import open_db
+        from roam.query.metrics import resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                target_type, tid, row = _resolve_target(conn, "nonexistent_xyz_999")
+                target_type, tid, row = resolve_target(conn, "nonexistent_xyz_999")
                 assert target_type == "unknown"
                 assert tid is None
         finally:
@@ -136,8 +136,8 @@ class TestResolveTarget:
 
 class TestCollectSymbolMetrics:
     def test_returns_all_keys(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target, collect_symbol_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_symbol_metrics, resolve_target
 
         expected_keys = {
             "complexity",
@@ -164,7 +164,7 @@ class TestCollectSymbolMetrics:
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                _, sid, _ = _resolve_target(conn, "create_user")
+                _, sid, _ = resolve_target(conn, "create_user")
                 if sid is None:
                     pytest.skip("create_user symbol not found")
                 m = collect_symbol_metrics(conn, sid)
@@ -173,14 +173,14 @@ class TestCollectSymbolMetrics:
             os.chdir(old_cwd)
 
     def test_complexity_non_negative(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target, collect_symbol_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_symbol_metrics, resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                _, sid, _ = _resolve_target(conn, "create_user")
+                _, sid, _ = resolve_target(conn, "create_user")
                 if sid is None:
                     pytest.skip("create_user symbol not found")
                 m = collect_symbol_metrics(conn, sid)
@@ -189,14 +189,14 @@ class TestCollectSymbolMetrics:
             os.chdir(old_cwd)
 
     def test_pagerank_is_float(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target, collect_symbol_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_symbol_metrics, resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                _, sid, _ = _resolve_target(conn, "create_user")
+                _, sid, _ = resolve_target(conn, "create_user")
                 if sid is None:
                     pytest.skip("create_user symbol not found")
                 m = collect_symbol_metrics(conn, sid)
@@ -205,14 +205,14 @@ class TestCollectSymbolMetrics:
             os.chdir(old_cwd)
 
     def test_sna_v2_metrics_types(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target, collect_symbol_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_symbol_metrics, resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                _, sid, _ = _resolve_target(conn, "create_user")
+                _, sid, _ = resolve_target(conn, "create_user")
                 if sid is None:
                     pytest.skip("create_user symbol not found")
                 m = collect_symbol_metrics(conn, sid)
@@ -225,14 +225,14 @@ class TestCollectSymbolMetrics:
             os.chdir(old_cwd)
 
     def test_comprehension_metrics_present(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target, collect_symbol_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_symbol_metrics, resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                _, sid, _ = _resolve_target(conn, "create_user")
+                _, sid, _ = resolve_target(conn, "create_user")
                 if sid is None:
                     pytest.skip("create_user symbol not found")
                 m = collect_symbol_metrics(conn, sid)
@@ -253,14 +253,14 @@ class TestCollectSymbolMetrics:
 
 class TestCollectFileMetrics:
     def test_returns_expected_structure(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target, collect_file_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_file_metrics, resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                _, fid, _ = _resolve_target(conn, "src/models.py")
+                _, fid, _ = resolve_target(conn, "src/models.py")
                 if fid is None:
                     pytest.skip("src/models.py not found")
                 data = collect_file_metrics(conn, fid)
@@ -272,8 +272,8 @@ class TestCollectFileMetrics:
             os.chdir(old_cwd)
 
     def test_file_metrics_keys(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target, collect_file_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_file_metrics, resolve_target
 
         expected_keys = {
             "complexity",
@@ -292,7 +292,7 @@ class TestCollectFileMetrics:
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                _, fid, _ = _resolve_target(conn, "src/models.py")
+                _, fid, _ = resolve_target(conn, "src/models.py")
                 if fid is None:
                     pytest.skip("src/models.py not found")
                 data = collect_file_metrics(conn, fid)
@@ -302,14 +302,14 @@ class TestCollectFileMetrics:
             os.chdir(old_cwd)
 
     def test_symbols_list_not_empty(self, metrics_project):
-        from roam.commands.cmd_metrics import _resolve_target, collect_file_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_file_metrics, resolve_target
 
         old_cwd = os.getcwd()
         try:
             os.chdir(str(metrics_project))
             with open_db(readonly=True) as conn:
-                _, fid, _ = _resolve_target(conn, "src/models.py")
+                _, fid, _ = resolve_target(conn, "src/models.py")
                 if fid is None:
                     pytest.skip("src/models.py not found")
                 data = collect_file_metrics(conn, fid)
@@ -318,8 +318,8 @@ class TestCollectFileMetrics:
             os.chdir(old_cwd)
 
     def test_nonexistent_file_returns_empty(self, metrics_project):
-        from roam.commands.cmd_metrics import collect_file_metrics
         from roam.db.connection import open_db
+        from roam.query.metrics import collect_file_metrics
 
         old_cwd = os.getcwd()
         try:
@@ -332,33 +332,33 @@ class TestCollectFileMetrics:
 
 
 # ---------------------------------------------------------------------------
-# Unit tests: _health_label
+# Unit tests: health_label
 # ---------------------------------------------------------------------------
 
 
 class TestHealthLabel:
     def test_good(self):
-        from roam.commands.cmd_metrics import _health_label
+        from roam.query.metrics import health_label
 
-        assert _health_label({"complexity": 5, "fan_out": 3, "churn": 2, "dead_code_risk": False}) == "good"
+        assert health_label({"complexity": 5, "fan_out": 3, "churn": 2, "dead_code_risk": False}) == "good"
 
     def test_fair(self):
-        from roam.commands.cmd_metrics import _health_label
+        from roam.query.metrics import health_label
 
-        assert _health_label({"complexity": 20, "fan_out": 5, "churn": 2, "dead_code_risk": False}) == "fair"
+        assert health_label({"complexity": 20, "fan_out": 5, "churn": 2, "dead_code_risk": False}) == "fair"
 
     def test_poor(self):
-        from roam.commands.cmd_metrics import _health_label
+        from roam.query.metrics import health_label
 
-        assert _health_label({"complexity": 30, "fan_out": 20, "churn": 100, "dead_code_risk": True}) == "poor"
+        assert health_label({"complexity": 30, "fan_out": 20, "churn": 100, "dead_code_risk": True}) == "poor"
 
     def test_dead_code_risk_bumps_score(self):
-        from roam.commands.cmd_metrics import _health_label
+        from roam.query.metrics import health_label
 
         # Without dead code risk: good
-        assert _health_label({"complexity": 5, "fan_out": 3, "churn": 2, "dead_code_risk": False}) == "good"
+        assert health_label({"complexity": 5, "fan_out": 3, "churn": 2, "dead_code_risk": False}) == "good"
         # With dead code risk: fair
-        assert _health_label({"complexity": 5, "fan_out": 3, "churn": 2, "dead_code_risk": True}) == "fair"
+        assert health_label({"complexity": 5, "fan_out": 3, "churn": 2, "dead_code_risk": True}) == "fair"
 
 
 # ---------------------------------------------------------------------------
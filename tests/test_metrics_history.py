@@ -0,0 +1,96 @@
+"""Tests for indexer-materialised snapshot metrics (roam.commands.metrics_history)."""
+
+from __future__ import annotations
+
+import sqlite3
+
+import pytest
+
+from roam.commands import metrics_history
+from roam.commands.metrics_history import (
+    collect_metrics,
+    compute_metrics,
+    load_snapshot_metrics,
+    store_snapshot_metrics,
+)
+from roam.db.connection import ensure_schema
+
+
+def _make_db(tmp_path):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    conn.row_factory = sqlite3.Row
+    ensure_schema(conn)
+    conn.executemany("INSERT INTO files (id, path) VALUES (?, ?)", [(1, "a.py"), (2, "b.py")])
+    # 1 <-> 2 form a cycle; 3 -> 1; 4 is an unreferenced export
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind) VALUES (?, ?, ?, 'function')",
+        [(1, 1, "alpha"), (2, 1, "beta"), (3, 2, "gamma"), (4, 2, "delta")],
+    )
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind) VALUES (?, ?, 'call')",
+        [(1, 2), (2, 1), (3, 1)],
+    )
+    conn.executemany(
+        "INSERT INTO symbol_metrics (symbol_id, cognitive_complexity, line_count) VALUES (?, ?, ?)",
+        [(1, 30, 60), (2, 4, 10), (3, 2, 5), (4, 0, 2)],
+    )
+    return conn
+
+
+def test_stored_metrics_match_computed(tmp_path):
+    conn = _make_db(tmp_path)
+    computed = compute_metrics(conn)
+    assert computed["cycles"] == 1
+    assert computed["tangle_ratio"] == 50.0
+    assert computed["brain_methods"] == 1
+    assert store_snapshot_metrics(conn) == computed
+    loaded = load_snapshot_metrics(conn)
+    assert loaded == computed
+    assert isinstance(loaded["tangle_ratio"], float)
+    assert isinstance(loaded["cycles"], int)
+
+
+def test_collect_reads_stored_without_graph(tmp_path, monkeypatch):
+    conn = _make_db(tmp_path)
+    expected = store_snapshot_metrics(conn)
+
+    def _fail(*args, **kwargs):
+        raise AssertionError("collect_metrics rebuilt the graph")
+
+    monkeypatch.setattr(metrics_history, "compute_metrics", _fail)
+    assert collect_metrics(conn) == expected
+
+
+def test_stale_aggregates_ignored(tmp_path):
+    conn = _make_db(tmp_path)
+    store_snapshot_metrics(conn)
+    conn.execute("INSERT INTO edges (source_id, target_id, kind) VALUES (4, 3, 'call')")
+    assert load_snapshot_metrics(conn) is None
+    assert collect_metrics(conn)["edges"] == 4
+
+
+@pytest.mark.parametrize("drop", [True, False])
+def test_missing_aggregates_fall_back(tmp_path, drop):
+    conn = _make_db(tmp_path)
+    if drop:
+        conn.execute("DROP TABLE snapshot_metrics")
+    assert load_snapshot_metrics(conn) is None
+    assert collect_metrics(conn) == compute_metrics(conn)
+
+
+def test_targeted_reindex_falls_back(tmp_path):
+    from roam.index.indexer import Indexer
+
+    (tmp_path / "main.prg").write_text("FUNCTION Alpha\n  RETURN 1\nENDFUNC\n")
+    Indexer(tmp_path).run(quiet=True, progress_bar=False)
+    conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+    assert load_snapshot_metrics(conn) is not None
+    conn.close()
+
+    # Same file, symbol and edge counts: only the dirty phase tells
+    (tmp_path / "main.prg").write_text("FUNCTION Alpha\n  RETURN 2\nENDFUNC\n")
+    Indexer(tmp_path).run_paths(["main.prg"], quiet=True, progress_bar=False)
+    conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+    conn.row_factory = sqlite3.Row
+    assert load_snapshot_metrics(conn) is None
+    assert collect_metrics(conn) == compute_metrics(conn)
@@ -0,0 +1,71 @@
+"""Tests for neighbourhood subgraph loading (roam.graph.neighbourhood, load_neighbourhood)."""
+
+from __future__ import annotations
+
+import random
+import sqlite3
+
+import networkx as nx
+import pytest
+
+from roam.graph.builder import build_symbol_graph, load_neighbourhood
+from roam.graph.neighbourhood import walk_neighbourhood
+
+
+@pytest.fixture
+def db():
+    """A random symbol graph stored in the index tables."""
+    rng = random.Random(11)
+    conn = sqlite3.connect(":memory:")
+    conn.executescript(
+        "CREATE TABLE files (id INTEGER PRIMARY KEY, path TEXT);"
+        "CREATE TABLE symbols (id INTEGER PRIMARY KEY, file_id INTEGER, name TEXT, kind TEXT, qualified_name TEXT);"
+        "CREATE TABLE edges (source_id INTEGER, target_id INTEGER, kind TEXT);"
+    )
+    conn.executemany("INSERT INTO files VALUES (?, ?)", [(i, f"f{i}.py") for i in range(10)])
+    conn.executemany(
+        "INSERT INTO symbols VALUES (?, ?, ?, 'function', ?)",
+        [(i, i % 10, f"s{i}", f"m.s{i}") for i in range(1, 201)],
+    )
+    edges = {(rng.randint(1, 200), rng.randint(1, 200)) for _ in range(400)}
+    conn.executemany("INSERT INTO edges VALUES (?, ?, 'call')", sorted(e for e in edges if e[0] != e[1]))
+    return conn
+
+
+def test_closure_matches_full_graph(db):
+    G = build_symbol_graph(db)
+    for seed in (1, 50, 123):
+        sub = load_neighbourhood(db, [seed], direction="in")
+        assert set(sub) == nx.ancestors(G, seed) | {seed}
+        assert set(sub.edges()) == set(G.subgraph(sub).edges())
+        assert sub.nodes[seed]["hops"] == 0
+        assert sub.nodes[seed]["file_path"] == G.nodes[seed]["file_path"]
+
+        out = load_neighbourhood(db, [seed], direction="out")
+        assert set(out) == nx.descendants(G, seed) | {seed}
+
+
+def test_depth_matches_ego_graph(db):
+    G = build_symbol_graph(db)
+    for seed in (2, 77):
+        sub = load_neighbourhood(db, [seed], depth=2, direction="both")
+        ego = nx.ego_graph(G, seed, radius=2, undirected=True)
+        assert set(sub) == set(ego)
+        assert set(sub.edges()) == set(ego.edges())
+        lengths = nx.single_source_shortest_path_length(G.to_undirected(), seed, cutoff=2)
+        assert {n: sub.nodes[n]["hops"] for n in sub} == lengths
+
+
+def test_max_nodes_truncates(db):
+    hops, edges, truncated = walk_neighbourhood(db, [1, 2], direction="both", max_nodes=5)
+    assert len(hops) == 5 and truncated
+    assert hops[1] == hops[2] == 0
+    assert all(s in hops and t in hops for s, t, _ in edges)
+    _, _, truncated = walk_neighbourhood(db, [1], depth=1, direction="both", max_nodes=1000)
+    assert not truncated
+
+
+def test_unknown_seed_and_bad_direction(db):
+    assert len(load_neighbourhood(db, [9999])) == 0
+    with pytest.raises(ValueError):
+        walk_neighbourhood(db, [1], direction="sideways")
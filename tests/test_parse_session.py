@@ -0,0 +1,150 @@
+"""Tests for the shared on-demand parse session (roam.index.parse_session)."""
+
+from __future__ import annotations
+
+import threading
+
+import pytest
+
+import roam.index.parser as parser_mod
+from roam.index.parse_session import ParseSession, current_session, reset_session
+from roam.index.parser import parse_file
+
+
+class _FakeTree:
+    def __init__(self, source):
+        self.source = source
+
+
+class _FakeParser:
+    def __init__(self, grammar):
+        self.grammar = grammar
+        self.language = f"<{grammar}>"
+        self.parsed = []
+
+    def parse(self, source):
+        self.parsed.append(source)
+        return _FakeTree(source)
+
+
+@pytest.fixture
+def fake_parsers(monkeypatch):
+    """Replace grammar loading with fake parsers; returns the load log."""
+    loads = []
+
+    def get_parser(grammar):
+        loads.append(grammar)
+        if grammar == "missing":
+            raise LookupError(grammar)
+        return _FakeParser(grammar)
+
+    monkeypatch.setattr(parser_mod, "get_parser", get_parser)
+    reset_session()
+    yield loads
+    reset_session()
+
+
+def test_parser_and_language_are_pooled(fake_parsers):
+    session = ParseSession()
+    assert session.parser("python") is session.parser("python")
+    assert session.language("python") == "<python>"
+    assert fake_parsers == ["python"]
+
+
+def test_missing_grammar_is_not_retried(fake_parsers):
+    session = ParseSession()
+    for _ in range(3):
+        with pytest.raises(LookupError):
+            session.parser("missing")
+    assert fake_parsers == ["missing"]
+
+
+def test_tree_cache_keyed_by_path_and_content(fake_parsers):
+    session = ParseSession()
+    a = session.parse(b"x = 1", "python", path="a.py")
+    assert session.parse(b"x = 1", "python", path="a.py") is a
+    assert session.parse(b"x = 2", "python", path="a.py") is not a
+    assert session.parse(b"x = 1", "python", path="b.py") is not a
+
+    summary = session.summary()
+    assert summary["grammars"]["python"]["parses"] == 3
+    assert summary["grammars"]["python"]["cache_hits"] == 1
+    assert summary["parses"] == 3 and summary["cache_hits"] == 1
+
+
+def test_summary_since_baseline(fake_parsers):
+    session = ParseSession()
+    session.parse(b"x = 1", "python", path="a.py")
+    session.parse(b"x = 1", "go", path="a.go")
+    baseline = session.counters()
+    session.parse(b"x = 1", "python", path="a.py")
+    session.parse(b"x = 2", "python", path="a.py")
+
+    summary = session.summary(since=baseline)
+    assert set(summary["grammars"]) == {"python"}
+    assert summary["parses"] == 1 and summary["cache_hits"] == 1
+    assert session.summary()["parses"] == 3
+
+
+def test_indexer_reports_parses_of_its_own_run(tmp_path, monkeypatch):
+    from roam.index.indexer import Indexer
+
+    monkeypatch.delenv("ROAM_DB_DIR", raising=False)
+    reset_session()
+    # Parses done earlier on this thread (another run, a command) are not this run's
+    current_session().record("python", 0.5)
+    (tmp_path / "app.prg").write_text("FUNCTION Main\n  RETURN .T.\nENDFUNC\n")
+    indexer = Indexer(project_root=tmp_path)
+    indexer.run(force=True, quiet=True)
+    assert indexer.summary["parse"]["parses"] == 0
+    assert indexer.summary["parse"]["ms"] == 0
+    reset_session()
+
+
+def test_tree_cache_is_bounded(fake_parsers):
+    session = ParseSession(max_trees=2)
+    first = session.parse(b"1", "python", path="a.py")
+    session.parse(b"2", "python", path="b.py")
+    session.parse(b"3", "python", path="c.py")
+    assert session.summary()["cached_trees"] == 2
+    assert session.parse(b"1", "python", path="a.py") is not first
+
+
+def test_compiled_artefacts_are_memoised(fake_parsers):
+    session = ParseSession()
+    builds = []
+
+    def build(parser):
+        builds.append(parser.grammar)
+        return object()
+
+    first = session.compiled("python", "pattern", build)
+    assert session.compiled("python", "pattern", build) is first
+    session.compiled("go", "pattern", build)
+    assert builds == ["python", "go"]
+
+
+def test_sessions_are_per_thread(fake_parsers):
+    main = current_session()
+    assert current_session() is main
+    seen = []
+    t = threading.Thread(target=lambda: seen.append(current_session()))
+    t.start()
+    t.join()
+    assert seen[0] is not main
+
+
+def test_parse_file_shares_trees(fake_parsers, tmp_path):
+    path = tmp_path / "mod.py"
+    path.write_text("def f():\n    return 1\n")
+    tree1, source, lang = parse_file(path)
+    tree2, _, _ = parse_file(path)
+    assert lang == "python" and source == path.read_bytes()
+    assert tree2 is tree1
+
+    path.write_text("def f():\n    return 2\n")
+    tree3, _, _ = parse_file(path)
+    assert tree3 is not tree1
+    stats = current_session().summary()["grammars"]["python"]
+    assert stats == {"parses": 2, "cache_hits": 1, "ms": stats["ms"]}
+    assert fake_parsers == ["python"]
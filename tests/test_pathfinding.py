@@ -0,0 +1,94 @@
+"""Tests for the CSR path engine (roam.graph.pathfinding)."""
+
+from __future__ import annotations
+
+import itertools
+import random
+import sqlite3
+
+import networkx as nx
+
+from roam.db.connection import ensure_schema
+from roam.graph.pathfinding import PathGraph, find_k_paths
+
+_KINDS = ["call", "import", "uses", "template", "reference"]
+
+
+def _random_graph(seed: int, n: int = 40, m: int = 120) -> nx.DiGraph:
+    rnd = random.Random(seed)
+    G = nx.DiGraph()
+    G.add_nodes_from(range(1, n + 1))
+    for _ in range(m):
+        u, v = rnd.sample(range(1, n + 1), 2)
+        G.add_edge(u, v, kind=rnd.choice(_KINDS))
+    return G
+
+
+def _nx_costs(G, s, t, k):
+    H = G.copy()
+    for _u, _v, d in H.edges(data=True):
+        d["weight"] = {"call": 1.0, "uses": 1.0, "template": 1.0, "import": 1.1}.get(d["kind"], 2.0)
+    try:
+        paths = list(itertools.islice(nx.shortest_simple_paths(H, s, t, weight="weight"), k))
+    except nx.NetworkXNoPath:
+        return []
+    return [round(nx.path_weight(H, p, "weight"), 6) for p in paths]
+
+
+def _costs(graph, paths):
+    return [round(sum(graph._weight(graph._index[u], graph._index[v]) for u, v in zip(p, p[1:])), 6) for p in paths]
+
+
+def test_yen_matches_networkx_costs():
+    for seed in range(6):
+        G = _random_graph(seed)
+        graph = PathGraph.from_networkx(G)
+        rnd = random.Random(seed)
+        for _ in range(15):
+            s, t = rnd.sample(range(1, 41), 2)
+            expected = _nx_costs(G, s, t, 5)
+            paths = graph.k_shortest(s, t, 5)
+            assert _costs(graph, paths) == expected
+            for p in paths:
+                assert p[0] == s and p[-1] == t
+                assert len(set(p)) == len(p)
+                assert all(G.has_edge(u, v) for u, v in zip(p, p[1:]))
+            assert len({tuple(p) for p in paths}) == len(paths)
+
+
+def test_cutoff_bounds_cost():
+    G = nx.DiGraph()
+    nx.add_path(G, [1, 2, 3, 4], kind="call")
+    G.add_edge(1, 4, kind="reference")  # cost 2
+    graph = PathGraph.from_networkx(G)
+    assert graph.k_shortest(1, 4, 3) == [[1, 4], [1, 2, 3, 4]]
+    assert graph.k_shortest(1, 4, 3, cutoff=2.5) == [[1, 4]]
+    assert graph.k_shortest(1, 4, 3, cutoff=1.5) == []
+
+
+def test_undirected_fallback():
+    G = nx.DiGraph()
+    G.add_edge(1, 2, kind="call")
+    G.add_edge(3, 2, kind="call")
+    G.add_node(9)
+    assert find_k_paths(G, 1, 3) == [[1, 2, 3]]
+    assert find_k_paths(G, 1, 9) == []
+    assert find_k_paths(G, 1, 99) == []
+
+
+def test_from_db_collapses_parallel_edges(tmp_path):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    ensure_schema(conn)
+    conn.execute("INSERT INTO files (id, path) VALUES (1, 'a.py')")
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind) VALUES (?, 1, ?, 'function')",
+        [(1, "a"), (2, "b"), (3, "c")],
+    )
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind) VALUES (?, ?, ?)",
+        [(1, 2, "import"), (1, 2, "call"), (2, 3, "call")],
+    )
+    graph = PathGraph.from_db(conn)
+    assert graph.edge_kind(1, 2) == "call"
+    assert graph.degree(2) == 2
+    assert find_k_paths(graph, 1, 3, k=2) == [[1, 2, 3]]
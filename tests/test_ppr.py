@@ -0,0 +1,82 @@
+"""Tests for local personalized PageRank (roam.graph.ppr)."""
+
+from __future__ import annotations
+
+import random
+import sqlite3
+
+import networkx as nx
+import pytest
+from networkx.algorithms.link_analysis.pagerank_alg import _pagerank_python
+
+from roam.graph.ppr import EdgeAdjacency, graph_adjacency, personalized_pagerank
+
+
+def _random_graph(n=300, m=1200, seed=7):
+    rng = random.Random(seed)
+    G = nx.DiGraph()
+    G.add_nodes_from(range(n))
+    while G.number_of_edges() < m:
+        u, v = rng.randrange(n), rng.randrange(n)
+        if u != v:
+            G.add_edge(u, v)
+    return G
+
+
+def _edges_db(G):
+    conn = sqlite3.connect(":memory:")
+    conn.execute("CREATE TABLE edges (source_id INTEGER, target_id INTEGER, kind TEXT)")
+    # Duplicate edges of different kinds must count once
+    conn.executemany("INSERT INTO edges VALUES (?, ?, 'call')", list(G.edges()))
+    conn.executemany("INSERT INTO edges VALUES (?, ?, 'reference')", list(G.edges())[:50])
+    return conn
+
+
+def test_matches_networkx_pagerank():
+    G = _random_graph()
+    exact = _pagerank_python(G, alpha=0.85, personalization={0: 1}, tol=1e-12, max_iter=1000)
+    approx = personalized_pagerank(graph_adjacency(G), [0], tolerance=1e-6)
+    assert max(abs(exact[n] - approx.get(n, 0.0)) for n in G) < 1e-3
+    top = sorted(exact, key=exact.get, reverse=True)[:10]
+    assert sorted(approx, key=approx.get, reverse=True)[:10] == top
+
+
+def test_coarse_tolerance_stays_local():
+    G = _random_graph(n=3000, m=6000)
+    approx = personalized_pagerank(graph_adjacency(G), [0], tolerance=1e-3)
+    assert 0 < len(approx) < G.number_of_nodes() // 2
+
+
+def test_edge_adjacency_matches_graph():
+    G = _random_graph(n=60, m=200)
+    conn = _edges_db(G)
+    callers, callees = EdgeAdjacency(conn, "in"), EdgeAdjacency(conn, "out")
+    callers.prefetch(range(60))
+    for n in G:
+        assert callers(n) == tuple(sorted(G.predecessors(n)))
+        assert callees(n) == tuple(sorted(G.successors(n)))
+    from_db = personalized_pagerank(callers, [3])
+    from_graph = personalized_pagerank(graph_adjacency(G, reverse=True), [3])
+    assert from_db == pytest.approx(from_graph)
+
+
+def test_dangling_mass_returns_to_seed():
+    G = nx.DiGraph([(1, 2)])
+    scores = personalized_pagerank(graph_adjacency(G), [1], tolerance=1e-9)
+    exact = _pagerank_python(G, personalization={1: 1}, tol=1e-12, max_iter=1000)
+    assert scores[1] == pytest.approx(exact[1], abs=1e-6)
+    assert scores[2] == pytest.approx(exact[2], abs=1e-6)
+    assert sum(scores.values()) == pytest.approx(1.0, abs=1e-6)
+
+
+def test_weighted_seeds():
+    G = nx.DiGraph([(1, 3), (2, 4)])
+    scores = personalized_pagerank(graph_adjacency(G), {1: 3, 2: 1, 5: 0}, tolerance=1e-9)
+    assert 5 not in scores
+    assert scores[3] == pytest.approx(3 * scores[4])
+    assert personalized_pagerank(graph_adjacency(G), {}) == {}
+
+
+def test_bad_direction():
+    with pytest.raises(ValueError):
+        EdgeAdjacency(sqlite3.connect(":memory:"), "both")
@@ -0,0 +1,143 @@
+"""Tests for batched, multi-hop path_match evaluation (roam.rules.path_match)."""
+
+from __future__ import annotations
+
+import sqlite3
+
+from roam.db.connection import ensure_schema
+from roam.rules.engine import _matches_glob, evaluate_all, evaluate_rule
+from roam.rules.path_match import PathIndex, compile_glob, evaluate_path_rules
+
+# ctrl.handle -> svc.process -> repo.fetch -> db.query ; ctrl.handle -> db.raw
+_FILES = {1: "app/controllers/ctrl.py", 2: "app/services/svc.py", 3: "app/repo/repo.py", 4: "app/db/db.py"}
+_SYMBOLS = [
+    (1, 1, "handle", "function"),
+    (2, 2, "process", "function"),
+    (3, 3, "fetch", "function"),
+    (4, 4, "query", "function"),
+    (5, 4, "raw", "function"),
+    (6, 1, "health_check", "function"),
+    (7, 4, "Row", "class"),
+]
+_EDGES = [(1, 2), (2, 3), (3, 4), (1, 5), (1, 5), (6, 3), (3, 7)]
+
+
+def _make_db(tmp_path):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    conn.row_factory = sqlite3.Row
+    ensure_schema(conn)
+    conn.executemany("INSERT INTO files (id, path) VALUES (?, ?)", list(_FILES.items()))
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind, line_start) VALUES (?, ?, ?, ?, ?)",
+        [(sid, fid, name, kind, sid * 10) for sid, fid, name, kind in _SYMBOLS],
+    )
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind, source_file_id) VALUES (?, ?, 'calls', 1)",
+        _EDGES,
+    )
+    conn.commit()
+    return conn
+
+
+def _rule(name="ctrl-db", max_distance=1, exempt=None, to_kind=None):
+    to_spec = {"file_glob": "**/db/**"}
+    if to_kind:
+        to_spec["kind"] = to_kind
+    rule = {
+        "name": name,
+        "severity": "error",
+        "match": {"from": {"file_glob": "**/controllers/**"}, "to": to_spec, "max_distance": max_distance},
+    }
+    if exempt:
+        rule["exempt"] = exempt
+    return rule
+
+
+class TestDirectEdges:
+    def test_one_violation_per_edge_row(self, tmp_path):
+        conn = _make_db(tmp_path)
+        result = evaluate_rule(_rule(), conn)
+        assert result["passed"] is False
+        assert [v["reason"] for v in result["violations"]] == [
+            "handle (app/controllers/ctrl.py) -> raw (app/db/db.py)",
+        ] * 2
+        assert result["violations"][0]["line"] == 10
+
+    def test_zero_distance_disables_rule(self, tmp_path):
+        conn = _make_db(tmp_path)
+        assert evaluate_rule(_rule(max_distance=0), conn)["passed"] is True
+
+
+class TestMultiHop:
+    def test_transitive_paths_within_bound(self, tmp_path):
+        conn = _make_db(tmp_path)
+        result = evaluate_rule(_rule(max_distance=3), conn)
+        hops = sorted((v["symbol"], v["reason"].split(" -> ")[-1], v.get("distance", 1)) for v in result["violations"])
+        assert hops == [
+            ("handle", "Row (app/db/db.py) [3 hops]", 3),
+            ("handle", "query (app/db/db.py) [3 hops]", 3),
+            ("handle", "raw (app/db/db.py)", 1),
+            ("handle", "raw (app/db/db.py)", 1),
+            ("health_check", "Row (app/db/db.py) [2 hops]", 2),
+            ("health_check", "query (app/db/db.py) [2 hops]", 2),
+        ]
+
+    def test_bound_cuts_longer_paths(self, tmp_path):
+        conn = _make_db(tmp_path)
+        result = evaluate_rule(_rule(max_distance=2), conn)
+        assert {v.get("distance", 1) for v in result["violations"]} == {1, 2}
+        assert all(v["symbol"] == "health_check" for v in result["violations"] if v.get("distance"))
+
+    def test_exemptions_and_kinds_apply_to_endpoints(self, tmp_path):
+        conn = _make_db(tmp_path)
+        rule = _rule(max_distance=3, exempt={"symbols": ["health_check"]}, to_kind=["function"])
+        result = evaluate_rule(rule, conn)
+        targets = sorted(v["reason"].split(" -> ")[-1] for v in result["violations"])
+        assert targets == ["query (app/db/db.py) [3 hops]", "raw (app/db/db.py)", "raw (app/db/db.py)"]
+
+        exempt_files = _rule(max_distance=3, exempt={"files": ["**/controllers/**"]})
+        assert evaluate_rule(exempt_files, conn)["passed"] is True
+
+
+class TestBatch:
+    def test_batch_matches_single_rule_results(self, tmp_path):
+        conn = _make_db(tmp_path)
+        rules = [
+            _rule("a"),
+            _rule("b", max_distance=3),
+            _rule("c", max_distance=2, exempt={"symbols": "handle"}),
+            {"name": "d", "match": {"from": {"file_glob": "**/repo/**"}, "to": {"kind": "class"}}},
+        ]
+        batch = evaluate_path_rules(rules, PathIndex(conn))
+        assert batch == [evaluate_rule(r, conn) for r in rules]
+        assert [r["passed"] for r in batch] == [False, False, False, False]
+
+    def test_evaluate_all_keeps_rule_order(self, tmp_path):
+        conn = _make_db(tmp_path)
+        rules_dir = tmp_path / "rules"
+        rules_dir.mkdir()
+        (rules_dir / "a_path.yaml").write_text(
+            'name: "path"\nmatch:\n  from:\n    file_glob: "**/controllers/**"\n'
+            '  to:\n    file_glob: "**/db/**"\n  max_distance: 3\n'
+        )
+        (rules_dir / "b_symbol.yaml").write_text('name: "symbols"\nmatch:\n  kind: [class]\n')
+        results = evaluate_all(rules_dir, conn)
+        assert [r["name"] for r in results] == ["path", "symbols"]
+        assert len(results[0]["violations"]) == 6
+
+
+class TestGlobs:
+    def test_compiled_glob_matches_legacy_semantics(self):
+        cases = [
+            ("src/a/b.py", "**/b.py", True),
+            ("b.py", "**/b.py", True),
+            ("src/a/b.py", "src/*.py", True),  # plain fnmatch: * crosses /
+            ("src/a/b.py", "src/*/b.py", True),
+            ("src/a/c/b.py", "src/**/*.py", True),
+            ("src/a/c/b.py", "src/*/b.py", True),
+            ("lib/a.py", "src/**", False),
+            ("src\\win\\x.py", "src/**/x.py", True),
+        ]
+        for path, pattern, expected in cases:
+            assert compile_glob(pattern)(path) is expected, (path, pattern)
+            assert _matches_glob(path, pattern) is expected
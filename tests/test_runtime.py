@@ -519,3 +519,49 @@ class TestCliSecurityHotspots:
         )
         assert result.exit_code != 0
         assert "Cannot combine --security with --runtime or --discrepancy" in result.output
+
+
+class TestSecuritySinkScan:
+    def _per_line(self, text, language):
+        from roam.commands.cmd_hotspots import _SECURITY_SINKS, _is_comment_line
+
+        out = []
+        for i, line in enumerate(text.split("\n"), start=1):
+            if _is_comment_line(line, language):
+                continue
+            for sink in _SECURITY_SINKS:
+                if language in sink["languages"] and sink["regex"].search(line):
+                    out.append((i, sink["id"]))
+        return out
+
+    def test_combined_scan_matches_per_line_scan(self):
+        import random
+
+        from roam.commands.cmd_hotspots import _sink_hits_in_text
+
+        fragments = [
+            "x = eval(data)",
+            "os.system(cmd)",
+            "subprocess.Popen(args)",
+            "cur.execute(q); pickle.loads(b)",
+            "# eval(not_code)",
+            "yaml.load(f)",
+            "eval",
+            "(x)",
+            "el.innerHTML = html",
+            "child_process.exec(c)",
+            "",
+            "plain = 1",
+        ]
+        rnd = random.Random(11)
+        for language in ("python", "javascript", "ruby"):
+            for _ in range(30):
+                text = "\n".join(rnd.choice(fragments) for _ in range(rnd.randint(1, 25)))
+                starts = [0] + [i + 1 for i, ch in enumerate(text) if ch == "\n"]
+                got = [(i, sink["id"]) for i, _, sink in _sink_hits_in_text(text, starts, language)]
+                assert got == self._per_line(text, language)
+
+    def test_unknown_language_yields_nothing(self):
+        from roam.commands.cmd_hotspots import _sink_hits_in_text
+
+        assert list(_sink_hits_in_text("eval(x)", [0], "cobol")) == []
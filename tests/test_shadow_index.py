@@ -0,0 +1,149 @@
+"""Tests for shadow-database builds (roam.db.shadow)."""
+
+from __future__ import annotations
+
+import sqlite3
+
+from roam.db.connection import ensure_schema, get_connection
+from roam.db.shadow import current_generation, discard_shadow, publish_shadow, seed_shadow, shadow_path
+
+
+def _make_live(path, n_files=3):
+    conn = get_connection(path)
+    ensure_schema(conn)
+    conn.executemany("INSERT INTO files (path) VALUES (?)", [(f"f{i}.py",) for i in range(n_files)])
+    conn.commit()
+    conn.close()
+
+
+def _count_files(path):
+    conn = sqlite3.connect(str(path))
+    try:
+        return conn.execute("SELECT COUNT(*) FROM files").fetchone()[0]
+    finally:
+        conn.close()
+
+
+class TestSeedShadow:
+    def test_copies_live_snapshot(self, tmp_path):
+        live = tmp_path / "index.db"
+        _make_live(live)
+        shadow = seed_shadow(live)
+        assert shadow == shadow_path(live)
+        assert _count_files(shadow) == 3
+
+    def test_empty_for_rebuild_and_discards_leftovers(self, tmp_path):
+        live = tmp_path / "index.db"
+        _make_live(live)
+        shadow_path(live).write_bytes(b"stale")
+        shadow = seed_shadow(live, empty=True)
+        assert not shadow.exists()
+
+    def test_discard(self, tmp_path):
+        live = tmp_path / "index.db"
+        _make_live(live)
+        seed_shadow(live)
+        discard_shadow(live)
+        assert not shadow_path(live).exists()
+
+
+class TestPublishShadow:
+    def test_first_publish_renames(self, tmp_path):
+        live = tmp_path / "index.db"
+        shadow = seed_shadow(live)
+        _make_live(shadow)
+        assert publish_shadow(shadow, live) == 1
+        assert not shadow.exists()
+        assert _count_files(live) == 3
+
+    def test_inflight_reader_keeps_old_generation(self, tmp_path):
+        live = tmp_path / "index.db"
+        _make_live(live)
+        shadow = seed_shadow(live)
+        conn = get_connection(shadow)
+        conn.execute("INSERT INTO files (path) VALUES ('new.py')")
+        conn.commit()
+        conn.close()
+
+        reader = get_connection(live, readonly=True)
+        reader.execute("BEGIN")
+        assert reader.execute("SELECT COUNT(*) FROM files").fetchone()[0] == 3
+
+        generation = publish_shadow(shadow, live)
+        assert generation == 1
+        # The open read transaction still sees the previous generation
+        assert reader.execute("SELECT COUNT(*) FROM files").fetchone()[0] == 3
+        assert current_generation(reader) == 0
+        reader.execute("COMMIT")
+        assert reader.execute("SELECT COUNT(*) FROM files").fetchone()[0] == 4
+        assert current_generation(reader) == 1
+        reader.close()
+
+    def test_generation_increments(self, tmp_path):
+        live = tmp_path / "index.db"
+        _make_live(live)
+        for expected in (1, 2, 3):
+            assert publish_shadow(seed_shadow(live), live) == expected
+        assert _count_files(live) == 3
+
+    def test_keeps_rows_written_during_build(self, tmp_path):
+        live = tmp_path / "index.db"
+        _make_live(live)
+        conn = get_connection(live)
+        conn.execute(
+            "INSERT INTO symbols (id, file_id, name, qualified_name, kind) VALUES (7, 1, 'a', 'm.a', 'function')"
+        )
+        conn.commit()
+        conn.close()
+        shadow = seed_shadow(live)
+        # The build renumbers the symbol while a user annotates it on the live DB
+        conn = get_connection(shadow)
+        conn.execute("DELETE FROM symbols")
+        conn.execute(
+            "INSERT INTO symbols (id, file_id, name, qualified_name, kind) VALUES (9, 1, 'a', 'm.a', 'function')"
+        )
+        conn.commit()
+        conn.close()
+        conn = get_connection(live)
+        conn.execute("INSERT INTO annotations (symbol_id, qualified_name, content) VALUES (7, 'm.a', 'keep me')")
+        conn.execute("INSERT INTO snapshots (timestamp, source) VALUES (1, 'snapshot')")
+        conn.execute("INSERT INTO runtime_stats (symbol_id, symbol_name, file_path) VALUES (7, 'a', 'f0.py')")
+        conn.commit()
+        conn.close()
+
+        publish_shadow(shadow, live)
+        conn = sqlite3.connect(str(live))
+        try:
+            assert conn.execute("SELECT symbol_id, content FROM annotations").fetchall() == [(9, "keep me")]
+            assert conn.execute("SELECT COUNT(*) FROM snapshots").fetchone()[0] == 1
+            assert conn.execute("SELECT symbol_id FROM runtime_stats").fetchall() == [(9,)]
+        finally:
+            conn.close()
+
+
+class TestIndexerShadow:
+    def test_force_run_publishes_generation(self, tmp_path, monkeypatch):
+        from roam.index.indexer import Indexer
+
+        monkeypatch.delenv("ROAM_DB_DIR", raising=False)
+        (tmp_path / "a.py").write_text("def a():\n    return 1\n")
+        (tmp_path / "b.py").write_text("def b():\n    return 2\n")
+        indexer = Indexer(project_root=tmp_path)
+        indexer.run(force=True, quiet=True)
+        assert indexer.summary["generation"] == 1
+        indexer.run(force=True, quiet=True)
+        assert indexer.summary["generation"] == 2
+
+        live = tmp_path / ".roam" / "index.db"
+        assert not shadow_path(live).exists()
+        assert _count_files(live) == 2
+
+    def test_in_place_run_skips_shadow(self, tmp_path, monkeypatch):
+        from roam.index.indexer import Indexer
+
+        monkeypatch.delenv("ROAM_DB_DIR", raising=False)
+        (tmp_path / "a.py").write_text("def a():\n    return 1\n")
+        indexer = Indexer(project_root=tmp_path)
+        indexer.run(force=True, quiet=True, shadow=False)
+        assert "generation" not in indexer.summary
+        assert _count_files(tmp_path / ".roam" / "index.db") == 1
@@ -13,6 +13,7 @@ from click.testing import CliRunner
 
 from roam.catalog.smells import (
     ALL_DETECTORS,
+    SmellScan,
     _parse_param_count,
     detect_brain_method,
     detect_data_clumps,
@@ -605,6 +606,62 @@ class TestRunAllDetectors:
             assert required.issubset(set(r.keys())), f"Missing fields: {required - set(r.keys())}"
         conn.close()
 
+    def test_meta_reports_timings(self, tmp_path):
+        conn = _make_db(tmp_path)
+        _populate_brain_method(conn)
+        results, meta = run_all_detectors(conn, return_meta=True)
+        assert "brain-method" in {r["smell_id"] for r in results}
+        assert meta["detectors_failed"] == 0
+        assert set(meta["detector_timings_ms"]) == {smell_id for smell_id, _ in ALL_DETECTORS}
+        conn.close()
+
+    def test_missing_tables_only_skip_dependent_detectors(self, tmp_path):
+        conn = _make_db(tmp_path)
+        _populate_brain_method(conn)
+        conn.execute("DROP TABLE edges")
+        conn.execute("DROP TABLE graph_metrics")
+        conn.commit()
+        results, meta = run_all_detectors(conn, return_meta=True)
+        assert "brain-method" in {r["smell_id"] for r in results}
+        assert "feature-envy" in meta["failed_detectors"]
+        conn.close()
+
+    def test_class_membership_and_cohesion_batched(self, tmp_path):
+        conn = _make_db(tmp_path)
+        conn.execute("INSERT INTO files (id, path) VALUES (1, 'src/a.py')")
+        conn.execute("INSERT INTO files (id, path) VALUES (2, 'src/b.py')")
+        conn.execute(
+            "INSERT INTO symbols (id, file_id, name, kind, line_start, line_end) VALUES (1, 1, 'Loose', 'class', 1, 100)"
+        )
+        conn.execute(
+            "INSERT INTO symbols (id, file_id, name, kind, line_start, line_end) VALUES (2, 1, 'Tight', 'class', 200, 300)"
+        )
+        for i in range(6):
+            conn.execute(
+                "INSERT INTO symbols (id, file_id, name, kind, line_start, line_end) VALUES (?, 1, ?, 'method', ?, ?)",
+                (10 + i, f"loose_{i}", 2 + i * 10, 8 + i * 10),
+            )
+            conn.execute(
+                "INSERT INTO symbols (id, file_id, name, kind, line_start, line_end) VALUES (?, 1, ?, 'method', ?, ?)",
+                (20 + i, f"tight_{i}", 202 + i * 10, 208 + i * 10),
+            )
+        # Same line range in another file must not count towards either class
+        conn.execute(
+            "INSERT INTO symbols (id, file_id, name, kind, line_start, line_end) VALUES (30, 2, 'other', 'method', 3, 5)"
+        )
+        for i in range(5):
+            conn.execute("INSERT INTO edges (source_id, target_id) VALUES (?, ?)", (20 + i, 21 + i))
+        conn.execute("INSERT INTO edges (source_id, target_id) VALUES (10, 20)")
+        conn.commit()
+        scan = SmellScan(conn)
+        classes = {c["name"]: c for c in scan.classes()}
+        assert scan.class_methods(classes["Loose"]) == [10, 11, 12, 13, 14, 15]
+        assert scan.internal_edges(classes["Loose"]) == 0
+        assert scan.internal_edges(classes["Tight"]) == 5
+        results = detect_low_cohesion(conn, scan)
+        assert [r["symbol_name"] for r in results] == ["Loose"]
+        conn.close()
+
 
 # ---------------------------------------------------------------------------
 # Tests: file_health_scores
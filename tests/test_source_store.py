@@ -0,0 +1,150 @@
+"""Tests for indexed source snapshots (roam.db.source_store)."""
+
+from __future__ import annotations
+
+import hashlib
+import sqlite3
+
+from roam.db.connection import ensure_schema
+from roam.db.source_store import MAX_SOURCE_BYTES, SKIPPED_CODEC, SourceStore, prune_sources, store_source
+
+
+def _make_db(tmp_path):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    conn.row_factory = sqlite3.Row
+    ensure_schema(conn)
+    return conn
+
+
+def _add_file(conn, path: str, data: bytes) -> str:
+    h = hashlib.sha256(data).hexdigest()
+    conn.execute("INSERT INTO files (path, language, hash) VALUES (?, 'python', ?)", (path, h))
+    store_source(conn, h, data)
+    return h
+
+
+class TestStoreSource:
+    def test_dedup_by_hash(self, tmp_path):
+        conn = _make_db(tmp_path)
+        data = b"def a():\n    return 1\n"
+        _add_file(conn, "a.py", data)
+        _add_file(conn, "copy/a.py", data)
+        assert conn.execute("SELECT COUNT(*) FROM file_sources").fetchone()[0] == 1
+        row = conn.execute("SELECT line_count, size FROM file_sources").fetchone()
+        assert row["line_count"] == 2
+        assert row["size"] == len(data)
+
+    def test_oversized_files_not_stored(self, tmp_path):
+        conn = _make_db(tmp_path)
+        assert store_source(conn, "deadbeef", b"x" * (MAX_SOURCE_BYTES + 1)) is False
+        # Only a content-less marker row, which readers treat as missing
+        rows = conn.execute("SELECT codec, size, data FROM file_sources").fetchall()
+        assert [tuple(r) for r in rows] == [(SKIPPED_CODEC, MAX_SOURCE_BYTES + 1, b"")]
+
+    def test_backfill_skips_oversized_files_once(self, tmp_path, monkeypatch):
+        import roam.db.source_store as store_mod
+        from roam.index.indexer import Indexer
+
+        monkeypatch.setattr(store_mod, "MAX_SOURCE_BYTES", 16)
+        (tmp_path / "big.prg").write_text("FUNCTION Big\n  RETURN 1\nENDFUNC\n")
+        Indexer(tmp_path).run(quiet=True, progress_bar=False)
+        conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+        conn.row_factory = sqlite3.Row
+        indexer = Indexer(tmp_path)
+        reads = []
+        monkeypatch.setattr(type(tmp_path), "read_bytes", lambda self: reads.append(self) or b"")
+        indexer._sync_source_snapshots(conn)
+        assert reads == []
+        assert SourceStore(conn, tmp_path)._load_indexed("big.prg") is None
+
+    def test_prune_removes_unreferenced(self, tmp_path):
+        conn = _make_db(tmp_path)
+        _add_file(conn, "a.py", b"a = 1\n")
+        store_source(conn, "orphan", b"b = 2\n")
+        assert prune_sources(conn) == 1
+        assert conn.execute("SELECT COUNT(*) FROM file_sources").fetchone()[0] == 1
+
+
+class TestSourceStore:
+    def test_line_and_span_access(self, tmp_path):
+        conn = _make_db(tmp_path)
+        _add_file(conn, "src/m.py", b"one\r\ntwo\rthree\nfour")
+        store = SourceStore(conn, tmp_path)
+        assert store.text("src/m.py") == "one\ntwo\nthree\nfour"
+        assert store.lines("src/m.py") == ["one", "two", "three", "four"]
+        assert store.line_count("src/m.py") == 4
+        assert store.line("src/m.py", 1) == "one"
+        assert store.line("src/m.py", 4) == "four"
+        assert store.line("src/m.py", 5) is None
+        assert store.span("src/m.py", 2, 3) == "two\nthree"
+        assert store.span("src/m.py", 0, 99) == "one\ntwo\nthree\nfour"
+        assert store.line_of("src/m.py", store.text("src/m.py").index("three")) == 3
+
+    def test_lines_agree_with_offsets_on_unicode_breaks(self, tmp_path):
+        conn = _make_db(tmp_path)
+        _add_file(conn, "src/u.py", "a = 1  # \u2028 sep\nb = '\x0c'\nc = 3\n".encode())
+        store = SourceStore(conn, tmp_path)
+        lines = store.lines("src/u.py")
+        assert len(lines) == store.line_count("src/u.py") == 3
+        assert [store.line("src/u.py", i) for i in (1, 2, 3)] == lines
+        assert lines[2] == "c = 3"
+
+    def test_reads_indexed_snapshot_not_working_tree(self, tmp_path):
+        conn = _make_db(tmp_path)
+        (tmp_path / "a.py").write_text("edited after indexing\n")
+        _add_file(conn, "a.py", b"indexed = True\n")
+        store = SourceStore(conn, tmp_path)
+        assert store.lines("a.py") == ["indexed = True"]
+        assert store.hits == 1 and store.disk_reads == 0
+
+    def test_falls_back_to_disk(self, tmp_path):
+        (tmp_path / "b.py").write_text("x = 1\ny = 2\n")
+        store = SourceStore(None, tmp_path)
+        assert store.line("b.py", 2) == "y = 2"
+        assert store.text("missing.py") is None
+        assert store.disk_reads == 1
+
+    def test_index_without_table_uses_disk(self, tmp_path):
+        conn = sqlite3.connect(str(tmp_path / "old.db"))
+        conn.execute("CREATE TABLE files (id INTEGER PRIMARY KEY, path TEXT, hash TEXT)")
+        (tmp_path / "c.py").write_text("z = 3\n")
+        store = SourceStore(conn, tmp_path)
+        assert store.lines("c.py") == ["z = 3"]
+
+    def test_lru_bounded(self, tmp_path):
+        conn = _make_db(tmp_path)
+        for i in range(5):
+            _add_file(conn, f"f{i}.py", f"v = {i}\n".encode())
+        store = SourceStore(conn, tmp_path, cache_size=2)
+        for i in range(5):
+            assert store.line(f"f{i}.py", 1) == f"v = {i}"
+        assert len(store._cache) == 2
+
+
+class TestAnalyzersUseSnapshots:
+    def test_migration_indexes_from_snapshot(self, tmp_path):
+        from roam.commands.cmd_missing_index import _parse_migration_indexes
+
+        conn = _make_db(tmp_path)
+        _add_file(
+            conn,
+            "migrations/001.php",
+            b"<?php\nSchema::create('orders', function($table) {\n    $table->string('user_id')->index();\n});\n",
+        )
+        # Not present on disk: only the indexed snapshot can satisfy the read
+        result = _parse_migration_indexes(tmp_path, ["migrations/001.php"], SourceStore(conn, tmp_path))
+        assert ("user_id",) in result["orders"]
+
+    def test_frontend_scan_reads_each_file_once(self, tmp_path):
+        from roam.workspace.api_scanner import _cached_scan, _iter_url_lines
+
+        conn = _make_db(tmp_path)
+        _add_file(conn, "api.js", b"api.get('/users/list')\napi.post('/users/save', data)\n")
+        store = SourceStore(conn, tmp_path)
+        hits = _cached_scan(None, "api_calls", None, store, "api.js", _iter_url_lines)
+        # One pass yields both the first URL on a line and the api.<verb> call
+        assert [(h[0], h[1], h[3], h[4]) for h in hits] == [
+            (1, "/users/list", "GET", "/users/list"),
+            (2, "/users/save", "POST", "/users/save"),
+        ]
+        assert store.hits == 1
@@ -0,0 +1,98 @@
+"""Tests for stable symbol identities (roam.index.symbol_keys)."""
+
+from __future__ import annotations
+
+import sqlite3
+
+from roam.index.indexer import Indexer
+from roam.index.symbol_keys import assign_symbol_keys, symbol_key
+
+SOURCE = """\
+FUNCTION Alpha
+  RETURN 1
+ENDFUNC
+
+FUNCTION Beta
+  RETURN Alpha()
+ENDFUNC
+
+PROCEDURE Gamma
+  x = Beta()
+ENDPROC
+"""
+
+
+def _sym(name, kind, start, end, qualified_name=None):
+    return {"name": name, "qualified_name": qualified_name, "kind": kind, "line_start": start, "line_end": end}
+
+
+def test_keys_use_ordinals_for_duplicates():
+    source = b"def f():\n    pass\n\ndef f():\n    pass\n"
+    syms = [_sym("f", "function", 1, 2), _sym("f", "function", 4, 5), _sym("f", "variable", 4, 4)]
+    assign_symbol_keys("a.py", syms, source)
+    assert syms[0]["stable_key"] == symbol_key("a.py", "f", "function", 0)
+    assert syms[1]["stable_key"] == symbol_key("a.py", "f", "function", 1)
+    assert syms[2]["stable_key"] == symbol_key("a.py", "f", "variable", 0)
+    assert len({s["stable_key"] for s in syms}) == 3
+    # Same body text at another position hashes the same
+    assert syms[0]["content_hash"] == syms[1]["content_hash"]
+
+    moved = [_sym("f", "function", 3, 4)]
+    assign_symbol_keys("b.py", moved, b"\n\n" + source)
+    assert moved[0]["content_hash"] == syms[0]["content_hash"]
+    assert moved[0]["stable_key"] != syms[0]["stable_key"]
+
+
+def _index(root):
+    Indexer(root).run(quiet=True, progress_bar=False)
+    conn = sqlite3.connect(str(root / ".roam" / "index.db"))
+    conn.row_factory = sqlite3.Row
+    return conn
+
+
+def _ids(conn):
+    return {r["name"]: r["id"] for r in conn.execute("SELECT id, name FROM symbols")}
+
+
+def test_reindex_keeps_ids_and_unchanged_derived_rows(tmp_path):
+    (tmp_path / "main.prg").write_text(SOURCE)
+    conn = _index(tmp_path)
+    before = _ids(conn)
+    assert set(before) == {"Alpha", "Beta", "Gamma"}
+
+    # Per-symbol rows no indexer phase rewrites here: embeddings (ONNX is
+    # not configured) and links from annotations / runtime stats
+    conn.executemany(
+        "INSERT INTO symbol_embeddings (symbol_id, vector, dims, model_id) VALUES (?, '[1]', 1, 'm')",
+        [(before["Alpha"],), (before["Beta"],)],
+    )
+    conn.execute(
+        "INSERT INTO annotations (symbol_id, qualified_name, content) VALUES (?, 'Beta', 'note')",
+        (before["Beta"],),
+    )
+    conn.execute("INSERT INTO runtime_stats (symbol_id, symbol_name) VALUES (?, 'Beta')", (before["Beta"],))
+    conn.commit()
+    conn.close()
+
+    # Shift everything down two lines and change Beta's body
+    (tmp_path / "main.prg").write_text("* header\n\n" + SOURCE.replace("RETURN Alpha()", "RETURN Alpha() + 1"))
+    conn = _index(tmp_path)
+    after = _ids(conn)
+    assert after == before
+
+    embedded = {r[0] for r in conn.execute("SELECT symbol_id FROM symbol_embeddings")}
+    assert embedded == {before["Alpha"]}
+    assert conn.execute("SELECT symbol_id FROM annotations").fetchone()[0] == before["Beta"]
+    assert conn.execute("SELECT symbol_id FROM runtime_stats").fetchone()[0] == before["Beta"]
+    assert conn.execute("SELECT line_start FROM symbols WHERE name = 'Alpha'").fetchone()[0] == 3
+
+
+def test_renamed_symbol_gets_new_id(tmp_path):
+    (tmp_path / "main.prg").write_text(SOURCE)
+    before = _ids(_index(tmp_path))
+
+    (tmp_path / "main.prg").write_text(SOURCE.replace("Gamma", "Delta"))
+    after = _ids(_index(tmp_path))
+    assert after["Alpha"] == before["Alpha"] and after["Beta"] == before["Beta"]
+    assert "Gamma" not in after
+    assert after["Delta"] > max(before.values())
@@ -0,0 +1,203 @@
+"""Tests for stored test reachability (roam.graph.test_reach)."""
+
+from __future__ import annotations
+
+import sqlite3
+
+from roam.commands.cmd_test_gaps import _find_test_coverage
+from roam.commands.context_helpers import get_affected_tests_bfs
+from roam.db.connection import ensure_schema
+from roam.graph.test_reach import (
+    TEST_REACH_MAX_FILES,
+    directly_tested_ids,
+    has_test_reach,
+    load_test_files,
+    store_test_reach,
+)
+from roam.index.incremental import mark_dirty
+from roam.rules.engine import evaluate_rule
+
+
+def _make_db(tmp_path):
+    conn = sqlite3.connect(str(tmp_path / "index.db"))
+    conn.row_factory = sqlite3.Row
+    ensure_schema(conn)
+    conn.executemany(
+        "INSERT INTO files (id, path) VALUES (?, ?)",
+        [(1, "src/app.py"), (2, "tests/test_app.py"), (3, "tests/test_api.py")],
+    )
+    # test_run -> run -> parse -> decode ; test_api -> parse ; orphan untested
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind, line_start, is_exported) VALUES (?, ?, ?, 'function', ?, 1)",
+        [
+            (1, 1, "run", 1),
+            (2, 1, "parse", 5),
+            (3, 1, "decode", 9),
+            (4, 1, "orphan", 13),
+            (10, 2, "test_run", 1),
+            (11, 3, "test_api", 1),
+        ],
+    )
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind) VALUES (?, ?, 'call')",
+        [(10, 1), (1, 2), (2, 3), (11, 2), (11, 2), (3, 3)],
+    )
+    return conn
+
+
+def test_store_rows(tmp_path):
+    conn = _make_db(tmp_path)
+    assert not has_test_reach(conn)
+    assert store_test_reach(conn) == 5
+    rows = {
+        (r[0], r[1]): (r[2], r[3], r[4])
+        for r in conn.execute("SELECT symbol_id, test_file_id, hops, test_id, via_id FROM test_reach")
+    }
+    assert rows == {
+        (1, 2): (1, 10, None),
+        (2, 2): (2, 10, 1),
+        (3, 2): (3, 10, 2),
+        (2, 3): (1, 11, None),
+        (3, 3): (2, 11, 2),
+    }
+    assert has_test_reach(conn)
+
+
+def test_max_hops_bounds_rows(tmp_path):
+    conn = _make_db(tmp_path)
+    assert store_test_reach(conn, max_hops=1) == 2
+    assert directly_tested_ids(conn) == {1, 2}
+
+
+def test_one_row_per_test_file(tmp_path):
+    conn = _make_db(tmp_path)
+    # Many tests in one file reaching the same helper: one row, nearest test first
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind, line_start, is_exported) VALUES (?, 3, ?, 'function', ?, 1)",
+        [(20 + i, f"test_case_{i}", 10 + i) for i in range(50)],
+    )
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind) VALUES (?, 1, 'call')", [(20 + i,) for i in range(50)]
+    )
+    store_test_reach(conn)
+    rows = conn.execute("SELECT test_file_id, hops, test_id FROM test_reach WHERE symbol_id = 1 ORDER BY 1").fetchall()
+    assert [tuple(r) for r in rows] == [(2, 1, 10), (3, 1, 20)]
+    # parse is called directly by test_api and via run from test_case_*
+    row = conn.execute("SELECT hops, test_id FROM test_reach WHERE symbol_id = 2 AND test_file_id = 3").fetchone()
+    assert tuple(row) == (1, 11)
+
+
+def test_has_test_fallback_uses_shared_classifier(tmp_path):
+    conn = _make_db(tmp_path)
+    # "contest" contains "test" but is not a test file
+    conn.execute("INSERT INTO files (id, path) VALUES (4, 'src/contest.py')")
+    conn.execute(
+        "INSERT INTO symbols (id, file_id, name, kind, line_start, is_exported) VALUES (30, 4, 'judge', 'function', 1, 1)"
+    )
+    conn.execute("INSERT INTO edges (source_id, target_id, kind) VALUES (30, 4, 'call')")
+    rule = {
+        "name": "needs tests",
+        "match": {"kind": ["function"], "file_glob": "src/app.py", "require": {"has_test": True}},
+    }
+    walked = evaluate_rule(rule, conn)
+    store_test_reach(conn)
+    assert evaluate_rule(rule, conn) == walked
+    assert sorted(v["symbol"] for v in walked["violations"]) == ["decode", "orphan"]
+
+
+def test_only_test_functions_seed(tmp_path):
+    conn = _make_db(tmp_path)
+    # A fixture and a constant in a test file do not make their callees tested
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind, line_start, is_exported) VALUES (?, 2, ?, ?, ?, 1)",
+        [(40, "db_fixture", "function", 20), (41, "CONFIG", "constant", 30)],
+    )
+    conn.executemany("INSERT INTO edges (source_id, target_id, kind) VALUES (?, 4, 'call')", [(40,), (41,)])
+    store_test_reach(conn)
+    assert conn.execute("SELECT COUNT(*) FROM test_reach WHERE symbol_id = 4").fetchone()[0] == 0
+    assert 4 not in directly_tested_ids(conn)
+
+
+def test_rows_per_symbol_are_capped(tmp_path):
+    conn = _make_db(tmp_path)
+    # More test files than the cap, each calling run directly
+    extra = TEST_REACH_MAX_FILES + 2
+    for i in range(extra):
+        conn.execute("INSERT INTO files (id, path) VALUES (?, ?)", (100 + i, f"tests/test_more_{i}.py"))
+        conn.execute(
+            "INSERT INTO symbols (id, file_id, name, kind, line_start, is_exported) VALUES (?, ?, ?, 'function', 1, 1)",
+            (100 + i, 100 + i, f"test_more_{i}"),
+        )
+        conn.execute("INSERT INTO edges (source_id, target_id, kind) VALUES (?, 1, 'call')", (100 + i,))
+    walked = get_affected_tests_bfs(conn, 3)
+    total = store_test_reach(conn)
+    per_symbol = dict(conn.execute("SELECT symbol_id, COUNT(*) FROM test_reach GROUP BY symbol_id").fetchall())
+    assert max(per_symbol.values()) == TEST_REACH_MAX_FILES
+    assert total <= len(per_symbol) * TEST_REACH_MAX_FILES
+    # The nearest files win: test_api calls parse directly
+    assert conn.execute("SELECT hops FROM test_reach WHERE symbol_id = 2 AND test_file_id = 3").fetchone()[0] == 1
+    # Capped symbols fall back to the walk so no affected test is dropped
+    assert get_affected_tests_bfs(conn, 3) == walked
+    assert len(walked) == extra + 2
+
+
+def test_per_test_table_replaced_on_upgrade(tmp_path):
+    conn = _make_db(tmp_path)
+    conn.execute("DROP TABLE test_reach")
+    conn.execute(
+        "CREATE TABLE test_reach (symbol_id INTEGER NOT NULL, test_id INTEGER NOT NULL, hops INTEGER NOT NULL, "
+        "test_file_id INTEGER NOT NULL, via_id INTEGER, PRIMARY KEY (symbol_id, test_id)) WITHOUT ROWID"
+    )
+    conn.execute("INSERT INTO test_reach VALUES (1, 10, 1, 2, NULL)")
+    ensure_schema(conn)
+    assert not has_test_reach(conn)
+    assert store_test_reach(conn) == 5
+
+
+def test_dirty_phase_disables_table(tmp_path):
+    conn = _make_db(tmp_path)
+    store_test_reach(conn)
+    mark_dirty(conn, ["test_reach"])
+    assert not has_test_reach(conn)
+    assert load_test_files(conn, [3]) is None
+    assert directly_tested_ids(conn) is None
+
+
+def test_affected_tests_match_graph_walk(tmp_path):
+    conn = _make_db(tmp_path)
+    walked = {sid: get_affected_tests_bfs(conn, sid) for sid in (1, 2, 3, 4)}
+    store_test_reach(conn)
+    for sid, expected in walked.items():
+        assert get_affected_tests_bfs(conn, sid) == expected
+    assert get_affected_tests_bfs(conn, 3, max_hops=2) == [
+        {"file": "tests/test_api.py", "symbol": "test_api", "kind": "TRANSITIVE", "hops": 2, "via": "parse"}
+    ]
+
+
+def test_test_gaps_coverage_from_table(tmp_path):
+    conn = _make_db(tmp_path)
+    walked = _find_test_coverage(conn, {1, 2, 3, 4})
+    store_test_reach(conn)
+    stored = _find_test_coverage(conn, {1, 2, 3, 4})
+    assert stored == {
+        1: {"tests/test_app.py"},
+        2: {"tests/test_app.py", "tests/test_api.py"},
+        3: {"tests/test_app.py", "tests/test_api.py"},
+    }
+    # The shared-frontier walk stops at start symbols it already visited,
+    # so it can only under-report
+    for sid, files in walked.items():
+        assert files <= stored[sid]
+
+
+def test_has_test_rule_uses_direct_reach(tmp_path):
+    conn = _make_db(tmp_path)
+    rule = {
+        "name": "needs tests",
+        "match": {"kind": ["function"], "file_glob": "src/**", "require": {"has_test": True}},
+    }
+    walked = evaluate_rule(rule, conn)
+    store_test_reach(conn)
+    stored = evaluate_rule(rule, conn)
+    assert stored == walked
+    assert sorted(v["symbol"] for v in stored["violations"]) == ["decode", "orphan"]
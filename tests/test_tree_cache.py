@@ -0,0 +1,227 @@
+"""Tests for incremental reparsing (roam.index.tree_cache)."""
+
+from __future__ import annotations
+
+import random
+import sqlite3
+
+import pytest
+
+from roam.db.connection import ensure_schema
+from roam.index.complexity import carried_metrics, compute_and_store, snapshot_file_metrics
+from roam.index.indexer import Indexer
+from roam.index.parser import parse_file
+from roam.index.tree_cache import ParseDelta, TreeCache, compute_edit
+
+
+class _FakeRange:
+    def __init__(self, r0, r1):
+        self.start_point = (r0, 0)
+        self.end_point = (r1, 0)
+
+
+class _FakeTree:
+    def __init__(self, source):
+        self.source = source
+        self.edits = []
+
+    def edit(self, **kwargs):
+        self.edits.append(kwargs)
+
+    def changed_ranges(self, other):
+        return [_FakeRange(1, 2)]
+
+
+class _FakeParser:
+    def __init__(self):
+        self.calls = []
+
+    def parse(self, source, old_tree=None):
+        self.calls.append(old_tree)
+        return _FakeTree(source)
+
+
+class TestComputeEdit:
+    def test_identical_is_none(self):
+        assert compute_edit(b"abc", b"abc") is None
+
+    def test_random_edits_roundtrip(self):
+        rnd = random.Random(5)
+        for _ in range(300):
+            old = bytes(rnd.choice(b"ab\n") for _ in range(rnd.randint(0, 60)))
+            i = rnd.randint(0, len(old))
+            j = rnd.randint(i, len(old))
+            new = old[:i] + bytes(rnd.choice(b"ab\n") for _ in range(rnd.randint(0, 8))) + old[j:]
+            edit = compute_edit(old, new)
+            if old == new:
+                assert edit is None
+                continue
+            s, oe, ne = edit["start_byte"], edit["old_end_byte"], edit["new_end_byte"]
+            assert old[:s] == new[:s]
+            assert old[oe:] == new[ne:]
+            assert edit["start_point"][0] == old[:s].count(b"\n")
+            assert edit["new_end_point"][0] == new[:ne].count(b"\n")
+
+    def test_large_common_blocks(self):
+        old = b"x\n" * 10000 + b"old" + b"y\n" * 10000
+        new = b"x\n" * 10000 + b"brand new" + b"y\n" * 10000
+        edit = compute_edit(old, new)
+        assert edit["start_byte"] == 20000
+        assert edit["old_end_byte"] == 20003
+        assert edit["new_end_byte"] == 20009
+        assert edit["start_point"] == (10000, 0)
+
+
+class TestParseDelta:
+    def test_touches_edit_and_changed_rows(self):
+        delta = ParseDelta((4, 5, 7), [(20, 21)])
+        assert delta.touches(5, 5)
+        assert delta.touches(1, 6)
+        assert delta.touches(21, 30)
+        assert not delta.touches(1, 4)
+        assert not delta.touches(9, 19)
+
+    def test_old_line_maps_around_edit(self):
+        delta = ParseDelta((4, 5, 7), [])
+        assert delta.old_line(3) == 3
+        assert delta.old_line(6) is None
+        assert delta.old_line(10) == 8
+        assert delta.row_shift == 2
+
+
+class TestTreeCache:
+    def test_reparses_incrementally(self):
+        cache = TreeCache(measure_full=True)
+        parser = _FakeParser()
+        tree1, delta1 = cache.parse("a.py", b"a\nb\n", "python", parser)
+        assert delta1 is None and parser.calls == [None]
+        tree2, delta2 = cache.parse("a.py", b"a\nbb\nc\n", "python", parser)
+        assert parser.calls[1] is tree1
+        assert tree1.edits[0]["start_byte"] == 3
+        assert delta2.edit_rows == (1, 1, 2)
+        assert delta2.changed_rows == [(1, 2)]
+        assert cache.delta("a.py") is delta2
+        summary = cache.summary()
+        assert summary["full_parses"] == 1
+        assert summary["incremental_parses"] == 1
+        assert "full_equivalent_ms" in summary
+
+    def test_grammar_change_forces_full_parse(self):
+        cache = TreeCache()
+        parser = _FakeParser()
+        cache.parse("a", b"x", "python", parser)
+        _, delta = cache.parse("a", b"y", "javascript", parser)
+        assert delta is None
+        assert parser.calls == [None, None]
+
+    def test_lru_bound(self):
+        cache = TreeCache(max_files=2)
+        parser = _FakeParser()
+        for key in ("a", "b", "c"):
+            cache.parse(key, b"x", "python", parser)
+        assert len(cache) == 2
+        assert "a" not in cache
+        cache.discard("b")
+        assert "b" not in cache
+
+    def test_parse_file_with_real_grammar(self, tmp_path):
+        path = tmp_path / "m.py"
+        path.write_text("def a():\n    return 1\n\n\ndef b():\n    return 2\n")
+        cache = TreeCache()
+        tree, _, _ = parse_file(path, tree_cache=cache)
+        assert tree is not None
+        path.write_text("def a():\n    return 1\n\n\ndef b():\n    x = 3\n    return x\n")
+        tree, source, _ = parse_file(path, tree_cache=cache)
+        delta = cache.delta(str(path))
+        assert cache.incremental_parses == 1
+        assert delta.edit_rows == (5, 5, 6)
+        assert delta.touches(5, 7)
+        assert tree.root_node.text == source
+
+
+class TestCarriedMetrics:
+    def test_untouched_symbols_reuse_stored_metrics(self, tmp_path):
+        conn = sqlite3.connect(str(tmp_path / "index.db"))
+        conn.row_factory = sqlite3.Row
+        ensure_schema(conn)
+        conn.execute("INSERT INTO files (id, path) VALUES (1, 'm.py')")
+        conn.executemany(
+            "INSERT INTO symbols (id, file_id, name, qualified_name, kind, line_start, line_end) "
+            "VALUES (?, 1, ?, ?, 'function', ?, ?)",
+            [(1, "a", "m.a", 1, 3), (2, "b", "m.b", 10, 12)],
+        )
+        conn.executemany(
+            "INSERT INTO symbol_metrics (symbol_id, cognitive_complexity, line_count) VALUES (?, ?, 3)",
+            [(1, 4.0), (2, 7.0)],
+        )
+        conn.execute("INSERT INTO math_signals (symbol_id, loop_depth, calls_in_loops) VALUES (2, 2, '[]')")
+        snapshot = snapshot_file_metrics(conn, 1)
+        assert set(snapshot) == {("m.a", "function", 1, 3), ("m.b", "function", 10, 12)}
+
+        # Reindex: two lines inserted after a(); b() moves down to 12-14
+        for table in ("symbols", "symbol_metrics", "math_signals"):
+            conn.execute(f"DELETE FROM {table}")
+        conn.executemany(
+            "INSERT INTO symbols (id, file_id, name, qualified_name, kind, line_start, line_end) "
+            "VALUES (?, 1, ?, ?, 'function', ?, ?)",
+            [(3, "a", "m.a", 1, 3), (4, "b", "m.b", 12, 14)],
+        )
+        delta = ParseDelta((4, 4, 6), [])
+        reused = compute_and_store(conn, 1, None, b"", reuse=carried_metrics(delta, snapshot))
+        assert reused == 2
+        rows = dict(conn.execute("SELECT symbol_id, cognitive_complexity FROM symbol_metrics").fetchall())
+        assert rows == {3: 4.0, 4: 7.0}
+        math = conn.execute("SELECT symbol_id, loop_depth, calls_in_loops FROM math_signals").fetchall()
+        assert [tuple(r) for r in math] == [(4, 2, "[]")]
+
+
+class TestNeighbourReextraction:
+    """Neighbour files are re-extracted but not re-stored; the cache must not see them."""
+
+    def test_reextract_bypasses_tree_cache(self, tmp_path, monkeypatch):
+        import roam.index.indexer as indexer_mod
+
+        (tmp_path / "b.prg").write_text("FUNCTION Beta\n  RETURN 1\nENDFUNC\n")
+        Indexer(tmp_path).run(quiet=True, progress_bar=False)
+        conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+        conn.row_factory = sqlite3.Row
+        fid = conn.execute("SELECT id FROM files WHERE path = 'b.prg'").fetchone()[0]
+
+        seen = []
+        real_parse = indexer_mod.parse_file
+
+        def recording_parse(path, language=None, tree_cache=None):
+            seen.append(tree_cache)
+            return real_parse(path, language, tree_cache=tree_cache)
+
+        monkeypatch.setattr(indexer_mod, "parse_file", recording_parse)
+        Indexer(tmp_path, tree_cache=TreeCache())._re_extract_affected(conn, {fid}, None, [], False)
+        assert seen == [None]
+
+    def test_neighbour_metrics_recomputed_after_its_own_edit(self, tmp_path):
+        probe = tmp_path / "probe.py"
+        probe.write_text("x = 1\n")
+        if parse_file(probe)[0] is None:
+            pytest.skip("no tree-sitter grammar available")
+        probe.unlink()
+
+        (tmp_path / "a.py").write_text("def foo():\n    return 1\n")
+        (tmp_path / "b.py").write_text("from a import foo\n\n\ndef bar(x):\n    return foo()\n")
+        indexer = Indexer(tmp_path, tree_cache=TreeCache())
+        indexer.run(quiet=True, progress_bar=False)
+
+        # b.py changes on disk, but only a.py is reindexed: b.py is merely
+        # re-extracted as a.py's neighbour and keeps its indexed metrics
+        (tmp_path / "b.py").write_text(
+            "from a import foo\n\n\ndef bar(x):\n    if x:\n        if x > 1:\n            return foo()\n    return foo()\n"
+        )
+        (tmp_path / "a.py").write_text("def foo():\n    return 2\n\n\ndef baz():\n    return 3\n")
+        indexer.run_paths(["a.py"], quiet=True, progress_bar=False)
+        indexer.run_paths(["b.py"], quiet=True, progress_bar=False)
+
+        conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+        cc = conn.execute(
+            "SELECT m.cognitive_complexity FROM symbol_metrics m JOIN symbols s ON s.id = m.symbol_id "
+            "WHERE s.name = 'bar'"
+        ).fetchone()[0]
+        assert cc > 0
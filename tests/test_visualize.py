@@ -205,3 +205,145 @@ class TestVisualizeEmpty:
         data = json.loads(out)
         assert data["summary"]["verdict"] == "EMPTY"
         assert data["summary"]["nodes"] == 0
+
+
+# ============================================================================
+# Level-of-detail (--collapse) view on a hand-built index
+# ============================================================================
+
+
+@pytest.fixture
+def lod_project(tmp_path, monkeypatch):
+    """Index with src/api <-> src/core cycle, a lib/ dependency and stored SCC/cluster ids."""
+    import sqlite3
+
+    from roam.db.connection import ensure_schema
+
+    (tmp_path / ".git").mkdir()
+    (tmp_path / ".roam").mkdir()
+    conn = sqlite3.connect(str(tmp_path / ".roam" / "index.db"))
+    ensure_schema(conn)
+    conn.executemany(
+        "INSERT INTO files (id, path) VALUES (?, ?)",
+        [(1, "src/api/routes.py"), (2, "src/core/engine.py"), (3, "lib/util.py"), (4, "setup.py")],
+    )
+    conn.executemany(
+        "INSERT INTO symbols (id, file_id, name, kind) VALUES (?, ?, ?, 'function')",
+        [(1, 1, "route"), (2, 1, "handler"), (3, 2, "run"), (4, 3, "helper"), (5, 4, "main")],
+    )
+    conn.executemany(
+        "INSERT INTO edges (source_id, target_id, kind) VALUES (?, ?, 'call')",
+        [(1, 3), (2, 3), (3, 1), (1, 4), (3, 4), (5, 1), (1, 2)],
+    )
+    conn.executemany(
+        "INSERT INTO graph_metrics (symbol_id, scc_id) VALUES (?, ?)",
+        [(1, 1), (2, None), (3, 1), (4, None), (5, None)],
+    )
+    conn.executemany(
+        "INSERT INTO clusters (symbol_id, cluster_id, cluster_label) VALUES (?, ?, ?)",
+        [(1, 7, "web"), (2, 7, "web"), (3, 7, "web"), (4, 8, "support")],
+    )
+    conn.commit()
+    conn.close()
+    monkeypatch.chdir(tmp_path)
+    return tmp_path
+
+
+def _invoke(*args):
+    from click.testing import CliRunner
+
+    from roam.cli import cli
+
+    result = CliRunner().invoke(cli, list(args))
+    assert result.exit_code == 0, result.output
+    return result.output
+
+
+class TestVisualizeCollapse:
+    """Super-node aggregation, expansion by prefix and streamed DOT."""
+
+    def test_dir_super_nodes(self, lod_project):
+        from roam.commands.cmd_visualize import _collapse_graph
+        from roam.db.connection import open_db
+
+        with open_db(readonly=True) as conn:
+            nodes, edges = _collapse_graph(conn, "dir", 1, ())
+        assert set(nodes) == {"src/", "lib/", "setup.py"}
+        assert nodes["src/"]["symbols"] == 3
+        # Intra-directory edges disappear; cross edges are summed
+        assert edges == {("src/", "lib/"): [2, 0], ("setup.py", "src/"): [1, 0]}
+
+    def test_expand_prefix_and_stored_scc(self, lod_project):
+        from roam.commands.cmd_visualize import _collapse_graph
+        from roam.db.connection import open_db
+
+        with open_db(readonly=True) as conn:
+            nodes, edges = _collapse_graph(conn, "dir", 1, ("src",))
+            assert set(nodes) == {"src/api/", "src/core/", "lib/", "setup.py"}
+            # route -> run and run -> route share stored SCC 1
+            assert edges[("src/api/", "src/core/")] == [2, 1]
+            assert edges[("src/core/", "src/api/")] == [1, 1]
+            nodes, _ = _collapse_graph(conn, "dir", 1, ("src/api",))
+            assert "src/api/routes.py" in nodes and "src/core/" in nodes
+
+    def test_cluster_mode(self, lod_project):
+        from roam.commands.cmd_visualize import _collapse_graph
+        from roam.db.connection import open_db
+
+        with open_db(readonly=True) as conn:
+            nodes, edges = _collapse_graph(conn, "cluster", 1, ())
+        assert nodes["cluster:7"]["label"] == "web"
+        assert nodes["cluster:7"]["symbols"] == 3
+        # Unclustered symbols fall back to their directory
+        assert nodes["setup.py"]["kind"] == "file"
+        assert edges[("cluster:7", "cluster:8")] == [2, 0]
+
+    def test_streamed_dot(self, lod_project):
+        out = _invoke("visualize", "--collapse", "dir", "--expand", "src", "--format", "dot")
+        assert "collapse=dir level=1 expand=src" in out
+        assert "shape=folder" in out
+        assert "style=dashed, color=red" in out
+        assert out.rstrip().endswith("}")
+
+    def test_json_and_limit(self, lod_project):
+        data = json.loads(_invoke("--json", "visualize", "--collapse", "dir", "--limit", "2"))
+        assert data["summary"]["nodes"] == 2
+        assert data["summary"]["hidden_nodes"] == 1
+        assert [n["key"] for n in data["super_nodes"]] == ["lib/", "src/"]
+        assert "graph TD" in data["diagram"]
+
+    def test_focus_rejected(self, lod_project):
+        from click.testing import CliRunner
+
+        from roam.cli import cli
+
+        result = CliRunner().invoke(cli, ["visualize", "--collapse", "dir", "--focus", "route"])
+        assert result.exit_code != 0
+
+    def test_flat_view_uses_stored_scc(self, lod_project):
+        out = _invoke("visualize", "--format", "dot", "--no-clusters")
+        assert "n1 -> n3 [style=dashed, color=red];" in out
+        assert "n1 -> n2;" in out
+
+    def test_upgraded_index_computes_scc(self, lod_project):
+        """An index upgraded to the scc_id column has it empty until the next index run."""
+        import sqlite3
+
+        from roam.commands.cmd_visualize import _collapse_graph
+        from roam.db.connection import ensure_schema, open_db
+        from roam.index.incremental import dirty_phases
+
+        db = lod_project / ".roam" / "index.db"
+        conn = sqlite3.connect(str(db))
+        conn.execute("ALTER TABLE graph_metrics DROP COLUMN scc_id")
+        ensure_schema(conn)
+        assert dirty_phases(conn) == ["graph_metrics"]
+        conn.commit()
+        conn.close()
+
+        with open_db(readonly=True) as conn:
+            _, edges = _collapse_graph(conn, "dir", 1, ("src",))
+        # Computed from edges: handler -> run -> route -> handler is a cycle too
+        assert edges[("src/api/", "src/core/")] == [2, 2]
+        out = _invoke("visualize", "--format", "dot", "--no-clusters")
+        assert "n1 -> n3 [style=dashed, color=red];" in out
@@ -554,6 +554,49 @@ class TestPollLoopWebhook:
         assert len(writes) == 1
 
 
+class TestPollLoopTargeted:
+    def _run(self, tmp_path, **kwargs):
+        (tmp_path / "a.py").write_text("x = 1\n")
+        sleeps = 0
+        discovered = [["a.py"]]
+
+        def _sleep(_seconds):
+            nonlocal sleeps
+            sleeps += 1
+            if sleeps > 3:
+                raise KeyboardInterrupt
+
+        with pytest.raises(KeyboardInterrupt):
+            poll_loop(
+                project_root=tmp_path,
+                interval=0.0,
+                debounce=0.0,
+                quiet=True,
+                _sleep=_sleep,
+                _discover=lambda: discovered.pop() if discovered else [],
+                **kwargs,
+            )
+
+    def test_file_changes_reindex_paths_then_refresh_when_idle(self, tmp_path):
+        events: list = []
+        self._run(
+            tmp_path,
+            _reindex=lambda force=False: events.append(("full", force)),
+            _reindex_paths=lambda paths: events.append(("paths", paths)),
+            _refresh_derived=lambda: events.append(("refresh",)),
+        )
+        assert events == [("paths", ["a.py"]), ("refresh",)]
+
+    def test_injected_reindex_alone_keeps_full_runs(self, tmp_path):
+        events: list = []
+        self._run(
+            tmp_path,
+            _reindex=lambda force=False: events.append(("full", force)),
+            _refresh_derived=lambda: events.append(("refresh",)),
+        )
+        assert events == [("full", False)]
+
+
 class TestWatchRegistration:
     def test_watch_registered_in_cli(self):
         from roam.cli import _COMMANDS
@@ -375,71 +375,59 @@ class TestWsStatus:
 class TestApiScanner:
     """Test API call/route scanning."""
 
-    def test_scan_file_for_api_calls(self, tmp_path):
-        from roam.workspace.api_scanner import _scan_file_for_api_calls
-
-        src = tmp_path / "api.js"
-        src.write_text(
-            'const res = api.get("/users");\n'
-            'api.post("/users/create", data);\n'
-            'axios.delete("/users/123");\n'
-            "const x = 42;\n"  # not an API call
-        )
-        calls = _scan_file_for_api_calls(src, "api.js")
-        assert len(calls) == 3
-        assert calls[0]["url_pattern"] == "/users"
-        assert calls[0]["http_method"] == "GET"
-        assert calls[1]["url_pattern"] == "/users/create"
-        assert calls[1]["http_method"] == "POST"
-        assert calls[2]["url_pattern"] == "/users/123"
-        assert calls[2]["http_method"] == "DELETE"
-
-    def test_scan_file_for_routes_laravel(self, tmp_path):
-        from roam.workspace.api_scanner import _scan_file_for_routes
-
-        src = tmp_path / "routes.php"
-        src.write_text(
-            "<?php\n"
-            "Route::get('/users', [UserController::class, 'index']);\n"
-            "Route::post('/users/create', [UserController::class, 'store']);\n"
-            "Route::delete('/users/{id}', [UserController::class, 'destroy']);\n"
-            "Route::resource('/articles', ArticleController::class);\n"
-        )
-        routes = _scan_file_for_routes(src, "routes.php")
-        assert len(routes) == 4
-        assert routes[0]["url_pattern"] == "/users"
-        assert routes[0]["http_method"] == "GET"
-        assert routes[1]["url_pattern"] == "/users/create"
-        assert routes[1]["http_method"] == "POST"
-        assert routes[2]["url_pattern"] == "/users/{id}"
-        assert routes[2]["http_method"] == "DELETE"
-        assert routes[3]["http_method"] == "RESOURCE"
-
-    def test_scan_file_for_routes_express(self, tmp_path):
-        from roam.workspace.api_scanner import _scan_file_for_routes
-
-        src = tmp_path / "routes.js"
-        src.write_text("router.get('/users', handler);\napp.post('/users', createHandler);\n")
-        routes = _scan_file_for_routes(src, "routes.js")
-        assert len(routes) == 2
-        assert routes[0]["http_method"] == "GET"
-        assert routes[1]["http_method"] == "POST"
-
-    def test_scan_file_for_routes_fastapi(self, tmp_path):
-        from roam.workspace.api_scanner import _scan_file_for_routes
-
-        src = tmp_path / "main.py"
-        src.write_text(
-            '@app.get("/items")\n'
-            "def list_items():\n"
-            "    return []\n"
-            "\n"
-            '@router.post("/items")\n'
-            "def create_item():\n"
-            "    pass\n"
-        )
-        routes = _scan_file_for_routes(src, "main.py")
-        assert len(routes) == 2
+    def test_scan_api_calls(self):
+        from roam.workspace.api_scanner import _iter_url_lines
+
+        lines = [
+            'const res = api.get("/users");',
+            'api.post("/users/create", data);',
+            'axios.delete("/users/123");',
+            "const x = 42;",  # not an API call
+        ]
+        calls = [(line, method, url) for line, _, _, method, url in _iter_url_lines(lines) if url]
+        assert calls == [
+            (1, "GET", "/users"),
+            (2, "POST", "/users/create"),
+            (3, "DELETE", "/users/123"),
+        ]
+
+    def test_scan_routes_laravel(self):
+        from roam.workspace.api_scanner import _iter_routes
+
+        lines = [
+            "<?php",
+            "Route::get('/users', [UserController::class, 'index']);",
+            "Route::post('/users/create', [UserController::class, 'store']);",
+            "Route::delete('/users/{id}', [UserController::class, 'destroy']);",
+            "Route::resource('/articles', ArticleController::class);",
+        ]
+        assert list(_iter_routes(lines)) == [
+            [2, "GET", "/users"],
+            [3, "POST", "/users/create"],
+            [4, "DELETE", "/users/{id}"],
+            [5, "RESOURCE", "/articles"],
+        ]
+
+    def test_scan_routes_express(self):
+        from roam.workspace.api_scanner import _iter_routes
+
+        lines = ["router.get('/users', handler);", "app.post('/users', createHandler);"]
+        routes = list(_iter_routes(lines))
+        assert [r[1] for r in routes] == ["GET", "POST"]
+
+    def test_scan_routes_fastapi(self):
+        from roam.workspace.api_scanner import _iter_routes
+
+        lines = [
+            '@app.get("/items")',
+            "def list_items():",
+            "    return []",
+            "",
+            '@router.post("/items")',
+            "def create_item():",
+            "    pass",
+        ]
+        assert list(_iter_routes(lines)) == [[1, "GET", "/items"], [5, "POST", "/items"]]
 
 
 class TestUrlNormalization:
@@ -655,6 +643,74 @@ class TestBuildCrossEdges:
 # ===================================================================
 
 
+class TestScanEngine:
+    """Route trie and content-hash scan cache."""
+
+    def test_trie_matches_pairwise_equivalence(self):
+        import random
+
+        from roam.workspace.api_scanner import _RouteTrie, _urls_equivalent
+
+        rnd = random.Random(3)
+        segs = ["users", "items", "[*]", "orders", "save"]
+        urls = ["/" + "/".join(rnd.choice(segs) for _ in range(rnd.randint(0, 4))) for _ in range(300)]
+        urls = [u.rstrip("/") or "/" for u in urls]
+        trie = _RouteTrie(urls)
+        unique = list(dict.fromkeys(urls))
+        for q in urls[:80]:
+            assert trie.match(q) == [u for u in unique if _urls_equivalent(q, u)]
+
+    def _repo_db(self, tmp_path, files: dict[str, str]):
+        import hashlib
+
+        from roam.db.connection import ensure_schema
+        from roam.db.source_store import store_source
+
+        db = tmp_path / "index.db"
+        conn = sqlite3.connect(str(db))
+        ensure_schema(conn)
+        for i, (path, text) in enumerate(files.items(), 1):
+            data = text.encode()
+            h = hashlib.sha256(data).hexdigest()
+            lang = "php" if path.endswith(".php") else "javascript"
+            conn.execute("INSERT INTO files (id, path, language, hash) VALUES (?, ?, ?, ?)", (i, path, lang, h))
+            store_source(conn, h, data)
+            conn.execute(
+                "INSERT INTO symbols (file_id, name, kind, line_start, line_end) VALUES (?, 'handler', 'function', 1, 99)",
+                (i,),
+            )
+        conn.commit()
+        conn.close()
+        return db
+
+    def test_scan_cache_skips_unchanged_files(self, tmp_path):
+        from roam.workspace.api_scanner import ScanCache, scan_backend_routes, scan_frontend_api_calls
+        from roam.workspace.db import open_workspace_db
+
+        (tmp_path / "fe").mkdir()
+        (tmp_path / "be").mkdir()
+        fe_db = self._repo_db(tmp_path / "fe", {"api.js": "api.get('/users/{id}')\napi.post('/users', d)\n"})
+        be_db = self._repo_db(tmp_path / "be", {"routes.php": "Route::get('/users/{id}', [C::class, 'show']);\n"})
+
+        with open_workspace_db(tmp_path) as ws_conn:
+            cache = ScanCache(ws_conn)
+            calls = scan_frontend_api_calls(fe_db, tmp_path / "fe", cache)
+            routes = scan_backend_routes(be_db, tmp_path / "be", cache)
+            assert (cache.hits, cache.misses) == (0, 2)
+            assert [(c["http_method"], c["url_pattern"], c["symbol_name"]) for c in calls] == [
+                ("GET", "/users/{id}", "handler"),
+                ("POST", "/users", "handler"),
+            ]
+            assert [(r["http_method"], r["url_pattern"], r["line"]) for r in routes] == [("GET", "/users/{id}", 1)]
+
+            again = ScanCache(ws_conn)
+            assert scan_frontend_api_calls(fe_db, tmp_path / "fe", again) == calls
+            assert scan_backend_routes(be_db, tmp_path / "be", again) == routes
+            assert (again.hits, again.misses) == (2, 0)
+            assert again.prune() == 0
+            assert ScanCache(ws_conn).prune() == 2
+
+
 class TestWsResolve:
     """Test `roam ws resolve` command."""
 